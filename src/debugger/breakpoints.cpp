@@ -183,13 +183,18 @@ HRESULT Breakpoints::ManagedCallbackBreakpoint(ICorDebugThread *pThread, ICorDeb
         return S_OK; // forced to interrupt this callback (breakpoint in not user code, continue process execution)
     }
 
-    if (SUCCEEDED(Status = m_uniqueLineBreakpoints->CheckBreakpointHit(pThread, pBreakpoint, breakpoint)) &&
+    // Note, key calculated once and used by line and function breakpoints for fast breakpoint search.
+    BreakpointUtils::FuncBreakpointKey hitKey;
+    if (FAILED(BreakpointUtils::GetFuncBreakpointKey(pBreakpoint, hitKey)))
+        return S_OK; // not function breakpoint, forced to interrupt this callback
+
+    if (SUCCEEDED(Status = m_uniqueLineBreakpoints->CheckBreakpointHit(pThread, hitKey, breakpoint)) &&
         Status == S_OK) // S_FALSE - no breakpoint hit
     {
         return S_FALSE; // S_FALSE - not affect on callback (callback will emit stop event)
     }
 
-    if (SUCCEEDED(Status = m_uniqueFuncBreakpoints->CheckBreakpointHit(pThread, pBreakpoint, breakpoint)) &&
+    if (SUCCEEDED(Status = m_uniqueFuncBreakpoints->CheckBreakpointHit(pThread, hitKey, breakpoint)) &&
         Status == S_OK) // S_FALSE - no breakpoint hit
     {
         return S_FALSE; // S_FALSE - not affect on callback (callback will emit stop event)
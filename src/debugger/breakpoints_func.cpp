@@ -27,18 +27,34 @@ void FuncBreakpoints::DeleteAll()
 {
     m_breakpointsMutex.lock();
     m_funcBreakpoints.clear();
+    m_hitIndex.clear();
     m_breakpointsMutex.unlock();
 }
 
-HRESULT FuncBreakpoints::CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, Breakpoint &breakpoint)
+static std::string GetFullFuncName(const std::string &module, const std::string &func, const std::string &params)
+{
+    std::string fullFuncName("");
+
+    if (!module.empty())
+        fullFuncName = module + "!";
+
+    fullFuncName += func + params;
+    return fullFuncName;
+}
+
+HRESULT FuncBreakpoints::CheckBreakpointHit(ICorDebugThread *pThread, const BreakpointUtils::FuncBreakpointKey &hitKey, Breakpoint &breakpoint)
 {
     if (m_funcBreakpoints.empty())
         return S_FALSE; // Stopped at break, but no breakpoints.
 
-    HRESULT Status;
-    ToRelease<ICorDebugFunctionBreakpoint> pFunctionBreakpoint;
-    IfFailRet(pBreakpoint->QueryInterface(IID_ICorDebugFunctionBreakpoint, (LPVOID *) &pFunctionBreakpoint));
+    // Note, check index first, since arguments types calculation below is expensive.
+    auto findNames = m_hitIndex.find(hitKey);
+    if (findNames == m_hitIndex.end())
+        return S_FALSE; // Stopped at break, but no breakpoints.
+    // Note, index could be changed during IsEnableByCondition() eval (new module load).
+    const std::vector<std::string> names(findNames->second.begin(), findNames->second.end());
 
+    HRESULT Status;
     ToRelease<ICorDebugFrame> pFrame;
     IfFailRet(pThread->GetActiveFrame(&pFrame));
     if (pFrame == nullptr)
@@ -76,19 +92,24 @@ HRESULT FuncBreakpoints::CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugB
 
     // Note, since IsEnableByCondition() during eval execution could neutered frame, all frame-related calculation
     // must be done before enter into this cycles.
-    for (auto &fb : m_funcBreakpoints)
+    for (const auto &name : names)
     {
-        ManagedFuncBreakpoint &fbp = fb.second;
+        auto findBreakpoint = m_funcBreakpoints.find(name);
+        if (findBreakpoint == m_funcBreakpoints.end())
+            continue;
+
+        ManagedFuncBreakpoint &fbp = findBreakpoint->second;
 
         if (!fbp.enabled || (!fbp.params.empty() && params != fbp.params))
             continue;
 
         for (auto &funcBreakpoint : fbp.funcBreakpoints)
         {
-            if (FAILED(BreakpointUtils::IsSameFunctionBreakpoint(pFunctionBreakpoint, funcBreakpoint.iCorFuncBreakpoint)) ||
-                FAILED(BreakpointUtils::IsEnableByCondition(fbp.condition, m_sharedVariables.get(), pThread)))
+            if (!(funcBreakpoint.key == hitKey) ||
+                FAILED(BreakpointUtils::IsEnableByCondition(fbp.id, fbp.condition, fbp.compiledCondition, m_sharedVariables.get(), pThread)))
                 continue;
-            
+
+
             ++fbp.times;
             fbp.ToBreakpoint(breakpoint);
             return S_OK;
@@ -127,13 +148,7 @@ HRESULT FuncBreakpoints::SetFuncBreakpoints(bool haveProcess, const std::vector<
     std::unordered_set<std::string> funcBreakpointFuncs;
     for (const auto &fb : funcBreakpoints)
     {
-        std::string fullFuncName("");
-        if (!fb.module.empty())
-        {
-            fullFuncName = fb.module + "!";
-        }
-        fullFuncName += fb.func + fb.params;
-        funcBreakpointFuncs.insert(fullFuncName);
+        funcBreakpointFuncs.insert(GetFullFuncName(fb.module, fb.func, fb.params));
     }
     for (auto it = m_funcBreakpoints.begin(); it != m_funcBreakpoints.end();)
     {
@@ -152,13 +167,7 @@ HRESULT FuncBreakpoints::SetFuncBreakpoints(bool haveProcess, const std::vector<
 
     for (const auto &fb : funcBreakpoints)
     {
-        std::string fullFuncName("");
-
-        if (!fb.module.empty())
-            fullFuncName = fb.module + "!";
-
-        fullFuncName += fb.func + fb.params;
-
+        std::string fullFuncName = GetFullFuncName(fb.module, fb.func, fb.params);
         Breakpoint breakpoint;
 
         auto b = m_funcBreakpoints.find(fullFuncName);
@@ -273,7 +282,11 @@ HRESULT FuncBreakpoints::AddFuncBreakpoint(ManagedFuncBreakpoint &fbp, ResolvedF
         IfFailRet(pCode->CreateBreakpoint(ilNextOffset, &iCorFuncBreakpoint));
         IfFailRet(iCorFuncBreakpoint->Activate(fbp.enabled ? TRUE : FALSE));
 
-        fbp.funcBreakpoints.emplace_back(entry.second, currentVersion, iCorFuncBreakpoint.Detach());
+        BreakpointUtils::FuncBreakpointKey key;
+        IfFailRet(BreakpointUtils::GetFuncBreakpointKey(iCorFuncBreakpoint.GetPtr(), key));
+        m_hitIndex[key].emplace(GetFullFuncName(fbp.module, fbp.name, fbp.params));
+
+        fbp.funcBreakpoints.emplace_back(entry.second, currentVersion, iCorFuncBreakpoint.Detach(), key);
     }
 
     return S_OK;
@@ -14,7 +14,9 @@
 #include <list>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include "interfaces/idebugger.h"
+#include "debugger/breakpointutils.h"
 #include "utils/torelease.h"
 
 namespace netcoredbg
@@ -45,7 +47,7 @@ public:
     // Important! Must provide succeeded return code:
     // S_OK - breakpoint hit
     // S_FALSE - no breakpoint hit
-    HRESULT CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, Breakpoint &breakpoint);
+    HRESULT CheckBreakpointHit(ICorDebugThread *pThread, const BreakpointUtils::FuncBreakpointKey &hitKey, Breakpoint &breakpoint);
 
     // Important! Callbacks related methods must control return for succeeded return code.
     // Do not allow debugger API return succeeded (uncontrolled) return code.
@@ -69,9 +71,11 @@ private:
             mdMethodDef methodToken;
             ULONG32 methodVersion;
             ToRelease<ICorDebugFunctionBreakpoint> iCorFuncBreakpoint;
+            BreakpointUtils::FuncBreakpointKey key;
 
-            internalFuncBreakpoint(mdMethodDef methodToken_, ULONG32 methodVersion_, ICorDebugFunctionBreakpoint *pCorDebugFunctionBreakpoint) : 
-                methodToken(methodToken_), methodVersion(methodVersion_), iCorFuncBreakpoint(pCorDebugFunctionBreakpoint)
+            internalFuncBreakpoint(mdMethodDef methodToken_, ULONG32 methodVersion_, ICorDebugFunctionBreakpoint *pCorDebugFunctionBreakpoint,
+                                   const BreakpointUtils::FuncBreakpointKey &key_) :
+                methodToken(methodToken_), methodVersion(methodVersion_), iCorFuncBreakpoint(pCorDebugFunctionBreakpoint), key(key_)
             {}
 
             internalFuncBreakpoint(internalFuncBreakpoint &&that) = default;
@@ -88,6 +92,7 @@ private:
         ULONG32 times;
         bool enabled;
         std::string condition;
+        BreakpointUtils::CompiledCondition compiledCondition;
         std::list<internalFuncBreakpoint> funcBreakpoints;
 
         bool IsResolved() const { return module_checked; }
@@ -116,6 +121,9 @@ private:
 
     std::mutex m_breakpointsMutex;
     std::unordered_map<std::string, ManagedFuncBreakpoint> m_funcBreakpoints;
+    // Breakpoint hit index: function breakpoint key -> m_funcBreakpoints keys (full function names).
+    // Note, we don't remove entries from index at breakpoint remove, all found by index data checked at breakpoint hit.
+    std::unordered_map<BreakpointUtils::FuncBreakpointKey, std::unordered_set<std::string>, BreakpointUtils::FuncBreakpointKeyHash> m_hitIndex;
 
     typedef std::vector<std::pair<ICorDebugModule*,mdMethodDef> > ResolvedFBP;
     HRESULT AddFuncBreakpoint(ManagedFuncBreakpoint &fbp, ResolvedFBP &fbpResolved);
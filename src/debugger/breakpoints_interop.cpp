@@ -4,8 +4,6 @@
 
 #include "debugger/breakpoints_interop.h"
 #include "debugger/interop_brk_helpers.h"
-#include <sys/uio.h> // iovec
-#include <elf.h> // NT_PRSTATUS
 #include <assert.h>
 #include <string.h>
 #include "utils/logger.h"
@@ -21,26 +19,15 @@ int InteropBreakpoints::Add(pid_t pid, std::uintptr_t brkAddr, bool isThumbCode,
     m_breakpointsMutex.lock();
 
     word_t savedData = 0;
-    word_t dataWithBrk = 0;
 
     auto find = m_currentBreakpointsInMemory.find(brkAddr);
     if (find == m_currentBreakpointsInMemory.end())
     {
         StopAllThreads();
-        errno = 0;  // Since the value returned by a successful PTRACE_PEEK* request may be -1, the caller must clear errno before the call,
-                    // and then check it afterward to determine whether or not an error occurred.
-        savedData = async_ptrace(PTRACE_PEEKDATA, pid, (void*)brkAddr, nullptr);
-        if (errno != 0)
+        int err_code = ReadModifyWriteData(pid, brkAddr, [&](word_t data) { return EncodeBrkOpcode(data, isThumbCode); }, savedData);
+        if (err_code != 0)
         {
-            int err_code = errno;
-            LOGE("Ptrace peekdata error: %s", strerror(err_code));
-            return err_code;
-        }
-        dataWithBrk = EncodeBrkOpcode(savedData, isThumbCode);
-        if (async_ptrace(PTRACE_POKEDATA, pid, (void*)brkAddr, (void*)dataWithBrk) == -1)
-        {
-            int err_code = errno;
-            LOGE("Ptrace pokedata error: %s", strerror(err_code));
+            m_breakpointsMutex.unlock();
             return err_code;
         }
 
@@ -69,22 +56,12 @@ int InteropBreakpoints::Remove(pid_t pid, std::uintptr_t brkAddr, std::function<
         StopAllThreads();
         FixAllThreads(find->first);
 
-        errno = 0;
-        word_t brkData = async_ptrace(PTRACE_PEEKDATA, pid, (void*)find->first, nullptr);
-        if (errno != 0)
-        {
-            int err_code = errno;
-            LOGE("Ptrace peekdata error: %s", strerror(err_code));
+        word_t brkData = 0;
+        word_t savedData = find->second.m_savedData;
+        int err_code = ReadModifyWriteData(pid, find->first, [&](word_t data) { return RestoredOpcode(data, savedData); }, brkData);
+        if (err_code != 0)
             return err_code;
-        }
-        word_t restoredData = RestoredOpcode(brkData, find->second.m_savedData);
 
-        if (async_ptrace(PTRACE_POKEDATA, pid, (void*)find->first, (void*)restoredData) == -1)
-        {
-            int err_code = errno;
-            LOGW("Ptrace pokedata error: %s\n", strerror(err_code));
-            return err_code;
-        }
         m_currentBreakpointsInMemory.erase(find);
     }
     return 0;
@@ -97,21 +74,34 @@ void InteropBreakpoints::RemoveAllAtDetach(pid_t pid)
 
     if (pid != 0) // In case we already don't have process, no need real remove from memory.
     {
-        for (auto entry : m_currentBreakpointsInMemory)
+        // Restore all breakpoints by one ptrace thread handoff.
+        std::vector<std::pair<std::uintptr_t, int>> peekErrors;
+        std::vector<std::pair<std::uintptr_t, int>> pokeErrors;
+        async_ptrace_exec([&]()
         {
-            errno = 0;
-            word_t brkData = async_ptrace(PTRACE_PEEKDATA, pid, (void*)entry.first, nullptr);
-            if (errno != 0)
+            for (const auto &entry : m_currentBreakpointsInMemory)
             {
-                LOGE("Ptrace peekdata error: %s", strerror(errno));
-                continue;
+                errno = 0;
+                word_t brkData = ptrace(PTRACE_PEEKDATA, pid, (void*)entry.first, nullptr);
+                if (errno != 0)
+                {
+                    peekErrors.emplace_back(entry.first, errno);
+                    continue;
+                }
+                word_t restoredData = RestoredOpcode(brkData, entry.second.m_savedData);
+
+                if (ptrace(PTRACE_POKEDATA, pid, (void*)entry.first, (void*)restoredData) == -1)
+                    pokeErrors.emplace_back(entry.first, errno);
             }
-            word_t restoredData = RestoredOpcode(brkData, entry.second.m_savedData);
+        });
 
-            if (async_ptrace(PTRACE_POKEDATA, pid, (void*)entry.first, (void*)restoredData) == -1)
-            {
-                LOGE("Ptrace pokedata error: %s\n", strerror(errno));
-            }
+        for (const auto &entry : peekErrors)
+        {
+            LOGE("Ptrace peekdata error: %s", strerror(entry.second));
+        }
+        for (const auto &entry : pokeErrors)
+        {
+            LOGE("Ptrace pokedata error: %s\n", strerror(entry.second));
         }
     }
 
@@ -150,23 +140,8 @@ bool InteropBreakpoints::StepPrevToBrk(pid_t pid, std::uintptr_t brkAddr)
     if (!NeedSetPrevBrkPC())
         return true;
 
-    user_regs_struct regs;
-    iovec iov;
-    iov.iov_base = &regs;
-    iov.iov_len = sizeof(user_regs_struct);
-    if (async_ptrace(PTRACE_GETREGSET, pid, (void*)NT_PRSTATUS, &iov) == -1)
-    {
-        LOGE("Ptrace getregset error: %s\n", strerror(errno));
-        std::abort(); // Fatal error, we already logged all data about this error.
-    }
-
-    SetPrevBrkPC(regs);
-
-    if (async_ptrace(PTRACE_SETREGSET, pid, (void*)NT_PRSTATUS, &iov) == -1)
-    {
-        LOGE("Ptrace setregset error: %s\n", strerror(errno));
+    if (!SetPrevBrkPCForThread(pid))
         std::abort(); // Fatal error, we already logged all data about this error.
-    }
 
     return true;
 }
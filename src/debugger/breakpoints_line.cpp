@@ -28,42 +28,27 @@ void LineBreakpoints::DeleteAll()
     m_breakpointsMutex.lock();
     m_lineResolvedBreakpoints.clear();
     m_lineBreakpointMapping.clear();
+    m_hitIndex.clear();
     m_breakpointsMutex.unlock();
 }
 
-HRESULT LineBreakpoints::CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, Breakpoint &breakpoint)
+HRESULT LineBreakpoints::CheckBreakpointHit(ICorDebugThread *pThread, const BreakpointUtils::FuncBreakpointKey &hitKey, Breakpoint &breakpoint)
 {
-    HRESULT Status;
-    ToRelease<ICorDebugFunctionBreakpoint> pFunctionBreakpoint;
-    IfFailRet(pBreakpoint->QueryInterface(IID_ICorDebugFunctionBreakpoint, (LPVOID *) &pFunctionBreakpoint));
-
-    ToRelease<ICorDebugFrame> pFrame;
-    IfFailRet(pThread->GetActiveFrame(&pFrame));
-    if (pFrame == nullptr)
-        return E_FAIL;
-
-    ULONG32 ilOffset;
-    Modules::SequencePoint sp;
-    IfFailRet(m_sharedModules->GetFrameILAndSequencePoint(pFrame, ilOffset, sp));
-
-    unsigned filenameIndex;
-    IfFailRet(m_sharedModules->GetIndexBySourceFullPath(sp.document, filenameIndex));
+    auto findLocation = m_hitIndex.find(hitKey);
+    if (findLocation == m_hitIndex.end())
+        return S_FALSE; // Stopped at break, but no breakpoints.
+    const resolved_location_t location = findLocation->second;
 
-    auto breakpoints = m_lineResolvedBreakpoints.find(filenameIndex);
+    auto breakpoints = m_lineResolvedBreakpoints.find(location.fullname_index);
     if (breakpoints == m_lineResolvedBreakpoints.end())
-        return E_FAIL;
+        return S_FALSE; // Stopped at break, but no breakpoints.
 
     auto &breakpointsInSource = breakpoints->second;
-    auto it = breakpointsInSource.find(sp.startLine);
+    auto it = breakpointsInSource.find(location.linenum);
     if (it == breakpointsInSource.end())
         return S_FALSE; // Stopped at break, but no breakpoints.
 
     std::list<ManagedLineBreakpoint> &bList = it->second;
-    if (bList.empty())
-        return S_FALSE; // Stopped at break, but no breakpoints.
-
-    mdMethodDef methodToken;
-    IfFailRet(pFrame->GetFunctionToken(&methodToken));
 
     // Same logic as provide vsdbg - only one breakpoint is active for one line, find first active in the list.
     for (auto &b : bList)
@@ -71,14 +56,16 @@ HRESULT LineBreakpoints::CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugB
         if (!b.enabled)
             continue;
 
-        for (const auto &iCorFuncBreakpoint : b.iCorFuncBreakpoints)
+        for (const auto &key : b.iCorFuncBreakpointsKeys)
         {
-            if (FAILED(BreakpointUtils::IsSameFunctionBreakpoint(pFunctionBreakpoint, iCorFuncBreakpoint)) ||
-                FAILED(BreakpointUtils::IsEnableByCondition(b.condition, m_sharedVariables.get(), pThread)))
+            if (!(key == hitKey) ||
+                FAILED(BreakpointUtils::IsEnableByCondition(b.id, b.condition, b.compiledCondition, m_sharedVariables.get(), pThread)))
                 continue;
 
             ++b.times;
-            b.ToBreakpoint(breakpoint, sp.document);
+            std::string resolved_fullname;
+            m_sharedModules->GetSourceFullPathByIndex(location.fullname_index, resolved_fullname);
+            b.ToBreakpoint(breakpoint, resolved_fullname);
             return S_OK;
         }
     }
@@ -167,6 +154,7 @@ static HRESULT ActivateLineBreakpoint(LineBreakpoints::ManagedLineBreakpoint &bp
     CORDB_ADDRESS modAddress = 0;
     CORDB_ADDRESS modAddressTrack = 0;
     bp.iCorFuncBreakpoints.reserve(resolvedPoints.size());
+    bp.iCorFuncBreakpointsKeys.reserve(resolvedPoints.size());
     for (const auto &resolvedBP : resolvedPoints)
     {
         // Note, we might have situation with same source path in different modules.
@@ -196,7 +184,11 @@ static HRESULT ActivateLineBreakpoint(LineBreakpoints::ManagedLineBreakpoint &bp
         IfFailRet(pCode->CreateBreakpoint(resolvedBP.ilOffset, &iCorFuncBreakpoint));
         IfFailRet(iCorFuncBreakpoint->Activate(bp.enabled ? TRUE : FALSE));
 
+        BreakpointUtils::FuncBreakpointKey key;
+        IfFailRet(BreakpointUtils::GetFuncBreakpointKey(iCorFuncBreakpoint.GetPtr(), key));
+
         bp.iCorFuncBreakpoints.emplace_back(iCorFuncBreakpoint.Detach());
+        bp.iCorFuncBreakpointsKeys.emplace_back(key);
     }
 
     if (modAddress == 0)
@@ -204,6 +196,7 @@ static HRESULT ActivateLineBreakpoint(LineBreakpoints::ManagedLineBreakpoint &bp
 
     // No reason leave extra space here, since breakpoint could be setup for 1 module only (no more breakpoints will be added).
     bp.iCorFuncBreakpoints.shrink_to_fit();
+    bp.iCorFuncBreakpointsKeys.shrink_to_fit();
 
     // same for multiple breakpoint resolve for one module
     bp.linenum = resolvedPoints[0].startLine;
@@ -213,6 +206,19 @@ static HRESULT ActivateLineBreakpoint(LineBreakpoints::ManagedLineBreakpoint &bp
     return S_OK;
 }
 
+// Caller must care about m_breakpointsMutex.
+void LineBreakpoints::AddResolvedBreakpoint(unsigned resolved_fullname_index, ManagedLineBreakpoint &&bp)
+{
+    for (const auto &key : bp.iCorFuncBreakpointsKeys)
+    {
+        m_hitIndex[key] = resolved_location_t{resolved_fullname_index, bp.linenum};
+    }
+
+    auto &bList = m_lineResolvedBreakpoints[resolved_fullname_index][bp.linenum];
+    bList.push_back(std::move(bp));
+    EnableOneICorBreakpointForLine(bList);
+}
+
 HRESULT LineBreakpoints::ManagedCallbackLoadModule(ICorDebugModule *pModule, std::vector<BreakpointEvent> &events)
 {
     std::lock_guard<std::mutex> lock(m_breakpointsMutex);
@@ -248,8 +254,7 @@ HRESULT LineBreakpoints::ManagedCallbackLoadModule(ICorDebugModule *pModule, std
             initialBreakpoint.resolved_fullname_index = resolved_fullname_index;
             initialBreakpoint.resolved_linenum = bp.linenum;
 
-            m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum].push_back(std::move(bp));
-            EnableOneICorBreakpointForLine(m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum]);
+            AddResolvedBreakpoint(resolved_fullname_index, std::move(bp));
         }
     }
 
@@ -327,8 +332,7 @@ HRESULT LineBreakpoints::UpdateLineBreakpoint(bool haveProcess, int id, int line
 
             bp.ToBreakpoint(breakpoint, resolved_fullname);
 
-            m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum].push_back(std::move(bp));
-            EnableOneICorBreakpointForLine(m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum]);
+            AddResolvedBreakpoint(resolved_fullname_index, std::move(bp));
             return S_OK;
         }
     }
@@ -446,8 +450,7 @@ HRESULT LineBreakpoints::SetLineBreakpoints(bool haveProcess, const std::string&
                 std::string resolved_fullname;
                 m_sharedModules->GetSourceFullPathByIndex(resolved_fullname_index, resolved_fullname);
                 bp.ToBreakpoint(breakpoint, resolved_fullname);
-                m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum].push_back(std::move(bp));
-                EnableOneICorBreakpointForLine(m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum]);
+                AddResolvedBreakpoint(resolved_fullname_index, std::move(bp));
             }
             else
             {
@@ -587,8 +590,7 @@ HRESULT LineBreakpoints::UpdateBreakpointsOnHotReload(ICorDebugModule *pModule,
                 events.emplace_back(BreakpointChanged, breakpoint);
             }
 
-            m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum].push_back(std::move(bp));
-            EnableOneICorBreakpointForLine(m_lineResolvedBreakpoints[resolved_fullname_index][initialBreakpoint.resolved_linenum]);
+            AddResolvedBreakpoint(resolved_fullname_index, std::move(bp));
         }
     }
 
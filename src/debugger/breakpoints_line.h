@@ -14,6 +14,7 @@
 #include <string>
 #include <unordered_map>
 #include "interfaces/idebugger.h"
+#include "debugger/breakpointutils.h"
 #include "utils/torelease.h"
 
 namespace netcoredbg
@@ -45,7 +46,7 @@ public:
     // Important! Must provide succeeded return code:
     // S_OK - breakpoint hit
     // S_FALSE - no breakpoint hit
-    HRESULT CheckBreakpointHit(ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint, Breakpoint &breakpoint);
+    HRESULT CheckBreakpointHit(ICorDebugThread *pThread, const BreakpointUtils::FuncBreakpointKey &hitKey, Breakpoint &breakpoint);
 
     // Important! Callbacks related methods must control return for succeeded return code.
     // Do not allow debugger API return succeeded (uncontrolled) return code.
@@ -66,9 +67,12 @@ public:
         bool enabled;
         ULONG32 times;
         std::string condition;
+        BreakpointUtils::CompiledCondition compiledCondition;
         // In case of code line in constructor, we could resolve multiple methods for breakpoints.
         // For example, `MyType obj = new MyType(1);` code will be added to all class constructors).
         std::vector<ToRelease<ICorDebugFunctionBreakpoint> > iCorFuncBreakpoints;
+        // Keys for iCorFuncBreakpoints (same indexes), used for fast breakpoint search at breakpoint hit.
+        std::vector<BreakpointUtils::FuncBreakpointKey> iCorFuncBreakpointsKeys;
 
         bool IsVerified() const { return !iCorFuncBreakpoints.empty(); }
 
@@ -122,6 +126,17 @@ private:
     // Container have structure for fast compare current breakpoints data with new breakpoints data from protocol:
     // path to source -> list of ManagedLineBreakpointMapping that include LineBreakpoint (from protocol) and resolve related data.
     std::unordered_map<std::string, std::list<ManagedLineBreakpointMapping> > m_lineBreakpointMapping;
+    // Breakpoint hit index: function breakpoint key -> resolved source full path index and resolved line number in m_lineResolvedBreakpoints.
+    // Note, we don't remove entries from index at breakpoint remove, since index could only point to m_lineResolvedBreakpoints entry,
+    // that will be checked at breakpoint hit in any case (data for removed breakpoint will not be found).
+    struct resolved_location_t
+    {
+        unsigned fullname_index;
+        int linenum;
+    };
+    std::unordered_map<BreakpointUtils::FuncBreakpointKey, resolved_location_t, BreakpointUtils::FuncBreakpointKeyHash> m_hitIndex;
+
+    void AddResolvedBreakpoint(unsigned resolved_fullname_index, ManagedLineBreakpoint &&bp);
 
 };
 
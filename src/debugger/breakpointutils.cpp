@@ -2,9 +2,14 @@
 // Distributed under the MIT License.
 // See the LICENSE file in the project root for more information.
 
+#include <chrono>
 #include "debugger/breakpointutils.h"
 #include "debugger/variables.h"
+#include "debugger/evaluator.h"
+#include "debugger/evalstackmachine.h"
+#include "debugger/valueprint.h"
 #include "metadata/attributes.h"
+#include "utils/logger.h"
 #include "utils/torelease.h"
 
 namespace netcoredbg
@@ -13,6 +18,38 @@ namespace netcoredbg
 namespace BreakpointUtils
 {
 
+HRESULT GetFuncBreakpointKey(ICorDebugFunctionBreakpoint *pBreakpoint, FuncBreakpointKey &key)
+{
+    HRESULT Status;
+
+    if (!pBreakpoint)
+        return E_FAIL;
+
+    IfFailRet(pBreakpoint->GetOffset(&key.ilOffset));
+
+    ToRelease<ICorDebugFunction> pFunction;
+    IfFailRet(pBreakpoint->GetFunction(&pFunction));
+    IfFailRet(pFunction->GetToken(&key.methodToken));
+
+    ToRelease<ICorDebugModule> pModule;
+    IfFailRet(pFunction->GetModule(&pModule));
+    IfFailRet(pModule->GetBaseAddress(&key.modAddress));
+
+    ToRelease<ICorDebugCode> pCode;
+    IfFailRet(pFunction->GetILCode(&pCode));
+    IfFailRet(pCode->GetVersionNumber(&key.methodVersion));
+
+    return S_OK;
+}
+
+HRESULT GetFuncBreakpointKey(ICorDebugBreakpoint *pBreakpoint, FuncBreakpointKey &key)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugFunctionBreakpoint> pFunctionBreakpoint;
+    IfFailRet(pBreakpoint->QueryInterface(IID_ICorDebugFunctionBreakpoint, (LPVOID *) &pFunctionBreakpoint));
+    return GetFuncBreakpointKey(pFunctionBreakpoint, key);
+}
+
 HRESULT IsSameFunctionBreakpoint(ICorDebugFunctionBreakpoint *pBreakpoint1, ICorDebugFunctionBreakpoint *pBreakpoint2)
 {
     HRESULT Status;
@@ -69,30 +106,158 @@ HRESULT IsSameFunctionBreakpoint(ICorDebugFunctionBreakpoint *pBreakpoint1, ICor
     return S_OK;
 }
 
-HRESULT IsEnableByCondition(const std::string &condition, Variables *pVariables, ICorDebugThread *pThread)
+// Read primitive value directly from debuggee memory, no func-eval or managed part calls here.
+static HRESULT GetConditionValue(ICorDebugValue *pInputValue, ConditionValue &value)
 {
     HRESULT Status;
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, &isNull));
+    if (isNull)
+        return E_FAIL;
+
+    CorElementType corType;
+    IfFailRet(pValue->GetType(&corType));
+
+    ToRelease<ICorDebugGenericValue> pGenericValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugGenericValue, (LPVOID*) &pGenericValue));
+
+    ULONG32 cbSize = 0;
+    IfFailRet(pValue->GetSize(&cbSize));
+    union
+    {
+        int8_t i1; uint8_t u1; int16_t i2; uint16_t u2; int32_t i4; uint32_t u4;
+        int64_t i8; uint64_t u8; float r4; double r8;
+    } data;
+    if (cbSize > sizeof(data))
+        return E_FAIL;
+    IfFailRet(pGenericValue->GetValue(&data));
 
-    if (!condition.empty())
+    switch (corType)
     {
-        DWORD threadId = 0;
-        IfFailRet(pThread->GetID(&threadId));
-        FrameId frameId(ThreadId{threadId}, FrameLevel{0});
+        case ELEMENT_TYPE_BOOLEAN: value = ConditionValue::Boolean(data.u1 != 0); break;
+        case ELEMENT_TYPE_CHAR: value = ConditionValue::Signed(data.u2); break;
+        case ELEMENT_TYPE_I1: value = ConditionValue::Signed(data.i1); break;
+        case ELEMENT_TYPE_U1: value = ConditionValue::Signed(data.u1); break;
+        case ELEMENT_TYPE_I2: value = ConditionValue::Signed(data.i2); break;
+        case ELEMENT_TYPE_U2: value = ConditionValue::Signed(data.u2); break;
+        case ELEMENT_TYPE_I4: value = ConditionValue::Signed(data.i4); break;
+        case ELEMENT_TYPE_U4: value = ConditionValue::Signed(data.u4); break;
+        case ELEMENT_TYPE_I8: value = ConditionValue::Signed(data.i8); break;
+        case ELEMENT_TYPE_U8: value = ConditionValue::Unsigned(data.u8); break;
+        case ELEMENT_TYPE_R4: value = ConditionValue::Single(data.r4); break;
+        case ELEMENT_TYPE_R8: value = ConditionValue::Real(data.r8); break;
+        default: return E_FAIL; // enums, decimal, nullable, etc. - stack machine's work
+    }
 
-        ToRelease<ICorDebugProcess> iCorProcess;
-        IfFailRet(pThread->GetProcess(&iCorProcess));
+    return S_OK;
+}
 
-        Variable variable;
-        std::string output;
-        IfFailRet(pVariables->Evaluate(iCorProcess, frameId, condition, variable, output));
+void CompiledCondition::Compile(const std::string &condition)
+{
+    m_condition = condition;
+    m_compileStatus = S_OK;
+    m_program.reset();
+    m_predicateEnabled = ParseConditionPredicate(condition, m_predicate);
+    m_evalCount = 0;
+    m_evalTotalTime = 0;
+    m_evalMaxTime = 0;
+}
 
-        if (variable.type != "bool" || variable.value != "true")
-            return E_FAIL;
+HRESULT CompiledCondition::EvaluatePredicate(ICorDebugThread *pThread, Evaluator *pEvaluator, bool &result)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugValue> pResultValue;
+    IfFailRet(pEvaluator->ResolveIdentifiers(pThread, FrameLevel{0}, nullptr, nullptr, m_predicate.identifiers,
+                                             &pResultValue, nullptr, nullptr, EVAL_NOFUNCEVAL));
+    if (!pResultValue) // property, getter call needed
+        return E_FAIL;
+
+    ConditionValue value;
+    IfFailRet(GetConditionValue(pResultValue, value));
+
+    return EvaluateConditionPredicate(m_predicate, value, result) ? S_OK : E_FAIL;
+}
+
+HRESULT CompiledCondition::EvaluateProgram(ICorDebugThread *pThread, EvalStackMachine *pEvalStackMachine, bool &result)
+{
+    HRESULT Status;
+    std::string output;
+    if (!m_program)
+    {
+        // Note, don't try to compile same condition with syntax error at each breakpoint hit.
+        IfFailRet(m_compileStatus);
+        if (FAILED(Status = pEvalStackMachine->CompileExpression(m_condition, m_program, output)))
+        {
+            LOGW("Condition `%s` compilation failed: %s", m_condition.c_str(), output.c_str());
+            m_compileStatus = Status;
+            return Status;
+        }
     }
 
+    ToRelease<ICorDebugValue> pResultValue;
+    IfFailRet(pEvalStackMachine->EvaluateExpression(pThread, FrameLevel{0}, defaultEvalFlags, *m_program, &pResultValue, output));
+
+    ConditionValue value;
+    if (FAILED(GetConditionValue(pResultValue, value)) ||
+        value.kind != ConditionValue::Kind::Boolean)
+        return E_FAIL;
+
+    result = value.booleanValue;
     return S_OK;
 }
 
+HRESULT CompiledCondition::Evaluate(ICorDebugThread *pThread, const std::string &condition, Evaluator *pEvaluator,
+                                    EvalStackMachine *pEvalStackMachine, bool &result)
+{
+    if (condition != m_condition)
+        Compile(condition);
+
+    if (m_predicateEnabled)
+    {
+        if (SUCCEEDED(EvaluatePredicate(pThread, pEvaluator, result)))
+        {
+            m_lastEvalNative = true;
+            return S_OK;
+        }
+        // Identifier can't be resolved without func-eval or value not primitive (could be changed at next hit, for example,
+        // null reference in access chain), use stack machine for this breakpoint hit only.
+    }
+
+    m_lastEvalNative = false;
+    return EvaluateProgram(pThread, pEvalStackMachine, result);
+}
+
+void CompiledCondition::AddEvalTime(uint64_t nanoseconds)
+{
+    m_evalCount++;
+    m_evalTotalTime += nanoseconds;
+    if (nanoseconds > m_evalMaxTime)
+        m_evalMaxTime = nanoseconds;
+}
+
+HRESULT IsEnableByCondition(uint32_t id, const std::string &condition, CompiledCondition &compiledCondition,
+                            Variables *pVariables, ICorDebugThread *pThread)
+{
+    if (condition.empty())
+        return S_OK;
+
+    HRESULT Status;
+    bool result = false;
+    auto start = std::chrono::steady_clock::now();
+    Status = pVariables->EvaluateCondition(pThread, condition, compiledCondition, result);
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    compiledCondition.AddEvalTime(elapsed);
+    LOGD("Breakpoint %u condition evaluated (%s) in %llu ns, evaluations %u, average %llu ns, max %llu ns",
+         id, compiledCondition.IsLastEvalNative() ? "native" : "stack machine", (unsigned long long)elapsed,
+         compiledCondition.GetEvalCount(), (unsigned long long)compiledCondition.GetEvalAverageTime(),
+         (unsigned long long)compiledCondition.GetEvalMaxTime());
+
+    IfFailRet(Status);
+    return result ? S_OK : E_FAIL;
+}
+
 HRESULT SkipBreakpoint(ICorDebugModule *pModule, mdMethodDef methodToken, bool justMyCode)
 {
     HRESULT Status;
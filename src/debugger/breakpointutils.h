@@ -8,16 +8,97 @@
 #include "cordebug.h"
 
 #include <string>
+#include <memory>
+#include <functional>
+#include "debugger/conditionpredicate.h"
 
 namespace netcoredbg
 {
 
 class Variables;
+class Evaluator;
+class EvalStackMachine;
+class EvalStackProgram;
 
 namespace BreakpointUtils
 {
+    // Same data as IsSameFunctionBreakpoint() compare, but calculated once and could be used as hash key
+    // for fast breakpoint search at breakpoint hit.
+    struct FuncBreakpointKey
+    {
+        CORDB_ADDRESS modAddress;
+        mdMethodDef methodToken;
+        ULONG32 methodVersion;
+        ULONG32 ilOffset;
+
+        FuncBreakpointKey() :
+            modAddress(0), methodToken(mdMethodDefNil), methodVersion(0), ilOffset(0)
+        {}
+
+        bool operator == (const FuncBreakpointKey &other) const
+        {
+            return modAddress == other.modAddress && methodToken == other.methodToken &&
+                   methodVersion == other.methodVersion && ilOffset == other.ilOffset;
+        }
+    };
+
+    struct FuncBreakpointKeyHash
+    {
+        size_t operator()(const FuncBreakpointKey &key) const
+        {
+            size_t hash = std::hash<CORDB_ADDRESS>()(key.modAddress);
+            hash ^= std::hash<uint64_t>()(((uint64_t)key.methodToken << 32) | key.ilOffset) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            hash ^= std::hash<ULONG32>()(key.methodVersion) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            return hash;
+        }
+    };
+
+    // Breakpoint's condition data, prepared at first condition evaluation and reused at next breakpoint hits
+    // (prepared again in case condition was changed). Simple predicates (see ConditionPredicate) evaluated by direct value read,
+    // without func-eval and managed part calls, all other conditions evaluated by stack machine program, generated once.
+    class CompiledCondition
+    {
+    public:
+
+        CompiledCondition() :
+            m_compileStatus(S_OK), m_predicateEnabled(false), m_lastEvalNative(false),
+            m_evalCount(0), m_evalTotalTime(0), m_evalMaxTime(0)
+        {}
+
+        // Return S_OK and evaluation result in `result`, or error code in case condition can't be evaluated.
+        HRESULT Evaluate(ICorDebugThread *pThread, const std::string &condition, Evaluator *pEvaluator,
+                         EvalStackMachine *pEvalStackMachine, bool &result);
+
+        // Condition evaluation latency statistic.
+        void AddEvalTime(uint64_t nanoseconds);
+        bool IsLastEvalNative() const { return m_lastEvalNative; }
+        uint32_t GetEvalCount() const { return m_evalCount; }
+        uint64_t GetEvalAverageTime() const { return m_evalCount ? m_evalTotalTime / m_evalCount : 0; }
+        uint64_t GetEvalMaxTime() const { return m_evalMaxTime; }
+
+    private:
+
+        std::string m_condition;
+        HRESULT m_compileStatus;
+        bool m_predicateEnabled;
+        ConditionPredicate m_predicate;
+        std::shared_ptr<EvalStackProgram> m_program;
+        bool m_lastEvalNative;
+
+        uint32_t m_evalCount;
+        uint64_t m_evalTotalTime; // nanoseconds
+        uint64_t m_evalMaxTime; // nanoseconds
+
+        void Compile(const std::string &condition);
+        HRESULT EvaluatePredicate(ICorDebugThread *pThread, Evaluator *pEvaluator, bool &result);
+        HRESULT EvaluateProgram(ICorDebugThread *pThread, EvalStackMachine *pEvalStackMachine, bool &result);
+    };
+
+    HRESULT GetFuncBreakpointKey(ICorDebugFunctionBreakpoint *pBreakpoint, FuncBreakpointKey &key);
+    HRESULT GetFuncBreakpointKey(ICorDebugBreakpoint *pBreakpoint, FuncBreakpointKey &key);
     HRESULT IsSameFunctionBreakpoint(ICorDebugFunctionBreakpoint *pBreakpoint1, ICorDebugFunctionBreakpoint *pBreakpoint2);
-    HRESULT IsEnableByCondition(const std::string &condition, Variables *pVariables, ICorDebugThread *pThread);
+    HRESULT IsEnableByCondition(uint32_t id, const std::string &condition, CompiledCondition &compiledCondition,
+                                Variables *pVariables, ICorDebugThread *pThread);
     HRESULT SkipBreakpoint(ICorDebugModule *pModule, mdMethodDef methodToken, bool justMyCode);
 }
 
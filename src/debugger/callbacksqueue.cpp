@@ -13,6 +13,7 @@
 #include "debugger/stepper_simple.h"
 #include "debugger/stepper_async.h"
 #include "debugger/steppers.h"
+#include "metadata/modules.h"
 #include "interfaces/iprotocol.h"
 
 #include <algorithm>
@@ -20,8 +21,16 @@
 namespace netcoredbg
 {
 
+void CallbacksQueue::ApplyDeferredJMC(ICorDebugThread *pThread)
+{
+    m_debugger.m_sharedModules->WaitDeferredWork(pThread);
+    m_debugger.m_sharedModules->ApplyDeferredJMC();
+}
+
 bool CallbacksQueue::CallbacksWorkerBreakpoint(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint)
 {
+    ApplyDeferredJMC(pThread);
+
     // S_FALSE or error - continue callback.
     // S_OK - this is internal Hot Reload breakpoint, ignore this callback call.
     if (S_OK == m_debugger.m_sharedBreakpoints->CheckApplicationReload(pThread, pBreakpoint))
@@ -60,6 +69,7 @@ bool CallbacksQueue::CallbacksWorkerBreakpoint(ICorDebugAppDomain *pAppDomain, I
 
 bool CallbacksQueue::CallbacksWorkerStepComplete(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, CorDebugStepReason reason)
 {
+    ApplyDeferredJMC(pThread);
     m_debugger.m_sharedBreakpoints->CheckApplicationReload(pThread);
 
     // S_FALSE - not error and steppers not affect on callback (callback will emit stop event)
@@ -87,6 +97,7 @@ bool CallbacksQueue::CallbacksWorkerStepComplete(ICorDebugAppDomain *pAppDomain,
 
 bool CallbacksQueue::CallbacksWorkerBreak(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread)
 {
+    ApplyDeferredJMC(pThread);
     m_debugger.m_sharedBreakpoints->CheckApplicationReload(pThread);
 
     // S_FALSE - not error and not affect on callback (callback will emit stop event)
@@ -117,6 +128,7 @@ bool CallbacksQueue::CallbacksWorkerBreak(ICorDebugAppDomain *pAppDomain, ICorDe
 
 bool CallbacksQueue::CallbacksWorkerException(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ExceptionCallbackType eventType, const std::string &excModule)
 {
+    ApplyDeferredJMC(pThread);
     m_debugger.m_sharedBreakpoints->CheckApplicationReload(pThread);
 
     ThreadId threadId(getThreadId(pThread));
@@ -323,6 +335,8 @@ HRESULT CallbacksQueue::Continue(ICorDebugProcess *pProcess)
     assert(m_stopEventInProcess);
     m_stopEventInProcess = false;
 
+    m_debugger.m_sharedModules->ApplyDeferredJMC();
+
     if (m_callbacksQueue.empty())
     {
 #ifdef INTEROP_DEBUGGING
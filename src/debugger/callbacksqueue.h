@@ -120,6 +120,9 @@ private:
     std::thread m_callbacksWorker;
 
     void CallbacksWorker();
+    // Apply JMC status from deferred module's work before any JMC related checks at stop event (breakpoint in not user code, etc).
+    // Note, only module of thread's active frame is waited, JMC status for other modules applied when their work is finished.
+    void ApplyDeferredJMC(ICorDebugThread *pThread);
     bool CallbacksWorkerBreakpoint(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, ICorDebugBreakpoint *pBreakpoint);
     bool CallbacksWorkerStepComplete(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread, CorDebugStepReason reason);
     bool CallbacksWorkerBreak(ICorDebugAppDomain *pAppDomain, ICorDebugThread *pThread);
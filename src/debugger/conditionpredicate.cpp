@@ -0,0 +1,416 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/conditionpredicate.h"
+
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <unordered_set>
+
+namespace netcoredbg
+{
+
+namespace
+{
+
+    bool IsIdentifierStart(char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+    }
+
+    bool IsIdentifierChar(char c)
+    {
+        return IsIdentifierStart(c) || (c >= '0' && c <= '9');
+    }
+
+    bool IsDigit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    bool IsSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    void SkipSpaces(const std::string &str, size_t &pos)
+    {
+        while (pos < str.size() && IsSpace(str[pos]))
+            pos++;
+    }
+
+    // Parse `identifier(.identifier)*` at `pos`.
+    // Note, any non ASCII identifiers, verbatim identifiers and internal names (`$exception`) are not simple, let stack machine care about them.
+    bool ParseIdentifiers(const std::string &str, size_t &pos, std::vector<std::string> &identifiers)
+    {
+        static const std::unordered_set<std::string> keywords{"true", "false", "null", "new", "typeof", "sizeof", "default",
+                                                              "base", "checked", "unchecked", "is", "as", "stackalloc"};
+        do
+        {
+            if (pos >= str.size() || !IsIdentifierStart(str[pos]))
+                return false;
+
+            size_t start = pos;
+            while (pos < str.size() && IsIdentifierChar(str[pos]))
+                pos++;
+
+            identifiers.emplace_back(str, start, pos - start);
+            if (keywords.find(identifiers.back()) != keywords.end() ||
+                (identifiers.size() > 1 && identifiers.back() == "this"))
+                return false;
+        }
+        while (pos < str.size() && str[pos] == '.' && ++pos);
+
+        return true;
+    }
+
+    bool ParseOperation(const std::string &str, size_t &pos, ConditionPredicate::Operation &operation)
+    {
+        if (pos + 1 < str.size() && str[pos + 1] == '=')
+        {
+            switch (str[pos])
+            {
+                case '=': operation = ConditionPredicate::Operation::Equal; break;
+                case '!': operation = ConditionPredicate::Operation::NotEqual; break;
+                case '<': operation = ConditionPredicate::Operation::LessOrEqual; break;
+                case '>': operation = ConditionPredicate::Operation::GreaterOrEqual; break;
+                default: return false;
+            }
+            pos += 2;
+            return true;
+        }
+
+        if (pos < str.size() && (str[pos] == '<' || str[pos] == '>'))
+        {
+            // Note, `<<`, `>>` and `=>` are not comparison.
+            if (pos + 1 < str.size() && (str[pos + 1] == '<' || str[pos + 1] == '>'))
+                return false;
+
+            operation = str[pos] == '<' ? ConditionPredicate::Operation::Less : ConditionPredicate::Operation::Greater;
+            pos++;
+            return true;
+        }
+
+        return false;
+    }
+
+    ConditionPredicate::Operation SwapOperands(ConditionPredicate::Operation operation)
+    {
+        switch (operation)
+        {
+            case ConditionPredicate::Operation::Less: return ConditionPredicate::Operation::Greater;
+            case ConditionPredicate::Operation::LessOrEqual: return ConditionPredicate::Operation::GreaterOrEqual;
+            case ConditionPredicate::Operation::Greater: return ConditionPredicate::Operation::Less;
+            case ConditionPredicate::Operation::GreaterOrEqual: return ConditionPredicate::Operation::LessOrEqual;
+            default: return operation;
+        }
+    }
+
+    bool AccumulateDigit(uint64_t &value, unsigned base, unsigned digit)
+    {
+        if (value > (std::numeric_limits<uint64_t>::max() - digit) / base)
+            return false; // C# error CS1021: Integral constant is too large
+        value = value * base + digit;
+        return true;
+    }
+
+    bool ParseIntegerSuffix(const std::string &text, size_t pos)
+    {
+        // u, l, ul, lu (any case)
+        size_t suffixSize = text.size() - pos;
+        if (suffixSize > 2)
+            return false;
+        bool unsignedSuffix = false;
+        bool longSuffix = false;
+        for (; pos < text.size(); pos++)
+        {
+            bool &suffix = (text[pos] == 'u' || text[pos] == 'U') ? unsignedSuffix : longSuffix;
+            if (suffix || (text[pos] != 'u' && text[pos] != 'U' && text[pos] != 'l' && text[pos] != 'L'))
+                return false;
+            suffix = true;
+        }
+        return true;
+    }
+
+    bool ParseNumericLiteral(const std::string &text, ConditionValue &literal)
+    {
+        size_t pos = 0;
+        bool negative = false;
+        if (pos < text.size() && (text[pos] == '-' || text[pos] == '+'))
+        {
+            negative = text[pos] == '-';
+            pos++;
+            SkipSpaces(text, pos);
+        }
+
+        if (pos >= text.size() || !(IsDigit(text[pos]) || (text[pos] == '.' && pos + 1 < text.size() && IsDigit(text[pos + 1]))))
+            return false;
+
+        uint64_t value = 0;
+        if (text[pos] == '0' && pos + 1 < text.size() && (text[pos + 1] == 'x' || text[pos + 1] == 'X'))
+        {
+            pos += 2;
+            size_t digits = 0;
+            for (; pos < text.size(); pos++)
+            {
+                char c = text[pos];
+                unsigned digit;
+                if (IsDigit(c))
+                    digit = c - '0';
+                else if (c >= 'a' && c <= 'f')
+                    digit = c - 'a' + 10;
+                else if (c >= 'A' && c <= 'F')
+                    digit = c - 'A' + 10;
+                else if (c == '_' && digits > 0)
+                    continue;
+                else
+                    break;
+
+                if (!AccumulateDigit(value, 16, digit))
+                    return false;
+                digits++;
+            }
+            if (digits == 0 || !ParseIntegerSuffix(text, pos))
+                return false;
+        }
+        else
+        {
+            std::string number;
+            bool real = false;
+            for (; pos < text.size(); pos++)
+            {
+                char c = text[pos];
+                if (IsDigit(c))
+                    number += c;
+                else if (c == '_' && !number.empty() && IsDigit(number.back()))
+                    continue;
+                else if (c == '.' && !real && pos + 1 < text.size() && IsDigit(text[pos + 1]))
+                {
+                    real = true;
+                    number += c;
+                }
+                else if ((c == 'e' || c == 'E') && !number.empty() && IsDigit(number.back()))
+                {
+                    real = true;
+                    number += c;
+                    if (pos + 1 < text.size() && (text[pos + 1] == '-' || text[pos + 1] == '+'))
+                        number += text[++pos];
+                    if (pos + 1 >= text.size() || !IsDigit(text[pos + 1]))
+                        return false;
+                }
+                else
+                    break;
+            }
+
+            bool floatSuffix = false;
+            if (pos + 1 == text.size() && (text[pos] == 'f' || text[pos] == 'F' || text[pos] == 'd' || text[pos] == 'D'))
+            {
+                floatSuffix = text[pos] == 'f' || text[pos] == 'F';
+                real = true;
+                pos++;
+            }
+
+            if (real)
+            {
+                if (pos != text.size()) // `m` suffix (decimal) or garbage
+                    return false;
+
+                // Note, locale independent conversion.
+                std::istringstream ss(number);
+                ss.imbue(std::locale::classic());
+                double realValue = 0;
+                ss >> realValue;
+                if (ss.fail())
+                    return false;
+                if (negative)
+                    realValue = -realValue;
+
+                literal = floatSuffix ? ConditionValue::Single(static_cast<float>(realValue)) : ConditionValue::Real(realValue);
+                return true;
+            }
+
+            for (auto c : number)
+            {
+                if (!AccumulateDigit(value, 10, c - '0'))
+                    return false;
+            }
+            if (!ParseIntegerSuffix(text, pos))
+                return false;
+        }
+
+        static const uint64_t minSignedMagnitude = static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + 1;
+        if (negative)
+        {
+            if (value > minSignedMagnitude)
+                return false;
+            literal = value == minSignedMagnitude ? ConditionValue::Signed(std::numeric_limits<int64_t>::min())
+                                                  : ConditionValue::Signed(-static_cast<int64_t>(value));
+        }
+        else if (value < minSignedMagnitude)
+            literal = ConditionValue::Signed(static_cast<int64_t>(value));
+        else
+            literal = ConditionValue::Unsigned(value);
+
+        return true;
+    }
+
+    bool ParseLiteral(const std::string &str, size_t start, size_t end, ConditionValue &literal)
+    {
+        while (end > start && IsSpace(str[end - 1]))
+            end--;
+        std::string text(str, start, end - start);
+
+        if (text == "true" || text == "false")
+        {
+            literal = ConditionValue::Boolean(text == "true");
+            return true;
+        }
+
+        // Only trivial ASCII char literals, escape sequences are stack machine's work.
+        if (text.size() == 3 && text[0] == '\'' && text[2] == '\'' &&
+            text[1] != '\\' && text[1] != '\'' && static_cast<unsigned char>(text[1]) < 0x80)
+        {
+            literal = ConditionValue::Signed(text[1]);
+            return true;
+        }
+
+        return ParseNumericLiteral(text, literal);
+    }
+
+    // `identifier <op> literal`
+    bool ParseIdentifierFirst(const std::string &condition, ConditionPredicate &predicate)
+    {
+        size_t pos = 0;
+        SkipSpaces(condition, pos);
+        if (!ParseIdentifiers(condition, pos, predicate.identifiers))
+            return false;
+        SkipSpaces(condition, pos);
+        if (!ParseOperation(condition, pos, predicate.operation))
+            return false;
+        SkipSpaces(condition, pos);
+        return ParseLiteral(condition, pos, condition.size(), predicate.literal);
+    }
+
+    // `literal <op> identifier`
+    bool ParseLiteralFirst(const std::string &condition, ConditionPredicate &predicate)
+    {
+        size_t pos = 0;
+        SkipSpaces(condition, pos);
+        size_t opPos = condition.find_first_of("=!<>", pos);
+        if (opPos == std::string::npos ||
+            !ParseLiteral(condition, pos, opPos, predicate.literal))
+            return false;
+
+        pos = opPos;
+        if (!ParseOperation(condition, pos, predicate.operation))
+            return false;
+        predicate.operation = SwapOperands(predicate.operation);
+        SkipSpaces(condition, pos);
+        if (!ParseIdentifiers(condition, pos, predicate.identifiers))
+            return false;
+        SkipSpaces(condition, pos);
+        return pos == condition.size();
+    }
+
+    template <class T>
+    bool Compare(T left, T right, ConditionPredicate::Operation operation)
+    {
+        switch (operation)
+        {
+            case ConditionPredicate::Operation::Equal: return left == right;
+            case ConditionPredicate::Operation::NotEqual: return left != right;
+            case ConditionPredicate::Operation::Less: return left < right;
+            case ConditionPredicate::Operation::LessOrEqual: return left <= right;
+            case ConditionPredicate::Operation::Greater: return left > right;
+            case ConditionPredicate::Operation::GreaterOrEqual: return left >= right;
+        }
+        return false;
+    }
+
+    double ToReal(const ConditionValue &value)
+    {
+        switch (value.kind)
+        {
+            case ConditionValue::Kind::Signed: return static_cast<double>(value.signedValue);
+            case ConditionValue::Kind::Unsigned: return static_cast<double>(value.unsignedValue);
+            default: return value.realValue;
+        }
+    }
+
+    float ToSingle(const ConditionValue &value)
+    {
+        switch (value.kind)
+        {
+            case ConditionValue::Kind::Signed: return static_cast<float>(value.signedValue);
+            case ConditionValue::Kind::Unsigned: return static_cast<float>(value.unsignedValue);
+            default: return static_cast<float>(value.realValue);
+        }
+    }
+
+} // unnamed namespace
+
+bool ParseConditionPredicate(const std::string &condition, ConditionPredicate &predicate)
+{
+    predicate = ConditionPredicate();
+    if (ParseIdentifierFirst(condition, predicate))
+        return true;
+
+    predicate = ConditionPredicate();
+    if (ParseLiteralFirst(condition, predicate))
+        return true;
+
+    predicate = ConditionPredicate();
+    return false;
+}
+
+bool EvaluateConditionPredicate(const ConditionPredicate &predicate, const ConditionValue &value, bool &result)
+{
+    const ConditionValue &literal = predicate.literal;
+
+    if (value.kind == ConditionValue::Kind::Boolean || literal.kind == ConditionValue::Kind::Boolean)
+    {
+        if (value.kind != literal.kind ||
+            (predicate.operation != ConditionPredicate::Operation::Equal && predicate.operation != ConditionPredicate::Operation::NotEqual))
+            return false; // C# error CS0019
+
+        result = Compare(value.booleanValue, literal.booleanValue, predicate.operation);
+        return true;
+    }
+
+    // Note, C# convert integral operand to floating point type in case one of operands is floating point,
+    // Single operand converted to Double only in case other operand is Double.
+    if (value.kind == ConditionValue::Kind::Real || literal.kind == ConditionValue::Kind::Real)
+    {
+        if ((value.kind != ConditionValue::Kind::Real || value.isSingle) &&
+            (literal.kind != ConditionValue::Kind::Real || literal.isSingle))
+            result = Compare(ToSingle(value), ToSingle(literal), predicate.operation);
+        else
+            result = Compare(ToReal(value), ToReal(literal), predicate.operation);
+        return true;
+    }
+
+    if (value.kind == ConditionValue::Kind::Signed && literal.kind == ConditionValue::Kind::Signed)
+    {
+        result = Compare(value.signedValue, literal.signedValue, predicate.operation);
+        return true;
+    }
+
+    if (value.kind == ConditionValue::Kind::Unsigned && literal.kind == ConditionValue::Kind::Unsigned)
+    {
+        result = Compare(value.unsignedValue, literal.unsignedValue, predicate.operation);
+        return true;
+    }
+
+    // UInt64 could be compared with non negative constant only, all other mixes are C# errors (CS0034 or CS0019).
+    if (value.kind == ConditionValue::Kind::Unsigned && literal.signedValue >= 0)
+    {
+        result = Compare(value.unsignedValue, static_cast<uint64_t>(literal.signedValue), predicate.operation);
+        return true;
+    }
+
+    return false;
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,74 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace netcoredbg
+{
+
+// Primitive value, that could be compared by condition predicate (see below).
+struct ConditionValue
+{
+    enum class Kind
+    {
+        Signed,   // all signed and unsigned integral types up to 32 bits, char, Int64
+        Unsigned, // UInt64
+        Real,     // Single, Double
+        Boolean
+    };
+
+    Kind kind;
+    bool isSingle; // Real kind only, value have Single type (C# compare Single with integral or Single as Single)
+    union
+    {
+        int64_t signedValue;
+        uint64_t unsignedValue;
+        double realValue;
+        bool booleanValue;
+    };
+
+    ConditionValue() : kind(Kind::Signed), isSingle(false), signedValue(0) {}
+
+    static ConditionValue Signed(int64_t value) { ConditionValue result; result.kind = Kind::Signed; result.signedValue = value; return result; }
+    static ConditionValue Unsigned(uint64_t value) { ConditionValue result; result.kind = Kind::Unsigned; result.unsignedValue = value; return result; }
+    static ConditionValue Real(double value) { ConditionValue result; result.kind = Kind::Real; result.realValue = value; return result; }
+    static ConditionValue Single(float value) { ConditionValue result = Real(value); result.isSingle = true; return result; }
+    static ConditionValue Boolean(bool value) { ConditionValue result; result.kind = Kind::Boolean; result.booleanValue = value; return result; }
+};
+
+// Simple breakpoint's condition, that could be evaluated without stack machine and func-eval:
+// `identifier <op> literal` or `literal <op> identifier`, where identifier is local/argument/field access chain
+// (`i`, `this.count`, `obj.field`) and literal is numeric, char or bool literal. For example, `i == 1000`.
+// Note, no CoreCLR headers dependency here, value for identifiers must be provided by caller.
+struct ConditionPredicate
+{
+    enum class Operation
+    {
+        Equal,
+        NotEqual,
+        Less,
+        LessOrEqual,
+        Greater,
+        GreaterOrEqual
+    };
+
+    std::vector<std::string> identifiers;
+    Operation operation; // always in `identifier <op> literal` form, swapped during parse if need
+    ConditionValue literal;
+
+    ConditionPredicate() : operation(Operation::Equal) {}
+};
+
+// Return true in case condition is simple predicate.
+bool ParseConditionPredicate(const std::string &condition, ConditionPredicate &predicate);
+
+// Compare value with predicate's literal in the same way as C# do for primitive types.
+// Return false in case value and literal can't be compared by predicate (caller should use stack machine for proper error).
+bool EvaluateConditionPredicate(const ConditionPredicate &predicate, const ConditionValue &value, bool &result);
+
+} // namespace netcoredbg
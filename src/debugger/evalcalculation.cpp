@@ -0,0 +1,490 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/evalcalculation.h"
+
+#include <cmath>
+#include <limits>
+
+namespace netcoredbg
+{
+
+namespace
+{
+
+    // Result type of C# numeric promotion (see C# spec "Numeric promotions").
+    enum class PromotedType
+    {
+        None,
+        Int32,
+        UInt32,
+        Int64,
+        UInt64,
+        Single,
+        Double
+    };
+
+    bool IsIntegral(BasicTypes type)
+    {
+        switch (type)
+        {
+        case BasicTypes::TypeByte:
+        case BasicTypes::TypeSByte:
+        case BasicTypes::TypeChar:
+        case BasicTypes::TypeInt16:
+        case BasicTypes::TypeUInt16:
+        case BasicTypes::TypeInt32:
+        case BasicTypes::TypeUInt32:
+        case BasicTypes::TypeInt64:
+        case BasicTypes::TypeUInt64:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool IsNumeric(BasicTypes type)
+    {
+        return IsIntegral(type) || type == BasicTypes::TypeSingle || type == BasicTypes::TypeDouble;
+    }
+
+    bool IsSigned(BasicTypes type)
+    {
+        return type == BasicTypes::TypeSByte || type == BasicTypes::TypeInt16 ||
+               type == BasicTypes::TypeInt32 || type == BasicTypes::TypeInt64;
+    }
+
+    PromotedType UnaryPromotion(BasicTypes type)
+    {
+        switch (type)
+        {
+        case BasicTypes::TypeByte:
+        case BasicTypes::TypeSByte:
+        case BasicTypes::TypeChar:
+        case BasicTypes::TypeInt16:
+        case BasicTypes::TypeUInt16:
+        case BasicTypes::TypeInt32:
+            return PromotedType::Int32;
+        case BasicTypes::TypeUInt32:
+            return PromotedType::UInt32;
+        case BasicTypes::TypeInt64:
+            return PromotedType::Int64;
+        case BasicTypes::TypeUInt64:
+            return PromotedType::UInt64;
+        case BasicTypes::TypeSingle:
+            return PromotedType::Single;
+        case BasicTypes::TypeDouble:
+            return PromotedType::Double;
+        default:
+            return PromotedType::None;
+        }
+    }
+
+    PromotedType BinaryPromotion(BasicTypes type1, BasicTypes type2)
+    {
+        if (!IsNumeric(type1) || !IsNumeric(type2))
+            return PromotedType::None;
+
+        if (type1 == BasicTypes::TypeDouble || type2 == BasicTypes::TypeDouble)
+            return PromotedType::Double;
+
+        if (type1 == BasicTypes::TypeSingle || type2 == BasicTypes::TypeSingle)
+            return PromotedType::Single;
+
+        // Note, ulong with signed operand is compile time error CS0034 (ambiguous operator).
+        if (type1 == BasicTypes::TypeUInt64 || type2 == BasicTypes::TypeUInt64)
+            return (IsSigned(type1) || IsSigned(type2)) ? PromotedType::None : PromotedType::UInt64;
+
+        if (type1 == BasicTypes::TypeInt64 || type2 == BasicTypes::TypeInt64)
+            return PromotedType::Int64;
+
+        if (type1 == BasicTypes::TypeUInt32 || type2 == BasicTypes::TypeUInt32)
+            return (IsSigned(type1) || IsSigned(type2)) ? PromotedType::Int64 : PromotedType::UInt32;
+
+        return PromotedType::Int32;
+    }
+
+    // Implicit numeric conversion, value converted from its own type directly (no intermediate double for float).
+    template <class T>
+    T ConvertTo(const CalculationValue &value)
+    {
+        switch (value.type)
+        {
+        case BasicTypes::TypeByte:   return static_cast<T>(value.byteValue);
+        case BasicTypes::TypeSByte:  return static_cast<T>(value.sbyteValue);
+        case BasicTypes::TypeChar:   return static_cast<T>(value.charValue);
+        case BasicTypes::TypeInt16:  return static_cast<T>(value.int16Value);
+        case BasicTypes::TypeUInt16: return static_cast<T>(value.uint16Value);
+        case BasicTypes::TypeInt32:  return static_cast<T>(value.int32Value);
+        case BasicTypes::TypeUInt32: return static_cast<T>(value.uint32Value);
+        case BasicTypes::TypeInt64:  return static_cast<T>(value.int64Value);
+        case BasicTypes::TypeUInt64: return static_cast<T>(value.uint64Value);
+        case BasicTypes::TypeSingle: return static_cast<T>(value.singleValue);
+        case BasicTypes::TypeDouble: return static_cast<T>(value.doubleValue);
+        default:                     return T();
+        }
+    }
+
+    void SetResult(CalculationValue &result, int32_t value)  { result.type = BasicTypes::TypeInt32; result.int32Value = value; }
+    void SetResult(CalculationValue &result, uint32_t value) { result.type = BasicTypes::TypeUInt32; result.uint32Value = value; }
+    void SetResult(CalculationValue &result, int64_t value)  { result.type = BasicTypes::TypeInt64; result.int64Value = value; }
+    void SetResult(CalculationValue &result, uint64_t value) { result.type = BasicTypes::TypeUInt64; result.uint64Value = value; }
+    void SetResult(CalculationValue &result, float value)    { result.type = BasicTypes::TypeSingle; result.singleValue = value; }
+    void SetResult(CalculationValue &result, double value)   { result.type = BasicTypes::TypeDouble; result.doubleValue = value; }
+    void SetResult(CalculationValue &result, bool value)     { result.type = BasicTypes::TypeBoolean; result.boolValue = value; }
+
+    bool Compare(OperationType opType, int cmp, CalculationValue &result)
+    {
+        switch (opType)
+        {
+        case OperationType::EqualsExpression:             SetResult(result, cmp == 0); return true;
+        case OperationType::NotEqualsExpression:          SetResult(result, cmp != 0); return true;
+        case OperationType::LessThanExpression:           SetResult(result, cmp < 0); return true;
+        case OperationType::GreaterThanExpression:        SetResult(result, cmp > 0); return true;
+        case OperationType::LessThanOrEqualExpression:    SetResult(result, cmp <= 0); return true;
+        case OperationType::GreaterThanOrEqualExpression: SetResult(result, cmp >= 0); return true;
+        default: return false;
+        }
+    }
+
+    // Signed integral arithmetic in unchecked context, overflow wrap around. S - signed type, U - unsigned type same size.
+    template <class S, class U>
+    bool CalculateSigned(OperationType opType, S first, S second, CalculationValue &result)
+    {
+        switch (opType)
+        {
+        case OperationType::AddExpression:      SetResult(result, static_cast<S>(static_cast<U>(first) + static_cast<U>(second))); return true;
+        case OperationType::SubtractExpression: SetResult(result, static_cast<S>(static_cast<U>(first) - static_cast<U>(second))); return true;
+        case OperationType::MultiplyExpression: SetResult(result, static_cast<S>(static_cast<U>(first) * static_cast<U>(second))); return true;
+        case OperationType::DivideExpression:
+        case OperationType::ModuloExpression:
+            // Note, DivideByZeroException and OverflowException (MinValue / -1 and MinValue % -1) messages provided by managed part.
+            if (second == 0 || (first == std::numeric_limits<S>::min() && second == -1))
+                return false;
+            SetResult(result, opType == OperationType::DivideExpression ? static_cast<S>(first / second) : static_cast<S>(first % second));
+            return true;
+        case OperationType::BitwiseAndExpression:  SetResult(result, static_cast<S>(first & second)); return true;
+        case OperationType::BitwiseOrExpression:   SetResult(result, static_cast<S>(first | second)); return true;
+        case OperationType::ExclusiveOrExpression: SetResult(result, static_cast<S>(first ^ second)); return true;
+        default:
+            return Compare(opType, first < second ? -1 : (first > second ? 1 : 0), result);
+        }
+    }
+
+    template <class U>
+    bool CalculateUnsigned(OperationType opType, U first, U second, CalculationValue &result)
+    {
+        switch (opType)
+        {
+        case OperationType::AddExpression:      SetResult(result, static_cast<U>(first + second)); return true;
+        case OperationType::SubtractExpression: SetResult(result, static_cast<U>(first - second)); return true;
+        case OperationType::MultiplyExpression: SetResult(result, static_cast<U>(first * second)); return true;
+        case OperationType::DivideExpression:
+        case OperationType::ModuloExpression:
+            if (second == 0)
+                return false;
+            SetResult(result, opType == OperationType::DivideExpression ? static_cast<U>(first / second) : static_cast<U>(first % second));
+            return true;
+        case OperationType::BitwiseAndExpression:  SetResult(result, static_cast<U>(first & second)); return true;
+        case OperationType::BitwiseOrExpression:   SetResult(result, static_cast<U>(first | second)); return true;
+        case OperationType::ExclusiveOrExpression: SetResult(result, static_cast<U>(first ^ second)); return true;
+        default:
+            return Compare(opType, first < second ? -1 : (first > second ? 1 : 0), result);
+        }
+    }
+
+    // IEEE 754 arithmetic, same as CLR do (no exceptions, NaN is unordered).
+    template <class T>
+    bool CalculateFloat(OperationType opType, T first, T second, CalculationValue &result)
+    {
+        switch (opType)
+        {
+        case OperationType::AddExpression:      SetResult(result, static_cast<T>(first + second)); return true;
+        case OperationType::SubtractExpression: SetResult(result, static_cast<T>(first - second)); return true;
+        case OperationType::MultiplyExpression: SetResult(result, static_cast<T>(first * second)); return true;
+        case OperationType::DivideExpression:   SetResult(result, static_cast<T>(first / second)); return true;
+        case OperationType::ModuloExpression:   SetResult(result, static_cast<T>(std::fmod(first, second))); return true;
+        case OperationType::EqualsExpression:             SetResult(result, first == second); return true;
+        case OperationType::NotEqualsExpression:          SetResult(result, first != second); return true;
+        case OperationType::LessThanExpression:           SetResult(result, first < second); return true;
+        case OperationType::GreaterThanExpression:        SetResult(result, first > second); return true;
+        case OperationType::LessThanOrEqualExpression:    SetResult(result, first <= second); return true;
+        case OperationType::GreaterThanOrEqualExpression: SetResult(result, first >= second); return true;
+        default: return false;
+        }
+    }
+
+    bool CalculateShift(OperationType opType, const CalculationValue &first, const CalculationValue &second, CalculationValue &result)
+    {
+        // Shift count must be implicitly convertible to int.
+        switch (second.type)
+        {
+        case BasicTypes::TypeByte:
+        case BasicTypes::TypeSByte:
+        case BasicTypes::TypeChar:
+        case BasicTypes::TypeInt16:
+        case BasicTypes::TypeUInt16:
+        case BasicTypes::TypeInt32:
+            break;
+        default:
+            return false;
+        }
+        int32_t count = ConvertTo<int32_t>(second);
+        bool left = opType == OperationType::LeftShiftExpression;
+
+        switch (UnaryPromotion(first.type))
+        {
+        case PromotedType::Int32:
+        {
+            uint32_t value = static_cast<uint32_t>(ConvertTo<int32_t>(first));
+            count &= 0x1f;
+            // Note, right shift of negative value is arithmetic for supported compilers.
+            SetResult(result, left ? static_cast<int32_t>(value << count) : (static_cast<int32_t>(value) >> count));
+            return true;
+        }
+        case PromotedType::UInt32:
+        {
+            uint32_t value = first.uint32Value;
+            count &= 0x1f;
+            SetResult(result, left ? static_cast<uint32_t>(value << count) : static_cast<uint32_t>(value >> count));
+            return true;
+        }
+        case PromotedType::Int64:
+        {
+            uint64_t value = static_cast<uint64_t>(first.int64Value);
+            count &= 0x3f;
+            SetResult(result, left ? static_cast<int64_t>(value << count) : (static_cast<int64_t>(value) >> count));
+            return true;
+        }
+        case PromotedType::UInt64:
+        {
+            uint64_t value = first.uint64Value;
+            count &= 0x3f;
+            SetResult(result, left ? static_cast<uint64_t>(value << count) : static_cast<uint64_t>(value >> count));
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    bool AppendUTF16CodeUnit(std::string &str, uint16_t ch)
+    {
+        // Note, single surrogate can't be converted into UTF-8.
+        if (ch >= 0xd800 && ch <= 0xdfff)
+            return false;
+
+        if (ch < 0x80)
+        {
+            str += static_cast<char>(ch);
+        }
+        else if (ch < 0x800)
+        {
+            str += static_cast<char>(0xc0 | (ch >> 6));
+            str += static_cast<char>(0x80 | (ch & 0x3f));
+        }
+        else
+        {
+            str += static_cast<char>(0xe0 | (ch >> 12));
+            str += static_cast<char>(0x80 | ((ch >> 6) & 0x3f));
+            str += static_cast<char>(0x80 | (ch & 0x3f));
+        }
+        return true;
+    }
+
+    // Same as ToString() for value in string concatenation.
+    bool AppendAsString(std::string &str, const CalculationValue &value)
+    {
+        switch (value.type)
+        {
+        case BasicTypes::TypeString:
+            str += value.stringValue;
+            return true;
+        case BasicTypes::TypeBoolean:
+            str += value.boolValue ? "True" : "False";
+            return true;
+        case BasicTypes::TypeChar:
+            return AppendUTF16CodeUnit(str, value.charValue);
+        case BasicTypes::TypeByte:
+        case BasicTypes::TypeUInt16:
+        case BasicTypes::TypeUInt32:
+        case BasicTypes::TypeUInt64:
+            str += std::to_string(ConvertTo<uint64_t>(value));
+            return true;
+        case BasicTypes::TypeSByte:
+        case BasicTypes::TypeInt16:
+        case BasicTypes::TypeInt32:
+        case BasicTypes::TypeInt64:
+            str += std::to_string(ConvertTo<int64_t>(value));
+            return true;
+        default:
+            // Note, float and double formatting ("R" by default, culture dependent) provided by managed part only.
+            return false;
+        }
+    }
+
+    bool CalculateString(OperationType opType, const CalculationValue &first, const CalculationValue &second, CalculationValue &result)
+    {
+        switch (opType)
+        {
+        case OperationType::AddExpression:
+            result.type = BasicTypes::TypeString;
+            result.stringValue.clear();
+            return AppendAsString(result.stringValue, first) && AppendAsString(result.stringValue, second);
+        case OperationType::EqualsExpression:
+        case OperationType::NotEqualsExpression:
+            if (first.type != BasicTypes::TypeString || second.type != BasicTypes::TypeString)
+                return false;
+            // Note, ordinal comparison, UTF-8 bytes equality is same as UTF-16 code units equality.
+            SetResult(result, (first.stringValue == second.stringValue) == (opType == OperationType::EqualsExpression));
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool CalculateBoolean(OperationType opType, bool first, bool second, CalculationValue &result)
+    {
+        switch (opType)
+        {
+        case OperationType::LogicalAndExpression:
+        case OperationType::BitwiseAndExpression:  SetResult(result, first && second); return true;
+        case OperationType::LogicalOrExpression:
+        case OperationType::BitwiseOrExpression:   SetResult(result, first || second); return true;
+        case OperationType::ExclusiveOrExpression:
+        case OperationType::NotEqualsExpression:   SetResult(result, first != second); return true;
+        case OperationType::EqualsExpression:      SetResult(result, first == second); return true;
+        default: return false;
+        }
+    }
+
+    bool CalculateBinary(OperationType opType, const CalculationValue &first, const CalculationValue &second, CalculationValue &result)
+    {
+        if (first.type == BasicTypes::TypeString || second.type == BasicTypes::TypeString)
+            return CalculateString(opType, first, second, result);
+
+        if (first.type == BasicTypes::TypeBoolean || second.type == BasicTypes::TypeBoolean)
+        {
+            if (first.type != second.type)
+                return false;
+            return CalculateBoolean(opType, first.boolValue, second.boolValue, result);
+        }
+
+        if (opType == OperationType::LeftShiftExpression || opType == OperationType::RightShiftExpression)
+            return CalculateShift(opType, first, second, result);
+
+        if (opType == OperationType::LogicalAndExpression || opType == OperationType::LogicalOrExpression)
+            return false;
+
+        switch (BinaryPromotion(first.type, second.type))
+        {
+        case PromotedType::Int32:
+            return CalculateSigned<int32_t, uint32_t>(opType, ConvertTo<int32_t>(first), ConvertTo<int32_t>(second), result);
+        case PromotedType::UInt32:
+            return CalculateUnsigned<uint32_t>(opType, ConvertTo<uint32_t>(first), ConvertTo<uint32_t>(second), result);
+        case PromotedType::Int64:
+            return CalculateSigned<int64_t, uint64_t>(opType, ConvertTo<int64_t>(first), ConvertTo<int64_t>(second), result);
+        case PromotedType::UInt64:
+            return CalculateUnsigned<uint64_t>(opType, ConvertTo<uint64_t>(first), ConvertTo<uint64_t>(second), result);
+        case PromotedType::Single:
+            // Note, bitwise operators are not defined for floating point types.
+            return CalculateFloat<float>(opType, ConvertTo<float>(first), ConvertTo<float>(second), result);
+        case PromotedType::Double:
+            return CalculateFloat<double>(opType, ConvertTo<double>(first), ConvertTo<double>(second), result);
+        default:
+            return false;
+        }
+    }
+
+    bool CalculateUnary(OperationType opType, const CalculationValue &first, CalculationValue &result)
+    {
+        if (first.type == BasicTypes::TypeBoolean)
+        {
+            if (opType != OperationType::LogicalNotExpression)
+                return false;
+            SetResult(result, !first.boolValue);
+            return true;
+        }
+
+        PromotedType promoted = UnaryPromotion(first.type);
+        switch (opType)
+        {
+        case OperationType::UnaryPlusExpression:
+            switch (promoted)
+            {
+            case PromotedType::Int32:  SetResult(result, ConvertTo<int32_t>(first)); return true;
+            case PromotedType::UInt32: SetResult(result, first.uint32Value); return true;
+            case PromotedType::Int64:  SetResult(result, first.int64Value); return true;
+            case PromotedType::UInt64: SetResult(result, first.uint64Value); return true;
+            case PromotedType::Single: SetResult(result, first.singleValue); return true;
+            case PromotedType::Double: SetResult(result, first.doubleValue); return true;
+            default: return false;
+            }
+        case OperationType::UnaryMinusExpression:
+            switch (promoted)
+            {
+            case PromotedType::Int32:  SetResult(result, static_cast<int32_t>(0u - static_cast<uint32_t>(ConvertTo<int32_t>(first)))); return true;
+            // Note, uint negation promoted to long, ulong negation is compile time error CS0023.
+            case PromotedType::UInt32: SetResult(result, -static_cast<int64_t>(first.uint32Value)); return true;
+            case PromotedType::Int64:  SetResult(result, static_cast<int64_t>(0ull - static_cast<uint64_t>(first.int64Value))); return true;
+            case PromotedType::Single: SetResult(result, -first.singleValue); return true;
+            case PromotedType::Double: SetResult(result, -first.doubleValue); return true;
+            default: return false;
+            }
+        case OperationType::BitwiseNotExpression:
+            switch (promoted)
+            {
+            case PromotedType::Int32:  SetResult(result, static_cast<int32_t>(~ConvertTo<int32_t>(first))); return true;
+            case PromotedType::UInt32: SetResult(result, static_cast<uint32_t>(~first.uint32Value)); return true;
+            case PromotedType::Int64:  SetResult(result, static_cast<int64_t>(~first.int64Value)); return true;
+            case PromotedType::UInt64: SetResult(result, static_cast<uint64_t>(~first.uint64Value)); return true;
+            default: return false;
+            }
+        default:
+            return false;
+        }
+    }
+
+} // unnamed namespace
+
+size_t GetBasicTypeSize(BasicTypes type)
+{
+    switch (type)
+    {
+    case BasicTypes::TypeBoolean:
+    case BasicTypes::TypeByte:
+    case BasicTypes::TypeSByte:
+        return 1;
+    case BasicTypes::TypeChar:
+    case BasicTypes::TypeInt16:
+    case BasicTypes::TypeUInt16:
+        return 2;
+    case BasicTypes::TypeSingle:
+    case BasicTypes::TypeInt32:
+    case BasicTypes::TypeUInt32:
+        return 4;
+    case BasicTypes::TypeDouble:
+    case BasicTypes::TypeInt64:
+    case BasicTypes::TypeUInt64:
+        return 8;
+    default:
+        return 0;
+    }
+}
+
+bool CalculateNatively(OperationType opType, const CalculationValue &first, const CalculationValue &second, CalculationValue &result)
+{
+    switch (opType)
+    {
+    case OperationType::BitwiseNotExpression:
+    case OperationType::LogicalNotExpression:
+    case OperationType::UnaryPlusExpression:
+    case OperationType::UnaryMinusExpression:
+        return CalculateUnary(opType, first, result);
+    default:
+        return CalculateBinary(opType, first, second, result);
+    }
+}
+
+} // namespace netcoredbg
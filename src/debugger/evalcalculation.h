@@ -0,0 +1,97 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace netcoredbg
+{
+
+// Keep in sync with BasicTypes enum in Evaluation.cs
+enum class BasicTypes : int32_t
+{
+    TypeBoolean = 1,
+    TypeByte,
+    TypeSByte,
+    TypeChar,
+    TypeDouble,
+    TypeSingle,
+    TypeInt32,
+    TypeUInt32,
+    TypeInt64,
+    TypeUInt64,
+    TypeInt16,
+    TypeUInt16,
+    TypeString
+};
+
+// Keep in sync with OperationType enum in Evaluation.cs
+enum class OperationType : int32_t
+{
+    AddExpression = 1,
+    SubtractExpression,
+    MultiplyExpression,
+    DivideExpression,
+    ModuloExpression,
+    RightShiftExpression,
+    LeftShiftExpression,
+    BitwiseNotExpression,
+    LogicalAndExpression,
+    LogicalOrExpression,
+    ExclusiveOrExpression,
+    BitwiseAndExpression,
+    BitwiseOrExpression,
+    LogicalNotExpression,
+    EqualsExpression,
+    NotEqualsExpression,
+    LessThanExpression,
+    GreaterThanExpression,
+    LessThanOrEqualExpression,
+    GreaterThanOrEqualExpression,
+    UnaryPlusExpression,
+    UnaryMinusExpression
+};
+
+// Operand or result of calculation, same types as managed CalculationDelegate() support.
+// Note, no CoreCLR headers dependency here, caller must convert debuggee values.
+struct CalculationValue
+{
+    BasicTypes type;
+    union
+    {
+        bool boolValue;
+        uint8_t byteValue;
+        int8_t sbyteValue;
+        uint16_t charValue;
+        double doubleValue;
+        float singleValue;
+        int32_t int32Value;
+        uint32_t uint32Value;
+        int64_t int64Value;
+        uint64_t uint64Value;
+        int16_t int16Value;
+        uint16_t uint16Value;
+    };
+    std::string stringValue; // UTF-8, null string provided as empty string (same as managed part do)
+
+    CalculationValue() : type(BasicTypes::TypeInt64), uint64Value(0) {}
+
+    // Raw data in the same layout as ICorDebugGenericValue::GetValue() provide (not used for string).
+    void *GetRawData() { return &uint64Value; }
+    const void *GetRawData() const { return &uint64Value; }
+};
+
+// Return size of raw data for primitive type, 0 for string.
+size_t GetBasicTypeSize(BasicTypes type);
+
+// Calculate unary or binary operation in the same way as C# `dynamic` do in managed CalculationDelegate()
+// (numeric promotion, unchecked context, string concatenation). For unary operations second operand is ignored.
+// Return false in case operation can't be calculated natively (C# compile or runtime error, or value could be formatted
+// by managed part in different way), caller should use managed CalculationDelegate() for result or proper error message.
+bool CalculateNatively(OperationType opType, const CalculationValue &first, const CalculationValue &second, CalculationValue &result);
+
+} // namespace netcoredbg
@@ -4,6 +4,8 @@
 
 #include <vector>
 #include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include "debugger/evalhelpers.h"
 #include "debugger/evalwaiter.h"
 #include "debugger/evalutils.h"
@@ -23,8 +25,59 @@ void EvalHelpers::Cleanup()
     m_pSuppressFinalizeMutex.unlock();
 
     m_typeObjectCacheMutex.lock();
+    m_typeObjectIndex.clear();
     m_typeObjectCache.clear();
+    m_noStaticMembersTypes.clear();
     m_typeObjectCacheMutex.unlock();
+
+    m_evalDurationsMutex.lock();
+    m_evalDurations.clear();
+    m_evalDurationsMutex.unlock();
+}
+
+static HRESULT GetFunctionKey(ICorDebugFunction *pFunc, std::pair<CORDB_ADDRESS, mdMethodDef> &key)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugModule> pModule;
+    IfFailRet(pFunc->GetModule(&pModule));
+    IfFailRet(pModule->GetBaseAddress(&key.first));
+    return pFunc->GetToken(&key.second);
+}
+
+bool EvalHelpers::IsSlowFunction(const std::pair<CORDB_ADDRESS, mdMethodDef> &key)
+{
+    int threshold = m_sharedEvalWaiter->GetEvalTimeouts().slowGetterThreshold;
+    if (threshold <= 0)
+        return false;
+
+    static const unsigned SlowFunctionMaxSkips = 10;
+
+    std::lock_guard<std::mutex> lock(m_evalDurationsMutex);
+    auto find = m_evalDurations.find(key);
+    if (find == m_evalDurations.end() || find->second.lastMs < threshold)
+        return false;
+
+    if (find->second.skipped >= SlowFunctionMaxSkips)
+    {
+        LOGI("Evaluation of slow method 0x%08x retried after %u skips", key.second, find->second.skipped);
+        find->second.skipped = 0;
+        return false;
+    }
+
+    find->second.skipped++;
+    LOGI("Evaluation of method 0x%08x skipped as slow: last %lld ms, max %lld ms, evaluations %u",
+         key.second, (long long)find->second.lastMs, (long long)find->second.maxMs, find->second.count);
+    return true;
+}
+
+void EvalHelpers::AddEvalDuration(const std::pair<CORDB_ADDRESS, mdMethodDef> &key, int64_t durationMs)
+{
+    std::lock_guard<std::mutex> lock(m_evalDurationsMutex);
+    eval_duration_t &duration = m_evalDurations[key];
+    duration.count++;
+    duration.skipped = 0;
+    duration.lastMs = durationMs;
+    duration.maxMs = std::max(duration.maxMs, durationMs);
 }
 
 HRESULT EvalHelpers::CreateString(ICorDebugThread *pThread, const std::string &value, ICorDebugValue **ppNewString)
@@ -49,6 +102,7 @@ HRESULT EvalHelpers::CreateString(ICorDebugThread *pThread, const std::string &v
 // [in] ArgsValueCount - size of args Value array;
 // [out] ppEvalResult - return value;
 // [in] evalFlags - evaluation flags.
+// Return S_FALSE without evaluation in case of variables listing and function was slow on previous evaluation.
 HRESULT EvalHelpers::EvalFunction(
     ICorDebugThread *pThread,
     ICorDebugFunction *pFunc,
@@ -83,7 +137,13 @@ HRESULT EvalHelpers::EvalFunction(
         }
     }
 
-    return m_sharedEvalWaiter->WaitEvalResult(pThread, ppEvalResult,
+    std::pair<CORDB_ADDRESS, mdMethodDef> key;
+    bool haveKey = SUCCEEDED(GetFunctionKey(pFunc, key));
+    if (haveKey && EvalWaiter::GetRequestKind() == EvalRequestKind::Locals && IsSlowFunction(key))
+        return S_FALSE;
+
+    auto startTime = std::chrono::steady_clock::now();
+    HRESULT Status = m_sharedEvalWaiter->WaitEvalResult(pThread, ppEvalResult,
         [&](ICorDebugEval *pEval) -> HRESULT
         {
             // Note, this code execution protected by EvalWaiter mutex.
@@ -98,6 +158,12 @@ HRESULT EvalHelpers::EvalFunction(
                 ppArgsValue));
             return S_OK;
         });
+
+    // Note, canceled by user evaluation don't provide real duration.
+    if (haveKey && Status != COR_E_OPERATIONCANCELED)
+        AddEvalDuration(key, std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime).count());
+
+    return Status;
 }
 
 HRESULT EvalHelpers::EvalGenericFunction(
@@ -237,23 +303,45 @@ static bool TypeHaveStaticMembers(ICorDebugType *pType)
     return false;
 }
 
-HRESULT EvalHelpers::TryReuseTypeObjectFromCache(ICorDebugType *pType, ICorDebugValue **ppTypeObjectResult)
+size_t EvalHelpers::GetTypeObjectCacheSizeSetting()
+{
+    const char *sizeEnv = getenv("NETCOREDBG_TYPE_OBJECT_CACHE_SIZE");
+    if (sizeEnv == nullptr)
+        return DefaultTypeObjectCacheSize;
+
+    char *err;
+    unsigned long size = strtoul(sizeEnv, &err, 10);
+    if (*sizeEnv == 0 || *err != 0 || size == 0)
+    {
+        LOGW("Wrong type object cache size '%s', default size %u used", sizeEnv, (unsigned)DefaultTypeObjectCacheSize);
+        return DefaultTypeObjectCacheSize;
+    }
+    return std::min<size_t>(size, MaxTypeObjectCacheSize);
+}
+
+void EvalHelpers::ClearStaticMembersCache()
 {
     std::lock_guard<std::mutex> lock(m_typeObjectCacheMutex);
+    m_noStaticMembersTypes.clear();
+}
 
-    HRESULT Status;
-    ToRelease<ICorDebugType2> iCorType2;
-    IfFailRet(pType->QueryInterface(IID_ICorDebugType2, (LPVOID*) &iCorType2));
+EvalHelpers::TypeObjectCacheStats EvalHelpers::GetTypeObjectCacheStats()
+{
+    std::lock_guard<std::mutex> lock(m_typeObjectCacheMutex);
+    return m_typeObjectCacheStats;
+}
 
-    COR_TYPEID typeID;
-    IfFailRet(iCorType2->GetTypeID(&typeID));
+HRESULT EvalHelpers::TryReuseTypeObjectFromCache(const COR_TYPEID &typeID, ICorDebugValue **ppTypeObjectResult)
+{
+    std::lock_guard<std::mutex> lock(m_typeObjectCacheMutex);
 
-    auto is_same = [&typeID](type_object_t &typeObject){ return typeObject.id.token1 == typeID.token1 && typeObject.id.token2 == typeID.token2; };
-    auto it = std::find_if(m_typeObjectCache.begin(), m_typeObjectCache.end(), is_same);
-    if (it == m_typeObjectCache.end())
+    auto find = m_typeObjectIndex.find(typeID);
+    if (find == m_typeObjectIndex.end())
         return E_FAIL;
 
+    m_typeObjectCacheStats.hits++;
     // Move data to begin, so, last used will be on front.
+    auto it = find->second;
     if (it != m_typeObjectCache.begin())
         m_typeObjectCache.splice(m_typeObjectCache.begin(), m_typeObjectCache, it);
 
@@ -262,28 +350,20 @@ HRESULT EvalHelpers::TryReuseTypeObjectFromCache(ICorDebugType *pType, ICorDebug
         // We don't check handle's status here, since we store only strong handles.
         // https://docs.microsoft.com/en-us/dotnet/framework/unmanaged-api/debugging/cordebughandletype-enumeration
         // The handle is strong, which prevents an object from being reclaimed by garbage collection.
-        return m_typeObjectCache.front().typeObject->QueryInterface(IID_ICorDebugValue, (LPVOID *)ppTypeObjectResult);
+        return it->typeObject->QueryInterface(IID_ICorDebugValue, (LPVOID *)ppTypeObjectResult);
     }
 
     return S_OK;
 }
 
-HRESULT EvalHelpers::AddTypeObjectToCache(ICorDebugType *pType, ICorDebugValue *pTypeObject)
+HRESULT EvalHelpers::AddTypeObjectToCache(const COR_TYPEID &typeID, ICorDebugValue *pTypeObject)
 {
     std::lock_guard<std::mutex> lock(m_typeObjectCacheMutex);
 
-    HRESULT Status;
-    ToRelease<ICorDebugType2> iCorType2;
-    IfFailRet(pType->QueryInterface(IID_ICorDebugType2, (LPVOID*) &iCorType2));
-
-    COR_TYPEID typeID;
-    IfFailRet(iCorType2->GetTypeID(&typeID));
-
-    auto is_same = [&typeID](type_object_t &typeObject){ return typeObject.id.token1 == typeID.token1 && typeObject.id.token2 == typeID.token2; };
-    auto it = std::find_if(m_typeObjectCache.begin(), m_typeObjectCache.end(), is_same);
-    if (it != m_typeObjectCache.end())
+    if (m_typeObjectIndex.find(typeID) != m_typeObjectIndex.end())
         return S_OK;
 
+    HRESULT Status;
     ToRelease<ICorDebugHandleValue> iCorHandleValue;
     IfFailRet(pTypeObject->QueryInterface(IID_ICorDebugHandleValue, (LPVOID *) &iCorHandleValue));
 
@@ -292,21 +372,45 @@ HRESULT EvalHelpers::AddTypeObjectToCache(ICorDebugType *pType, ICorDebugValue *
         handleType != HANDLE_STRONG)
         return E_FAIL;
 
-    if (m_typeObjectCache.size() == m_typeObjectCacheSize)
+    m_typeObjectCacheStats.misses++;
+    if (m_typeObjectCache.size() >= m_typeObjectCacheSize)
     {
         // Re-use last list entry.
-        m_typeObjectCache.back().id = typeID;
-        m_typeObjectCache.back().typeObject.Free();
-        m_typeObjectCache.back().typeObject = iCorHandleValue.Detach();
-        assert(m_typeObjectCacheSize >= 2);
-        m_typeObjectCache.splice(m_typeObjectCache.begin(), m_typeObjectCache, std::prev(m_typeObjectCache.end()));
+        m_typeObjectCacheStats.evictions++;
+        auto last = std::prev(m_typeObjectCache.end());
+        m_typeObjectIndex.erase(last->id);
+        last->id = typeID;
+        last->typeObject.Free();
+        last->typeObject = iCorHandleValue.Detach();
+        m_typeObjectCache.splice(m_typeObjectCache.begin(), m_typeObjectCache, last);
     }
     else
         m_typeObjectCache.emplace_front(type_object_t{typeID, iCorHandleValue.Detach()});
 
+    m_typeObjectIndex[typeID] = m_typeObjectCache.begin();
     return S_OK;
 }
 
+bool EvalHelpers::TypeHaveStaticMembersCached(const COR_TYPEID &typeID, ICorDebugType *pType)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_typeObjectCacheMutex);
+        if (m_noStaticMembersTypes.find(typeID) != m_noStaticMembersTypes.end())
+        {
+            m_typeObjectCacheStats.noStaticMembersHits++;
+            return false;
+        }
+    }
+
+    // Note, metadata walk executed out of lock.
+    if (TypeHaveStaticMembers(pType))
+        return true;
+
+    std::lock_guard<std::mutex> lock(m_typeObjectCacheMutex);
+    m_noStaticMembersTypes.insert(typeID);
+    return false;
+}
+
 HRESULT EvalHelpers::CreatTypeObjectStaticConstructor(
     ICorDebugThread *pThread,
     ICorDebugType *pType,
@@ -321,13 +425,20 @@ HRESULT EvalHelpers::CreatTypeObjectStaticConstructor(
     if (et != ELEMENT_TYPE_CLASS && et != ELEMENT_TYPE_VALUETYPE)
         return S_OK;
 
+    // Note, type ID is runtime type handle, so, it's unique for each generic instantiation.
+    // In case type ID can't be provided (for example, type is not loaded yet), caches are not used.
+    ToRelease<ICorDebugType2> iCorType2;
+    COR_TYPEID typeID;
+    bool haveTypeID = SUCCEEDED(pType->QueryInterface(IID_ICorDebugType2, (LPVOID*) &iCorType2)) &&
+                      SUCCEEDED(iCorType2->GetTypeID(&typeID));
+
     // Check cache first, before check type for static members.
-    if (SUCCEEDED(TryReuseTypeObjectFromCache(pType, ppTypeObjectResult)))
+    if (haveTypeID && SUCCEEDED(TryReuseTypeObjectFromCache(typeID, ppTypeObjectResult)))
         return S_OK;
 
     // Create type object only in case type have static members.
     // Note, for some cases we have static members check outside this method.
-    if (DetectStaticMembers && !TypeHaveStaticMembers(pType))
+    if (DetectStaticMembers && !(haveTypeID ? TypeHaveStaticMembersCached(typeID, pType) : TypeHaveStaticMembers(pType)))
         return S_FALSE;
 
     std::vector< ToRelease<ICorDebugType> > typeParams;
@@ -379,7 +490,8 @@ HRESULT EvalHelpers::CreatTypeObjectStaticConstructor(
         IfFailRet(EvalFunction(pThread, m_pSuppressFinalize, &pType, 1, pTypeObject.GetRef(), 1, nullptr, defaultEvalFlags));
     }
 
-    AddTypeObjectToCache(pType, pTypeObject);
+    if (haveTypeID)
+        AddTypeObjectToCache(typeID, pTypeObject);
 
     if (ppTypeObjectResult)
         *ppTypeObjectResult = pTypeObject.Detach();
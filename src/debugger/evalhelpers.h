@@ -9,8 +9,12 @@
 
 #include <string>
 #include <list>
+#include <map>
 #include <mutex>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include "debugger/evalutils.h"
 #include "utils/torelease.h"
 
 namespace netcoredbg
@@ -28,9 +32,19 @@ public:
     EvalHelpers(std::shared_ptr<Modules> &sharedModules,
                 std::shared_ptr<EvalWaiter> &sharedEvalWaiter) :
         m_sharedModules(sharedModules),
-        m_sharedEvalWaiter(sharedEvalWaiter)
+        m_sharedEvalWaiter(sharedEvalWaiter),
+        m_typeObjectCacheSize(GetTypeObjectCacheSizeSetting()),
+        m_typeObjectCacheStats()
     {}
 
+    struct TypeObjectCacheStats
+    {
+        uint64_t hits;                // type object reused, CreatTypeObjectStaticConstructor() func-evals avoided
+        uint64_t misses;              // type object created by func-eval
+        uint64_t evictions;           // least recently used type object handle released
+        uint64_t noStaticMembersHits; // "no static members" result reused, metadata walk avoided
+    };
+
     HRESULT CreatTypeObjectStaticConstructor(
         ICorDebugThread *pThread,
         ICorDebugType *pType,
@@ -72,6 +86,9 @@ public:
     HRESULT FindMethodInModule(const std::string &moduleName, const WCHAR className[], const WCHAR methodName[], ICorDebugFunction **ppFunction);
 
     void Cleanup();
+    // Note, must be called at Hot Reload, since types could get static members.
+    void ClearStaticMembersCache();
+    TypeObjectCacheStats GetTypeObjectCacheStats();
 
 private:
 
@@ -92,14 +109,39 @@ private:
     // small number of handles (about 256) that are active at a time.
     // https://docs.microsoft.com/en-us/dotnet/framework/unmanaged-api/debugging/icordebugheapvalue2-createhandle-method
     // Note, we also use handles (results of eval) in var refs during brake (cleared at 'Continue').
-    // Warning! Since we use `std::prev(m_typeObjectCache.end())` without any check in code, make sure cache size is `2` or bigger.
-    static const size_t m_typeObjectCacheSize = 100;
+    // Size could be changed by NETCOREDBG_TYPE_OBJECT_CACHE_SIZE environment variable (`--type-object-cache-size` option).
+    static const size_t DefaultTypeObjectCacheSize = 100;
+    static const size_t MaxTypeObjectCacheSize = 256;
+    const size_t m_typeObjectCacheSize;
     // The idea of cache is not hold all type objects, but prevent numerous times same type objects creation during eval.
     // At access, element moved to front of list, new element also add to front. In this way, not used elements displaced from cache.
     std::list<type_object_t> m_typeObjectCache;
+    std::unordered_map<COR_TYPEID, std::list<type_object_t>::iterator, EvalUtils::TypeIdHash, EvalUtils::TypeIdEqual> m_typeObjectIndex;
+    // Types without static members, type object creation is not needed for them.
+    std::unordered_set<COR_TYPEID, EvalUtils::TypeIdHash, EvalUtils::TypeIdEqual> m_noStaticMembersTypes;
+    TypeObjectCacheStats m_typeObjectCacheStats;
+
+    static size_t GetTypeObjectCacheSizeSetting();
+    HRESULT TryReuseTypeObjectFromCache(const COR_TYPEID &typeID, ICorDebugValue **ppTypeObjectResult);
+    HRESULT AddTypeObjectToCache(const COR_TYPEID &typeID, ICorDebugValue *pTypeObject);
+    bool TypeHaveStaticMembersCached(const COR_TYPEID &typeID, ICorDebugType *pType);
+
+    struct eval_duration_t
+    {
+        unsigned count = 0;
+        unsigned skipped = 0; // skipped in a row evaluations since last evaluation
+        int64_t lastMs = 0;
+        int64_t maxMs = 0;
+    };
+
+    // Evaluation duration history for each function (module base address and method token), in order to skip slow
+    // properties getters in variables listing on next stops. Note, explicit evaluation update history as well.
+    // Note, slow function is evaluated again after SlowFunctionMaxSkips skips, since it could be fast for other state.
+    std::mutex m_evalDurationsMutex;
+    std::map<std::pair<CORDB_ADDRESS, mdMethodDef>, eval_duration_t> m_evalDurations;
 
-    HRESULT TryReuseTypeObjectFromCache(ICorDebugType *pType, ICorDebugValue **ppTypeObjectResult);
-    HRESULT AddTypeObjectToCache(ICorDebugType *pType, ICorDebugValue *pTypeObject);
+    bool IsSlowFunction(const std::pair<CORDB_ADDRESS, mdMethodDef> &key);
+    void AddEvalDuration(const std::pair<CORDB_ADDRESS, mdMethodDef> &key, int64_t durationMs);
 
 };
 
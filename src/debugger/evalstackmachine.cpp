@@ -3,17 +3,20 @@
 // See the LICENSE file in the project root for more information.
 
 #include <array>
+#include <cstring>
 #include <functional>
 #include <sstream>
 #include <iterator>
 #include <arrayholder.h>
 #include "debugger/evalstackmachine.h"
+#include "debugger/evalcalculation.h"
 #include "debugger/evalhelpers.h"
 #include "debugger/evalwaiter.h"
 #include "debugger/valueprint.h"
 #include "debugger/evalutils.h"
 #include "managed/interop.h"
 #include "metadata/typeprinter.h"
+#include "utils/logger.h"
 #include "utils/utf.h"
 
 
@@ -53,51 +56,6 @@ namespace
         PVOID Ptr;
     };
 
-    // Keep in sync with BasicTypes enum in Evaluation.cs
-    enum class BasicTypes : int32_t
-    {
-        TypeBoolean = 1,
-        TypeByte,
-        TypeSByte,
-        TypeChar,
-        TypeDouble,
-        TypeSingle,
-        TypeInt32,
-        TypeUInt32,
-        TypeInt64,
-        TypeUInt64,
-        TypeInt16,
-        TypeUInt16,
-        TypeString
-    };
-
-    // Keep in sync with OperationType enum in Evaluation.cs
-    enum class OperationType : int32_t
-    {
-        AddExpression = 1,
-        SubtractExpression,
-        MultiplyExpression,
-        DivideExpression,
-        ModuloExpression,
-        RightShiftExpression,
-        LeftShiftExpression,
-        BitwiseNotExpression,
-        LogicalAndExpression,
-        LogicalOrExpression,
-        ExclusiveOrExpression,
-        BitwiseAndExpression,
-        BitwiseOrExpression,
-        LogicalNotExpression,
-        EqualsExpression,
-        NotEqualsExpression,
-        LessThanExpression,
-        GreaterThanExpression,
-        LessThanOrEqualExpression,
-        GreaterThanOrEqualExpression,
-        UnaryPlusExpression,
-        UnaryMinusExpression
-    };
-
     void ReplaceAllSubstring(std::string &str, const std::string &from, const std::string &to)
     {
         size_t start = 0;
@@ -660,6 +618,32 @@ namespace
         return E_INVALIDARG;
     }
 
+    bool GetBasicTypeByElementType(CorElementType elemType, BasicTypes &basicType)
+    {
+        static std::unordered_map<CorElementType, BasicTypes> basicTypesMap
+        {
+            {ELEMENT_TYPE_BOOLEAN, BasicTypes::TypeBoolean},
+            {ELEMENT_TYPE_U1, BasicTypes::TypeByte},
+            {ELEMENT_TYPE_I1, BasicTypes::TypeSByte},
+            {ELEMENT_TYPE_CHAR, BasicTypes::TypeChar},
+            {ELEMENT_TYPE_R8, BasicTypes::TypeDouble},
+            {ELEMENT_TYPE_R4, BasicTypes::TypeSingle},
+            {ELEMENT_TYPE_I4, BasicTypes::TypeInt32},
+            {ELEMENT_TYPE_U4, BasicTypes::TypeUInt32},
+            {ELEMENT_TYPE_I8, BasicTypes::TypeInt64},
+            {ELEMENT_TYPE_U8, BasicTypes::TypeUInt64},
+            {ELEMENT_TYPE_I2, BasicTypes::TypeInt16},
+            {ELEMENT_TYPE_U2, BasicTypes::TypeUInt16}
+        };
+
+        auto findType = basicTypesMap.find(elemType);
+        if (findType == basicTypesMap.end())
+            return false;
+
+        basicType = findType->second;
+        return true;
+    }
+
     HRESULT GetOperandDataTypeByValue(ICorDebugValue *pValue, CorElementType elemType, PVOID &resultData, int32_t &resultType)
     {
         HRESULT Status;
@@ -680,26 +664,10 @@ namespace
             return S_OK;
         }
 
-        static std::unordered_map<CorElementType, BasicTypes> basicTypesMap
-        {
-            {ELEMENT_TYPE_BOOLEAN, BasicTypes::TypeBoolean},
-            {ELEMENT_TYPE_U1, BasicTypes::TypeByte},
-            {ELEMENT_TYPE_I1, BasicTypes::TypeSByte},
-            {ELEMENT_TYPE_CHAR, BasicTypes::TypeChar},
-            {ELEMENT_TYPE_R8, BasicTypes::TypeDouble},
-            {ELEMENT_TYPE_R4, BasicTypes::TypeSingle},
-            {ELEMENT_TYPE_I4, BasicTypes::TypeInt32},
-            {ELEMENT_TYPE_U4, BasicTypes::TypeUInt32},
-            {ELEMENT_TYPE_I8, BasicTypes::TypeInt64},
-            {ELEMENT_TYPE_U8, BasicTypes::TypeUInt64},
-            {ELEMENT_TYPE_I2, BasicTypes::TypeInt16},
-            {ELEMENT_TYPE_U2, BasicTypes::TypeUInt16}
-        };
-
-        auto findType = basicTypesMap.find(elemType);
-        if (findType == basicTypesMap.end())
+        BasicTypes basicType;
+        if (!GetBasicTypeByElementType(elemType, basicType))
             return E_FAIL;
-        resultType = (int32_t)findType->second;
+        resultType = (int32_t)basicType;
 
         ToRelease<ICorDebugGenericValue> iCorGenValue;
         IfFailRet(pValue->QueryInterface(IID_ICorDebugGenericValue, (LPVOID *) &iCorGenValue));
@@ -737,6 +705,76 @@ namespace
         return CreatePrimitiveValue(ed.pThread, ppValue, findType->second, valueData);
     }
 
+    HRESULT GetCalculationValue(ICorDebugValue *pValue, CorElementType elemType, CalculationValue &value)
+    {
+        HRESULT Status;
+
+        if (elemType == ELEMENT_TYPE_STRING)
+        {
+            value.type = BasicTypes::TypeString;
+            ToRelease<ICorDebugValue> iCorValue;
+            BOOL isNull = FALSE;
+            IfFailRet(DereferenceAndUnboxValue(pValue, &iCorValue, &isNull));
+            // Note, managed part use empty string for null string too.
+            if (!isNull)
+                IfFailRet(PrintStringValue(iCorValue, value.stringValue));
+            return S_OK;
+        }
+
+        if (!GetBasicTypeByElementType(elemType, value.type))
+            return E_FAIL;
+
+        ToRelease<ICorDebugGenericValue> iCorGenValue;
+        IfFailRet(pValue->QueryInterface(IID_ICorDebugGenericValue, (LPVOID *) &iCorGenValue));
+        return iCorGenValue->GetValue(value.GetRawData());
+    }
+
+    HRESULT GetValueByCalculationValue(CalculationValue &value, ICorDebugValue **ppValue, EvalData &ed)
+    {
+        if (value.type == BasicTypes::TypeString)
+            return ed.pEvalHelpers->CreateString(ed.pThread, value.stringValue, ppValue);
+
+        return GetValueByOperandDataType(value.GetRawData(), value.type, ppValue, ed);
+    }
+
+#ifdef DEBUG
+    // Differential check, native calculation must provide same result as managed CalculationDelegate().
+    void CheckCalculationByDelegate(OperationType opType, CalculationValue &first, CalculationValue &second, const CalculationValue &result)
+    {
+        PVOID valueData1 = first.type == BasicTypes::TypeString ? Interop::AllocString(first.stringValue) : first.GetRawData();
+        PVOID valueData2 = second.type == BasicTypes::TypeString ? Interop::AllocString(second.stringValue) : second.GetRawData();
+        PVOID resultData = NULL;
+        int32_t resultType = 0;
+        std::string output;
+        if (FAILED(Interop::CalculationDelegate(valueData1, (int32_t)first.type, valueData2, (int32_t)second.type, (int32_t)opType, resultType, &resultData, output)))
+        {
+            LOGE("Native calculation mismatch, operation %d: managed part failed with \"%s\"", (int)opType, output.c_str());
+        }
+        else
+        {
+            bool equal = resultType == (int32_t)result.type;
+            if (equal && result.type == BasicTypes::TypeString)
+                equal = to_utf8((WCHAR*)resultData) == result.stringValue;
+            else if (equal)
+                equal = memcmp(resultData, result.GetRawData(), GetBasicTypeSize(result.type)) == 0;
+
+            if (!equal)
+                LOGE("Native calculation mismatch, operation %d: managed result type %d, native result type %d", (int)opType, resultType, (int)result.type);
+
+            if (resultType == (int32_t)BasicTypes::TypeString)
+                Interop::SysFreeString((BSTR)resultData);
+            else
+                Interop::CoTaskMemFree(resultData);
+        }
+
+        if (first.type == BasicTypes::TypeString && valueData1)
+            Interop::SysFreeString((BSTR)valueData1);
+
+        if (second.type == BasicTypes::TypeString && valueData2)
+            Interop::SysFreeString((BSTR)valueData2);
+    }
+#endif // DEBUG
+
     HRESULT CallBinaryOperator(const std::string &opName, ICorDebugValue *pValue, ICorDebugValue *pType1Value, ICorDebugValue *pType2Value,
                                ICorDebugValue **pResultValue, EvalData &ed)
     {
@@ -935,6 +973,21 @@ namespace
         else if (!SupportedByCalculationDelegateType(elemType1) || !SupportedByCalculationDelegateType(elemType2))
             return E_INVALIDARG;
 
+        // Note, native calculation avoid managed CalculationDelegate() call, managed part still used for cases that
+        // can't be calculated natively (errors, decimal/float to string conversion, etc).
+        CalculationValue value1;
+        CalculationValue value2;
+        CalculationValue result;
+        if (SUCCEEDED(GetCalculationValue(iCorRealValue1, elemType1, value1)) &&
+            SUCCEEDED(GetCalculationValue(iCorRealValue2, elemType2, value2)) &&
+            CalculateNatively(opType, value1, value2, result))
+        {
+#ifdef DEBUG
+            CheckCalculationByDelegate(opType, value1, value2, result);
+#endif // DEBUG
+            return GetValueByCalculationValue(result, &evalStack.front().iCorValue, ed);
+        }
+
         int64_t valueDataHolder1 = 0;
         PVOID valueData1 = &valueDataHolder1;
         int32_t valueType1 = 0;
@@ -999,6 +1052,18 @@ namespace
         else if (!SupportedByCalculationDelegateType(elemType))
             return E_INVALIDARG;
 
+        CalculationValue value;
+        CalculationValue fakeValue; // same as fake second operand for managed delegate below
+        CalculationValue result;
+        if (SUCCEEDED(GetCalculationValue(iCorRealValue, elemType, value)) &&
+            CalculateNatively(opType, value, fakeValue, result))
+        {
+#ifdef DEBUG
+            CheckCalculationByDelegate(opType, value, fakeValue, result);
+#endif // DEBUG
+            return GetValueByCalculationValue(result, &evalStack.front().iCorValue, ed);
+        }
+
         int64_t valueDataHolder1 = 0;
         PVOID valueData1 = &valueDataHolder1;
         int32_t valueType1 = 0;
@@ -1932,8 +1997,89 @@ namespace
 
 } // unnamed namespace
 
+EvalStackProgram::~EvalStackProgram()
+{
+    if (m_pStackProgram)
+        Interop::ReleaseStackMachineProgram(m_pStackProgram);
+}
+
+std::shared_ptr<EvalStackProgram> EvalStackMachine::FindProgramInCache(const std::string &expression)
+{
+    std::lock_guard<std::mutex> lock(m_programsCacheMutex);
+
+    auto find = m_programsCacheIndex.find(expression);
+    if (find == m_programsCacheIndex.end())
+        return nullptr;
+
+    // Move data to begin, so, last used will be on front.
+    if (find->second != m_programsCache.begin())
+        m_programsCache.splice(m_programsCache.begin(), m_programsCache, find->second);
+
+    return m_programsCache.front().second;
+}
+
+void EvalStackMachine::AddProgramToCache(const std::string &expression, const std::shared_ptr<EvalStackProgram> &program)
+{
+    std::lock_guard<std::mutex> lock(m_programsCacheMutex);
+
+    if (m_programsCacheIndex.find(expression) != m_programsCacheIndex.end())
+        return;
+
+    if (m_programsCache.size() >= m_programsCacheSize)
+    {
+        m_programsCacheIndex.erase(m_programsCache.back().first);
+        m_programsCache.pop_back();
+    }
+
+    m_programsCache.emplace_front(expression, program);
+    m_programsCacheIndex.emplace(expression, m_programsCache.begin());
+}
+
+HRESULT EvalStackMachine::CompileExpression(const std::string &expression, std::shared_ptr<EvalStackProgram> &program, std::string &output)
+{
+    program = FindProgramInCache(expression);
+    if (program)
+        return S_OK;
+
+    // Note, internal variables start with "$" and must be replaced before CSharp syntax analyzer.
+    // This data will be restored after CSharp syntax analyzer in IdentifierName and StringLiteralExpression.
+    std::string fixed_expression = expression;
+    ReplaceInternalNames(fixed_expression);
+
+    HRESULT Status;
+    std::shared_ptr<EvalStackProgram> newProgram(new EvalStackProgram());
+    IfFailRet(Interop::GenerateStackMachineProgram(fixed_expression, &newProgram->m_pStackProgram, output));
+
+    static constexpr int32_t ProgramFinished = -1;
+    int32_t Command;
+    PVOID pArguments;
+
+    do
+    {
+        IfFailRet(Interop::NextStackCommand(newProgram->m_pStackProgram, Command, pArguments, output));
+        if (Command == ProgramFinished)
+            break;
+
+        newProgram->m_commands.emplace_back(Command, pArguments);
+    }
+    while (1);
+
+    AddProgramToCache(expression, newProgram);
+    program = std::move(newProgram);
+    return S_OK;
+}
+
 HRESULT EvalStackMachine::Run(ICorDebugThread *pThread, FrameLevel frameLevel, int evalFlags, const std::string &expression,
                               std::list<EvalStackEntry> &evalStack, std::string &output)
+{
+    HRESULT Status;
+    std::shared_ptr<EvalStackProgram> program;
+    IfFailRet(CompileExpression(expression, program, output));
+    return Run(pThread, frameLevel, evalFlags, *program, evalStack, output);
+}
+
+HRESULT EvalStackMachine::Run(ICorDebugThread *pThread, FrameLevel frameLevel, int evalFlags, const EvalStackProgram &program,
+                              std::list<EvalStackEntry> &evalStack, std::string &output)
 {
     static const std::vector<std::function<HRESULT(std::list<EvalStackEntry>&, PVOID, std::string&, EvalData&)>> CommandImplementation = {
         IdentifierName,
@@ -1990,31 +2136,16 @@ HRESULT EvalStackMachine::Run(ICorDebugThread *pThread, FrameLevel frameLevel, i
         ThisExpression
     };
 
-    // Note, internal variables start with "$" and must be replaced before CSharp syntax analyzer.
-    // This data will be restored after CSharp syntax analyzer in IdentifierName and StringLiteralExpression.
-    std::string fixed_expression = expression;
-    ReplaceInternalNames(fixed_expression);
-
-    HRESULT Status;
-    PVOID pStackProgram = nullptr;
-    IfFailRet(Interop::GenerateStackMachineProgram(fixed_expression, &pStackProgram, output));
-
-    static constexpr int32_t ProgramFinished = -1;
-    int32_t Command;
-    PVOID pArguments;
-
     m_evalData.pThread = pThread;
     m_evalData.frameLevel = frameLevel;
     m_evalData.evalFlags = evalFlags;
 
-    do
+    HRESULT Status = S_OK;
+    for (const auto &command : program.m_commands)
     {
-        if (FAILED(Status = Interop::NextStackCommand(pStackProgram, Command, pArguments, output)) ||
-            Command == ProgramFinished ||
-            FAILED(Status = CommandImplementation[Command](evalStack, pArguments, output, m_evalData)))
+        if (FAILED(Status = CommandImplementation[command.first](evalStack, command.second, output, m_evalData)))
             break;
     }
-    while (1);
 
     switch (Status)
     {
@@ -2045,7 +2176,6 @@ HRESULT EvalStackMachine::Run(ICorDebugThread *pThread, FrameLevel frameLevel, i
             break;
     }
 
-    Interop::ReleaseStackMachineProgram(pStackProgram);
     return Status;
 }
 
@@ -2071,6 +2201,18 @@ HRESULT EvalStackMachine::EvaluateExpression(ICorDebugThread *pThread, FrameLeve
     return S_OK;
 }
 
+HRESULT EvalStackMachine::EvaluateExpression(ICorDebugThread *pThread, FrameLevel frameLevel, int evalFlags, const EvalStackProgram &program,
+                                             ICorDebugValue **ppResultValue, std::string &output)
+{
+    HRESULT Status;
+    std::list<EvalStackEntry> evalStack;
+    IfFailRet(Run(pThread, frameLevel, evalFlags, program, evalStack, output));
+
+    assert(evalStack.size() == 1);
+
+    return GetFrontStackEntryValue(ppResultValue, nullptr, evalStack, m_evalData, output);
+}
+
 HRESULT EvalStackMachine::SetValueByExpression(ICorDebugThread *pThread, FrameLevel frameLevel, int evalFlags, ICorDebugValue *pValue,
                                                const std::string &expression, std::string &output)
 {
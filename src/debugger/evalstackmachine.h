@@ -11,6 +11,7 @@
 #include <memory>
 #include <vector>
 #include <list>
+#include <mutex>
 #include <unordered_map>
 #include "interfaces/types.h"
 #include "utils/torelease.h"
@@ -85,6 +86,25 @@ struct EvalData
     {}
 };
 
+// Stack machine program, generated by managed part for particular expression.
+// Note, commands arguments memory owned by managed part and valid until program release, so, same program
+// could be executed multiple times (for example, breakpoint's condition at each breakpoint hit).
+class EvalStackProgram
+{
+    friend class EvalStackMachine;
+
+    PVOID m_pStackProgram;
+    std::vector<std::pair<int32_t /*command*/, PVOID /*arguments*/>> m_commands;
+
+public:
+
+    EvalStackProgram() : m_pStackProgram(nullptr) {}
+    ~EvalStackProgram();
+
+    EvalStackProgram(const EvalStackProgram&) = delete;
+    EvalStackProgram& operator=(const EvalStackProgram&) = delete;
+};
+
 class EvalStackMachine
 {
     std::shared_ptr<Evaluator> m_sharedEvaluator;
@@ -92,9 +112,24 @@ class EvalStackMachine
     std::shared_ptr<EvalWaiter> m_sharedEvalWaiter;
     EvalData m_evalData;
 
+    std::mutex m_programsCacheMutex;
+    // IDE re-evaluate same watch expressions at each stop, cache programs in order to avoid managed part parse and commands marshalling.
+    // At access, element moved to front of list, new element also add to front. In this way, not used elements displaced from cache.
+    static const size_t m_programsCacheSize = 64;
+    typedef std::list<std::pair<std::string, std::shared_ptr<EvalStackProgram>>> programs_cache_t;
+    programs_cache_t m_programsCache;
+    // Expression -> m_programsCache element.
+    std::unordered_map<std::string, programs_cache_t::iterator> m_programsCacheIndex;
+
+    std::shared_ptr<EvalStackProgram> FindProgramInCache(const std::string &expression);
+    void AddProgramToCache(const std::string &expression, const std::shared_ptr<EvalStackProgram> &program);
+
     // Run stack machine for particular expression.
     HRESULT Run(ICorDebugThread *pThread, FrameLevel frameLevel, int evalFlags, const std::string &expression,
                 std::list<EvalStackEntry> &evalStack, std::string &output);
+    // Run stack machine for already compiled expression.
+    HRESULT Run(ICorDebugThread *pThread, FrameLevel frameLevel, int evalFlags, const EvalStackProgram &program,
+                std::list<EvalStackEntry> &evalStack, std::string &output);
 
 public:
 
@@ -116,12 +151,24 @@ public:
         m_evalData.pEvaluator = nullptr;
         m_evalData.pEvalHelpers = nullptr;
         m_evalData.pEvalWaiter = nullptr;
+
+        std::lock_guard<std::mutex> lock(m_programsCacheMutex);
+        m_programsCacheIndex.clear();
+        m_programsCache.clear();
     }
 
     // Evaluate expression. Optional, return `editable` state and in case result is property - setter related information.
     HRESULT EvaluateExpression(ICorDebugThread *pThread, FrameLevel frameLevel, int evalFlags, const std::string &expression, ICorDebugValue **ppResultValue,
                                std::string &output, bool *editable = nullptr, std::unique_ptr<Evaluator::SetterData> *resultSetterData = nullptr);
 
+    // Generate stack machine program for expression, that could be evaluated multiple times (see EvaluateExpression() below).
+    // Note, program could be reused from cache of recently compiled expressions.
+    HRESULT CompileExpression(const std::string &expression, std::shared_ptr<EvalStackProgram> &program, std::string &output);
+
+    // Evaluate compiled expression.
+    HRESULT EvaluateExpression(ICorDebugThread *pThread, FrameLevel frameLevel, int evalFlags, const EvalStackProgram &program,
+                               ICorDebugValue **ppResultValue, std::string &output);
+
     // Set value in pValue by expression with implicitly cast expression result to pValue type, if need.
     HRESULT SetValueByExpression(ICorDebugThread *pThread, FrameLevel frameLevel, int evalFlags, ICorDebugValue *pValue,
                                  const std::string &expression, std::string &output);
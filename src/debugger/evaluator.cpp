@@ -2,7 +2,6 @@
 // Distributed under the MIT License.
 // See the LICENSE file in the project root for more information.
 
-#include <sstream>
 #include <memory>
 #include <unordered_set>
 #include <vector>
@@ -164,38 +163,30 @@ static HRESULT FollowNestedFindType(ICorDebugThread *pThread,
     return E_FAIL;
 }
 
-static void IncIndicies(std::vector<ULONG32> &ind, const std::vector<ULONG32> &dims)
+std::string Evaluator::GetArrayIndexName(ULONG32 position, const std::vector<ULONG32> &dims, const std::vector<ULONG32> &base)
 {
-    int i = static_cast<int32_t>(ind.size()) - 1;
-
-    while (i >= 0)
+    // Note, last index changed first (same order as ICorDebugArrayValue::GetElementAtPosition() use).
+    std::vector<ULONG32> ind(dims.size(), 0);
+    for (size_t i = dims.size(); i-- > 0 && position > 0;)
     {
-        ind[i] += 1;
-        if (ind[i] < dims[i])
-            return;
-        ind[i] = 0;
-        --i;
+        if (dims[i] == 0)
+            break;
+        ind[i] = position % dims[i];
+        position /= dims[i];
     }
-}
-
-static std::string IndiciesToStr(const std::vector<ULONG32> &ind, const std::vector<ULONG32> &base)
-{
-    const size_t ind_size = ind.size();
-    if (ind_size < 1 || base.size() != ind_size)
-        return std::string();
 
-    std::ostringstream ss;
-    const char *sep = "";
-    for (size_t i = 0; i < ind_size; ++i)
+    std::string name = "[";
+    for (size_t i = 0; i < ind.size(); ++i)
     {
-        ss << sep;
-        sep = ", ";
-        ss << (base[i] + ind[i]);
+        if (i > 0)
+            name += ", ";
+        name += std::to_string(base[i] + ind[i]);
     }
-    return ss.str();
+    name += "]";
+    return name;
 }
+
 typedef std::function<HRESULT(mdFieldDef)> WalkFieldsCallback;
-typedef std::function<HRESULT(mdProperty)> WalkPropertiesCallback;
 
 static HRESULT ForEachFields(IMetaDataImport *pMD, mdTypeDef currentTypeDef, WalkFieldsCallback cb)
 {
@@ -213,22 +204,6 @@ static HRESULT ForEachFields(IMetaDataImport *pMD, mdTypeDef currentTypeDef, Wal
     return Status;
 }
 
-static HRESULT ForEachProperties(IMetaDataImport *pMD, mdTypeDef currentTypeDef, WalkPropertiesCallback cb)
-{
-    HRESULT Status = S_OK;
-    mdProperty propertyDef;
-    ULONG numProperties = 0;
-    HCORENUM propEnum = NULL;
-    while(SUCCEEDED(pMD->EnumProperties(&propEnum, currentTypeDef, &propertyDef, 1, &numProperties)) && numProperties != 0)
-    {
-        Status = cb(propertyDef);
-        if (FAILED(Status))
-            break;
-    }
-    pMD->CloseEnum(propEnum);
-    return Status;
-}
-
 // https://github.com/dotnet/runtime/blob/57bfe474518ab5b7cfe6bf7424a79ce3af9d6657/docs/design/coreclr/profiling/davbr-blog-archive/samples/sigparse.cpp
 // This blog post originally appeared on David Broman's blog on 10/13/2005
 
@@ -486,7 +461,8 @@ HRESULT Evaluator::WalkMethods(ICorDebugValue *pInputTypeValue, WalkMethodsCallb
 static const ULONG SIG_METHOD_VARARG = 0x5; // vararg calling convention
 static const ULONG SIG_METHOD_GENERIC = 0x10; // used to indicate that the method has one or more generic parameters.
 
-static HRESULT InternalWalkMethods(ICorDebugType *pInputType, ICorDebugType **ppResultType, std::vector<Evaluator::ArgElementType> &methodGenerics, Evaluator::WalkMethodsCallback cb)
+static HRESULT InternalWalkMethods(TypeLayoutCache *pTypeLayoutCache, ICorDebugType *pInputType, ICorDebugType **ppResultType,
+                                   std::vector<Evaluator::ArgElementType> &methodGenerics, Evaluator::WalkMethodsCallback cb)
 {
     HRESULT Status;
     ToRelease<ICorDebugClass> pClass;
@@ -495,10 +471,9 @@ static HRESULT InternalWalkMethods(ICorDebugType *pInputType, ICorDebugType **pp
     IfFailRet(pClass->GetModule(&pModule));
     mdTypeDef currentTypeDef;
     IfFailRet(pClass->GetToken(&currentTypeDef));
-    ToRelease<IUnknown> pMDUnknown;
-    IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
-    ToRelease<IMetaDataImport> pMD;
-    IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD));
+    std::shared_ptr<const TypeLayoutCache::MethodsLayout> layout;
+    IfFailRet(pTypeLayoutCache->GetMethodsLayout(pModule, currentTypeDef, layout));
+    IMetaDataImport *pMD = layout->pMD.GetPtr();
 
     std::vector<Evaluator::ArgElementType> typeGenerics;
     ToRelease<ICorDebugTypeEnum> paramTypes;
@@ -519,22 +494,9 @@ static HRESULT InternalWalkMethods(ICorDebugType *pInputType, ICorDebugType **pp
         }
     }
 
-    ULONG numMethods = 0;
-    HCORENUM fEnum = NULL;
-    mdMethodDef methodDef;
-    while(SUCCEEDED(pMD->EnumMethods(&fEnum, currentTypeDef, &methodDef, 1, &numMethods)) && numMethods != 0)
+    for (const auto &method : layout->methods)
     {
-
-        mdTypeDef memTypeDef;
-        ULONG nameLen;
-        WCHAR szFunctionName[mdNameLen] = {0};
-        DWORD methodAttr = 0;
-        PCCOR_SIGNATURE pSig = NULL;
-        ULONG cbSig = 0;
-        if (FAILED(pMD->GetMethodProps(methodDef, &memTypeDef,
-                                     szFunctionName, _countof(szFunctionName), &nameLen,
-                                     &methodAttr, &pSig, &cbSig, nullptr,  nullptr)))
-            continue;
+        PCCOR_SIGNATURE pSig = method.pSig;
         ULONG gParams; // Count of signature generics
         ULONG cParams; // Count of signature parameters.
         ULONG elementSize;
@@ -577,28 +539,26 @@ static HRESULT InternalWalkMethods(ICorDebugType *pInputType, ICorDebugType **pp
         if (Status == S_FALSE)
             continue;
 
-        bool is_static = (methodAttr & mdStatic);
+        bool is_static = (method.attr & mdStatic);
 
         auto getFunction = [&](ICorDebugFunction **ppResultFunction) -> HRESULT
         {
-            return pModule->GetFunctionFromToken(methodDef, ppResultFunction);
+            return pModule->GetFunctionFromToken(method.methodDef, ppResultFunction);
         };
 
-        Status = cb(is_static, to_utf8(szFunctionName), returnElementType, argElementTypes, getFunction);
+        Status = cb(is_static, method.name, returnElementType, argElementTypes, getFunction);
         if (FAILED(Status))
         {
             pInputType->AddRef();
             *ppResultType = pInputType;
-            pMD->CloseEnum(fEnum);
             return Status;
         }
     }
-    pMD->CloseEnum(fEnum);
 
     ToRelease<ICorDebugType> iCorBaseType;
     if(SUCCEEDED(pInputType->GetBase(&iCorBaseType)) && iCorBaseType != NULL)
     {
-        IfFailRet(InternalWalkMethods(iCorBaseType, ppResultType, methodGenerics, cb));
+        IfFailRet(InternalWalkMethods(pTypeLayoutCache, iCorBaseType, ppResultType, methodGenerics, cb));
     }
 
     return S_OK;
@@ -606,7 +566,7 @@ static HRESULT InternalWalkMethods(ICorDebugType *pInputType, ICorDebugType **pp
 
 HRESULT Evaluator::WalkMethods(ICorDebugType *pInputType, ICorDebugType **ppResultType, std::vector<Evaluator::ArgElementType> &methodGenerics, Evaluator::WalkMethodsCallback cb)
 {
-    return InternalWalkMethods(pInputType, ppResultType, methodGenerics, cb);
+    return InternalWalkMethods(&m_typeLayoutCache, pInputType, ppResultType, methodGenerics, cb);
 }
 
 static HRESULT InternalSetValue(EvalStackMachine *pEvalStackMachine, EvalHelpers *pEvalHelpers, ICorDebugThread *pThread, FrameLevel frameLevel,
@@ -659,14 +619,21 @@ HRESULT Evaluator::SetValue(ICorDebugThread *pThread, FrameLevel frameLevel, ICo
     return InternalSetValue(m_sharedEvalStackMachine.get(), m_sharedEvalHelpers.get(), pThread, frameLevel, pValue, setterData, value, evalFlags, output);
 }
 
-// https://github.com/dotnet/roslyn/blob/d1e617ded188343ba43d24590802dd51e68e8e32/src/Compilers/CSharp/Portable/Symbols/Synthesized/GeneratedNameParser.cs#L13
-static bool IsSynthesizedLocalName(WCHAR *mdName, ULONG nameLen)
+static HRESULT GetBackingFieldValue(ICorDebugValue *pInputValue, ICorDebugClass *pClass, const TypeLayoutCache::GetterLayout &getterLayout,
+                                    ICorDebugValue **ppResultValue)
 {
-    return (nameLen > 1 && starts_with(mdName, W("<"))) ||
-           (nameLen > 4 && starts_with(mdName, W("CS$<")));
+    HRESULT Status;
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, &isNull));
+    if (isNull)
+        return E_FAIL;
+    ToRelease<ICorDebugObjectValue> pObjValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugObjectValue, (LPVOID*) &pObjValue));
+    return pObjValue->GetFieldValue(pClass, getterLayout.fieldDef, ppResultValue);
 }
 
-static HRESULT InternalWalkMembers(EvalHelpers *pEvalHelpers, ICorDebugValue *pInputValue, ICorDebugThread *pThread, FrameLevel frameLevel,
+static HRESULT InternalWalkMembers(EvalHelpers *pEvalHelpers, TypeLayoutCache *pTypeLayoutCache, ICorDebugValue *pInputValue, ICorDebugThread *pThread, FrameLevel frameLevel,
                                    ICorDebugType *pTypeCast, bool provideSetterData, Evaluator::WalkMembersCallback cb)
 {
     HRESULT Status = S_OK;
@@ -710,8 +677,6 @@ static HRESULT InternalWalkMembers(EvalHelpers *pEvalHelpers, ICorDebugValue *pI
         if (SUCCEEDED(pArrayValue->HasBaseIndicies(&hasBaseIndicies)) && hasBaseIndicies)
             IfFailRet(pArrayValue->GetBaseIndicies(nRank, &base[0]));
 
-        std::vector<ULONG32> ind(nRank, 0);
-
         for (ULONG32 i = 0; i < cElements; ++i)
         {
             auto getValue = [&](ICorDebugValue **ppResultValue, int) -> HRESULT
@@ -720,8 +685,7 @@ static HRESULT InternalWalkMembers(EvalHelpers *pEvalHelpers, ICorDebugValue *pI
                 return S_OK;
             };
 
-            IfFailRet(cb(nullptr, false, "[" + IndiciesToStr(ind, base) + "]", getValue, nullptr));
-            IncIndicies(ind, dims);
+            IfFailRet(cb(nullptr, false, GetArrayIndexName(i, dims, base), getValue, nullptr));
         }
 
         return S_OK;
@@ -757,171 +721,90 @@ static HRESULT InternalWalkMembers(EvalHelpers *pEvalHelpers, ICorDebugValue *pI
     IfFailRet(pClass->GetModule(&pModule));
     mdTypeDef currentTypeDef;
     IfFailRet(pClass->GetToken(&currentTypeDef));
-    ToRelease<IUnknown> pMDUnknown;
-    IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
-    ToRelease<IMetaDataImport> pMD;
-    IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD));
-    IfFailRet(ForEachFields(pMD, currentTypeDef, [&](mdFieldDef fieldDef) -> HRESULT
-    {
-        ULONG nameLen = 0;
-        DWORD fieldAttr = 0;
-        WCHAR mdName[mdNameLen] = {0};
-        PCCOR_SIGNATURE pSignatureBlob = nullptr;
-        ULONG sigBlobLength = 0;
-        UVCP_CONSTANT pRawValue = nullptr;
-        ULONG rawValueLength = 0;
-        if (SUCCEEDED(pMD->GetFieldProps(fieldDef, nullptr, mdName, _countof(mdName), &nameLen, &fieldAttr,
-                                         &pSignatureBlob, &sigBlobLength, nullptr, &pRawValue, &rawValueLength)))
-        {
-            // Prevent access to internal compiler added fields (without visible name).
-            // Should be accessed by debugger routine only and hidden from user/ide.
-            // More about compiler generated names in Roslyn sources:
-            // https://github.com/dotnet/roslyn/blob/315c2e149ba7889b0937d872274c33fcbfe9af5f/src/Compilers/CSharp/Portable/Symbols/Synthesized/GeneratedNames.cs
-            // Note, uncontrolled access to internal compiler added field or its properties may break debugger work.
-            if (IsSynthesizedLocalName(mdName, nameLen))
-                return S_OK;
-
-            bool is_static = (fieldAttr & fdStatic);
-            if (isNull && !is_static)
-                return S_OK;
+    std::shared_ptr<const TypeLayoutCache::MembersLayout> layout;
+    IfFailRet(pTypeLayoutCache->GetMembersLayout(pModule, currentTypeDef, layout));
 
-            std::string name = to_utf8(mdName);
+    for (const auto &field : layout->fields)
+    {
+        bool is_static = (field.attr & fdStatic);
+        if (isNull && !is_static)
+            continue;
 
-            auto getValue = [&](ICorDebugValue **ppResultValue, int) -> HRESULT
+        auto getValue = [&](ICorDebugValue **ppResultValue, int) -> HRESULT
+        {
+            if (field.attr & fdLiteral)
             {
-                if (fieldAttr & fdLiteral)
-                {
-                    IfFailRet(pEvalHelpers->GetLiteralValue(pThread, pType, pModule, pSignatureBlob, sigBlobLength, pRawValue, rawValueLength, ppResultValue));
-                }
-                else if (fieldAttr & fdStatic)
-                {
-                    if (!pThread)
-                        return E_FAIL;
-
-                    ToRelease<ICorDebugFrame> pFrame;
-                    IfFailRet(GetFrameAt(pThread, frameLevel, &pFrame));
-
-                    if (pFrame == nullptr)
-                        return E_FAIL;
-
-                    IfFailRet(pType->GetStaticFieldValue(fieldDef, pFrame, ppResultValue));
-                }
-                else
-                {
-                    // Get pValue again, since it could be neutered at eval call in `cb` on previous cycle.
-                    pValue.Free();
-                    IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, &isNull));
-                    ToRelease<ICorDebugObjectValue> pObjValue;
-                    IfFailRet(pValue->QueryInterface(IID_ICorDebugObjectValue, (LPVOID*) &pObjValue));
-                    IfFailRet(pObjValue->GetFieldValue(pClass, fieldDef, ppResultValue));
-                }
-
-                return S_OK;
-            };
+                IfFailRet(pEvalHelpers->GetLiteralValue(pThread, pType, pModule, field.pSignatureBlob, field.sigBlobLength,
+                                                        field.pRawValue, field.rawValueLength, ppResultValue));
+            }
+            else if (field.attr & fdStatic)
+            {
+                if (!pThread)
+                    return E_FAIL;
 
-            IfFailRet(cb(pType, is_static, name, getValue, nullptr));
-        }
-        return S_OK;
-    }));
-    IfFailRet(ForEachProperties(pMD, currentTypeDef, [&](mdProperty propertyDef) -> HRESULT
-    {
-        mdTypeDef  propertyClass;
-
-        ULONG propertyNameLen = 0;
-        UVCP_CONSTANT pDefaultValue;
-        ULONG cchDefaultValue;
-        mdMethodDef mdGetter;
-        mdMethodDef mdSetter;
-        WCHAR propertyName[mdNameLen] = W("\0");
-        if (SUCCEEDED(pMD->GetPropertyProps(propertyDef, &propertyClass, propertyName, _countof(propertyName),
-                                            &propertyNameLen, nullptr, nullptr, nullptr, nullptr, &pDefaultValue,
-                                            &cchDefaultValue, &mdSetter, &mdGetter, nullptr, 0, nullptr)))
-        {
-            DWORD getterAttr = 0;
-            if (FAILED(pMD->GetMethodProps(mdGetter, NULL, NULL, 0, NULL, &getterAttr, NULL, NULL, NULL, NULL)))
-                return S_OK;
+                ToRelease<ICorDebugFrame> pFrame;
+                IfFailRet(GetFrameAt(pThread, frameLevel, &pFrame));
 
-            bool is_static = (getterAttr & mdStatic);
-            if (isNull && !is_static)
-                return S_OK;
+                if (pFrame == nullptr)
+                    return E_FAIL;
 
-            // https://github.sec.samsung.net/dotnet/coreclr/blob/9df87a133b0f29f4932f38b7307c87d09ab80d5d/src/System.Private.CoreLib/shared/System/Diagnostics/DebuggerBrowsableAttribute.cs#L17
-            // Since we check only first byte, no reason store it as int (default enum type in c#)
-            enum DebuggerBrowsableState : char
+                IfFailRet(pType->GetStaticFieldValue(field.fieldDef, pFrame, ppResultValue));
+            }
+            else
             {
-                Never = 0,
-                Expanded = 1, 
-                Collapsed = 2,
-                RootHidden = 3
-            };
-
-            const char *g_DebuggerBrowsable = "System.Diagnostics.DebuggerBrowsableAttribute..ctor";
-            bool debuggerBrowsableState_Never = false;
+                // Get pValue again, since it could be neutered at eval call in `cb` on previous cycle.
+                pValue.Free();
+                IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, &isNull));
+                ToRelease<ICorDebugObjectValue> pObjValue;
+                IfFailRet(pValue->QueryInterface(IID_ICorDebugObjectValue, (LPVOID*) &pObjValue));
+                IfFailRet(pObjValue->GetFieldValue(pClass, field.fieldDef, ppResultValue));
+            }
 
-            ULONG numAttributes = 0;
-            HCORENUM hEnum = NULL;
-            mdCustomAttribute attr;
-            while(SUCCEEDED(pMD->EnumCustomAttributes(&hEnum, propertyDef, 0, &attr, 1, &numAttributes)) && numAttributes != 0)
-            {
-                mdToken ptkObj = mdTokenNil;
-                mdToken ptkType = mdTokenNil;
-                void const *ppBlob = 0;
-                ULONG pcbSize = 0;
-                if (FAILED(pMD->GetCustomAttributeProps(attr, &ptkObj, &ptkType, &ppBlob, &pcbSize)))
-                    continue;
+            return S_OK;
+        };
 
-                std::string mdName;
-                if (FAILED(TypePrinter::NameForToken(ptkType, pMD, mdName, true, nullptr)))
-                    continue;
+        IfFailRet(cb(pType, is_static, field.name, getValue, nullptr));
+    }
 
-                if (mdName == g_DebuggerBrowsable
-                    // In case of DebuggerBrowsableAttribute blob is 8 bytes:
-                    // 2 bytes - blob prolog 0x0001
-                    // 4 bytes - data (DebuggerBrowsableAttribute::State), default enum type (int)
-                    // 2 bytes - alignment
-                    // We check only one byte (first data byte), no reason check 4 bytes in our case.
-                    && pcbSize > 2
-                    && ((char const *)ppBlob)[2] == DebuggerBrowsableState::Never)
-                {
-                    debuggerBrowsableState_Never = true;
-                    break;
-                }
-            }
-            pMD->CloseEnum(hEnum);
+    for (const auto &property : layout->properties)
+    {
+        bool is_static = property.isStatic;
+        if (isNull && !is_static)
+            continue;
 
-            if (debuggerBrowsableState_Never)
+        auto getValue = [&](ICorDebugValue **ppResultValue, int evalFlags) -> HRESULT
+        {
+            if (!pThread)
+                return E_FAIL;
+
+            // Note, trivial getter (auto-property or `return field;`) value read from backing field, without func-eval.
+            TypeLayoutCache::GetterLayout getterLayout;
+            if (SUCCEEDED(pTypeLayoutCache->GetGetterLayout(pModule, currentTypeDef, property.getter, getterLayout)) &&
+                getterLayout.fieldDef != mdFieldDefNil &&
+                SUCCEEDED(GetBackingFieldValue(pInputValue, pClass, getterLayout, ppResultValue)))
                 return S_OK;
 
-            std::string name = to_utf8(propertyName);
-
-            auto getValue = [&](ICorDebugValue **ppResultValue, int evalFlags) -> HRESULT
-            {
-                if (!pThread)
-                    return E_FAIL;
-
-                ToRelease<ICorDebugFunction> iCorFunc;
-                IfFailRet(pModule->GetFunctionFromToken(mdGetter, &iCorFunc));
+            ToRelease<ICorDebugFunction> iCorFunc;
+            IfFailRet(pModule->GetFunctionFromToken(property.getter, &iCorFunc));
 
-                return pEvalHelpers->EvalFunction(pThread, iCorFunc, pType.GetRef(), 1, is_static ? nullptr : &pInputValue, is_static ? 0 : 1, ppResultValue, evalFlags);
-            };
+            return pEvalHelpers->EvalFunction(pThread, iCorFunc, pType.GetRef(), 1, is_static ? nullptr : &pInputValue, is_static ? 0 : 1, ppResultValue, evalFlags);
+        };
 
-            if (provideSetterData)
-            {
-                ToRelease<ICorDebugFunction> iCorFuncSetter;
-                if (FAILED(pModule->GetFunctionFromToken(mdSetter, &iCorFuncSetter)))
-                {
-                    iCorFuncSetter.Free();
-                }
-                Evaluator::SetterData setterData(is_static ? nullptr : pInputValue, pType, iCorFuncSetter);
-                IfFailRet(cb(pType, is_static, name, getValue, &setterData));
-            }
-            else
+        if (provideSetterData)
+        {
+            ToRelease<ICorDebugFunction> iCorFuncSetter;
+            if (FAILED(pModule->GetFunctionFromToken(property.setter, &iCorFuncSetter)))
             {
-                IfFailRet(cb(pType, is_static, name, getValue, nullptr));
+                iCorFuncSetter.Free();
             }
+            Evaluator::SetterData setterData(is_static ? nullptr : pInputValue, pType, iCorFuncSetter);
+            IfFailRet(cb(pType, is_static, property.name, getValue, &setterData));
         }
-        return S_OK;
-    }));
+        else
+        {
+            IfFailRet(cb(pType, is_static, property.name, getValue, nullptr));
+        }
+    }
 
     std::string baseTypeName;
     ToRelease<ICorDebugType> pBaseType;
@@ -937,7 +820,7 @@ static HRESULT InternalWalkMembers(EvalHelpers *pEvalHelpers, ICorDebugValue *pI
                 IfFailRet(pEvalHelpers->CreatTypeObjectStaticConstructor(pThread, pBaseType));
             }
             // Add fields of base class
-            IfFailRet(InternalWalkMembers(pEvalHelpers, pInputValue, pThread, frameLevel, pBaseType, provideSetterData, cb));
+            IfFailRet(InternalWalkMembers(pEvalHelpers, pTypeLayoutCache, pInputValue, pThread, frameLevel, pBaseType, provideSetterData, cb));
         }
     }
 
@@ -951,7 +834,7 @@ HRESULT Evaluator::WalkMembers(
     bool provideSetterData,
     WalkMembersCallback cb)
 {
-    return InternalWalkMembers(m_sharedEvalHelpers.get(), pValue, pThread, frameLevel, nullptr, provideSetterData, cb);
+    return InternalWalkMembers(m_sharedEvalHelpers.get(), &m_typeLayoutCache, pValue, pThread, frameLevel, nullptr, provideSetterData, cb);
 }
 
 enum class GeneratedCodeKind
@@ -1148,7 +1031,7 @@ static HRESULT InternalGetMethodClass(ICorDebugThread *pThread, FrameLevel frame
         WCHAR mdName[mdNameLen];
         IfFailRet(pMD->GetTypeDefProps(typeDef, mdName, _countof(mdName), &nameLen, NULL, NULL));
 
-        if (!IsSynthesizedLocalName(mdName, nameLen))
+        if (!TypePrinter::IsSynthesizedLocalName(mdName, nameLen))
             break;
 
         mdTypeDef enclosingClass;
@@ -1305,7 +1188,7 @@ static HRESULT WalkGeneratedClassFields(IMetaDataImport *pMD, ICorDebugValue *pI
             usedNames.insert(wLocalName);
         }
         // Ignore any other compiler generated fields, show only normal fields.
-        else if (!IsSynthesizedLocalName(mdName, nameLen))
+        else if (!TypePrinter::IsSynthesizedLocalName(mdName, nameLen))
         {
             IfFailRet(cb(to_utf8(mdName), getValue));
             usedNames.insert(mdName);
@@ -1503,7 +1386,7 @@ HRESULT Evaluator::WalkStackVars(ICorDebugThread *pThread, FrameLevel frameLevel
     return InternalWalkStackVars(m_sharedModules.get(), pThread, frameLevel, cb);
 }
 
-static HRESULT FollowFields(EvalHelpers *pEvalHelpers, ICorDebugThread *pThread, FrameLevel frameLevel, ICorDebugValue *pValue,
+static HRESULT FollowFields(EvalHelpers *pEvalHelpers, TypeLayoutCache *pTypeLayoutCache, ICorDebugThread *pThread, FrameLevel frameLevel, ICorDebugValue *pValue,
                             Evaluator::ValueKind valueKind, std::vector<std::string> &identifiers, int nextIdentifier,
                             ICorDebugValue **ppResult, std::unique_ptr<Evaluator::SetterData> *resultSetterData, int evalFlags)
 {
@@ -1522,7 +1405,7 @@ static HRESULT FollowFields(EvalHelpers *pEvalHelpers, ICorDebugThread *pThread,
 
         ToRelease<ICorDebugValue> pClassValue(std::move(pResultValue));
 
-        InternalWalkMembers(pEvalHelpers, pClassValue, pThread, frameLevel, nullptr, !!resultSetterData, [&](
+        InternalWalkMembers(pEvalHelpers, pTypeLayoutCache, pClassValue, pThread, frameLevel, nullptr, !!resultSetterData, [&](
             ICorDebugType *pType,
             bool is_static,
             const std::string &memberName,
@@ -1554,7 +1437,7 @@ static HRESULT FollowFields(EvalHelpers *pEvalHelpers, ICorDebugThread *pThread,
     return S_OK;
 }
 
-static HRESULT FollowNestedFindValue(Modules *pModules, EvalHelpers *pEvalHelpers, ICorDebugThread *pThread, FrameLevel frameLevel,
+static HRESULT FollowNestedFindValue(Modules *pModules, EvalHelpers *pEvalHelpers, TypeLayoutCache *pTypeLayoutCache, ICorDebugThread *pThread, FrameLevel frameLevel,
                                      const std::string &methodClass, std::vector<std::string> &identifiers, ICorDebugValue **ppResult,
                                      std::unique_ptr<Evaluator::SetterData> *resultSetterData, int evalFlags)
 {
@@ -1597,7 +1480,7 @@ static HRESULT FollowNestedFindValue(Modules *pModules, EvalHelpers *pEvalHelper
             ToRelease<ICorDebugValue> pTypeObject;
             if (S_OK == pEvalHelpers->CreatTypeObjectStaticConstructor(pThread, pType, &pTypeObject))
             {
-                if (SUCCEEDED(FollowFields(pEvalHelpers, pThread, frameLevel, pTypeObject, Evaluator::ValueIsClass, staticName, 0, ppResult, resultSetterData, evalFlags)))
+                if (SUCCEEDED(FollowFields(pEvalHelpers, pTypeLayoutCache, pThread, frameLevel, pTypeObject, Evaluator::ValueIsClass, staticName, 0, ppResult, resultSetterData, evalFlags)))
                     return S_OK;
             }
             trim = true;
@@ -1607,7 +1490,7 @@ static HRESULT FollowNestedFindValue(Modules *pModules, EvalHelpers *pEvalHelper
         ToRelease<ICorDebugValue> pTypeObject;
         IfFailRet(pEvalHelpers->CreatTypeObjectStaticConstructor(pThread, pType, &pTypeObject));
         if (Status == S_OK && // type have static members (S_FALSE if type don't have static members)
-            SUCCEEDED(FollowFields(pEvalHelpers, pThread, frameLevel, pTypeObject, Evaluator::ValueIsClass, fieldName, 0, ppResult, resultSetterData, evalFlags)))
+            SUCCEEDED(FollowFields(pEvalHelpers, pTypeLayoutCache, pThread, frameLevel, pTypeObject, Evaluator::ValueIsClass, fieldName, 0, ppResult, resultSetterData, evalFlags)))
             return S_OK;
 
         trim = true;
@@ -1616,7 +1499,7 @@ static HRESULT FollowNestedFindValue(Modules *pModules, EvalHelpers *pEvalHelper
     return E_FAIL;
 }
 
-static HRESULT InternalResolveIdentifiers(Modules *pModules, EvalHelpers *pEvalHelpers, ICorDebugThread *pThread, FrameLevel frameLevel, ICorDebugValue *pInputValue,
+static HRESULT InternalResolveIdentifiers(Modules *pModules, EvalHelpers *pEvalHelpers, TypeLayoutCache *pTypeLayoutCache, ICorDebugThread *pThread, FrameLevel frameLevel, ICorDebugValue *pInputValue,
                                           Evaluator::SetterData *inputSetterData, std::vector<std::string> &identifiers, ICorDebugValue **ppResultValue,
                                           std::unique_ptr<Evaluator::SetterData> *resultSetterData, ICorDebugType **ppResultType, int evalFlags)
 {
@@ -1630,7 +1513,7 @@ static HRESULT InternalResolveIdentifiers(Modules *pModules, EvalHelpers *pEvalH
     }
     else if (pInputValue)
     {
-        return FollowFields(pEvalHelpers, pThread, frameLevel, pInputValue, Evaluator::ValueIsVariable, identifiers, 0, ppResultValue, resultSetterData, evalFlags);
+        return FollowFields(pEvalHelpers, pTypeLayoutCache, pThread, frameLevel, pInputValue, Evaluator::ValueIsVariable, identifiers, 0, ppResultValue, resultSetterData, evalFlags);
     }
 
     HRESULT Status;
@@ -1678,7 +1561,7 @@ static HRESULT InternalResolveIdentifiers(Modules *pModules, EvalHelpers *pEvalH
         if (identifiers[nextIdentifier] == "this")
             nextIdentifier++; // skip first identifier with "this" (we have it in pThisValue), check rest
 
-        if (SUCCEEDED(FollowFields(pEvalHelpers, pThread, frameLevel, pThisValue, Evaluator::ValueIsVariable, identifiers, nextIdentifier, &pResolvedValue, resultSetterData, evalFlags)))
+        if (SUCCEEDED(FollowFields(pEvalHelpers, pTypeLayoutCache, pThread, frameLevel, pThisValue, Evaluator::ValueIsVariable, identifiers, nextIdentifier, &pResolvedValue, resultSetterData, evalFlags)))
         {
             *ppResultValue = pResolvedValue.Detach();
             return S_OK;
@@ -1696,7 +1579,7 @@ static HRESULT InternalResolveIdentifiers(Modules *pModules, EvalHelpers *pEvalH
         std::string methodName;
         TypePrinter::GetTypeAndMethod(pFrame, methodClass, methodName);
 
-        if (SUCCEEDED(FollowNestedFindValue(pModules, pEvalHelpers, pThread, frameLevel, methodClass, identifiers, &pResolvedValue, resultSetterData, evalFlags)))
+        if (SUCCEEDED(FollowNestedFindValue(pModules, pEvalHelpers, pTypeLayoutCache, pThread, frameLevel, methodClass, identifiers, &pResolvedValue, resultSetterData, evalFlags)))
         {
             *ppResultValue = pResolvedValue.Detach();
             return S_OK;
@@ -1740,7 +1623,7 @@ static HRESULT InternalResolveIdentifiers(Modules *pModules, EvalHelpers *pEvalH
     }
 
     ToRelease<ICorDebugValue> pValue(std::move(pResolvedValue));
-    IfFailRet(FollowFields(pEvalHelpers, pThread, frameLevel, pValue, valueKind, identifiers, nextIdentifier, &pResolvedValue, resultSetterData, evalFlags));
+    IfFailRet(FollowFields(pEvalHelpers, pTypeLayoutCache, pThread, frameLevel, pValue, valueKind, identifiers, nextIdentifier, &pResolvedValue, resultSetterData, evalFlags));
 
     *ppResultValue = pResolvedValue.Detach();
     return S_OK;
@@ -1750,7 +1633,7 @@ HRESULT Evaluator::ResolveIdentifiers(ICorDebugThread *pThread, FrameLevel frame
                                       std::vector<std::string> &identifiers, ICorDebugValue **ppResultValue, std::unique_ptr<SetterData> *resultSetterData,
                                       ICorDebugType **ppResultType, int evalFlags)
 {
-    return InternalResolveIdentifiers(m_sharedModules.get(), m_sharedEvalHelpers.get(), pThread, frameLevel, pInputValue,
+    return InternalResolveIdentifiers(m_sharedModules.get(), m_sharedEvalHelpers.get(), &m_typeLayoutCache, pThread, frameLevel, pInputValue,
                                       inputSetterData, identifiers, ppResultValue, resultSetterData, ppResultType, evalFlags);
 }
 
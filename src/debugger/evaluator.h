@@ -14,6 +14,7 @@
 #include <mutex>
 #include "interfaces/types.h"
 #include "utils/torelease.h"
+#include "metadata/typelayoutcache.h"
 
 namespace netcoredbg
 {
@@ -145,12 +146,17 @@ public:
                      const std::string &value, int evalFlags, std::string &output);
 
     ArgElementType GetElementTypeByTypeName(const std::string typeName);
+    TypeLayoutCache &GetTypeLayoutCache() { return m_typeLayoutCache; }
+
+    // Array element name (like `[1, 2]`) for element at `position`, as ICorDebugArrayValue::GetElementAtPosition() use.
+    static std::string GetArrayIndexName(ULONG32 position, const std::vector<ULONG32> &dims, const std::vector<ULONG32> &base);
 
 private:
 
     std::shared_ptr<Modules> m_sharedModules;
     std::shared_ptr<EvalHelpers> m_sharedEvalHelpers;
     std::shared_ptr<EvalStackMachine> m_sharedEvalStackMachine;
+    TypeLayoutCache m_typeLayoutCache;
 
 };
 
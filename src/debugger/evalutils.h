@@ -9,6 +9,7 @@
 
 #include <vector>
 #include <string>
+#include <functional>
 
 namespace netcoredbg
 {
@@ -22,6 +23,23 @@ namespace EvalUtils
     HRESULT FindType(const std::vector<std::string> &identifiers, int &nextIdentifier, ICorDebugThread *pThread, Modules *pModules,
                      ICorDebugModule *pModule, ICorDebugType **ppType, ICorDebugModule **ppModule = nullptr);
     std::vector<std::string> ParseGenericParams(const std::string &identifier, std::string &typeName);
+
+    // Hash and equal functors for COR_TYPEID keyed containers.
+    struct TypeIdHash
+    {
+        size_t operator()(const COR_TYPEID &typeId) const
+        {
+            return std::hash<UINT64>()(typeId.token1) ^ (std::hash<UINT64>()(typeId.token2) << 1);
+        }
+    };
+
+    struct TypeIdEqual
+    {
+        bool operator()(const COR_TYPEID &left, const COR_TYPEID &right) const
+        {
+            return left.token1 == right.token1 && left.token2 == right.token2;
+        }
+    };
 }
 
 } // namespace netcoredbg
@@ -12,6 +12,38 @@
 namespace netcoredbg
 {
 
+thread_local EvalRequestKind EvalWaiter::t_requestKind = EvalRequestKind::Watch;
+
+void EvalWaiter::SetEvalTimeouts(const EvalTimeouts &evalTimeouts)
+{
+    std::lock_guard<std::mutex> lock(m_evalTimeoutsMutex);
+    m_evalTimeouts = evalTimeouts;
+}
+
+EvalTimeouts EvalWaiter::GetEvalTimeouts()
+{
+    std::lock_guard<std::mutex> lock(m_evalTimeoutsMutex);
+    return m_evalTimeouts;
+}
+
+std::chrono::milliseconds EvalWaiter::GetEvalTimeout(EvalRequestKind kind)
+{
+    std::lock_guard<std::mutex> lock(m_evalTimeoutsMutex);
+    switch (kind)
+    {
+        case EvalRequestKind::Locals:    return std::chrono::milliseconds(m_evalTimeouts.locals);
+        case EvalRequestKind::Condition: return std::chrono::milliseconds(m_evalTimeouts.condition);
+        case EvalRequestKind::Hover:     return std::chrono::milliseconds(m_evalTimeouts.hover);
+        default:                         return std::chrono::milliseconds(m_evalTimeouts.watch);
+    }
+}
+
+std::chrono::milliseconds EvalWaiter::GetAbortTimeout()
+{
+    std::lock_guard<std::mutex> lock(m_evalTimeoutsMutex);
+    return std::chrono::milliseconds(m_evalTimeouts.abort);
+}
+
 void EvalWaiter::NotifyEvalComplete(ICorDebugThread *pThread, ICorDebugEval *pEval)
 {
     std::lock_guard<std::mutex> lock(m_evalResultMutex);
@@ -176,6 +208,8 @@ HRESULT EvalWaiter::WaitEvalResult(ICorDebugThread *pThread,
         }
     };
 
+    const std::chrono::milliseconds evalTimeout = GetEvalTimeout(t_requestKind);
+    const std::chrono::milliseconds abortTimeout = GetAbortTimeout();
     bool evalTimeOut = false;
     auto WaitResult = [&]() -> HRESULT
     {
@@ -197,12 +231,12 @@ HRESULT EvalWaiter::WaitEvalResult(ICorDebugThread *pThread,
             // C:\Program Files (x86)\Microsoft Visual Studio\YYYY\VERSION\Common7\IDE\Profiles\CSharp.vssettings
             // by default NormalEvalTimeout is 5000 milliseconds
             //
-            // TODO add timeout configuration feature (care about VSCode, MSVS with Tizen plugin, standalone usage)
+            // Note, timeout depends on request class and could be configured by launch arguments and command line options.
 
-            std::future_status timeoutStatus = f.wait_for(std::chrono::milliseconds(5000));
+            std::future_status timeoutStatus = f.wait_for(evalTimeout);
             if (timeoutStatus == std::future_status::timeout)
             {
-                LOGW("Evaluation timed out.");
+                LOGW("Evaluation timed out (%lld ms).", (long long)evalTimeout.count());
                 LOGW("%s %s", "To prevent an unsafe abort when evaluating, all threads were allowed to run.",
                      "This may have changed the state of the process and any breakpoints and exceptions encountered have been skipped.");
 
@@ -225,8 +259,8 @@ HRESULT EvalWaiter::WaitEvalResult(ICorDebugThread *pThread,
                 evalTimeOut = true;
                 iCorProcess->Continue(0);
             }
-            // Wait for 5 more seconds, give `Abort()` a chance.
-            timeoutStatus = f.wait_for(std::chrono::milliseconds(5000));
+            // Wait for abort timeout (5 seconds by default), give `Abort()` a chance.
+            timeoutStatus = f.wait_for(abortTimeout);
             if (timeoutStatus == std::future_status::timeout)
             {
                 // Looks like can't be aborted, this is fatal error for debugger (debuggee have inconsistent state now).
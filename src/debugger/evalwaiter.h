@@ -7,8 +7,11 @@
 #include "cor.h"
 #include "cordebug.h"
 
+#include <chrono>
 #include <functional>
 #include <future>
+#include <mutex>
+#include "interfaces/types.h"
 #include "utils/torelease.h"
 
 namespace netcoredbg
@@ -31,6 +34,23 @@ public:
 
     EvalWaiter() : m_evalCanceled(false), m_evalCrossThreadDependency(false) {}
 
+    // Set request class for all evaluations executed by current thread till the end of scope.
+    // Note, requests could be executed by different threads at the same time (see VSCodeProtocol workers).
+    class RequestKindScope
+    {
+    public:
+        RequestKindScope(EvalRequestKind kind) : m_prevKind(t_requestKind) { t_requestKind = kind; }
+        ~RequestKindScope() { t_requestKind = m_prevKind; }
+
+    private:
+        EvalRequestKind m_prevKind;
+    };
+
+    static EvalRequestKind GetRequestKind() { return t_requestKind; }
+
+    void SetEvalTimeouts(const EvalTimeouts &evalTimeouts);
+    EvalTimeouts GetEvalTimeouts();
+
     bool IsEvalRunning();
 #ifdef INTEROP_DEBUGGING
     DWORD GetEvalRunningThreadID();
@@ -54,6 +74,12 @@ private:
     bool m_evalCanceled;
     bool m_evalCrossThreadDependency;
 
+    static thread_local EvalRequestKind t_requestKind;
+    std::mutex m_evalTimeoutsMutex;
+    EvalTimeouts m_evalTimeouts;
+    std::chrono::milliseconds GetEvalTimeout(EvalRequestKind kind);
+    std::chrono::milliseconds GetAbortTimeout();
+
     ToRelease<ICorDebugClass> m_iCorCrossThreadDependencyNotification;
     HRESULT SetEnableCustomNotification(ICorDebugProcess *pProcess, BOOL fEnable);
 
@@ -143,50 +143,73 @@ word_t RestoredOpcode(word_t dataWithBrk, word_t restoreData)
 #endif
 }
 
-bool StepOverBrk(pid_t pid, std::uintptr_t addr, word_t restoreData, std::function<bool(pid_t, std::uintptr_t)> SingleStepOnBrk)
+int ReadModifyWriteData(pid_t pid, std::uintptr_t addr, const std::function<word_t(word_t)> &GetNewData, word_t &readData)
 {
-    // We have 2 cases here (at breakpoint stop):
-    //   * x86/amd64 already changed PC (executed 0xCC code), so, SetPrevBrkPC() call will change PC in our stored registers
-    //     and return `true`, after that we need set this registers into thread by ptrace(PTRACE_SETREGSET);
-    //   * arm32/arm64 don't move PC at breakpoint, so, SetPrevBrkPC() will return `false`, since PC was not changed
-    //     and we don't need call ptrace(PTRACE_SETREGSET) in order to set changed registers (PC).
-    if (NeedSetPrevBrkPC())
+    int err_code = EPERM; // ptrace thread not ready
+    bool peekFailed = true;
+    async_ptrace_exec([&]()
     {
-        user_regs_struct regs;
-        iovec iov;
-        iov.iov_base = &regs;
-        iov.iov_len = sizeof(user_regs_struct);
-        if (async_ptrace(PTRACE_GETREGSET, pid, (void*)NT_PRSTATUS, &iov) == -1)
+        errno = 0;  // Since the value returned by a successful PTRACE_PEEK* request may be -1, the caller must clear errno before the call,
+                    // and then check it afterward to determine whether or not an error occurred.
+        readData = ptrace(PTRACE_PEEKDATA, pid, (void*)addr, nullptr);
+        if (errno != 0)
         {
-            LOGE("Ptrace getregset error: %s\n", strerror(errno));
-            return false;
+            err_code = errno;
+            return;
         }
+        peekFailed = false;
+        err_code = ptrace(PTRACE_POKEDATA, pid, (void*)addr, (void*)GetNewData(readData)) == -1 ? errno : 0;
+    });
 
-        SetPrevBrkPC(regs);
+    if (err_code != 0)
+        LOGE("Ptrace %s error: %s\n", peekFailed ? "peekdata" : "pokedata", strerror(err_code));
 
-        if (async_ptrace(PTRACE_SETREGSET, pid, (void*)NT_PRSTATUS, &iov) == -1)
+    return err_code;
+}
+
+bool SetPrevBrkPCForThread(pid_t pid)
+{
+    user_regs_struct regs;
+    iovec iov;
+    iov.iov_base = &regs;
+    iov.iov_len = sizeof(user_regs_struct);
+    int err_code = EPERM; // ptrace thread not ready
+    bool getFailed = true;
+    async_ptrace_exec([&]()
+    {
+        if (ptrace(PTRACE_GETREGSET, pid, (void*)NT_PRSTATUS, &iov) == -1)
         {
-            LOGE("Ptrace setregset error: %s\n", strerror(errno));
-            return false;
+            err_code = errno;
+            return;
         }
-    }
+        getFailed = false;
+        SetPrevBrkPC(regs);
+        err_code = ptrace(PTRACE_SETREGSET, pid, (void*)NT_PRSTATUS, &iov) == -1 ? errno : 0;
+    });
 
-    errno = 0;
-    word_t brkData = async_ptrace(PTRACE_PEEKDATA, pid, (void*)addr, nullptr);
-    if (errno != 0)
+    if (err_code != 0)
     {
-        LOGE("Ptrace peekdata error: %s", strerror(errno));
+        LOGE("Ptrace %s error: %s\n", getFailed ? "getregset" : "setregset", strerror(err_code));
         return false;
     }
 
-    restoreData = RestoredOpcode(brkData, restoreData);
+    return true;
+}
+
+bool StepOverBrk(pid_t pid, std::uintptr_t addr, word_t restoreData, std::function<bool(pid_t, std::uintptr_t)> SingleStepOnBrk)
+{
+    // We have 2 cases here (at breakpoint stop):
+    //   * x86/amd64 already changed PC (executed 0xCC code), so, SetPrevBrkPC() call will change PC in our stored registers
+    //     and return `true`, after that we need set this registers into thread by ptrace(PTRACE_SETREGSET);
+    //   * arm32/arm64 don't move PC at breakpoint, so, SetPrevBrkPC() will return `false`, since PC was not changed
+    //     and we don't need call ptrace(PTRACE_SETREGSET) in order to set changed registers (PC).
+    if (NeedSetPrevBrkPC() && !SetPrevBrkPCForThread(pid))
+        return false;
 
     // restore data
-    if (async_ptrace(PTRACE_POKEDATA, pid, (void*)addr, (void*)restoreData) == -1)
-    {
-        LOGE("Ptrace pokedata error: %s\n", strerror(errno));
+    word_t brkData = 0;
+    if (ReadModifyWriteData(pid, addr, [&](word_t data) { return RestoredOpcode(data, restoreData); }, brkData) != 0)
         return false;
-    }
 
     if (!SingleStepOnBrk(pid, addr))
         return false;
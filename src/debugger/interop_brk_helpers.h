@@ -20,6 +20,10 @@ namespace InteropDebugging
     word_t EncodeBrkOpcode(word_t data, bool thumbCode);
     word_t RestoredOpcode(word_t dataWithBrk, word_t restoreData);
     bool StepOverBrk(pid_t pid, std::uintptr_t addr, word_t restoreData, std::function<bool(pid_t, std::uintptr_t)> SingleStepOnBrk);
+    // Read data from `addr` and write `GetNewData(readData)` back by one ptrace thread handoff. In case of error, return `errno`.
+    int ReadModifyWriteData(pid_t pid, std::uintptr_t addr, const std::function<word_t(word_t)> &GetNewData, word_t &readData);
+    // Change thread's PC to breakpoint address by one ptrace thread handoff (see SetPrevBrkPC()).
+    bool SetPrevBrkPCForThread(pid_t pid);
 
 #if DEBUGGER_UNIX_ARM
     bool IsThumbOpcode32Bits(word_t data);
@@ -7,6 +7,7 @@
 #include "debugger/interop_mem_helpers.h"
 #include "debugger/interop_ptrace_helpers.h"
 #include "debugger/interop_arm32_singlestep_helpers.h"
+#include "debugger/interop_waitpid_wakeup.h"
 
 #ifdef DEBUGGER_FOR_TIZEN
 // Tizen 5.0/5.5 build fix.
@@ -20,14 +21,16 @@
 #include <sys/uio.h> // iovec
 #include <elf.h> // NT_PRSTATUS
 #include <dirent.h>
-#include <unistd.h> // usleep
+#include <unistd.h>
 
 #include <vector>
 #include <algorithm>
 #include <sstream>
+#include <chrono>
 #include "interfaces/iprotocol.h"
 #include "debugger/breakpoints.h"
 #include "debugger/waitpid.h"
+#include "debugger/sigaction.h"
 #include "debugger/callbacksqueue.h"
 #include "debugger/evalwaiter.h"
 #include "debugger/interop_unwind.h"
@@ -351,6 +354,43 @@ void InteropDebuggerBase::WaitThreadStop(pid_t stoppedPid, std::vector<pid_t> *s
     }
 }
 
+// NOTE caller must care about m_waitpidMutex.
+// Get registers (we need PC) for all threads by one ptrace thread handoff, threads with error are not included into `threadsRegs`.
+static void GetAllThreadsRegs(const std::unordered_map<pid_t, thread_status_t> &TIDs, std::vector<std::pair<pid_t, user_regs_struct>> &threadsRegs)
+{
+    threadsRegs.resize(TIDs.size());
+    std::vector<iovec> iovs(TIDs.size());
+    std::vector<ptrace_call_t> calls;
+    calls.reserve(TIDs.size());
+
+    size_t i = 0;
+    for (const auto &tid : TIDs)
+    {
+        threadsRegs[i].first = tid.first;
+        iovs[i].iov_base = &threadsRegs[i].second;
+        iovs[i].iov_len = sizeof(user_regs_struct);
+        calls.emplace_back(PTRACE_GETREGSET, tid.first, (void*)NT_PRSTATUS, &iovs[i]);
+        i++;
+    }
+
+    async_ptrace_batch(calls);
+
+    size_t count = 0;
+    for (i = 0; i < calls.size(); i++)
+    {
+        if (calls[i].result == -1)
+        {
+            LOGW("Ptrace getregset error: %s\n", strerror(calls[i].error_n));
+            continue; // Will hope, this thread didn't stopped at breakpoint.
+        }
+
+        if (count != i)
+            threadsRegs[count] = threadsRegs[i];
+        count++;
+    }
+    threadsRegs.resize(count);
+}
+
 // NOTE caller must care about m_waitpidMutex.
 void InteropDebuggerHelpers::StopAndDetach(pid_t tgid)
 {
@@ -360,33 +400,31 @@ void InteropDebuggerHelpers::StopAndDetach(pid_t tgid)
     // TODO Remove all native steppers
 
     // Reset threads status stopped by native breakpoint
-    for (auto &entry : m_TIDs)
-    {
-        // get registers (we need PC)
-        user_regs_struct regs;
-        iovec iov;
-        iov.iov_base = &regs;
-        iov.iov_len = sizeof(user_regs_struct);
-        if (async_ptrace(PTRACE_GETREGSET, entry.first, (void*)NT_PRSTATUS, &iov) == -1)
-        {
-            LOGW("Ptrace getregset error: %s\n", strerror(errno));
-            continue; // Will hope, this thread didn't stopped at breakpoint.
-        }
-
-        if (m_sharedBreakpoints->InteropStepPrevToBrk(entry.first, GetBrkAddrByPC(regs)))
+    std::vector<std::pair<pid_t, user_regs_struct>> threadsRegs;
+    GetAllThreadsRegs(m_TIDs, threadsRegs);
+    for (const auto &entry : threadsRegs)
+    {
+        if (m_sharedBreakpoints->InteropStepPrevToBrk(entry.first, GetBrkAddrByPC(entry.second)))
         {
             // that was native breakpoint event, reset it
-            entry.second.stop_signal = 0;
+            m_TIDs[entry.first].stop_signal = 0;
         }
     }
 
     m_sharedBreakpoints->InteropRemoveAllAtDetach(tgid);
     m_uniqueInteropLibraries->RemoveAllLibraries();
 
+    std::vector<ptrace_call_t> calls;
+    calls.reserve(m_TIDs.size());
     for (const auto &tid : m_TIDs)
     {
-        if (async_ptrace(PTRACE_DETACH, tid.first, nullptr, (void*)((word_t)tid.second.stop_signal)) == -1)
-            LOGW("Ptrace detach error: %s\n", strerror(errno));
+        calls.emplace_back(PTRACE_DETACH, tid.first, nullptr, (void*)((word_t)tid.second.stop_signal));
+    }
+    async_ptrace_batch(calls);
+    for (const auto &call : calls)
+    {
+        if (call.result == -1)
+            LOGW("Ptrace detach error: %s\n", strerror(call.error_n));
     }
 
     m_TIDs.clear();
@@ -397,13 +435,19 @@ void InteropDebuggerHelpers::StopAndDetach(pid_t tgid)
 // NOTE caller must care about m_waitpidMutex.
 static void StopAllRunningThreads(const std::unordered_map<pid_t, thread_status_t> &TIDs)
 {
+    std::vector<ptrace_call_t> calls;
     for (const auto &tid : TIDs)
     {
-        if (tid.second.stat == thread_stat_e::running &&
-            async_ptrace(PTRACE_INTERRUPT, tid.first, nullptr, nullptr) == -1)
-        {
-            LOGW("Ptrace interrupt error: %s\n", strerror(errno));
-        }
+        if (tid.second.stat == thread_stat_e::running)
+            calls.emplace_back(PTRACE_INTERRUPT, tid.first, nullptr, nullptr);
+    }
+
+    async_ptrace_batch(calls);
+
+    for (const auto &call : calls)
+    {
+        if (call.result == -1)
+            LOGW("Ptrace interrupt error: %s\n", strerror(call.error_n));
     }
 }
 
@@ -414,6 +458,33 @@ void InteropDebuggerHelpers::Detach(pid_t tgid)
     StopAndDetach(tgid);
 }
 
+// Note, SIGCHLD sigaction is prohibited by hook in interop mode, so, original sigaction must be used here.
+static bool SetupWaitpidWakeupSignal(bool enable)
+{
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sigemptyset(&sa.sa_mask);
+    if (enable)
+    {
+        if (!InitWaitpidWakeup())
+            return false;
+
+        sa.sa_handler = WaitpidWakeupSignalHandler;
+        // Note, SA_NOCLDSTOP can't be used, since we need SIGCHLD for tracees stops too.
+        sa.sa_flags = SA_RESTART;
+    }
+    else
+        sa.sa_handler = SIG_DFL; // same as SetSigactionMode() setup
+
+    if (GetSigaction()(SIGCHLD, &sa, NULL) == -1)
+    {
+        LOGE("Failed SIGCHLD sigaction setup: %s\n", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
 // Note, InteropDebugging::Shutdown() must be called only in case process stopped or finished.
 void InteropDebugger::Shutdown()
 {
@@ -425,10 +496,13 @@ void InteropDebugger::Shutdown()
         if (m_waitpidThreadStatus == WaitpidThreadStatus::WORK)
         {
             m_waitpidNeedExit = true;
+            WakeupWaitpidLoop();
             m_waitpidCV.wait(lock); // wait for exit from infinite loop
         }
 
         m_waitpidWorker.join();
+        SetupWaitpidWakeupSignal(false);
+        m_waitpidWakeupSignal = false;
         Detach(m_TGID);
         m_TGID = 0;
         m_NotifyLastThreadExited = std::function<void(int)>{};
@@ -440,6 +514,7 @@ void InteropDebugger::Shutdown()
     lock.unlock();
 
     ShutdownNativeFramesUnwind();
+    ShutdownThreadStackUnwind();
     async_ptrace_shutdown();
 }
 
@@ -522,6 +597,7 @@ void InteropDebuggerHelpers::LoadLib(pid_t pid, const std::string &libLoadName,
     module.baseAddress = startAddr;
     module.size = endAddr - startAddr;
     m_uniqueInteropLibraries->AddLibrary(libLoadName, realLibName, startAddr, endAddr, module.symbolStatus);
+    FlushThreadStackUnwindCache(startAddr, endAddr);
 
     if (module.symbolStatus == SymbolStatus::SymbolsLoaded)
     {
@@ -545,6 +621,8 @@ void InteropDebuggerHelpers::UnloadLib(const std::string &realLibName)
     std::uintptr_t endAddr = 0;
     if (m_uniqueInteropLibraries->RemoveLibrary(realLibName, startAddr, endAddr))
     {
+        FlushThreadStackUnwindCache(startAddr, endAddr);
+
         std::vector<BreakpointEvent> events;
         m_sharedBreakpoints->InteropUnloadModule(startAddr, endAddr, events);
         for (const BreakpointEvent &event : events)
@@ -823,19 +901,32 @@ void InteropDebuggerBase::ParseThreadsChanges()
     }
 
     // NOTE we use second cycle, since during first (parsing) we may need stop all running threads (for example, in case user breakpoint during eval).
+    std::vector<ptrace_call_t> calls;
+    std::vector<thread_stat_e> prevStats;
     for (const auto &pid : m_changedThreads)
     {
         if (m_TIDs[pid].stat != thread_stat_e::stopped &&
             m_TIDs[pid].stat != thread_stat_e::stopped_on_event_need_continue)
             continue;
 
-        if (async_ptrace(PTRACE_CONT, pid, nullptr, (void*)((word_t)m_TIDs[pid].stop_signal)) == -1)
-            LOGW("Ptrace cont error: %s", strerror(errno));
-        else
+        // Note, same thread could be added into m_changedThreads few times, continue it only once.
+        prevStats.emplace_back(m_TIDs[pid].stat);
+        m_TIDs[pid].stat = thread_stat_e::running;
+        calls.emplace_back(PTRACE_CONT, pid, nullptr, (void*)((word_t)m_TIDs[pid].stop_signal));
+    }
+
+    // Continue all threads by one ptrace thread handoff.
+    async_ptrace_batch(calls);
+
+    for (size_t i = 0; i < calls.size(); i++)
+    {
+        if (calls[i].result == -1)
         {
-            m_TIDs[pid].stat = thread_stat_e::running;
-            m_TIDs[pid].stop_signal = 0;
+            LOGW("Ptrace cont error: %s", strerror(calls[i].error_n));
+            m_TIDs[calls[i].pid].stat = prevStats[i];
         }
+        else
+            m_TIDs[calls[i].pid].stop_signal = 0;
     }
 
     m_changedThreads.clear();
@@ -966,6 +1057,7 @@ void InteropDebugger::ContinueAllThreadsWithEvents()
     // Continue native code execution with care about stop events (CallbacksQueue).
     // Ignore allThreadsWereStopped status here, since we could have different events not only breakpoints.
     ParseThreadsChanges();
+    WakeupWaitpidLoop();
 }
 
 static void GetAllManagedThreads(ICorDebugProcess *pProcess, std::map<pid_t, ToRelease<ICorDebugThread>> &allManagedTreads)
@@ -987,15 +1079,21 @@ static void GetAllManagedThreads(ICorDebugProcess *pProcess, std::map<pid_t, ToR
 static void StopAllManagedThreads(std::unordered_map<pid_t, thread_status_t> &TIDs, std::map<pid_t, ToRelease<ICorDebugThread>> &allManagedTreads,
                                   std::vector<pid_t> &stoppedManagedTreads)
 {
+    std::vector<ptrace_call_t> calls;
     for (const auto &managedThread : allManagedTreads)
     {
-        if (TIDs[managedThread.first].stat != thread_stat_e::running)
-            continue;
+        if (TIDs[managedThread.first].stat == thread_stat_e::running)
+            calls.emplace_back(PTRACE_INTERRUPT, managedThread.first, nullptr, nullptr);
+    }
 
-        if (async_ptrace(PTRACE_INTERRUPT, managedThread.first, nullptr, nullptr) == -1)
-            LOGW("Ptrace interrupt error: %s\n", strerror(errno));
+    async_ptrace_batch(calls);
+
+    for (const auto &call : calls)
+    {
+        if (call.result == -1)
+            LOGW("Ptrace interrupt error: %s\n", strerror(call.error_n));
         else
-            stoppedManagedTreads.emplace_back(managedThread.first);
+            stoppedManagedTreads.emplace_back(call.pid);
     }
 }
 
@@ -1149,6 +1247,7 @@ HRESULT InteropDebugger::StopAllNativeThreads(ICorDebugProcess *pProcess)
     }
 
     ParseThreadsChanges();
+    WakeupWaitpidLoop();
     return S_OK;
 }
 
@@ -1171,8 +1270,8 @@ void InteropDebuggerBase::WaitpidWorker()
 
     pid_t pid = 0;
     int status = 0;
-    std::unordered_map<pid_t, int> injectTIDs; // CoreCLR's INJECT_ACTIVATION_SIGNAL related.
-    static const int injectSignalResetCountdown = 5; // 5 * 10 ms
+    std::unordered_map<pid_t, std::chrono::steady_clock::time_point> injectTIDs; // CoreCLR's INJECT_ACTIVATION_SIGNAL related.
+    static const std::chrono::milliseconds injectSignalResetTime(50);
 
     while (!m_TIDs.empty())
     {
@@ -1186,26 +1285,14 @@ void InteropDebuggerBase::WaitpidWorker()
 
         if (pid == 0) // No changes (see `waitpid` man for WNOHANG).
         {
-            // INJECT_ACTIVATION_SIGNAL could be delivered with some delay and we could have "no signals" return from `waitpid`.
-            // In the same time, injectTIDs should be reseted, since after some time next signal also could be INJECT_ACTIVATION_SIGNAL.
-            // Note, CoreCLR will be Ok in case INJECT_ACTIVATION_SIGNAL will be never delivered and rely on the GCPOLL mechanism, see
-            // https://github.com/dotnet/runtime/blob/8f517afeda93e031b3a797a0eb9e6643adcece2f/src/coreclr/vm/threadsuspend.cpp#L3407-L3425
-            for (auto it = injectTIDs.begin(); it != injectTIDs.end();)
-            {
-                if (it->second == 0)
-                    it = injectTIDs.erase(it);
-                else
-                {
-                    it->second--;
-                    ++it;
-                }
-            }
-
             ParseThreadsChanges();
             ParseThreadsEvents();
 
+            // Sleep until SIGCHLD or wakeup request from other thread (exit, threads changes, etc).
+            // Note, in case ParseThreadsEvents() can't send events now (m_callbackEventMutex locked), retry in 10 ms.
+            int timeout = (m_waitpidWakeupSignal && m_eventedThreads.empty()) ? -1 : 10;
             lockWaitpid.unlock();
-            usleep(10*1000); // sleep 10 ms before next waitpid call
+            WaitForWaitpidWakeup(timeout);
             lockWaitpid.lock();
 
             if (m_waitpidNeedExit)
@@ -1217,6 +1304,7 @@ void InteropDebuggerBase::WaitpidWorker()
         if (!WIFSTOPPED(status))
         {
             m_TIDs.erase(pid);
+            injectTIDs.erase(pid);
             pProtocol->EmitThreadEvent(ThreadEvent(NativeThreadExited, ThreadId(pid), true));
 
             // Tracee exited or was killed by signal.
@@ -1249,14 +1337,15 @@ void InteropDebuggerBase::WaitpidWorker()
 
             if (sendByItself)
             {
+                // INJECT_ACTIVATION_SIGNAL could be delivered with some delay, so, injectTIDs entry should be reseted after some time,
+                // since next signal also could be INJECT_ACTIVATION_SIGNAL.
+                // Note, CoreCLR will be Ok in case INJECT_ACTIVATION_SIGNAL will be never delivered and rely on the GCPOLL mechanism, see
+                // https://github.com/dotnet/runtime/blob/8f517afeda93e031b3a797a0eb9e6643adcece2f/src/coreclr/vm/threadsuspend.cpp#L3407-L3425
+                auto now = std::chrono::steady_clock::now();
                 auto find = injectTIDs.find(pid);
-                if (find != injectTIDs.end())
-                {
+                if (find != injectTIDs.end() && now < find->second)
                     stop_signal = 0;
-                    find->second = injectSignalResetCountdown;
-                }
-                else
-                    injectTIDs.emplace(std::make_pair(pid, injectSignalResetCountdown));
+                injectTIDs[pid] = now + injectSignalResetTime;
 
                 if (async_ptrace(PTRACE_CONT, pid, nullptr, (void*)((word_t)stop_signal)) == -1)
                     LOGW("Ptrace cont error: %s", strerror(errno));
@@ -1330,6 +1419,7 @@ HRESULT InteropDebugger::Init(pid_t pid, std::shared_ptr<CallbacksQueue> &shared
     ParseThreadsChanges();
 
     m_waitpidNeedExit = false;
+    m_waitpidWakeupSignal = SetupWaitpidWakeupSignal(true);
     InitWaitpidWorkerThread();
     m_waitpidCV.wait(lock); // wait for init complete from WaitpidWorker()
     m_waitpidThreadStatus = WaitpidThreadStatus::WORK;
@@ -1338,6 +1428,7 @@ HRESULT InteropDebugger::Init(pid_t pid, std::shared_ptr<CallbacksQueue> &shared
     m_waitpidCV.notify_one(); // notify WaitpidWorker() to start infinite loop
 
     m_NotifyLastThreadExited = NotifyLastThreadExited;
+    InitThreadStackUnwind();
     InitNativeFramesUnwind(this);
     return S_OK;
 }
@@ -1357,27 +1448,18 @@ void InteropDebuggerHelpers::BrkStopAllThreads(bool &allThreadsWereStopped)
 // Note, at this point we don't need step over breakpoint, since we don't need "fix, step and restore" logic here.
 void InteropDebuggerHelpers::BrkFixAllThreads(std::uintptr_t checkAddr)
 {
-    for (auto &entry : m_TIDs)
-    {
-        // get registers (we need PC)
-        user_regs_struct regs;
-        iovec iov;
-        iov.iov_base = &regs;
-        iov.iov_len = sizeof(user_regs_struct);
-        if (async_ptrace(PTRACE_GETREGSET, entry.first, (void*)NT_PRSTATUS, &iov) == -1)
-        {
-            LOGW("Ptrace getregset error: %s\n", strerror(errno));
-            continue; // Will hope, this thread didn't stopped at breakpoint.
-        }
-
-        std::uintptr_t brkAddrByPC = GetBrkAddrByPC(regs);
+    std::vector<std::pair<pid_t, user_regs_struct>> threadsRegs;
+    GetAllThreadsRegs(m_TIDs, threadsRegs);
+    for (const auto &entry : threadsRegs)
+    {
+        std::uintptr_t brkAddrByPC = GetBrkAddrByPC(entry.second);
         if (checkAddr != brkAddrByPC)
             continue;
 
         if (m_sharedBreakpoints->InteropStepPrevToBrk(entry.first, brkAddrByPC))
         {
             // that was native breakpoint event, reset it
-            entry.second.stop_signal = 0;
+            m_TIDs[entry.first].stop_signal = 0;
             // Note, in this point we could already have stop event added, CallbacksQueue will care about this case.
         }
     }
@@ -1394,7 +1476,10 @@ HRESULT InteropDebugger::SetLineBreakpoints(const std::string& filename, const s
 
     // Continue threads execution with care about stop events (CallbacksQueue).
     if (allThreadsWereStopped)
+    {
         ParseThreadsChanges();
+        WakeupWaitpidLoop();
+    }
 
     return Status;
 }
@@ -1410,7 +1495,10 @@ HRESULT InteropDebugger::AllBreakpointsActivate(bool act)
 
     // Continue threads execution with care about stop events (CallbacksQueue).
     if (allThreadsWereStopped)
+    {
         ParseThreadsChanges();
+        WakeupWaitpidLoop();
+    }
 
     return Status;
 }
@@ -1426,7 +1514,10 @@ HRESULT InteropDebugger::BreakpointActivate(uint32_t id, bool act)
 
     // Continue threads execution with care about stop events (CallbacksQueue).
     if (allThreadsWereStopped)
+    {
         ParseThreadsChanges();
+        WakeupWaitpidLoop();
+    }
 
     return Status;
 }
@@ -1668,6 +1759,11 @@ HRESULT InteropDebugger::GetFrameForAddr(std::uintptr_t addr, StackFrame &frame)
     return S_OK;
 }
 
+void InteropDebugger::FindFileNames(Utility::string_view pattern, unsigned limit, std::function<void(const char *)> cb)
+{
+    m_uniqueInteropLibraries->FindFileNames(pattern, limit, cb);
+}
+
 bool InteropDebugger::IsManagedThreadWasStoppedInNativeCode(pid_t pid)
 {
     std::lock_guard<std::mutex> lock(m_waitpidMutex);
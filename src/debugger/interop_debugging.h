@@ -17,6 +17,7 @@
 #include <unordered_map>
 #include "interfaces/types.h"
 #include "debugger/frames.h"
+#include "utils/string_view.h"
 
 namespace netcoredbg
 {
@@ -113,6 +114,8 @@ protected:
     std::mutex m_waitpidMutex;
     std::thread m_waitpidWorker;
     bool m_waitpidNeedExit = false;
+    // SIGCHLD handler setup for waitpid loop wakeup, in case of fail waitpid loop will poll with 10 ms timeout.
+    bool m_waitpidWakeupSignal = false;
     pid_t m_TGID = 0;
     std::function<void(int)> m_NotifyLastThreadExited;
     std::unordered_map<pid_t, thread_status_t> m_TIDs;
@@ -188,6 +191,7 @@ public:
     HRESULT BreakpointActivate(uint32_t id, bool act);
 
     HRESULT GetFrameForAddr(std::uintptr_t addr, StackFrame &frame);
+    void FindFileNames(Utility::string_view pattern, unsigned limit, std::function<void(const char *)> cb);
     HRESULT UnwindNativeFrames(pid_t pid, bool firstFrame, std::uintptr_t endAddr, CONTEXT *pStartContext,
                                std::function<HRESULT(NativeFrame &nativeFrame)> nativeFramesCallback);
 
@@ -0,0 +1,88 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/interop_memory_cache.h"
+
+#include <sys/uio.h> // process_vm_readv
+#include <errno.h>
+#include <string.h>
+#include <algorithm>
+
+
+namespace netcoredbg
+{
+namespace InteropDebugging
+{
+
+ProcessMemoryCache::ProcessMemoryCache() :
+    m_pages(CachePages),
+    m_data(CachePages * PageSize)
+{
+}
+
+void ProcessMemoryCache::Clear()
+{
+    for (auto &page : m_pages)
+    {
+        page.valid = false;
+    }
+}
+
+const uint8_t *ProcessMemoryCache::GetPage(pid_t pid, std::uintptr_t pageAddr)
+{
+    // Direct-mapped cache, unwinding read few stack pages and few pages with code/data.
+    size_t index = (pageAddr / PageSize) % CachePages;
+    CachePage &page = m_pages[index];
+    uint8_t *data = m_data.data() + index * PageSize;
+
+    if (page.valid && page.pid == pid && page.addr == pageAddr)
+        return data;
+
+    iovec local;
+    local.iov_base = data;
+    local.iov_len = PageSize;
+    iovec remote;
+    remote.iov_base = (void*)pageAddr;
+    remote.iov_len = PageSize;
+
+    page.valid = process_vm_readv(pid, &local, 1, &remote, 1, 0) == (ssize_t)PageSize;
+    if (!page.valid)
+    {
+        if (errno == ENOSYS || errno == EPERM)
+            m_disabled = true;
+        return nullptr;
+    }
+
+    page.pid = pid;
+    page.addr = pageAddr;
+    return data;
+}
+
+bool ProcessMemoryCache::Read(pid_t pid, std::uintptr_t addr, void *buffer, size_t size)
+{
+    if (m_disabled)
+        return false;
+
+    uint8_t *dst = static_cast<uint8_t*>(buffer);
+    while (size > 0)
+    {
+        std::uintptr_t pageAddr = addr & ~((std::uintptr_t)PageSize - 1);
+        size_t offset = addr - pageAddr;
+        size_t chunk = std::min(size, PageSize - offset);
+
+        const uint8_t *data = GetPage(pid, pageAddr);
+        if (!data)
+            return false;
+
+        memcpy(dst, data + offset, chunk);
+        dst += chunk;
+        addr += chunk;
+        size -= chunk;
+    }
+
+    return true;
+}
+
+} // namespace InteropDebugging
+} // namespace netcoredbg
@@ -0,0 +1,53 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+#pragma once
+
+#ifdef INTEROP_DEBUGGING
+
+#include <sys/types.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace netcoredbg
+{
+namespace InteropDebugging
+{
+
+// Tracee's memory snapshot for stopped threads (for example, for native unwinding), read by `process_vm_readv()` page by page.
+// Note, caller must clear cache each time tracee could change memory (threads resume, memory write).
+class ProcessMemoryCache
+{
+public:
+
+    static const size_t PageSize = 4096;
+    static const size_t CachePages = 32;
+
+    ProcessMemoryCache();
+
+    // Return `false` in case data can't be read by `process_vm_readv()`, caller should use ptrace() for this data.
+    bool Read(pid_t pid, std::uintptr_t addr, void *buffer, size_t size);
+    void Clear();
+
+private:
+
+    struct CachePage
+    {
+        pid_t pid = 0;
+        std::uintptr_t addr = 0;
+        bool valid = false;
+    };
+
+    std::vector<CachePage> m_pages;
+    std::vector<uint8_t> m_data;
+    // Note, `process_vm_readv()` could be not implemented or prohibited by security policy, don't call it again in this case.
+    bool m_disabled = false;
+
+    const uint8_t *GetPage(pid_t pid, std::uintptr_t pageAddr);
+};
+
+} // namespace InteropDebugging
+} // namespace netcoredbg
+
+#endif // INTEROP_DEBUGGING
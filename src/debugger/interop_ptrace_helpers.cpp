@@ -4,6 +4,8 @@
 
 #include "debugger/interop_ptrace_helpers.h"
 
+#include <errno.h>
+#include <atomic>
 #include <mutex>
 #include <thread>
 #include <condition_variable>
@@ -31,23 +33,39 @@ namespace
     PtraceThreadStatus g_ptraceThreadStatus = PtraceThreadStatus::UNKNOWN;
     bool g_exitPtraceWorker = false;
 
-    struct ptrace_args_t
+    // Note, task is function pointer with context (not std::function), since single ptrace call must not allocate memory.
+    typedef void (*ptrace_task_t)(void *context);
+    ptrace_task_t g_ptraceTask = nullptr;
+    void *g_ptraceTaskContext = nullptr;
+    bool g_ptraceTaskDone = false;
+
+    std::atomic<uint64_t> g_ptraceStateId(0);
+
+    bool IsReadOnlyRequest(__ptrace_request request)
     {
-        __ptrace_request request;
-        pid_t pid;
-        void *addr;
-        void *data;
-        void Set(__ptrace_request request_, pid_t pid_, void *addr_, void *data_)
+        switch (request)
         {
-            request = request_;
-            pid = pid_;
-            addr = addr_;
-            data = data_;
+        case PTRACE_PEEKTEXT:
+        case PTRACE_PEEKDATA:
+        case PTRACE_PEEKUSER:
+        case PTRACE_GETREGSET:
+        case PTRACE_GETSIGINFO:
+        case PTRACE_GETEVENTMSG:
+            return true;
+        default:
+            return false;
         }
-    };
-    ptrace_args_t g_ptraceArgs;
-    long g_ptraceResult = 0;
-    int g_errno = 0;
+    }
+
+    void ExecPtraceCall(ptrace_call_t &call)
+    {
+        if (!IsReadOnlyRequest(call.request))
+            g_ptraceStateId++;
+
+        errno = 0;
+        call.result = ptrace(call.request, call.pid, call.addr, call.data);
+        call.error_n = errno;
+    }
 
 } // unnamed namespace
 
@@ -59,15 +77,16 @@ static void PtraceWorker()
 
     while (true)
     {
-        g_ptraceCV.wait(lock); // wait for ptrace call request from async_ptrace() or exit request from async_ptrace_shutdown()
+        // wait for ptrace task request from async_ptrace*() or exit request from async_ptrace_shutdown()
+        g_ptraceCV.wait(lock, [](){ return g_exitPtraceWorker || g_ptraceTask != nullptr; });
 
         if (g_exitPtraceWorker)
             break;
 
-        errno = 0;
-        g_ptraceResult = ptrace(g_ptraceArgs.request, g_ptraceArgs.pid, g_ptraceArgs.addr, g_ptraceArgs.data);
-        g_errno = errno;
-        g_ptraceCV.notify_one(); // notify async_ptrace(), that result is ready
+        g_ptraceTask(g_ptraceTaskContext);
+        g_ptraceTask = nullptr;
+        g_ptraceTaskDone = true;
+        g_ptraceCV.notify_one(); // notify async_ptrace*(), that task is done
     }
 
     g_ptraceCV.notify_one(); // notify async_ptrace_shutdown(), that execution exit from PtraceWorker()
@@ -102,24 +121,72 @@ void async_ptrace_shutdown()
     g_ptraceWorker.join();
 }
 
-long async_ptrace(__ptrace_request request, pid_t pid, void *addr, void *data)
+// Return `false` in case ptrace thread not ready and task was not executed.
+static bool ExecPtraceTask(ptrace_task_t task, void *context)
 {
     std::lock_guard<std::mutex> lockCommand(g_ptraceCommandMutex);
     std::unique_lock<std::mutex> lock(g_ptraceMutex);
 
     if (g_ptraceThreadStatus != PtraceThreadStatus::WORK)
+        return false;
+
+    g_ptraceTask = task;
+    g_ptraceTaskContext = context;
+    g_ptraceTaskDone = false;
+
+    g_ptraceCV.notify_one(); // notify PtraceWorker for task execution
+    g_ptraceCV.wait(lock, [](){ return g_ptraceTaskDone; }); // wait for task done
+
+    return true;
+}
+
+long async_ptrace(__ptrace_request request, pid_t pid, void *addr, void *data)
+{
+    ptrace_call_t call(request, pid, addr, data);
+
+    if (!ExecPtraceTask([](void *context) { ExecPtraceCall(*static_cast<ptrace_call_t*>(context)); }, &call))
     {
         errno = EPERM;
         return -1;
     }
 
-    g_ptraceArgs.Set(request, pid, addr, data);
+    errno = call.error_n;
+    return call.result;
+}
+
+void async_ptrace_batch(std::vector<ptrace_call_t> &calls)
+{
+    if (calls.empty())
+        return;
+
+    auto task = [](void *context)
+    {
+        for (auto &call : *static_cast<std::vector<ptrace_call_t>*>(context))
+        {
+            ExecPtraceCall(call);
+        }
+    };
 
-    g_ptraceCV.notify_one(); // notify PtraceWorker for call real ptrace
-    g_ptraceCV.wait(lock); // wait for result in g_ptraceResult
+    if (!ExecPtraceTask(task, &calls))
+    {
+        for (auto &call : calls)
+        {
+            call.result = -1;
+            call.error_n = EPERM;
+        }
+    }
+}
 
-    errno = g_errno;
-    return g_ptraceResult;
+bool async_ptrace_exec(const std::function<void()> &func)
+{
+    // Note, we don't know what `func` do, care about worst case.
+    g_ptraceStateId++;
+    return ExecPtraceTask([](void *context) { (*static_cast<const std::function<void()>*>(context))(); }, const_cast<std::function<void()>*>(&func));
+}
+
+uint64_t async_ptrace_state_id()
+{
+    return g_ptraceStateId;
 }
 
 } // namespace InteropDebugging
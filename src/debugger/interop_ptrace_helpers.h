@@ -9,6 +9,8 @@
 #include <sys/types.h>
 #include <sys/user.h>
 #include <cstdint>
+#include <vector>
+#include <functional>
 
 namespace netcoredbg
 {
@@ -26,10 +28,33 @@ namespace netcoredbg
 namespace InteropDebugging
 {
 
+    struct ptrace_call_t
+    {
+        __ptrace_request request;
+        pid_t pid;
+        void *addr;
+        void *data;
+        long result;
+        int error_n; // `errno` of real ptrace() call
+
+        ptrace_call_t(__ptrace_request request_, pid_t pid_, void *addr_, void *data_) :
+            request(request_), pid(pid_), addr(addr_), data(data_), result(0), error_n(0)
+        {}
+    };
+
     void async_ptrace_init();
     void async_ptrace_shutdown();
     // Note, this function call will provide `errno` of real ptrace() call.
     long async_ptrace(__ptrace_request request, pid_t pid, void *addr, void *data);
+    // Execute all calls (in vector order) by one ptrace thread handoff, each call store own result and `errno`.
+    void async_ptrace_batch(std::vector<ptrace_call_t> &calls);
+    // Execute `func` in ptrace thread, in order to make dependent ptrace() calls (for example, read-modify-write) by one handoff.
+    // Note, `func` must call ptrace() directly and care about `errno` by itself (`errno` is not provided to caller).
+    // Return `false` in case ptrace thread not ready and `func` was not executed.
+    bool async_ptrace_exec(const std::function<void()> &func);
+    // Return value, that changed each time ptrace call could change tracee's state (threads resume/stop, memory or registers write).
+    // Could be used for tracee's memory caches invalidation.
+    uint64_t async_ptrace_state_id();
 
 } // namespace InteropDebugging
 } // namespace netcoredbg
@@ -4,11 +4,14 @@
 
 #include "debugger/interop_unwind.h"
 #include "debugger/interop_ptrace_helpers.h"
+#include "debugger/interop_memory_cache.h"
 
 #include <libunwind-ptrace.h> // _UPT_find_proc_info()
 #include <sys/mman.h>
 #include <array>
 #include <cstring>
+#include <memory>
+#include <mutex>
 #include <errno.h>
 #include <sys/uio.h> // iovec
 #include <elf.h> // NT_PRSTATUS
@@ -154,6 +157,13 @@ static std::array<int, UNW_REG_LAST + 1> InitPtraceRegOffset()
 }
 const std::array<int, UNW_REG_LAST + 1> g_ptraceRegOffset(InitPtraceRegOffset());
 
+// Note, all unwinding related data protected by g_unwindMutex, since libunwind call accessors only inside ThreadStackUnwind().
+static std::mutex g_unwindMutex;
+static unw_addr_space_t g_addrSpace = nullptr;
+static std::unique_ptr<ProcessMemoryCache> g_memoryCache;
+// Tracee's state id (see async_ptrace_state_id()), that g_memoryCache related to.
+static uint64_t g_memoryCacheStateId = 0;
+
 
 
 
@@ -208,6 +218,9 @@ static int AccessMem(unw_addr_space_t as, unw_word_t addr, unw_word_t *val, int
     if (!ui)
         return -UNW_EINVAL;
 
+    if (g_memoryCache && g_memoryCache->Read(ui->libunwind_UPT_info.pid, addr, val, sizeof(unw_word_t)))
+        return 0;
+
     errno = 0;
     *val = async_ptrace(PTRACE_PEEKDATA, ui->libunwind_UPT_info.pid, (void*)addr, 0);
 
@@ -265,28 +278,74 @@ static int ResumeExecution(unw_addr_space_t, unw_cursor_t *, void *)
     return -UNW_EINVAL;
 }
 
+static unw_accessors_t g_accessors =
+{
+    .find_proc_info             = FindProcInfo,
+    .put_unwind_info            = PutUnwindInfo,
+    .get_dyn_info_list_addr     = GetDynInfoListAddr,
+    .access_mem                 = AccessMem,
+    .access_reg                 = AccessReg,
+    .access_fpreg               = AccessFpreg,
+    .resume                     = ResumeExecution,
+    .get_proc_name              = GetProcName
+};
+
+void InitThreadStackUnwind()
+{
+    std::lock_guard<std::mutex> lock(g_unwindMutex);
+
+    if (g_addrSpace)
+        return;
+
+    // Use global cache for libunwind (increase unwinding speed in exchange of memory usage), see
+    // https://www.nongnu.org/libunwind/man/unw_set_caching_policy(3).html
+    g_addrSpace = unw_create_addr_space(&g_accessors, 0);
+    if (!g_addrSpace)
+        LOGE("Failed to create libunwind address space");
+    else if (unw_set_caching_policy(g_addrSpace, UNW_CACHE_GLOBAL) != 0)
+        LOGW("Failed to setup libunwind global caching policy");
+
+    g_memoryCache.reset(new ProcessMemoryCache());
+}
+
+void ShutdownThreadStackUnwind()
+{
+    std::lock_guard<std::mutex> lock(g_unwindMutex);
+
+    if (g_addrSpace)
+    {
+        unw_destroy_addr_space(g_addrSpace);
+        g_addrSpace = nullptr;
+    }
+
+    g_memoryCache.reset();
+}
+
+void FlushThreadStackUnwindCache(std::uintptr_t startAddr, std::uintptr_t endAddr)
+{
+    std::lock_guard<std::mutex> lock(g_unwindMutex);
+
+    // https://www.nongnu.org/libunwind/man/unw_flush_cache(3).html
+    if (g_addrSpace)
+        unw_flush_cache(g_addrSpace, startAddr, endAddr);
+}
+
 void ThreadStackUnwind(pid_t pid, std::array<unw_word_t, UNW_REG_LAST + 1> *contextRegs, std::function<bool(std::uintptr_t)> threadStackUnwindCallback)
 {
     // TODO ? setup for arm32 env UNW_ARM_UNWIND_METHOD with value UNW_ARM_METHOD_FRAME (looks like all unwinding good by default, no unwind method changes needed)
 
-    // TODO ? use global cache for libunwinde (increase unwinding speed in exchange of memory usage)
-    //  - unw_create_addr_space() at "unwind init"
-    //  - unw_set_caching_policy() with UNW_CACHE_GLOBAL https://www.nongnu.org/libunwind/man/unw_set_caching_policy(3).html
-    //  - unw_flush_cache() in case some lib unload or at "unwind shutdown" https://www.nongnu.org/libunwind/man/unw_flush_cache(3).html
+    std::lock_guard<std::mutex> lock(g_unwindMutex);
 
-    static unw_accessors_t accessors =
+    // Memory snapshot is valid until some thread resumed or memory changed by ptrace call.
+    uint64_t stateId = async_ptrace_state_id();
+    if (g_memoryCache && g_memoryCacheStateId != stateId)
     {
-        .find_proc_info             = FindProcInfo,
-        .put_unwind_info            = PutUnwindInfo,
-        .get_dyn_info_list_addr     = GetDynInfoListAddr,
-        .access_mem                 = AccessMem,
-        .access_reg                 = AccessReg,
-        .access_fpreg               = AccessFpreg,
-        .resume                     = ResumeExecution,
-        .get_proc_name              = GetProcName
-    };
-
-    unw_addr_space_t addrSpace = unw_create_addr_space(&accessors, 0);
+        g_memoryCache->Clear();
+        g_memoryCacheStateId = stateId;
+    }
+
+    // Note, in case InitThreadStackUnwind() was not called or failed, use address space without global cache.
+    unw_addr_space_t addrSpace = g_addrSpace ? g_addrSpace : unw_create_addr_space(&g_accessors, 0);
     void *unwind_context = UnwindContextCreate(pid, contextRegs);
     unw_cursor_t unwind_cursor;
     if (unw_init_remote(&unwind_cursor, addrSpace, unwind_context) < 0)
@@ -321,7 +380,8 @@ void ThreadStackUnwind(pid_t pid, std::array<unw_word_t, UNW_REG_LAST + 1> *cont
         while (unw_step(&unwind_cursor) > 0);
     }
     UnwindContextDestroy(unwind_context);
-    unw_destroy_addr_space(addrSpace);
+    if (addrSpace != g_addrSpace)
+        unw_destroy_addr_space(addrSpace);
 }
 
 
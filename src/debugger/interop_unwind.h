@@ -14,6 +14,11 @@ namespace netcoredbg
 namespace InteropDebugging
 {
 
+// Create global address space with libunwind's global caching and tracee's memory cache.
+void InitThreadStackUnwind();
+void ShutdownThreadStackUnwind();
+// Must be called in case of library load/unload.
+void FlushThreadStackUnwindCache(std::uintptr_t startAddr, std::uintptr_t endAddr);
 void ThreadStackUnwind(pid_t pid, std::array<unw_word_t, UNW_REG_LAST + 1> *contextRegs, std::function<bool(std::uintptr_t)> threadStackUnwindCallback);
 
 } // namespace InteropDebugging
@@ -0,0 +1,88 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/interop_waitpid_wakeup.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <mutex>
+#include "utils/logger.h"
+
+
+namespace netcoredbg
+{
+namespace InteropDebugging
+{
+
+namespace
+{
+    int g_wakeupPipe[2] = {-1, -1};
+    std::once_flag g_wakeupPipeOnce;
+}
+
+bool InitWaitpidWakeup()
+{
+    std::call_once(g_wakeupPipeOnce, []()
+    {
+        if (pipe2(g_wakeupPipe, O_NONBLOCK | O_CLOEXEC) == -1)
+        {
+            LOGE("Waitpid wakeup pipe create error: %s\n", strerror(errno));
+            g_wakeupPipe[0] = g_wakeupPipe[1] = -1;
+        }
+    });
+
+    return g_wakeupPipe[0] != -1;
+}
+
+void WaitpidWakeupSignalHandler(int)
+{
+    WakeupWaitpidLoop();
+}
+
+void WakeupWaitpidLoop()
+{
+    if (g_wakeupPipe[1] == -1)
+        return;
+
+    int savedErrno = errno;
+    static const char wakeup = 0;
+    // Note, in case pipe is full (EAGAIN), waitpid loop will be woken up anyway.
+    if (write(g_wakeupPipe[1], &wakeup, 1) == -1) {}
+    errno = savedErrno;
+}
+
+bool WaitForWaitpidWakeup(int timeout)
+{
+    if (g_wakeupPipe[0] == -1)
+    {
+        if (timeout > 0)
+            usleep(timeout * 1000);
+        return false;
+    }
+
+    struct pollfd pfd;
+    pfd.fd = g_wakeupPipe[0];
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+
+    int ret = poll(&pfd, 1, timeout);
+    if (ret == -1 && errno != EINTR)
+        LOGE("Waitpid wakeup poll error: %s\n", strerror(errno));
+
+    // Drain pipe, all requests before this point will be handled by next waitpid loop cycle.
+    char buffer[64];
+    bool woken = ret == -1; // EINTR mean this thread got signal (SIGCHLD), process it as wakeup
+    while (read(g_wakeupPipe[0], buffer, sizeof(buffer)) > 0)
+    {
+        woken = true;
+    }
+
+    return woken;
+}
+
+} // namespace InteropDebugging
+} // namespace netcoredbg
@@ -0,0 +1,29 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+#pragma once
+
+#ifdef INTEROP_DEBUGGING
+
+namespace netcoredbg
+{
+namespace InteropDebugging
+{
+    // Waitpid loop wakeup by self-pipe: SIGCHLD handler (tracee changed state) and other threads requests write into pipe,
+    // waitpid loop sleep in `poll()` until pipe have data, so, no polling with sleep needed.
+    // Note, signalfd can't be used here, since it need SIGCHLD blocked in all debugger's threads (include CoreCLR's threads).
+
+    // Create pipe (only once for debugger process lifetime, since SIGCHLD handler could be called at any time).
+    bool InitWaitpidWakeup();
+    // SIGCHLD handler, async-signal-safe.
+    void WaitpidWakeupSignalHandler(int signum);
+    // Wakeup waitpid loop, could be called from any thread.
+    void WakeupWaitpidLoop();
+    // Wait for wakeup request or SIGCHLD, `timeout` in milliseconds (-1 for infinite wait).
+    // Return true in case of wakeup and false in case of timeout.
+    bool WaitForWaitpidWakeup(int timeout);
+
+} // namespace InteropDebugging
+} // namespace netcoredbg
+
+#endif // INTEROP_DEBUGGING
@@ -13,7 +13,10 @@
 #include "debugger/breakpoints.h"
 #include "debugger/waitpid.h"
 #include "debugger/evalstackmachine.h"
+#include "debugger/evaluator.h"
+#include "debugger/stacktracecache.h"
 #include "metadata/modules.h"
+#include "metadata/typeprinter.h"
 #include "interfaces/iprotocol.h"
 #include "utils/utf.h"
 #include "managed/interop.h"
@@ -226,6 +229,9 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::ExitProcess(ICorDebugProcess *pProces
 
     m_debugger.m_sharedEvalWaiter->NotifyEvalComplete(nullptr, nullptr);
 
+    // Note, release held COM objects of process, that exited.
+    TypePrinter::ClearNamesCache();
+
     // Linux: exit() and _exit() argument is int (signed int)
     // Windows: ExitProcess() and TerminateProcess() argument is UINT (unsigned int)
     // Windows: GetExitCodeProcess() argument is DWORD (unsigned long)
@@ -277,6 +283,7 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::ExitThread(ICorDebugAppDomain *pAppDo
         m_debugger.InvalidateLastStoppedThreadId();
 
     m_debugger.m_sharedBreakpoints->ManagedCallbackExitThread(pThread);
+    m_debugger.m_uniqueStackTraceCache->RemoveThread(threadId);
 
     m_debugger.pProtocol->EmitThreadEvent(ThreadEvent(ManagedThreadExited, threadId, m_debugger.m_interopDebugging));
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
@@ -313,12 +320,24 @@ HRESULT STDMETHODCALLTYPE ManagedCallback::LoadModule(ICorDebugAppDomain *pAppDo
         m_debugger.m_sharedEvalStackMachine->FindPredefinedTypes(pModule);
     }
 
+    // Process stopped by this callback, good point to apply JMC data from already finished deferred work.
+    m_debugger.m_sharedModules->ApplyDeferredJMC();
+
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
 HRESULT STDMETHODCALLTYPE ManagedCallback::UnloadModule(ICorDebugAppDomain *pAppDomain, ICorDebugModule *pModule)
 {
     LogFuncEntry();
+
+    // Note, module base address could be reused by other module, frames locations are keyed by module base address.
+    m_debugger.m_uniqueStackTraceCache->Clear();
+    // Note, cached names are keyed by module's metadata and types objects, release them for unloaded module.
+    TypePrinter::ClearNamesCache();
+    CORDB_ADDRESS modAddress = 0;
+    if (SUCCEEDED(pModule->GetBaseAddress(&modAddress)))
+        m_debugger.m_sharedEvaluator->GetTypeLayoutCache().ClearModule(modAddress);
+
     return m_sharedCallbacksQueue->ContinueAppDomain(pAppDomain);
 }
 
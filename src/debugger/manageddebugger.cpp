@@ -42,6 +42,7 @@
 #include "debugger/stepper_simple.h"
 #include "debugger/stepper_async.h"
 #include "debugger/steppers.h"
+#include "debugger/stacktracecache.h"
 #include "managed/interop.h"
 #include "metadata/interop_libraries.h"
 #include "utils/utf.h"
@@ -200,6 +201,7 @@ ManagedDebuggerBase::ManagedDebuggerBase(IProtocol *pProtocol_) :
     m_sharedBreakpoints(new Breakpoints(m_sharedModules, m_sharedEvaluator, m_sharedEvalHelpers, m_sharedVariables)),
     m_sharedCallbacksQueue(nullptr),
     m_uniqueManagedCallback(nullptr),
+    m_uniqueStackTraceCache(new StackTraceCache),
 #ifdef INTEROP_DEBUGGING
     m_sharedInteropDebugger(new InteropDebugging::InteropDebugger(pProtocol, m_sharedBreakpoints, m_sharedEvalWaiter)),
 #endif // INTEROP_DEBUGGING
@@ -379,10 +381,19 @@ HRESULT ManagedDebugger::StepCommand(ThreadId threadId, StepType stepType)
 
     ToRelease<ICorDebugThread> pThread;
     IfFailRet(m_iCorProcess->GetThread(int(threadId), &pThread));
+
+    if (IsJustMyCode())
+    {
+        // JMC steppers depend on methods JMC status, at least stepped frame's module attributes scan must be applied.
+        // Note, JMC status for other modules applied when their work is finished (see Modules::ApplyDeferredJMC()).
+        m_sharedModules->WaitDeferredWork(pThread);
+        m_sharedModules->ApplyDeferredJMC();
+    }
     IfFailRet(m_uniqueSteppers->SetupStep(pThread, stepType));
 
     m_sharedVariables->Clear(); // Important, must be sync with MIProtocol m_vars.clear()
     FrameId::invalidate(); // Clear all created during break frames.
+    m_uniqueStackTraceCache->InvalidateStop();
     pProtocol->EmitContinuedEvent(threadId); // VSCode protocol need thread ID.
 
     // Note, process continue must be after event emitted, since we could get new stop event from queue here.
@@ -415,6 +426,7 @@ HRESULT ManagedDebugger::Continue(ThreadId threadId)
 
     m_sharedVariables->Clear(); // Important, must be sync with MIProtocol m_vars.clear()
     FrameId::invalidate(); // Clear all created during break frames.
+    m_uniqueStackTraceCache->InvalidateStop();
     pProtocol->EmitContinuedEvent(threadId); // VSCode protocol need thread ID.
 
     // Note, process continue must be after event emitted, since we could get new stop event from queue here.
@@ -841,6 +853,9 @@ void ManagedDebuggerBase::Cleanup()
 {
     m_sharedModules->CleanupAllModules();
     m_sharedEvalHelpers->Cleanup();
+    m_sharedEvaluator->GetTypeLayoutCache().Clear();
+    TypePrinter::ClearNamesCache();
+    m_uniqueStackTraceCache->Clear();
     m_sharedVariables->Clear(); // Important, must be sync with MIProtocol m_vars.clear()
     pProtocol->Cleanup();
 
@@ -1048,17 +1063,6 @@ HRESULT ManagedDebuggerBase::GetFrameLocation(ICorDebugFrame *pFrame, ThreadId t
         }
     }
 
-    ULONG32 ilOffset;
-    Modules::SequencePoint sp;
-    if (SUCCEEDED(m_sharedModules->GetFrameILAndSequencePoint(pFrame, ilOffset, sp)))
-    {
-        stackFrame.source = Source(sp.document);
-        stackFrame.line = sp.startLine;
-        stackFrame.column = sp.startColumn;
-        stackFrame.endLine = sp.endLine;
-        stackFrame.endColumn = sp.endColumn;
-    }
-
     mdMethodDef methodToken;
     IfFailRet(pFrame->GetFunctionToken(&methodToken));
 
@@ -1067,7 +1071,51 @@ HRESULT ManagedDebuggerBase::GetFrameLocation(ICorDebugFrame *pFrame, ThreadId t
     IfFailRet(pFrame->QueryInterface(IID_ICorDebugNativeFrame, (LPVOID*) &pNativeFrame));
     IfFailRet(pNativeFrame->GetIP(&nOffset));
 
-    IfFailRet(GetModuleId(pModule, stackFrame.moduleId));
+    ULONG32 ilOffset = 0;
+    CorDebugMappingResult mappingResult;
+    ToRelease<ICorDebugILFrame> pILFrame;
+    bool haveILOffset = SUCCEEDED(pFrame->QueryInterface(IID_ICorDebugILFrame, (LPVOID*) &pILFrame)) &&
+                        SUCCEEDED(pILFrame->GetIP(&ilOffset, &mappingResult));
+
+    // Note, sequence point resolve is managed call, reuse location in case frame's code position was not changed.
+    StackTraceCache::LocationKey locationKey;
+    IfFailRet(pModule->GetBaseAddress(&locationKey.modAddress));
+    locationKey.methodToken = methodToken;
+    locationKey.methodVersion = methodVersion;
+    locationKey.ilOffset = ilOffset;
+    locationKey.nativeOffset = nOffset;
+
+    // Note, thread's stack is changed by running evaluation, don't use and fill cache in this case.
+    const bool useCache = haveILOffset && !m_sharedEvalWaiter->IsEvalRunning();
+    StackTraceCache::Location location;
+    if (!useCache || !m_uniqueStackTraceCache->FindLocation(threadId, locationKey, location))
+    {
+        ULONG32 spILOffset;
+        Modules::SequencePoint sp;
+        if (haveILOffset && SUCCEEDED(m_sharedModules->GetFrameILAndSequencePoint(pFrame, spILOffset, sp)))
+        {
+            location.haveSequencePoint = true;
+            location.source = Source(sp.document);
+            location.line = sp.startLine;
+            location.column = sp.startColumn;
+            location.endLine = sp.endLine;
+            location.endColumn = sp.endColumn;
+        }
+
+        IfFailRet(GetModuleId(pModule, location.moduleId));
+        if (useCache)
+            m_uniqueStackTraceCache->AddLocation(threadId, locationKey, location);
+    }
+
+    if (location.haveSequencePoint)
+    {
+        stackFrame.source = location.source;
+        stackFrame.line = location.line;
+        stackFrame.column = location.column;
+        stackFrame.endLine = location.endLine;
+        stackFrame.endColumn = location.endColumn;
+    }
+    stackFrame.moduleId = location.moduleId;
 
     stackFrame.clrAddr.methodToken = methodToken;
     stackFrame.clrAddr.ilOffset = ilOffset;
@@ -1109,8 +1157,16 @@ HRESULT ManagedDebuggerBase::GetManagedStackTrace(ICorDebugThread *pThread, Thre
 {
     LogFuncEntry();
 
+    // Note, thread's stack is changed by running evaluation, stop snapshot can't be used or filled in this case.
+    if (!m_sharedEvalWaiter->IsEvalRunning() &&
+        m_uniqueStackTraceCache->GetFrames(threadId, hotReloadAwareCaller, startFrame, maxFrames, stackFrames, totalFrames))
+        return S_OK;
+
     HRESULT Status;
     int currentFrame = -1;
+    uint64_t namesHitsBefore = 0;
+    uint64_t namesMissesBefore = 0;
+    TypePrinter::GetNamesCacheStats(namesHitsBefore, namesMissesBefore);
 
     auto AddFrameStatementFlag = [&] ()
     {
@@ -1196,6 +1252,17 @@ HRESULT ManagedDebuggerBase::GetManagedStackTrace(ICorDebugThread *pThread, Thre
 
     totalFrames = currentFrame + 1;
 
+    // Note, stack could be changed in case process is running (for example, breakpoint with false condition), don't cache it.
+    if (!m_sharedCallbacksQueue->IsRunning() && !m_sharedEvalWaiter->IsEvalRunning())
+        m_uniqueStackTraceCache->AddFrames(threadId, hotReloadAwareCaller, totalFrames, stackFrames);
+
+    uint64_t namesHits = 0;
+    uint64_t namesMisses = 0;
+    TypePrinter::GetNamesCacheStats(namesHits, namesMisses);
+    LOGD("Stack trace for thread %d: frames %d, type printer names cache hits %llu, misses %llu",
+         int(threadId), totalFrames, (unsigned long long)(namesHits - namesHitsBefore),
+         (unsigned long long)(namesMisses - namesMissesBefore));
+
     return S_OK;
 }
 
@@ -1270,7 +1337,8 @@ HRESULT ManagedDebugger::GetVariables(
     VariablesFilter filter,
     int start,
     int count,
-    std::vector<Variable> &variables)
+    std::vector<Variable> &variables,
+    bool hexFormat)
 {
     LogFuncEntry();
 
@@ -1278,7 +1346,7 @@ HRESULT ManagedDebugger::GetVariables(
     HRESULT Status;
     IfFailRet(CheckDebugProcess());
 
-    return m_sharedVariables->GetVariables(m_iCorProcess, variablesReference, filter, start, count, variables);
+    return m_sharedVariables->GetVariables(m_iCorProcess, variablesReference, filter, start, count, variables, hexFormat);
 }
 
 HRESULT ManagedDebugger::GetScopes(FrameId frameId, std::vector<Scope> &scopes)
@@ -1336,7 +1404,19 @@ HRESULT ManagedDebugger::SetExpression(FrameId frameId, const std::string &expre
 void ManagedDebugger::FindFileNames(string_view pattern, unsigned limit, SearchCallback cb)
 {
     LogFuncEntry();
+#ifdef INTEROP_DEBUGGING
+    // Note, managed and native search results share same `limit`.
+    unsigned count = 0;
+    m_sharedModules->FindFileNames(pattern, limit, [&](const char *name)
+    {
+        count++;
+        cb(name);
+    });
+    if (m_interopDebugging && count < limit)
+        m_sharedInteropDebugger->FindFileNames(pattern, limit - count, cb);
+#else
     m_sharedModules->FindFileNames(pattern, limit, cb);
+#endif // INTEROP_DEBUGGING
 }
 
 void ManagedDebugger::FindFunctions(string_view pattern, unsigned limit, SearchCallback cb)
@@ -1459,6 +1539,16 @@ void ManagedDebugger::SetStepFiltering(bool enable)
     m_uniqueSteppers->SetStepFiltering(enable);
 }
 
+EvalTimeouts ManagedDebugger::GetEvalTimeouts()
+{
+    return m_sharedEvalWaiter->GetEvalTimeouts();
+}
+
+void ManagedDebugger::SetEvalTimeouts(const EvalTimeouts &evalTimeouts)
+{
+    m_sharedEvalWaiter->SetEvalTimeouts(evalTimeouts);
+}
+
 HRESULT ManagedDebugger::SetHotReload(bool enable)
 {
     std::lock_guard<Utility::RWLock::Reader> guardProcessRWLock(m_debugProcessRWLock.reader);
@@ -1520,6 +1610,12 @@ HRESULT ManagedDebuggerBase::ApplyPdbDeltaAndLineUpdates(const std::string &dllF
 
     std::unordered_set<mdMethodDef> pdbMethodTokens;
     IfFailRet(m_sharedModules->ApplyPdbDeltaAndLineUpdates(pModule, m_justMyCode, deltaPDB, lineUpdates, pdbMethodTokens));
+    // Note, types metadata could be changed by delta (new fields, properties and methods).
+    m_sharedEvaluator->GetTypeLayoutCache().Clear();
+    m_sharedEvalHelpers->ClearStaticMembersCache();
+    TypePrinter::ClearNamesCache();
+    // Note, sequence points could be changed by line updates.
+    m_uniqueStackTraceCache->Clear();
 
     updatedDLL = GetModuleFileName(pModule);
     for (const auto &methodToken : pdbMethodTokens)
@@ -36,6 +36,7 @@ class ManagedCallback;
 class CallbacksQueue;
 class Breakpoints;
 class Modules;
+class StackTraceCache;
 
 enum class ProcessAttachedState
 {
@@ -91,6 +92,7 @@ protected:
     std::shared_ptr<Breakpoints> m_sharedBreakpoints;
     std::shared_ptr<CallbacksQueue> m_sharedCallbacksQueue;
     std::unique_ptr<ManagedCallback> m_uniqueManagedCallback;
+    std::unique_ptr<StackTraceCache> m_uniqueStackTraceCache;
 #ifdef INTEROP_DEBUGGING
     std::shared_ptr<InteropDebugging::InteropDebugger> m_sharedInteropDebugger;
 #endif // INTEROP_DEBUGGING
@@ -159,6 +161,8 @@ public:
     void SetStepFiltering(bool enable) override;
     bool IsHotReload() const override { return m_hotReload; }
     HRESULT SetHotReload(bool enable) override;
+    EvalTimeouts GetEvalTimeouts() override;
+    void SetEvalTimeouts(const EvalTimeouts &evalTimeouts) override;
 #ifdef INTEROP_DEBUGGING
     void SetInteropDebugging(bool enable) override;
 #endif
@@ -185,7 +189,7 @@ public:
     HRESULT GetStackTrace(ThreadId threadId, FrameLevel startFrame, unsigned maxFrames, std::vector<StackFrame> &stackFrames, int &totalFrames, bool hotReloadAwareCaller = false) override;
     HRESULT StepCommand(ThreadId threadId, StepType stepType) override;
     HRESULT GetScopes(FrameId frameId, std::vector<Scope> &scopes) override;
-    HRESULT GetVariables(uint32_t variablesReference, VariablesFilter filter, int start, int count, std::vector<Variable> &variables) override;
+    HRESULT GetVariables(uint32_t variablesReference, VariablesFilter filter, int start, int count, std::vector<Variable> &variables, bool hexFormat = false) override;
     int GetNamedVariables(uint32_t variablesReference) override;
     HRESULT Evaluate(FrameId frameId, const std::string &expression, Variable &variable, std::string &output) override;
     void CancelEvalRunning() override;
@@ -0,0 +1,206 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/primitiveformat.h"
+
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+namespace netcoredbg
+{
+
+namespace
+{
+    const char DigitPairs[] =
+        "00010203040506070809"
+        "10111213141516171819"
+        "20212223242526272829"
+        "30313233343536373839"
+        "40414243444546474849"
+        "50515253545556575859"
+        "60616263646566676869"
+        "70717273747576777879"
+        "80818283848586878889"
+        "90919293949596979899";
+
+    const char HexDigits[] = "0123456789abcdef";
+
+    // Note, all formatters write backward from `end` and return pointer to the first character.
+    inline char *FormatUInt64(uint64_t value, char *end)
+    {
+        char *p = end;
+        while (value >= 100)
+        {
+            size_t index = (value % 100) * 2;
+            value /= 100;
+            *--p = DigitPairs[index + 1];
+            *--p = DigitPairs[index];
+        }
+        if (value >= 10)
+        {
+            size_t index = value * 2;
+            *--p = DigitPairs[index + 1];
+            *--p = DigitPairs[index];
+        }
+        else
+            *--p = static_cast<char>('0' + value);
+        return p;
+    }
+
+    inline char *FormatInt64(int64_t value, char *end)
+    {
+        if (value >= 0)
+            return FormatUInt64(static_cast<uint64_t>(value), end);
+
+        char *p = FormatUInt64(0 - static_cast<uint64_t>(value), end);
+        *--p = '-';
+        return p;
+    }
+
+    template <typename T>
+    inline char *FormatDecimal(T value, char *end)
+    {
+        return std::is_signed<T>::value ? FormatInt64(static_cast<int64_t>(value), end)
+                                        : FormatUInt64(static_cast<uint64_t>(value), end);
+    }
+
+    template <typename T>
+    inline char *FormatHex(T value, char *end)
+    {
+        uint64_t bits = static_cast<typename std::make_unsigned<T>::type>(value);
+        char *p = end;
+        for (size_t i = 0; i < sizeof(T) * 2; i++)
+        {
+            *--p = HexDigits[bits & 0xf];
+            bits >>= 4;
+        }
+        *--p = 'x';
+        *--p = '0';
+        return p;
+    }
+
+    // Note, each element formatted into stack buffer, so, short values don't need allocation (small string optimization).
+    template <typename T>
+    void FormatIntegers(const uint8_t *data, size_t count, bool hex, std::vector<std::string> &values)
+    {
+        char buffer[24];
+        char *end = buffer + sizeof(buffer);
+        for (size_t i = 0; i < count; i++)
+        {
+            T value;
+            memcpy(&value, data + i * sizeof(T), sizeof(T));
+            char *begin = hex ? FormatHex(value, end) : FormatDecimal(value, end);
+            values.emplace_back(begin, end - begin);
+        }
+    }
+
+    // Same output as std::ostream with std::setprecision(`precision`) provide.
+    template <typename T>
+    void FormatFloats(const uint8_t *data, size_t count, int precision, std::vector<std::string> &values)
+    {
+        char buffer[32];
+        for (size_t i = 0; i < count; i++)
+        {
+            T value;
+            memcpy(&value, data + i * sizeof(T), sizeof(T));
+            int length = snprintf(buffer, sizeof(buffer), "%.*g", precision, static_cast<double>(value));
+            values.emplace_back(buffer, length > 0 ? length : 0);
+        }
+    }
+
+} // unnamed namespace
+
+size_t GetPrimitiveSize(PrimitiveKind kind)
+{
+    switch (kind)
+    {
+        case PrimitiveKind::Boolean:
+        case PrimitiveKind::SByte:
+        case PrimitiveKind::Byte:
+            return 1;
+        case PrimitiveKind::Int16:
+        case PrimitiveKind::UInt16:
+            return 2;
+        case PrimitiveKind::Int32:
+        case PrimitiveKind::UInt32:
+        case PrimitiveKind::Single:
+            return 4;
+        case PrimitiveKind::Int64:
+        case PrimitiveKind::UInt64:
+        case PrimitiveKind::Double:
+            return 8;
+    }
+    return 0;
+}
+
+void FormatPrimitives(PrimitiveKind kind, const void *data, size_t count, bool hex, std::vector<std::string> &values)
+{
+    const uint8_t *bytes = static_cast<const uint8_t*>(data);
+    values.reserve(values.size() + count);
+
+    switch (kind)
+    {
+        case PrimitiveKind::Boolean:
+            for (size_t i = 0; i < count; i++)
+            {
+                values.emplace_back(bytes[i] == 0 ? "false" : "true");
+            }
+            break;
+        case PrimitiveKind::SByte:  FormatIntegers<int8_t>(bytes, count, hex, values); break;
+        case PrimitiveKind::Byte:   FormatIntegers<uint8_t>(bytes, count, hex, values); break;
+        case PrimitiveKind::Int16:  FormatIntegers<int16_t>(bytes, count, hex, values); break;
+        case PrimitiveKind::UInt16: FormatIntegers<uint16_t>(bytes, count, hex, values); break;
+        case PrimitiveKind::Int32:  FormatIntegers<int32_t>(bytes, count, hex, values); break;
+        case PrimitiveKind::UInt32: FormatIntegers<uint32_t>(bytes, count, hex, values); break;
+        case PrimitiveKind::Int64:  FormatIntegers<int64_t>(bytes, count, hex, values); break;
+        case PrimitiveKind::UInt64: FormatIntegers<uint64_t>(bytes, count, hex, values); break;
+        case PrimitiveKind::Single: FormatFloats<float>(bytes, count, 8, values); break;
+        case PrimitiveKind::Double: FormatFloats<double>(bytes, count, 16, values); break;
+    }
+}
+
+void FormatHexDump(const uint8_t *data, size_t size, std::string &output)
+{
+    static const size_t BytesPerLine = 16;
+    // offset + 2 spaces + 3 chars per byte + 1 extra space + " |" + ASCII + "|" + '\n'
+    output.reserve(output.size() + (size + BytesPerLine - 1) / BytesPerLine * (8 + 2 + BytesPerLine * 4 + 1 + 2 + 1 + 1));
+
+    for (size_t offset = 0; offset < size; offset += BytesPerLine)
+    {
+        if (offset > 0)
+            output.push_back('\n');
+
+        for (int shift = 28; shift >= 0; shift -= 4)
+        {
+            output.push_back(HexDigits[(offset >> shift) & 0xf]);
+        }
+        output.append("  ");
+
+        for (size_t i = 0; i < BytesPerLine; i++)
+        {
+            if (offset + i < size)
+            {
+                output.push_back(HexDigits[data[offset + i] >> 4]);
+                output.push_back(HexDigits[data[offset + i] & 0xf]);
+                output.push_back(' ');
+            }
+            else
+                output.append("   ");
+
+            if (i == BytesPerLine / 2 - 1)
+                output.push_back(' ');
+        }
+
+        output.append(" |");
+        for (size_t i = 0; i < BytesPerLine && offset + i < size; i++)
+        {
+            uint8_t ch = data[offset + i];
+            output.push_back((ch >= 0x20 && ch < 0x7f) ? static_cast<char>(ch) : '.');
+        }
+        output.push_back('|');
+    }
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,41 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace netcoredbg
+{
+
+// Array element types, that could be formatted in bulk from raw array storage.
+// Note, no CoreCLR headers dependency here, caller must convert element type and read array storage.
+enum class PrimitiveKind
+{
+    Boolean,
+    SByte,
+    Byte,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Int64,
+    UInt64,
+    Single,
+    Double
+};
+
+size_t GetPrimitiveSize(PrimitiveKind kind);
+
+// Format `count` elements of raw array storage into `values` (appended), in the same way as PrintValue() print
+// each element. In case `hex` is true, integral values formatted as zero padded hex numbers (`0x0000002a`).
+void FormatPrimitives(PrimitiveKind kind, const void *data, size_t count, bool hex, std::vector<std::string> &values);
+
+// Hex dump with 16 bytes per line: `offset  hex bytes  |ASCII|`, lines separated by '\n'.
+void FormatHexDump(const uint8_t *data, size_t size, std::string &output);
+
+} // namespace netcoredbg
@@ -0,0 +1,115 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "debugger/stacktracecache.h"
+
+#include <algorithm>
+
+namespace netcoredbg
+{
+
+bool StackTraceCache::FindLocation(ThreadId threadId, const LocationKey &key, Location &location)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto findThread = m_threads.find(int(threadId));
+    if (findThread == m_threads.end())
+        return false;
+
+    auto find = findThread->second.locations.find(key);
+    if (find == findThread->second.locations.end())
+        return false;
+
+    location = find->second;
+    return true;
+}
+
+void StackTraceCache::AddLocation(ThreadId threadId, const LocationKey &key, const Location &location)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    ThreadCache &threadCache = m_threads[int(threadId)];
+    if (threadCache.locations.size() >= m_locationsLimit)
+        threadCache.locations.clear();
+
+    threadCache.locations[key] = location;
+}
+
+bool StackTraceCache::GetFrames(ThreadId threadId, bool hotReloadAwareCaller, FrameLevel startFrame, unsigned maxFrames,
+                                std::vector<StackFrame> &stackFrames, int &totalFrames)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto findThread = m_threads.find(int(threadId));
+    if (findThread == m_threads.end() || !findThread->second.snapshot)
+        return false;
+
+    const StopSnapshot &snapshot = *findThread->second.snapshot;
+    if (snapshot.hotReloadAwareCaller != hotReloadAwareCaller)
+        return false;
+
+    int start = int(startFrame);
+    int end = maxFrames == 0 ? snapshot.totalFrames : std::min(snapshot.totalFrames, start + int(maxFrames));
+    for (int i = start; i < end; i++)
+    {
+        if (!snapshot.resolved[i])
+            return false;
+    }
+
+    for (int i = start; i < end; i++)
+    {
+        stackFrames.push_back(snapshot.frames[i]);
+    }
+    totalFrames = snapshot.totalFrames;
+    return true;
+}
+
+void StackTraceCache::AddFrames(ThreadId threadId, bool hotReloadAwareCaller, int totalFrames, const std::vector<StackFrame> &stackFrames)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::unique_ptr<StopSnapshot> &snapshot = m_threads[int(threadId)].snapshot;
+    if (!snapshot || snapshot->hotReloadAwareCaller != hotReloadAwareCaller || snapshot->totalFrames != totalFrames)
+    {
+        snapshot.reset(new StopSnapshot());
+        snapshot->hotReloadAwareCaller = hotReloadAwareCaller;
+        snapshot->totalFrames = totalFrames;
+        snapshot->frames.resize(totalFrames);
+        snapshot->resolved.resize(totalFrames, false);
+    }
+
+    for (const auto &stackFrame : stackFrames)
+    {
+        int level = int(stackFrame.GetLevel());
+        if (level < 0 || level >= totalFrames)
+            continue;
+
+        snapshot->frames[level] = stackFrame;
+        snapshot->resolved[level] = true;
+    }
+}
+
+void StackTraceCache::InvalidateStop()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (auto &thread : m_threads)
+    {
+        thread.second.snapshot.reset();
+    }
+}
+
+void StackTraceCache::RemoveThread(ThreadId threadId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_threads.erase(int(threadId));
+}
+
+void StackTraceCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_threads.clear();
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,104 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include "cor.h"
+#include "cordebug.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "interfaces/types.h"
+
+namespace netcoredbg
+{
+
+// Per thread cache of resolved stack frames:
+// - stop snapshot, frames provided by stack trace requests during current stop, aimed to serve paged requests
+//   (`startFrame`/`levels`) without frames walk, must be invalidated at any process continue (same as FrameId);
+// - frames locations, resolved managed frames data (sequence point and module id) keyed by frame's code position,
+//   survive process continue, so, after step only frames with changed IP resolved again.
+// Note, caller must not use and fill cache while evaluation is running (thread's stack have evaluation frames).
+class StackTraceCache
+{
+public:
+
+    struct LocationKey
+    {
+        CORDB_ADDRESS modAddress;
+        mdMethodDef methodToken;
+        ULONG32 methodVersion;
+        ULONG32 ilOffset;
+        ULONG32 nativeOffset;
+
+        bool operator == (const LocationKey &other) const
+        {
+            return modAddress == other.modAddress && methodToken == other.methodToken && methodVersion == other.methodVersion &&
+                   ilOffset == other.ilOffset && nativeOffset == other.nativeOffset;
+        }
+    };
+
+    struct Location
+    {
+        bool haveSequencePoint;
+        Source source;
+        int line;
+        int column;
+        int endLine;
+        int endColumn;
+        std::string moduleId;
+
+        Location() : haveSequencePoint(false), line(0), column(0), endLine(0), endColumn(0) {}
+    };
+
+    bool FindLocation(ThreadId threadId, const LocationKey &key, Location &location);
+    void AddLocation(ThreadId threadId, const LocationKey &key, const Location &location);
+
+    // Return true in case all requested frames are in stop snapshot.
+    bool GetFrames(ThreadId threadId, bool hotReloadAwareCaller, FrameLevel startFrame, unsigned maxFrames,
+                   std::vector<StackFrame> &stackFrames, int &totalFrames);
+    void AddFrames(ThreadId threadId, bool hotReloadAwareCaller, int totalFrames, const std::vector<StackFrame> &stackFrames);
+
+    void InvalidateStop();
+    void RemoveThread(ThreadId threadId);
+    void Clear();
+
+private:
+
+    struct LocationKeyHash
+    {
+        size_t operator()(const LocationKey &key) const
+        {
+            size_t hash = std::hash<CORDB_ADDRESS>()(key.modAddress);
+            hash ^= std::hash<uint64_t>()(((uint64_t)key.methodToken << 32) | key.methodVersion) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            hash ^= std::hash<uint64_t>()(((uint64_t)key.ilOffset << 32) | key.nativeOffset) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            return hash;
+        }
+    };
+
+    struct StopSnapshot
+    {
+        bool hotReloadAwareCaller;
+        int totalFrames;
+        std::vector<StackFrame> frames;
+        std::vector<bool> resolved;
+    };
+
+    struct ThreadCache
+    {
+        std::unordered_map<LocationKey, Location, LocationKeyHash> locations;
+        std::unique_ptr<StopSnapshot> snapshot;
+    };
+
+    // Note, thread's locations could grow with each step into new code, limit them.
+    static const size_t m_locationsLimit = 256;
+
+    std::mutex m_mutex;
+    std::unordered_map<int, ThreadCache> m_threads;
+};
+
+} // namespace netcoredbg
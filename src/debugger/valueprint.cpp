@@ -18,6 +18,7 @@
 #include "utils/utf.h"
 #include "managed/interop.h"
 #include "metadata/attributes.h"
+#include "debugger/primitiveformat.h"
 
 namespace netcoredbg
 {
@@ -561,6 +562,47 @@ static HRESULT PrintArrayValue(ICorDebugValue *pValue, std::string &output)
 }
 
 HRESULT PrintStringValue(ICorDebugValue * pValue, std::string &output)
+{
+    return PrintStringValueRange(pValue, 0, 0, output);
+}
+
+static bool IsHighSurrogate(WCHAR wch)
+{
+    return wch >= 0xd800 && wch <= 0xdbff;
+}
+
+static bool IsLowSurrogate(WCHAR wch)
+{
+    return wch >= 0xdc00 && wch <= 0xdfff;
+}
+
+// Read [first, last) characters of string object directly from debuggee memory.
+static HRESULT ReadStringChars(ICorDebugProcess *pProcess, ICorDebugValue *pStringValue, ULONG32 first, ULONG32 last, WCHAR *buffer)
+{
+    HRESULT Status;
+    CORDB_ADDRESS address = 0;
+    IfFailRet(pStringValue->GetAddress(&address));
+    if (address == 0)
+        return E_FAIL;
+
+    ToRelease<ICorDebugProcess5> pProcess5;
+    IfFailRet(pProcess->QueryInterface(IID_ICorDebugProcess5, (LPVOID*) &pProcess5));
+    COR_TYPEID typeId;
+    IfFailRet(pProcess5->GetTypeID(address, &typeId));
+    // Note, for string object array layout describe characters storage.
+    COR_ARRAY_LAYOUT layout;
+    IfFailRet(pProcess5->GetArrayLayout(typeId, &layout));
+    if (layout.componentType != ELEMENT_TYPE_CHAR || layout.elementSize != sizeof(WCHAR))
+        return E_FAIL;
+
+    DWORD size = (last - first) * sizeof(WCHAR);
+    SIZE_T read = 0;
+    IfFailRet(pProcess->ReadMemory(address + layout.firstElementOffset + first * sizeof(WCHAR), size, (BYTE*)buffer, &read));
+    return read == size ? S_OK : E_FAIL;
+}
+
+HRESULT PrintStringValueRange(ICorDebugValue *pValue, ULONG32 start, ULONG32 count, std::string &output, ULONG32 *pLength,
+                              ICorDebugProcess *pProcess)
 {
     HRESULT Status;
 
@@ -569,17 +611,46 @@ HRESULT PrintStringValue(ICorDebugValue * pValue, std::string &output)
 
     ULONG32 cchValue;
     IfFailRet(pStringValue->GetLength(&cchValue));
-    cchValue++;         // Allocate one more for null terminator
+    if (pLength)
+        *pLength = cchValue;
 
-    ArrayHolder<WCHAR> str = new WCHAR[cchValue];
+    output.clear();
+    if (start >= cchValue)
+        return S_OK;
+
+    ULONG32 end = (count == 0 || count > cchValue - start) ? cchValue : start + count;
+    // Note, one more character before and after range for surrogate pair, that could be split by range start or end.
+    ULONG32 first = start > 0 ? start - 1 : 0;
+    ULONG32 last = end < cchValue ? end + 1 : end;
+    std::vector<WCHAR> str;
+    if (pProcess && first > 0)
+    {
+        str.resize(last - first);
+        if (FAILED(ReadStringChars(pProcess, pValue, first, last, str.data())))
+            first = 0;
+    }
+    if (first == 0)
+    {
+        // Note, GetString() can't provide string from offset, so [0, last) part retrieved.
+        str.resize(last + 1); // one more for null terminator
+
+        ULONG32 cchValueReturned;
+        IfFailRet(pStringValue->GetString(
+            (ULONG32)str.size(),
+            &cchValueReturned,
+            str.data()));
+    }
 
-    ULONG32 cchValueReturned;
-    IfFailRet(pStringValue->GetString(
-        cchValue,
-        &cchValueReturned,
-        str));
+    // Surrogate pair split by range belongs to the range with high surrogate, so consecutive ranges
+    // could be concatenated into same string as whole string.
+    if (start > 0 && IsLowSurrogate(str[start - first]) && IsHighSurrogate(str[start - 1 - first]))
+        start++;
+    if (end < cchValue && IsHighSurrogate(str[end - 1 - first]) && IsLowSurrogate(str[end - first]))
+        end++;
+    if (start >= end)
+        return S_OK;
 
-    output = to_utf8(str);
+    output = to_utf8(str.data() + start - first, end - start);
 
     return S_OK;
 }
@@ -617,7 +688,26 @@ void EscapeString(std::string &s, char q = '\"')
     }
 }
 
-HRESULT PrintValue(ICorDebugValue *pInputValue, std::string &output, bool escape)
+static bool GetIntegralKind(CorElementType corElemType, ULONG32 cbSize, PrimitiveKind &kind)
+{
+    switch (corElemType)
+    {
+    case ELEMENT_TYPE_I1: kind = PrimitiveKind::SByte; return true;
+    case ELEMENT_TYPE_U1: kind = PrimitiveKind::Byte; return true;
+    case ELEMENT_TYPE_I2: kind = PrimitiveKind::Int16; return true;
+    case ELEMENT_TYPE_U2: kind = PrimitiveKind::UInt16; return true;
+    case ELEMENT_TYPE_I4: kind = PrimitiveKind::Int32; return true;
+    case ELEMENT_TYPE_U4: kind = PrimitiveKind::UInt32; return true;
+    case ELEMENT_TYPE_I8: kind = PrimitiveKind::Int64; return true;
+    case ELEMENT_TYPE_U8: kind = PrimitiveKind::UInt64; return true;
+    // Note, native int size depends on debuggee architecture.
+    case ELEMENT_TYPE_I:  kind = cbSize == 8 ? PrimitiveKind::Int64 : PrimitiveKind::Int32; return true;
+    case ELEMENT_TYPE_U:  kind = cbSize == 8 ? PrimitiveKind::UInt64 : PrimitiveKind::UInt32; return true;
+    default: return false;
+    }
+}
+
+HRESULT PrintValue(ICorDebugValue *pInputValue, std::string &output, bool escape, ULONG32 maxStringLength, bool hex)
 {
     HRESULT Status;
 
@@ -631,26 +721,18 @@ HRESULT PrintValue(ICorDebugValue *pInputValue, std::string &output, bool escape
         return S_OK;
     }
 
-    ULONG32 cbSize;
-    IfFailRet(pValue->GetSize(&cbSize));
-    ArrayHolder<BYTE> rgbValue = new (std::nothrow) BYTE[cbSize];
-    if (rgbValue == nullptr)
-    {
-        return E_OUTOFMEMORY;
-    }
-
-    memset(rgbValue.GetPtr(), 0, cbSize * sizeof(BYTE));
-
     CorElementType corElemType;
     IfFailRet(pValue->GetType(&corElemType));
     if (corElemType == ELEMENT_TYPE_STRING)
     {
         std::string raw_str;
-        IfFailRet(PrintStringValue(pValue, raw_str));
+        ULONG32 cchValue = 0;
+        IfFailRet(PrintStringValueRange(pValue, 0, maxStringLength, raw_str, &cchValue));
+        bool truncated = maxStringLength != 0 && cchValue > maxStringLength;
 
         if (!escape)
         {
-            output = raw_str;
+            output = truncated ? raw_str + "..." : raw_str;
             return S_OK;
         }
 
@@ -658,6 +740,8 @@ HRESULT PrintValue(ICorDebugValue *pInputValue, std::string &output, bool escape
 
         std::ostringstream ss;
         ss << "\"" << raw_str << "\"";
+        if (truncated)
+            ss << "...";
         output = ss.str();
         return S_OK;
     }
@@ -667,6 +751,17 @@ HRESULT PrintValue(ICorDebugValue *pInputValue, std::string &output, bool escape
         return PrintArrayValue(pValue, output);
     }
 
+    // Note, allocate value's buffer for primitive types only, string and array size could be huge.
+    ULONG32 cbSize;
+    IfFailRet(pValue->GetSize(&cbSize));
+    ArrayHolder<BYTE> rgbValue = new (std::nothrow) BYTE[cbSize];
+    if (rgbValue == nullptr)
+    {
+        return E_OUTOFMEMORY;
+    }
+
+    memset(rgbValue.GetPtr(), 0, cbSize * sizeof(BYTE));
+
     ToRelease<ICorDebugGenericValue> pGenericValue;
     IfFailRet(pValue->QueryInterface(IID_ICorDebugGenericValue, (LPVOID*) &pGenericValue));
     IfFailRet(pGenericValue->GetValue((LPVOID) &(rgbValue[0])));
@@ -676,6 +771,16 @@ HRESULT PrintValue(ICorDebugValue *pInputValue, std::string &output, bool escape
         return PrintEnumValue(pValue, rgbValue, output);
     }
 
+    PrimitiveKind kind;
+    if (hex && GetIntegralKind(corElemType, cbSize, kind) && cbSize >= GetPrimitiveSize(kind))
+    {
+        // Same format as array elements have in case of hex format request.
+        std::vector<std::string> values;
+        FormatPrimitives(kind, rgbValue.GetPtr(), 1, true, values);
+        output = values[0];
+        return S_OK;
+    }
+
     std::ostringstream ss;
 
     switch (corElemType)
@@ -734,7 +839,10 @@ HRESULT PrintValue(ICorDebugValue *pInputValue, std::string &output, bool escape
                 return S_OK;
             }
             EscapeString(printableVal, '\'');
-            ss << (unsigned int)wc << " '" << printableVal << "'";
+            if (hex)
+                ss << "0x" << std::hex << std::setw(4) << std::setfill('0') << (unsigned int)wc << " '" << printableVal << "'";
+            else
+                ss << (unsigned int)wc << " '" << printableVal << "'";
         }
         break;
 
@@ -11,8 +11,15 @@
 namespace netcoredbg
 {
 
-HRESULT PrintValue(ICorDebugValue *pInputValue, std::string &output, bool escape = true);
+// Note, `maxStringLength` limit string value (in UTF-16 code units), truncated string printed with "..." at the end.
+// In case `hex` is true, integral and char values printed as zero padded hex numbers (`0x0000002a`).
+HRESULT PrintValue(ICorDebugValue *pInputValue, std::string &output, bool escape = true, ULONG32 maxStringLength = 0, bool hex = false);
 HRESULT PrintStringValue(ICorDebugValue * pValue, std::string &output);
+// Print [start, start + count) range of string value (in UTF-16 code units), `count` 0 means up to the end of string.
+// Note, surrogate pair split by range end is included into range.
+// In case `pProcess` provided, only requested range is read from debuggee memory (string object layout is used).
+HRESULT PrintStringValueRange(ICorDebugValue *pValue, ULONG32 start, ULONG32 count, std::string &output, ULONG32 *pLength = nullptr,
+                              ICorDebugProcess *pProcess = nullptr);
 HRESULT DereferenceAndUnboxValue(ICorDebugValue * pValue, ICorDebugValue** ppOutputValue, BOOL * pIsNull = nullptr);
 
 } // namespace netcoredbg
@@ -8,6 +8,7 @@
 #include <cstring>
 #include <algorithm>
 #include <sstream>
+#include <initializer_list>
 
 #include "metadata/typeprinter.h"
 #include "valueprint.h"
@@ -16,6 +17,9 @@
 #include "debugger/evaluator.h"
 #include "debugger/frames.h"
 #include "debugger/evalstackmachine.h"
+#include "debugger/evalwaiter.h"
+#include "debugger/breakpointutils.h"
+#include "debugger/primitiveformat.h"
 #include "managed/interop.h"
 #include "utils/logger.h"
 #include "utils/utf.h"
@@ -24,17 +28,16 @@
 namespace netcoredbg
 {
 
-static void GetNumChild(Evaluator *pEvaluator, ICorDebugValue *pValue, int &numChild, bool static_members)
-{
-    numChild = 0;
-
-    if (pValue == nullptr)
-        return;
+// Note, variables listing provide only string value preview, full value (or its range) could be retrieved by
+// evaluation of variable's `evaluateName`.
+static const ULONG32 g_listingMaxStringLength = 1024;
 
-    int numStatic = 0;
-    int numInstance = 0;
+static HRESULT WalkMembersCount(Evaluator *pEvaluator, ICorDebugValue *pValue, int &numStatic, int &numInstance)
+{
+    numStatic = 0;
+    numInstance = 0;
     // No thread and FrameLevel{0} here, since we need only count children.
-    if (FAILED(pEvaluator->WalkMembers(pValue, nullptr, FrameLevel{0}, false, [&numStatic, &numInstance](
+    return pEvaluator->WalkMembers(pValue, nullptr, FrameLevel{0}, false, [&numStatic, &numInstance](
         ICorDebugType *,
         bool is_static,
         const std::string &,
@@ -46,19 +49,211 @@ static void GetNumChild(Evaluator *pEvaluator, ICorDebugValue *pValue, int &numC
         else
             numInstance++;
         return S_OK;
-    })))
+    });
+}
+
+// Find instance field declared by value's exact type (base types are not checked).
+static HRESULT FindInstanceField(TypeLayoutCache &typeLayoutCache, ICorDebugValue *pValue, const std::string &name,
+                                 ICorDebugClass **ppClass, mdFieldDef &fieldDef)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugValue2> pValue2;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugValue2, (LPVOID *) &pValue2));
+    ToRelease<ICorDebugType> pType;
+    IfFailRet(pValue2->GetExactType(&pType));
+    if (!pType)
+        return E_FAIL;
+    ToRelease<ICorDebugClass> pClass;
+    IfFailRet(pType->GetClass(&pClass));
+    ToRelease<ICorDebugModule> pModule;
+    IfFailRet(pClass->GetModule(&pModule));
+    mdTypeDef typeDef;
+    IfFailRet(pClass->GetToken(&typeDef));
+    std::shared_ptr<const TypeLayoutCache::MembersLayout> layout;
+    IfFailRet(typeLayoutCache.GetMembersLayout(pModule, typeDef, layout));
+
+    for (const auto &field : layout->fields)
     {
-        return;
+        if ((field.attr & fdStatic) || field.name != name)
+            continue;
+
+        fieldDef = field.fieldDef;
+        *ppClass = pClass.Detach();
+        return S_OK;
+    }
+
+    return E_FAIL;
+}
+
+// Read field value directly (no func-eval), `pValue` must be dereferenced and unboxed object or value type value.
+static HRESULT GetInstanceFieldValue(TypeLayoutCache &typeLayoutCache, ICorDebugValue *pValue, const std::string &name,
+                                     ICorDebugValue **ppResultValue)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugClass> pClass;
+    mdFieldDef fieldDef;
+    IfFailRet(FindInstanceField(typeLayoutCache, pValue, name, &pClass, fieldDef));
+    ToRelease<ICorDebugObjectValue> pObjValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugObjectValue, (LPVOID*) &pObjValue));
+    return pObjValue->GetFieldValue(pClass, fieldDef, ppResultValue);
+}
+
+static HRESULT GetInt32Value(ICorDebugValue *pValue, int32_t &result)
+{
+    HRESULT Status;
+    CorElementType corType;
+    IfFailRet(pValue->GetType(&corType));
+    if (corType != ELEMENT_TYPE_I4)
+        return E_FAIL;
+    ToRelease<ICorDebugGenericValue> pGenericValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugGenericValue, (LPVOID*) &pGenericValue));
+    return pGenericValue->GetValue(&result);
+}
+
+static HRESULT GetInt32FieldValue(TypeLayoutCache &typeLayoutCache, ICorDebugValue *pValue, const std::string &name, int32_t &result)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugValue> pFieldValue;
+    IfFailRet(GetInstanceFieldValue(typeLayoutCache, pValue, name, &pFieldValue));
+    return GetInt32Value(pFieldValue, result);
+}
+
+static HRESULT GetArrayFieldValue(TypeLayoutCache &typeLayoutCache, ICorDebugValue *pValue, const std::string &name,
+                                  ICorDebugArrayValue **ppArrayValue)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugValue> pFieldValue;
+    IfFailRet(GetInstanceFieldValue(typeLayoutCache, pValue, name, &pFieldValue));
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pDerefValue;
+    IfFailRet(DereferenceAndUnboxValue(pFieldValue, &pDerefValue, &isNull));
+    if (isNull || !pDerefValue)
+        return E_FAIL;
+    return pDerefValue->QueryInterface(IID_ICorDebugArrayValue, (LPVOID*) ppArrayValue);
+}
+
+// Note, only collections with known layout (backing array fields) supported, layout checked for .NET Core 3.x and .NET 5+ implementation.
+HRESULT Variables::GetCollectionKind(TypeLayoutCache &typeLayoutCache, ICorDebugValue *pValue, CollectionKind &kind)
+{
+    kind = CollectionKind::None;
+
+    HRESULT Status;
+    ToRelease<ICorDebugValue2> pValue2;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugValue2, (LPVOID *) &pValue2));
+    ToRelease<ICorDebugType> pType;
+    IfFailRet(pValue2->GetExactType(&pType));
+    if (!pType)
+        return E_FAIL;
+    CorElementType corType;
+    IfFailRet(pType->GetType(&corType));
+    if (corType != ELEMENT_TYPE_CLASS && corType != ELEMENT_TYPE_GENERICINST)
+        return S_OK;
+    ToRelease<ICorDebugClass> pClass;
+    IfFailRet(pType->GetClass(&pClass));
+    ToRelease<ICorDebugModule> pModule;
+    IfFailRet(pClass->GetModule(&pModule));
+    mdTypeDef typeDef;
+    IfFailRet(pClass->GetToken(&typeDef));
+    std::shared_ptr<const TypeLayoutCache::MembersLayout> layout;
+    IfFailRet(typeLayoutCache.GetMembersLayout(pModule, typeDef, layout));
+
+    WCHAR name[mdNameLen];
+    ULONG nameLen;
+    IfFailRet(layout->pMD->GetTypeDefProps(typeDef, name, _countof(name), &nameLen, nullptr, nullptr));
+
+    auto hasFields = [&](std::initializer_list<const char*> fieldNames)
+    {
+        for (const char *fieldName : fieldNames)
+        {
+            if (std::none_of(layout->fields.begin(), layout->fields.end(), [&](const TypeLayoutCache::FieldLayout &field)
+                             { return !(field.attr & fdStatic) && field.name == fieldName; }))
+                return false;
+        }
+        return true;
+    };
+
+    if (str_equal(name, W("System.Collections.Generic.List`1")) && hasFields({"_items", "_size"}))
+        kind = CollectionKind::List;
+    else if (str_equal(name, W("System.Collections.Generic.Dictionary`2")) && hasFields({"_entries", "_count", "_freeCount"}))
+        kind = CollectionKind::Dictionary;
+
+    return S_OK;
+}
+
+// Same result as members count by WalkMembers(), but without members walk for arrays and already known types.
+HRESULT Variables::GetMembersCount(ICorDebugValue *pValue, MembersCount &count)
+{
+    std::lock_guard<std::recursive_mutex> lock(m_referencesMutex);
+
+    HRESULT Status;
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pDerefValue;
+    IfFailRet(DereferenceAndUnboxValue(pValue, &pDerefValue, &isNull));
+    CorElementType corType;
+    IfFailRet(pValue->GetType(&corType));
+
+    // Note, null and pointers members count depend on value, not type.
+    if (isNull || !pDerefValue || corType == ELEMENT_TYPE_PTR)
+        return WalkMembersCount(m_sharedEvaluator.get(), pValue, count.numStatic, count.numInstance);
+
+    ToRelease<ICorDebugArrayValue> pArrayValue;
+    if (SUCCEEDED(pDerefValue->QueryInterface(IID_ICorDebugArrayValue, (LPVOID *) &pArrayValue)))
+    {
+        ULONG32 cElements = 0;
+        IfFailRet(pArrayValue->GetCount(&cElements));
+        count.numStatic = 0;
+        count.numInstance = (int)cElements;
+        count.collection = CollectionKind::Array;
+        return S_OK;
+    }
+
+    COR_TYPEID typeId;
+    ToRelease<ICorDebugValue2> pValue2;
+    ToRelease<ICorDebugType> pType;
+    ToRelease<ICorDebugType2> pType2;
+    bool haveTypeId = SUCCEEDED(pDerefValue->QueryInterface(IID_ICorDebugValue2, (LPVOID *) &pValue2)) &&
+                      SUCCEEDED(pValue2->GetExactType(&pType)) && pType &&
+                      SUCCEEDED(pType->QueryInterface(IID_ICorDebugType2, (LPVOID *) &pType2)) &&
+                      SUCCEEDED(pType2->GetTypeID(&typeId));
+    if (haveTypeId)
+    {
+        auto find = m_membersCountCache.find(typeId);
+        if (find != m_membersCountCache.end())
+        {
+            count = find->second;
+            return S_OK;
+        }
     }
 
+    IfFailRet(WalkMembersCount(m_sharedEvaluator.get(), pValue, count.numStatic, count.numInstance));
+    if (FAILED(GetCollectionKind(m_sharedEvaluator->GetTypeLayoutCache(), pDerefValue, count.collection)))
+        count.collection = CollectionKind::None;
+
+    if (haveTypeId)
+        m_membersCountCache.emplace(typeId, count);
+
+    return S_OK;
+}
+
+void Variables::GetNumChild(ICorDebugValue *pValue, int &numChild, bool static_members)
+{
+    numChild = 0;
+
+    MembersCount count;
+    if (pValue == nullptr || FAILED(GetMembersCount(pValue, count)))
+        return;
+
     if (static_members)
     {
-        numChild = numStatic;
+        numChild = count.numStatic;
     }
     else
     {
         // Note, "+1", since all static members will be "packed" into "Static members" entry
-        numChild = (numStatic > 0) ? numInstance + 1 : numInstance;
+        numChild = (count.numStatic > 0) ? count.numInstance + 1 : count.numInstance;
+        // Note, "+1" for "Results View" entry
+        if (count.collection == CollectionKind::List || count.collection == CollectionKind::Dictionary)
+            numChild++;
     }
 }
 
@@ -67,31 +262,33 @@ struct VariableMember
     std::string name;
     std::string ownerType;
     ToRelease<ICorDebugValue> value;
-    VariableMember(const std::string &name, const std::string& ownerType, ICorDebugValue *pValue) :
+    bool evalSkipped;
+    VariableMember(const std::string &name, const std::string& ownerType, ICorDebugValue *pValue, bool evalSkipped = false) :
         name(name),
         ownerType(ownerType),
-        value(pValue)
+        value(pValue),
+        evalSkipped(evalSkipped)
     {}
     VariableMember(VariableMember &&that) = default;
     VariableMember(const VariableMember &that) = delete;
 };
 
-static void FillValueAndType(VariableMember &member, Variable &var)
+static void FillValueAndType(VariableMember &member, Variable &var, bool hexFormat)
 {
     if (member.value == nullptr)
     {
-        var.value = "<error>";
+        var.value = member.evalSkipped ? "<evaluation skipped (slow)>" : "<error>";
         return;
     }
-    PrintValue(member.value, var.value, true);
+    PrintValue(member.value, var.value, true, g_listingMaxStringLength, hexFormat);
     TypePrinter::GetTypeOfValue(member.value, var.type);
 }
 
+// Note, walk stopped right after last member in [childStart, childEnd) range fetched.
 static HRESULT FetchFieldsAndProperties(Evaluator *pEvaluator, ICorDebugValue *pInputValue, ICorDebugThread *pThread,
                                         FrameLevel frameLevel, std::vector<VariableMember> &members, bool fetchOnlyStatic,
-                                        bool &hasStaticMembers, int childStart, int childEnd, int evalFlags)
+                                        int childStart, int childEnd, int evalFlags)
 {
-    hasStaticMembers = false;
     HRESULT Status;
 
     DWORD threadId = 0;
@@ -99,16 +296,14 @@ static HRESULT FetchFieldsAndProperties(Evaluator *pEvaluator, ICorDebugValue *p
 
     int currentIndex = -1;
 
-    IfFailRet(pEvaluator->WalkMembers(pInputValue, pThread, frameLevel, false, [&](
+    // Note, we use E_ABORT error code as fast way to exit from members walk routine here.
+    Status = pEvaluator->WalkMembers(pInputValue, pThread, frameLevel, false, [&](
         ICorDebugType *pType,
         bool is_static,
         const std::string &name,
         Evaluator::GetValueCallback getValue,
         Evaluator::SetterData*)
     {
-        if (is_static)
-            hasStaticMembers = true;
-
         bool addMember = fetchOnlyStatic ? is_static : !is_static;
         if (!addMember)
             return S_OK;
@@ -117,20 +312,210 @@ static HRESULT FetchFieldsAndProperties(Evaluator *pEvaluator, ICorDebugValue *p
         if (currentIndex < childStart)
             return S_OK;
         if (currentIndex >= childEnd)
-            return S_OK;
+            return E_ABORT;
 
         // Note, in this case error is not fatal, but if protocol side need cancel command execution, stop walk and return error to caller.
         ToRelease<ICorDebugValue> iCorResultValue;
-        if (getValue(&iCorResultValue, evalFlags) == COR_E_OPERATIONCANCELED)
+        HRESULT getStatus = getValue(&iCorResultValue, evalFlags);
+        if (getStatus == COR_E_OPERATIONCANCELED)
             return COR_E_OPERATIONCANCELED;
+        // Note, property getter could be skipped as slow (S_FALSE without value).
+        bool evalSkipped = getStatus == S_FALSE && iCorResultValue == nullptr;
 
         std::string className;
         if (pType)
             IfFailRet(TypePrinter::GetTypeOfValue(pType, className));
 
-        members.emplace_back(name, className, iCorResultValue.Detach());
+        members.emplace_back(name, className, iCorResultValue.Detach(), evalSkipped);
+        return currentIndex + 1 == childEnd ? E_ABORT : S_OK;
+    });
+
+    return Status == E_ABORT ? S_OK : Status;
+}
+
+// Note, only [childStart, childEnd) range elements fetched by position, without walk over all elements before range.
+static HRESULT GetArrayShape(ICorDebugArrayValue *pArrayValue, ULONG32 &cElements, std::vector<ULONG32> &dims, std::vector<ULONG32> &base)
+{
+    HRESULT Status;
+    ULONG32 nRank;
+    IfFailRet(pArrayValue->GetRank(&nRank));
+
+    IfFailRet(pArrayValue->GetCount(&cElements));
+
+    dims.assign(nRank, 0);
+    IfFailRet(pArrayValue->GetDimensions(nRank, &dims[0]));
+
+    base.assign(nRank, 0);
+    BOOL hasBaseIndicies = FALSE;
+    if (SUCCEEDED(pArrayValue->HasBaseIndicies(&hasBaseIndicies)) && hasBaseIndicies)
+        IfFailRet(pArrayValue->GetBaseIndicies(nRank, &base[0]));
+
+    return S_OK;
+}
+
+static HRESULT FetchArrayElements(ICorDebugValue *pInputValue, std::vector<VariableMember> &members, int childStart, int childEnd)
+{
+    HRESULT Status;
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, &isNull));
+    if (isNull || !pValue)
         return S_OK;
-    }));
+    ToRelease<ICorDebugArrayValue> pArrayValue;
+    IfFailRet(pValue->QueryInterface(IID_ICorDebugArrayValue, (LPVOID *) &pArrayValue));
+
+    ULONG32 cElements;
+    std::vector<ULONG32> dims;
+    std::vector<ULONG32> base;
+    IfFailRet(GetArrayShape(pArrayValue, cElements, dims, base));
+
+    ULONG32 end = std::min(cElements, (ULONG32)childEnd);
+    for (ULONG32 i = (ULONG32)childStart; i < end; ++i)
+    {
+        // Note, in this case error is not fatal, value will be shown as "<error>".
+        ToRelease<ICorDebugValue> pElementValue;
+        if (FAILED(pArrayValue->GetElementAtPosition(i, &pElementValue)))
+            pElementValue.Free();
+
+        members.emplace_back(Evaluator::GetArrayIndexName(i, dims, base), std::string(), pElementValue.Detach());
+    }
+
+    return S_OK;
+}
+
+static bool GetPrimitiveKind(CorElementType elemType, PrimitiveKind &kind)
+{
+    switch (elemType)
+    {
+        case ELEMENT_TYPE_BOOLEAN: kind = PrimitiveKind::Boolean; return true;
+        case ELEMENT_TYPE_I1:      kind = PrimitiveKind::SByte;   return true;
+        case ELEMENT_TYPE_U1:      kind = PrimitiveKind::Byte;    return true;
+        case ELEMENT_TYPE_I2:      kind = PrimitiveKind::Int16;   return true;
+        case ELEMENT_TYPE_U2:      kind = PrimitiveKind::UInt16;  return true;
+        case ELEMENT_TYPE_I4:      kind = PrimitiveKind::Int32;   return true;
+        case ELEMENT_TYPE_U4:      kind = PrimitiveKind::UInt32;  return true;
+        case ELEMENT_TYPE_I8:      kind = PrimitiveKind::Int64;   return true;
+        case ELEMENT_TYPE_U8:      kind = PrimitiveKind::UInt64;  return true;
+        case ELEMENT_TYPE_R4:      kind = PrimitiveKind::Single;  return true;
+        case ELEMENT_TYPE_R8:      kind = PrimitiveKind::Double;  return true;
+        // Note, char, native int and enum (value type) elements are printed by PrintValue() as usual.
+        default:                   return false;
+    }
+}
+
+// Read whole [start, start + count) window of primitive array elements by one ReadMemory() call and format it in bulk,
+// without ICorDebugValue creation and PrintValue() call for each element.
+// Return S_FALSE in case array elements can't be processed this way.
+static HRESULT GetPrimitiveArrayElements(ICorDebugValue *pInputValue, ICorDebugThread *pThread, const std::string &evaluateName,
+                                         int evalFlags, int start, int count, bool hexFormat, std::vector<Variable> &variables)
+{
+    HRESULT Status;
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, &isNull));
+    if (isNull || !pValue)
+        return S_FALSE;
+    ToRelease<ICorDebugArrayValue> pArrayValue;
+    if (FAILED(pValue->QueryInterface(IID_ICorDebugArrayValue, (LPVOID *) &pArrayValue)))
+        return S_FALSE;
+
+    CorElementType elemType;
+    IfFailRet(pArrayValue->GetElementType(&elemType));
+    PrimitiveKind kind;
+    if (!GetPrimitiveKind(elemType, kind))
+        return S_FALSE;
+
+    ULONG32 cElements;
+    std::vector<ULONG32> dims;
+    std::vector<ULONG32> base;
+    IfFailRet(GetArrayShape(pArrayValue, cElements, dims, base));
+
+    ULONG32 first = (ULONG32)std::max(0, start);
+    ULONG32 end = count <= 0 ? cElements : (ULONG32)std::min<int64_t>(cElements, (int64_t)first + count);
+    if (first >= end)
+        return S_OK;
+
+    // Note, array storage is contiguous (row-major for multidimensional arrays), so, position of element define its offset.
+    ToRelease<ICorDebugValue> pFirstElement;
+    IfFailRet(pArrayValue->GetElementAtPosition(first, &pFirstElement));
+    CORDB_ADDRESS address = 0;
+    if (FAILED(pFirstElement->GetAddress(&address)) || address == 0)
+        return S_FALSE;
+    std::string type;
+    IfFailRet(TypePrinter::GetTypeOfValue(pFirstElement, type));
+
+    ToRelease<ICorDebugProcess> pProcess;
+    IfFailRet(pThread->GetProcess(&pProcess));
+    size_t elementsCount = end - first;
+    std::vector<BYTE> data(elementsCount * GetPrimitiveSize(kind));
+    SIZE_T read = 0;
+    if (FAILED(pProcess->ReadMemory(address, (DWORD)data.size(), data.data(), &read)) || read != data.size())
+    {
+        LOGW("Can't read array storage at 0x%llx, fall back to per element read", (unsigned long long)address);
+        return S_FALSE;
+    }
+
+    std::vector<std::string> values;
+    FormatPrimitives(kind, data.data(), elementsCount, hexFormat, values);
+
+    variables.reserve(variables.size() + elementsCount);
+    for (size_t i = 0; i < elementsCount; i++)
+    {
+        Variable var(evalFlags);
+        var.name = Evaluator::GetArrayIndexName(first + (ULONG32)i, dims, base);
+        var.evaluateName = evaluateName + var.name;
+        var.value = std::move(values[i]);
+        var.type = type;
+        variables.push_back(std::move(var));
+    }
+
+    return S_OK;
+}
+
+// Print byte[] or sbyte[] storage as hex dump, read by one ReadMemory() call.
+// Return S_FALSE in case value is not one-dimensional byte array.
+static HRESULT PrintByteArrayHexDump(ICorDebugProcess *pProcess, ICorDebugValue *pInputValue, std::string &output)
+{
+    // Note, limit dump size, since it returned in one evaluation response.
+    static const ULONG32 MaxHexDumpSize = 4096;
+
+    HRESULT Status;
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pValue;
+    IfFailRet(DereferenceAndUnboxValue(pInputValue, &pValue, &isNull));
+    if (isNull || !pValue)
+        return S_FALSE;
+    ToRelease<ICorDebugArrayValue> pArrayValue;
+    if (FAILED(pValue->QueryInterface(IID_ICorDebugArrayValue, (LPVOID *) &pArrayValue)))
+        return S_FALSE;
+
+    CorElementType elemType;
+    ULONG32 nRank;
+    IfFailRet(pArrayValue->GetElementType(&elemType));
+    IfFailRet(pArrayValue->GetRank(&nRank));
+    if ((elemType != ELEMENT_TYPE_U1 && elemType != ELEMENT_TYPE_I1) || nRank != 1)
+        return S_FALSE;
+
+    ULONG32 cElements;
+    IfFailRet(pArrayValue->GetCount(&cElements));
+    output.clear();
+    if (cElements == 0)
+        return S_OK;
+
+    ToRelease<ICorDebugValue> pFirstElement;
+    IfFailRet(pArrayValue->GetElementAtPosition(0, &pFirstElement));
+    CORDB_ADDRESS address = 0;
+    if (FAILED(pFirstElement->GetAddress(&address)) || address == 0)
+        return S_FALSE;
+
+    std::vector<BYTE> data(std::min(cElements, MaxHexDumpSize));
+    SIZE_T read = 0;
+    if (FAILED(pProcess->ReadMemory(address, (DWORD)data.size(), data.data(), &read)) || read != data.size())
+        return S_FALSE;
+
+    FormatHexDump(data.data(), data.size(), output);
+    if (cElements > MaxHexDumpSize)
+        output.append("\n...");
 
     return S_OK;
 }
@@ -142,7 +527,7 @@ int Variables::GetNamedVariables(uint32_t variablesReference)
     auto it = m_references.find(variablesReference);
     if (it == m_references.end())
         return 0;
-    return it->second.namedVariables;
+    return it->second.namedVariables + it->second.indexedVariables;
 }
 
 // Caller should guarantee, that pProcess is not null.
@@ -152,7 +537,8 @@ HRESULT Variables::GetVariables(
     VariablesFilter filter,
     int start,
     int count,
-    std::vector<Variable> &variables)
+    std::vector<Variable> &variables,
+    bool hexFormat)
 {
     std::lock_guard<std::recursive_mutex> lock(m_referencesMutex);
 
@@ -168,19 +554,55 @@ HRESULT Variables::GetVariables(
     IfFailRet(pProcess->GetThread(int(ref.frameId.getThread()), &pThread));
 
     // Named and Indexed variables are in the same index (internally), Named variables go first
-    if (filter == VariablesNamed && (start + count > ref.namedVariables || count == 0))
-        count = ref.namedVariables - start;
+    if (filter == VariablesNamed)
+    {
+        if (start >= ref.namedVariables)
+            return S_OK;
+        if (start + count > ref.namedVariables || count == 0)
+            count = ref.namedVariables - start;
+    }
     if (filter == VariablesIndexed)
         start += ref.namedVariables;
 
+    TypeLayoutCache::Stats statsBefore = m_sharedEvaluator->GetTypeLayoutCache().GetStats();
+    EvalHelpers::TypeObjectCacheStats typeObjectsBefore = m_sharedEvalHelpers->GetTypeObjectCacheStats();
+    uint64_t namesHitsBefore = 0;
+    uint64_t namesMissesBefore = 0;
+    TypePrinter::GetNamesCacheStats(namesHitsBefore, namesMissesBefore);
+    EvalWaiter::RequestKindScope requestKindScope(EvalRequestKind::Locals);
+
     if (ref.IsScope())
     {
-        IfFailRet(GetStackVariables(ref.frameId, pThread, start, count, variables));
+        IfFailRet(GetStackVariables(ref.frameId, pThread, start, count, hexFormat, variables));
+    }
+    else if (ref.valueKind == ValueIsCollectionItems)
+    {
+        IfFailRet(GetCollectionItems(ref, start, count, hexFormat, variables));
     }
     else
     {
-        IfFailRet(GetChildren(ref, pThread, start, count, variables));
+        IfFailRet(GetChildren(ref, pThread, start, count, hexFormat, variables));
     }
+
+    TypeLayoutCache::Stats statsAfter = m_sharedEvaluator->GetTypeLayoutCache().GetStats();
+    EvalHelpers::TypeObjectCacheStats typeObjectsAfter = m_sharedEvalHelpers->GetTypeObjectCacheStats();
+    uint64_t namesHits = 0;
+    uint64_t namesMisses = 0;
+    TypePrinter::GetNamesCacheStats(namesHits, namesMisses);
+    LOGD("Variables request %u: type layouts hits %llu, misses %llu, metadata calls %llu, avoided metadata calls %llu; "
+         "type objects hits %llu, misses %llu, evictions %llu, no static members hits %llu; names hits %llu, misses %llu",
+         variablesReference,
+         (unsigned long long)(statsAfter.hits - statsBefore.hits),
+         (unsigned long long)(statsAfter.misses - statsBefore.misses),
+         (unsigned long long)(statsAfter.metadataCalls - statsBefore.metadataCalls),
+         (unsigned long long)(statsAfter.avoidedMetadataCalls - statsBefore.avoidedMetadataCalls),
+         (unsigned long long)(typeObjectsAfter.hits - typeObjectsBefore.hits),
+         (unsigned long long)(typeObjectsAfter.misses - typeObjectsBefore.misses),
+         (unsigned long long)(typeObjectsAfter.evictions - typeObjectsBefore.evictions),
+         (unsigned long long)(typeObjectsAfter.noStaticMembersHits - typeObjectsBefore.noStaticMembersHits),
+         (unsigned long long)(namesHits - namesHitsBefore),
+         (unsigned long long)(namesMisses - namesMissesBefore));
+
     return S_OK;
 }
 
@@ -192,11 +614,27 @@ HRESULT Variables::AddVariableReference(Variable &variable, FrameId frameId, ICo
         return E_FAIL;
 
     int numChild = 0;
-    GetNumChild(m_sharedEvaluator.get(), pValue, numChild, valueKind == ValueIsClass);
+    // Note, array elements and collection items are the only children in this case, so, all of them are indexed.
+    bool indexed = false;
+    if (valueKind == ValueIsCollectionItems)
+    {
+        GetCollectionItemsCount(pValue, numChild);
+        indexed = true;
+    }
+    else
+    {
+        GetNumChild(pValue, numChild, valueKind == ValueIsClass);
+        MembersCount membersCount;
+        indexed = valueKind == ValueIsVariable && numChild > 0 && SUCCEEDED(GetMembersCount(pValue, membersCount)) &&
+                  membersCount.collection == CollectionKind::Array;
+    }
     if (numChild == 0)
         return S_OK;
 
-    variable.namedVariables = numChild;
+    if (indexed)
+        variable.indexedVariables = numChild;
+    else
+        variable.namedVariables = numChild;
     variable.variablesReference = (uint32_t)m_references.size() + 1;
     pValue->AddRef();
     VariableReference variableReference(variable, frameId, pValue, valueKind);
@@ -228,6 +666,7 @@ HRESULT Variables::GetStackVariables(
     ICorDebugThread *pThread,
     int start,
     int count,
+    bool hexFormat,
     std::vector<Variable> &variables)
 {
     HRESULT Status;
@@ -254,7 +693,7 @@ HRESULT Variables::GetStackVariables(
         var.evaluateName = var.name;
         ToRelease<ICorDebugValue> iCorValue;
         IfFailRet(getValue(&iCorValue, var.evalFlags));
-        IfFailRet(PrintValue(iCorValue, var.value));
+        IfFailRet(PrintValue(iCorValue, var.value, true, g_listingMaxStringLength, hexFormat));
         IfFailRet(TypePrinter::GetTypeOfValue(iCorValue, var.type));
         IfFailRet(AddVariableReference(var, frameId, iCorValue, ValueIsVariable));
         variables.push_back(var);
@@ -325,6 +764,7 @@ HRESULT Variables::GetChildren(
     ICorDebugThread *pThread,
     int start,
     int count,
+    bool hexFormat,
     std::vector<Variable> &variables)
 {
     if (ref.IsScope())
@@ -335,11 +775,28 @@ HRESULT Variables::GetChildren(
 
     HRESULT Status;
     std::vector<VariableMember> members;
-    bool hasStaticMembers = false;
 
-    IfFailRet(FetchFieldsAndProperties(m_sharedEvaluator.get(), ref.iCorValue, pThread, ref.frameId.getLevel(),
-                                       members, ref.valueKind == ValueIsClass, hasStaticMembers, start,
-                                       count == 0 ? INT_MAX : start + count, ref.evalFlags));
+    // Note, members count for this type is cached already (see AddVariableReference()), so, no extra members walk here.
+    MembersCount membersCount;
+    IfFailRet(GetMembersCount(ref.iCorValue, membersCount));
+    bool hasStaticMembers = membersCount.numStatic > 0;
+
+    auto inRange = [&](int index) { return index >= start && (count == 0 || index < start + count); };
+
+    if (membersCount.collection == CollectionKind::Array)
+    {
+        IfFailRet(GetPrimitiveArrayElements(ref.iCorValue, pThread, ref.evaluateName, ref.evalFlags, start, count, hexFormat, variables));
+        if (Status == S_OK)
+            return S_OK;
+
+        IfFailRet(FetchArrayElements(ref.iCorValue, members, start, count == 0 ? INT_MAX : start + count));
+    }
+    else
+    {
+        IfFailRet(FetchFieldsAndProperties(m_sharedEvaluator.get(), ref.iCorValue, pThread, ref.frameId.getLevel(),
+                                           members, ref.valueKind == ValueIsClass, start,
+                                           count == 0 ? INT_MAX : start + count, ref.evalFlags));
+    }
 
     FixupInheritedFieldNames(members);
 
@@ -350,15 +807,14 @@ HRESULT Variables::GetChildren(
         bool isIndex = !it.name.empty() && it.name.at(0) == '[';
         if (var.name.find('(') == std::string::npos) // expression evaluator does not support typecasts
             var.evaluateName = ref.evaluateName + (isIndex ? "" : ".") + var.name;
-        FillValueAndType(it, var);
+        FillValueAndType(it, var, hexFormat);
         IfFailRet(AddVariableReference(var, ref.frameId, it.value, ValueIsVariable));
         variables.push_back(var);
     }
 
     if (ref.valueKind == ValueIsVariable && hasStaticMembers)
     {
-        bool staticsInRange = start < ref.namedVariables && (count == 0 || start + count >= ref.namedVariables);
-        if (staticsInRange)
+        if (inRange(membersCount.numInstance))
         {
             ToRelease<ICorDebugValue2> pValue2;
             IfFailRet(ref.iCorValue->QueryInterface(IID_ICorDebugValue2, (LPVOID *) &pValue2));
@@ -376,6 +832,213 @@ HRESULT Variables::GetChildren(
         }
     }
 
+    if (ref.valueKind == ValueIsVariable &&
+        (membersCount.collection == CollectionKind::List || membersCount.collection == CollectionKind::Dictionary))
+    {
+        if (inRange(membersCount.numInstance + (hasStaticMembers ? 1 : 0)))
+        {
+            Variable var(ref.evalFlags);
+            var.name = "Results View";
+            var.evaluateName = ref.evaluateName; // items evaluate names are collection's indexer calls
+            IfFailRet(AddVariableReference(var, ref.frameId, ref.iCorValue, ValueIsCollectionItems));
+            variables.push_back(var);
+        }
+    }
+
+    return S_OK;
+}
+
+HRESULT Variables::GetCollectionItemsCount(ICorDebugValue *pValue, int &itemsCount)
+{
+    itemsCount = 0;
+
+    HRESULT Status;
+    MembersCount membersCount;
+    IfFailRet(GetMembersCount(pValue, membersCount));
+
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pDerefValue;
+    IfFailRet(DereferenceAndUnboxValue(pValue, &pDerefValue, &isNull));
+    if (isNull || !pDerefValue)
+        return S_OK;
+
+    TypeLayoutCache &typeLayoutCache = m_sharedEvaluator->GetTypeLayoutCache();
+    if (membersCount.collection == CollectionKind::List)
+    {
+        IfFailRet(GetInt32FieldValue(typeLayoutCache, pDerefValue, "_size", itemsCount));
+    }
+    else if (membersCount.collection == CollectionKind::Dictionary)
+    {
+        int32_t entriesCount = 0;
+        int32_t freeCount = 0;
+        IfFailRet(GetInt32FieldValue(typeLayoutCache, pDerefValue, "_count", entriesCount));
+        IfFailRet(GetInt32FieldValue(typeLayoutCache, pDerefValue, "_freeCount", freeCount));
+        itemsCount = entriesCount - freeCount;
+    }
+
+    if (itemsCount < 0)
+        itemsCount = 0;
+
+    return S_OK;
+}
+
+// Dictionary key as expression for indexer (evaluateName), literal for primitive and string keys only.
+// Note, enum, floating point and object keys can't be represented by literal, `false` returned in this case.
+static bool GetKeyExpression(ICorDebugValue *pKey, std::string &expression)
+{
+    static const std::unordered_set<std::string> literalTypes{
+        "bool", "sbyte", "byte", "short", "ushort", "int", "uint", "long", "ulong", "char", "string"};
+
+    std::string typeName;
+    if (FAILED(TypePrinter::GetTypeOfValue(pKey, typeName)) ||
+        literalTypes.find(typeName) == literalTypes.end() ||
+        FAILED(PrintValue(pKey, expression)))
+        return false;
+
+    if (typeName == "char")
+    {
+        // Char printed as `65 'A'`, use escaped char literal part only.
+        std::size_t pos = expression.find(' ');
+        if (pos == std::string::npos)
+            return false;
+        expression.erase(0, pos + 1);
+    }
+    return true;
+}
+
+// Read [start, start + count) items of List<T> or Dictionary<TKey,TValue> directly from backing array, without func-eval.
+HRESULT Variables::GetCollectionItems(
+    VariableReference &ref,
+    int start,
+    int count,
+    bool hexFormat,
+    std::vector<Variable> &variables)
+{
+    if (!ref.iCorValue)
+        return S_OK;
+
+    HRESULT Status;
+    MembersCount membersCount;
+    IfFailRet(GetMembersCount(ref.iCorValue, membersCount));
+
+    BOOL isNull = FALSE;
+    ToRelease<ICorDebugValue> pDerefValue;
+    IfFailRet(DereferenceAndUnboxValue(ref.iCorValue, &pDerefValue, &isNull));
+    if (isNull || !pDerefValue)
+        return S_OK;
+
+    // Note, collection could be changed by func-eval after reference creation, actual items count used.
+    int itemsCount = 0;
+    IfFailRet(GetCollectionItemsCount(ref.iCorValue, itemsCount));
+    int end = (count == 0 || count > itemsCount - start) ? itemsCount : start + count;
+    if (start >= end)
+        return S_OK;
+
+    TypeLayoutCache &typeLayoutCache = m_sharedEvaluator->GetTypeLayoutCache();
+
+    if (membersCount.collection == CollectionKind::List)
+    {
+        ToRelease<ICorDebugArrayValue> pItems;
+        IfFailRet(GetArrayFieldValue(typeLayoutCache, pDerefValue, "_items", &pItems));
+
+        for (int i = start; i < end; i++)
+        {
+            VariableMember member("[" + std::to_string(i) + "]", std::string(), nullptr);
+            if (FAILED(pItems->GetElementAtPosition(i, &member.value)))
+                member.value.Free();
+
+            Variable var(ref.evalFlags);
+            var.name = member.name;
+            var.evaluateName = ref.evaluateName + var.name;
+            FillValueAndType(member, var, hexFormat);
+            IfFailRet(AddVariableReference(var, ref.frameId, member.value, ValueIsVariable));
+            variables.push_back(var);
+        }
+        return S_OK;
+    }
+
+    if (membersCount.collection != CollectionKind::Dictionary)
+        return E_FAIL;
+
+    ToRelease<ICorDebugArrayValue> pEntries;
+    IfFailRet(GetArrayFieldValue(typeLayoutCache, pDerefValue, "_entries", &pEntries));
+    int32_t entriesCount = 0;
+    int32_t freeCount = 0;
+    IfFailRet(GetInt32FieldValue(typeLayoutCache, pDerefValue, "_count", entriesCount));
+    IfFailRet(GetInt32FieldValue(typeLayoutCache, pDerefValue, "_freeCount", freeCount));
+
+    // Note, entry's fields tokens are same for all entries, resolve them by first entry.
+    // Note, .NET Core 3.x mark removed entries by `hashCode` -1 (int field), .NET 5+ by `next` less than -1
+    // (`hashCode` is uint field here and not changed at remove).
+    ToRelease<ICorDebugClass> pEntryClass;
+    mdFieldDef nextField, keyField, valueField, hashCodeField = mdFieldDefNil;
+    bool freeByHashCode = false;
+    {
+        ToRelease<ICorDebugValue> pEntry;
+        IfFailRet(pEntries->GetElementAtPosition(0, &pEntry));
+        IfFailRet(FindInstanceField(typeLayoutCache, pEntry, "next", &pEntryClass, nextField));
+        pEntryClass.Free();
+        IfFailRet(FindInstanceField(typeLayoutCache, pEntry, "key", &pEntryClass, keyField));
+        pEntryClass.Free();
+        ToRelease<ICorDebugValue> pHashCode;
+        CorElementType hashCodeType;
+        freeByHashCode = SUCCEEDED(GetInstanceFieldValue(typeLayoutCache, pEntry, "hashCode", &pHashCode)) &&
+                         SUCCEEDED(pHashCode->GetType(&hashCodeType)) && hashCodeType == ELEMENT_TYPE_I4 &&
+                         SUCCEEDED(FindInstanceField(typeLayoutCache, pEntry, "hashCode", &pEntryClass, hashCodeField));
+        pEntryClass.Free();
+        IfFailRet(FindInstanceField(typeLayoutCache, pEntry, "value", &pEntryClass, valueField));
+    }
+
+    auto getEntryField = [&](ICorDebugValue *pEntry, mdFieldDef fieldDef, ICorDebugValue **ppResultValue) -> HRESULT
+    {
+        ToRelease<ICorDebugObjectValue> pObjValue;
+        IfFailRet(pEntry->QueryInterface(IID_ICorDebugObjectValue, (LPVOID*) &pObjValue));
+        return pObjValue->GetFieldValue(pEntryClass, fieldDef, ppResultValue);
+    };
+
+    // Note, in case of no removed entries (free list), item position is entry position, in another case entries before
+    // requested range must be checked.
+    int itemIndex = 0;
+    for (int32_t entryIndex = freeCount == 0 ? start : 0; entryIndex < entriesCount && itemIndex < end; entryIndex++)
+    {
+        ToRelease<ICorDebugValue> pEntry;
+        IfFailRet(pEntries->GetElementAtPosition(entryIndex, &pEntry));
+
+        if (freeCount != 0)
+        {
+            ToRelease<ICorDebugValue> pFreeMark;
+            int32_t freeMark = 0;
+            IfFailRet(getEntryField(pEntry, freeByHashCode ? hashCodeField : nextField, &pFreeMark));
+            IfFailRet(GetInt32Value(pFreeMark, freeMark));
+            if (freeByHashCode ? freeMark < 0 : freeMark < -1)
+                continue;
+
+            if (itemIndex++ < start)
+                continue;
+        }
+        else
+            itemIndex = entryIndex + 1;
+
+        ToRelease<ICorDebugValue> pKey;
+        IfFailRet(getEntryField(pEntry, keyField, &pKey));
+        std::string key;
+        IfFailRet(PrintValue(pKey, key, true, g_listingMaxStringLength));
+
+        VariableMember member("[" + key + "]", std::string(), nullptr);
+        if (FAILED(getEntryField(pEntry, valueField, &member.value)))
+            member.value.Free();
+
+        Variable var(ref.evalFlags);
+        var.name = member.name;
+        // Note, printed key could be truncated or not valid expression, evaluateName left empty in this case.
+        std::string keyExpression;
+        if (GetKeyExpression(pKey, keyExpression))
+            var.evaluateName = ref.evaluateName + "[" + keyExpression + "]";
+        FillValueAndType(member, var, hexFormat);
+        IfFailRet(AddVariableReference(var, ref.frameId, member.value, ValueIsVariable));
+        variables.push_back(var);
+    }
+
     return S_OK;
 }
 
@@ -394,16 +1057,52 @@ HRESULT Variables::Evaluate(
     ToRelease<ICorDebugThread> pThread;
     IfFailRet(pProcess->GetThread(int(threadId), &pThread));
 
+    EvalWaiter::RequestKindScope requestKindScope(variable.evalRequest);
     ToRelease<ICorDebugValue> pResultValue;
     FrameLevel frameLevel = frameId.getLevel();
     IfFailRet(m_sharedEvalStackMachine->EvaluateExpression(pThread, frameLevel, variable.evalFlags, expression, &pResultValue, output, &variable.editable));
 
     variable.evaluateName = expression;
-    IfFailRet(PrintValue(pResultValue, variable.value));
+    if (variable.stringStart != 0 || variable.stringCount != 0)
+    {
+        BOOL isNull = TRUE;
+        ToRelease<ICorDebugValue> pValue;
+        CorElementType elemType = ELEMENT_TYPE_END;
+        if (SUCCEEDED(DereferenceAndUnboxValue(pResultValue, &pValue, &isNull)) && !isNull &&
+            SUCCEEDED(pValue->GetType(&elemType)) && elemType == ELEMENT_TYPE_STRING)
+        {
+            ULONG32 cchValue = 0;
+            IfFailRet(PrintStringValueRange(pValue, ULONG32(std::max(0, variable.stringStart)), ULONG32(std::max(0, variable.stringCount)),
+                                            variable.value, &cchValue, pProcess));
+            variable.stringLength = int(cchValue);
+            IfFailRet(TypePrinter::GetTypeOfValue(pResultValue, variable.type));
+            return AddVariableReference(variable, frameId, pResultValue, ValueIsVariable);
+        }
+    }
+    if (variable.hexFormat)
+    {
+        IfFailRet(PrintByteArrayHexDump(pProcess, pResultValue, variable.value));
+        if (Status == S_OK)
+        {
+            IfFailRet(TypePrinter::GetTypeOfValue(pResultValue, variable.type));
+            return AddVariableReference(variable, frameId, pResultValue, ValueIsVariable);
+        }
+    }
+    IfFailRet(PrintValue(pResultValue, variable.value, true, 0, variable.hexFormat));
     IfFailRet(TypePrinter::GetTypeOfValue(pResultValue, variable.type));
     return AddVariableReference(variable, frameId, pResultValue, ValueIsVariable);
 }
 
+HRESULT Variables::EvaluateCondition(
+    ICorDebugThread *pThread,
+    const std::string &condition,
+    BreakpointUtils::CompiledCondition &compiledCondition,
+    bool &result)
+{
+    EvalWaiter::RequestKindScope requestKindScope(EvalRequestKind::Condition);
+    return compiledCondition.Evaluate(pThread, condition, m_sharedEvaluator.get(), m_sharedEvalStackMachine.get(), result);
+}
+
 HRESULT Variables::SetVariable(
     ICorDebugProcess *pProcess,
     const std::string &name,
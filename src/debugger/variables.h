@@ -9,6 +9,7 @@
 #include <mutex>
 #include <unordered_map>
 #include "interfaces/types.h"
+#include "debugger/evalutils.h"
 #include "utils/torelease.h"
 
 namespace netcoredbg
@@ -18,6 +19,12 @@ class Evaluator;
 class EvalHelpers;
 class EvalWaiter;
 class EvalStackMachine;
+class TypeLayoutCache;
+
+namespace BreakpointUtils
+{
+    class CompiledCondition;
+}
 
 class Variables
 {
@@ -31,6 +38,7 @@ public:
         m_sharedEvalStackMachine(sharedEvalStackMachine)
     {}
 
+    // Note, return all (named and indexed) children count.
     int GetNamedVariables(uint32_t variablesReference);
 
     HRESULT GetVariables(
@@ -39,7 +47,8 @@ public:
         VariablesFilter filter,
         int start,
         int count,
-        std::vector<Variable> &variables);
+        std::vector<Variable> &variables,
+        bool hexFormat = false);
 
     HRESULT SetVariable(
         ICorDebugProcess *pProcess,
@@ -68,6 +77,13 @@ public:
         Variable &variable,
         std::string &output);
 
+    // Evaluate breakpoint's condition at top frame, compiled condition data reused between calls.
+    HRESULT EvaluateCondition(
+        ICorDebugThread *pThread,
+        const std::string &condition,
+        BreakpointUtils::CompiledCondition &compiledCondition,
+        bool &result);
+
     HRESULT GetExceptionVariable(
         FrameId frameId,
         ICorDebugThread *pThread,
@@ -77,6 +93,7 @@ public:
     {
         m_referencesMutex.lock();
         m_references.clear();
+        m_membersCountCache.clear();
         m_referencesMutex.unlock();
     }
 
@@ -86,7 +103,8 @@ private:
     {
         ValueIsScope,
         ValueIsClass,
-        ValueIsVariable
+        ValueIsVariable,
+        ValueIsCollectionItems // "Results View" of List<T> or Dictionary<TKey,TValue>, items read from backing array
     };
 
     struct VariableReference
@@ -136,6 +154,33 @@ private:
     std::recursive_mutex m_referencesMutex;
     std::unordered_map<uint32_t, VariableReference> m_references;
 
+    // Collections with children paging by position, without members walk and func-eval.
+    enum class CollectionKind
+    {
+        None,
+        Array,     // elements are instance members
+        List,      // System.Collections.Generic.List<T>, items provided by "Results View" child
+        Dictionary // System.Collections.Generic.Dictionary<TKey,TValue>, items provided by "Results View" child
+    };
+
+    struct MembersCount
+    {
+        int numStatic;
+        int numInstance;
+        CollectionKind collection;
+
+        MembersCount() : numStatic(0), numInstance(0), collection(CollectionKind::None) {}
+    };
+
+    // Members count by exact type, protected by m_referencesMutex. Aimed to prevent members walk (metadata enumeration)
+    // for each child during children fetch, since each child with same type have same members count.
+    // Note, cleared at Clear() call, since type's members could be changed by Hot Reload.
+    std::unordered_map<COR_TYPEID, MembersCount, EvalUtils::TypeIdHash, EvalUtils::TypeIdEqual> m_membersCountCache;
+
+    static HRESULT GetCollectionKind(TypeLayoutCache &typeLayoutCache, ICorDebugValue *pValue, CollectionKind &kind);
+    HRESULT GetMembersCount(ICorDebugValue *pValue, MembersCount &count);
+    void GetNumChild(ICorDebugValue *pValue, int &numChild, bool static_members);
+
     HRESULT AddVariableReference(Variable &variable, FrameId frameId, ICorDebugValue *pValue, ValueKind valueKind);
 
     HRESULT GetStackVariables(
@@ -143,6 +188,7 @@ private:
         ICorDebugThread *pThread,
         int start,
         int count,
+        bool hexFormat,
         std::vector<Variable> &variables);
 
     HRESULT GetChildren(
@@ -150,6 +196,16 @@ private:
         ICorDebugThread *pThread,
         int start,
         int count,
+        bool hexFormat,
+        std::vector<Variable> &variables);
+
+    HRESULT GetCollectionItemsCount(ICorDebugValue *pValue, int &itemsCount);
+
+    HRESULT GetCollectionItems(
+        VariableReference &ref,
+        int start,
+        int count,
+        bool hexFormat,
         std::vector<Variable> &variables);
 
     HRESULT SetStackVariable(
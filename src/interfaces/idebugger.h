@@ -69,6 +69,8 @@ public:
     virtual void SetStepFiltering(bool enable) = 0;
     virtual bool IsHotReload() const = 0;
     virtual HRESULT SetHotReload(bool enable) = 0;
+    virtual EvalTimeouts GetEvalTimeouts() = 0;
+    virtual void SetEvalTimeouts(const EvalTimeouts &evalTimeouts) = 0;
 #ifdef INTEROP_DEBUGGING
     virtual void SetInteropDebugging(bool enable) = 0;
 #endif
@@ -92,7 +94,7 @@ public:
     virtual HRESULT GetStackTrace(ThreadId threadId, FrameLevel startFrame, unsigned maxFrames, std::vector<StackFrame> &stackFrames, int &totalFrames, bool hotReloadAwareCaller = false) = 0;
     virtual HRESULT StepCommand(ThreadId threadId, StepType stepType) = 0;
     virtual HRESULT GetScopes(FrameId frameId, std::vector<Scope> &scopes) = 0;
-    virtual HRESULT GetVariables(uint32_t variablesReference, VariablesFilter filter, int start, int count, std::vector<Variable> &variables) = 0;
+    virtual HRESULT GetVariables(uint32_t variablesReference, VariablesFilter filter, int start, int count, std::vector<Variable> &variables, bool hexFormat = false) = 0;
     virtual int GetNamedVariables(uint32_t variablesReference) = 0;
     virtual HRESULT Evaluate(FrameId frameId, const std::string &expression, Variable &variable, std::string &output) = 0;
     virtual void CancelEvalRunning() = 0;
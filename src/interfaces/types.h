@@ -374,7 +374,7 @@ struct Scope
     int indexedVariables;
     bool expensive;
 
-    Scope() : variablesReference(0), namedVariables(0), expensive(false) {}
+    Scope() : variablesReference(0), namedVariables(0), indexedVariables(0), expensive(false) {}
 
     Scope(uint32_t variablesReference, const std::string &name, int namedVariables) :
         name(name),
@@ -406,6 +406,30 @@ enum enum_EVALFLAGS {
 
 #define defaultEvalFlags 0
 
+// Evaluation request classes, each class have own evaluation timeout.
+enum class EvalRequestKind
+{
+    Locals,    // variables listing, implicit properties getters calls
+    Watch,     // watch, repl and other explicit expressions evaluation
+    Condition, // breakpoints conditions
+    Hover      // hover expressions evaluation
+};
+
+struct EvalTimeouts
+{
+    // Evaluation timeouts (in milliseconds) for each request class.
+    int locals;
+    int watch;
+    int condition;
+    int hover;
+    // Time (in milliseconds) for evaluation abort, after evaluation timeout.
+    int abort;
+    // Functions evaluated longer than threshold (in milliseconds) are skipped in variables listing, 0 disable skip.
+    int slowGetterThreshold;
+
+    EvalTimeouts() : locals(5000), watch(5000), condition(5000), hover(5000), abort(5000), slowGetterThreshold(1000) {}
+};
+
 struct Variable
 {
     std::string name;
@@ -418,8 +442,19 @@ struct Variable
     int indexedVariables;
     int evalFlags;
     bool editable;
-
-    Variable(int flags = defaultEvalFlags) : variablesReference(0), namedVariables(0), indexedVariables(0), evalFlags(flags), editable(false) {}
+    // String value range request for evaluation (in UTF-16 code units), `stringCount` 0 means whole string.
+    // Note, `value` for range provided without quotes and escaping, `stringLength` provide full string length.
+    int stringStart;
+    int stringCount;
+    int stringLength; // -1 for non string values
+    // Hex format request for evaluation, integral values printed in hex, byte array `value` provided as hex dump.
+    bool hexFormat;
+    // Evaluation request class, define evaluation timeout.
+    EvalRequestKind evalRequest;
+
+    Variable(int flags = defaultEvalFlags) : variablesReference(0), namedVariables(0), indexedVariables(0), evalFlags(flags), editable(false),
+                                             stringStart(0), stringCount(0), stringLength(-1), hexFormat(false),
+                                             evalRequest(EvalRequestKind::Watch) {}
 };
 
 enum VariablesFilter
@@ -74,6 +74,17 @@ static void print_help()
         "                                      TCP %i will be used.\n"
         "--log[=<type>]                        Enable logging. Supported logging to file and to dlog (only for Tizen)\n"
         "                                      File log by default. File is created in 'current' folder.\n"
+        "--sources-cache=<path>                Store methods ranges data loaded from PDB files in specified directory\n"
+        "                                      and reuse it for same modules in next debug sessions.\n"
+        "--type-object-cache-size=<count>      Max count of type objects, cached for static members evaluation\n"
+        "                                      (100 by default, 256 max).\n"
+        "--eval-timeout-locals=<ms>            Evaluation timeout for properties getters in variables listing.\n"
+        "--eval-timeout-watch=<ms>             Evaluation timeout for watch and other explicit expressions.\n"
+        "--eval-timeout-condition=<ms>         Evaluation timeout for breakpoints conditions.\n"
+        "--eval-timeout-hover=<ms>             Evaluation timeout for hover expressions.\n"
+        "--eval-timeout-abort=<ms>             Time for evaluation abort after evaluation timeout.\n"
+        "--slow-getter-threshold=<ms>          Skip in variables listing properties getters, that were evaluated\n"
+        "                                      longer than threshold. 0 disable skip.\n"
         "--version                             Displays the current version.\n",
         (int)DEFAULT_SERVER_PORT
     );
@@ -266,6 +277,21 @@ int
     bool needInteropDebugging = false;
     bool run = false;
 
+    EvalTimeouts evalTimeouts;
+    // Note, 0 is allowed only for options, where it means "disabled" (zero timeout makes all evaluations fail).
+    auto ParseMilliseconds = [&](int i, const char *option, int &value, bool allowZero = false)
+    {
+        const char *str = argv[i] + strlen(option);
+        char *err;
+        unsigned long ms = strtoul(str, &err, 10);
+        if (*str == 0 || *err != 0 || ms > INT_MAX || (ms == 0 && !allowZero))
+        {
+            fprintf(stderr, "Error: Wrong milliseconds value in %s\n", argv[i]);
+            exit(EXIT_FAILURE);
+        }
+        value = static_cast<int>(ms);
+    };
+
     std::unordered_map<std::string, std::function<void(int& i)>> entireArguments
     {
         {"--attach", [&](int& i){
@@ -412,6 +438,46 @@ int
 
             setenv("LOG_OUTPUT", *argv + strlen("--log="), 1);
 
+        } },
+        { "--sources-cache=", [&](int& i){
+
+            setenv("NETCOREDBG_SOURCES_CACHE", argv[i] + strlen("--sources-cache="), 1);
+
+        } },
+        { "--type-object-cache-size=", [&](int& i){
+
+            setenv("NETCOREDBG_TYPE_OBJECT_CACHE_SIZE", argv[i] + strlen("--type-object-cache-size="), 1);
+
+        } },
+        { "--eval-timeout-locals=", [&](int& i){
+
+            ParseMilliseconds(i, "--eval-timeout-locals=", evalTimeouts.locals);
+
+        } },
+        { "--eval-timeout-watch=", [&](int& i){
+
+            ParseMilliseconds(i, "--eval-timeout-watch=", evalTimeouts.watch);
+
+        } },
+        { "--eval-timeout-condition=", [&](int& i){
+
+            ParseMilliseconds(i, "--eval-timeout-condition=", evalTimeouts.condition);
+
+        } },
+        { "--eval-timeout-hover=", [&](int& i){
+
+            ParseMilliseconds(i, "--eval-timeout-hover=", evalTimeouts.hover);
+
+        } },
+        { "--eval-timeout-abort=", [&](int& i){
+
+            ParseMilliseconds(i, "--eval-timeout-abort=", evalTimeouts.abort);
+
+        } },
+        { "--slow-getter-threshold=", [&](int& i){
+
+            ParseMilliseconds(i, "--slow-getter-threshold=", evalTimeouts.slowGetterThreshold, true);
+
         } },
         { "--server=", [&](int& i){
 
@@ -473,6 +539,15 @@ int
     }
 
     protocol->SetDebugger(debugger);
+    // Note, debugger hold managed part related objects (compiled stack machine programs, symbol readers),
+    // that must be released before Interop::Shutdown() call.
+    auto shutdown = [&]()
+    {
+        debugger.reset();
+        protocol->SetDebugger(debugger);
+        Interop::Shutdown();
+    };
+    debugger->SetEvalTimeouts(evalTimeouts);
     if (needHotReload)
     {
         if (pidDebuggee == 0)
@@ -495,13 +570,13 @@ int
     if (pidDebuggee != 0 && FAILED(Status = AttachToExistingProcess(debugger.get(), pidDebuggee)))
     {
         fprintf(stderr, "Error: 0x%x Failed to attach to %i\n", Status, pidDebuggee);
-        Interop::Shutdown();
+        shutdown();
         return EXIT_FAILURE;
     }
     else if (run && FAILED(Status = LaunchNewProcess(debugger.get(), execFile, execArgs)))
     {
         fprintf(stderr, "Error: %#x %s\n", Status, errormessage(Status));
-        Interop::Shutdown();
+        shutdown();
         return EXIT_FAILURE;
     }
 
@@ -524,6 +599,6 @@ int
     }
 
     protocol->CommandLoop();
-    Interop::Shutdown();
+    shutdown();
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -1492,6 +1492,56 @@ namespace NetCoreDbg
             return RetCode.OK;
         }
 
+        /// <summary>
+        /// Get all documents (source files) paths.
+        /// </summary>
+        /// <param name="symbolReaderHandle">symbol reader handle returned by LoadSymbolsForModule</param>
+        /// <param name="count">documents count</param>
+        /// <param name="data">pointer to memory with BSTR array</param>
+        /// <returns>"Ok" if information is available</returns>
+        internal static RetCode GetModuleDocuments(IntPtr symbolReaderHandle, out int count, out IntPtr data)
+        {
+            Debug.Assert(symbolReaderHandle != IntPtr.Zero);
+            count = 0;
+            data = IntPtr.Zero;
+            var unmanagedBSTRList = new List<IntPtr>();
+
+            try
+            {
+                GCHandle gch = GCHandle.FromIntPtr(symbolReaderHandle);
+                MetadataReader reader = ((OpenedReader)gch.Target).Reader;
+
+                foreach (var handle in reader.Documents)
+                {
+                    unmanagedBSTRList.Add(Marshal.StringToBSTR(reader.GetString(reader.GetDocument(handle).Name)));
+                }
+
+                if (unmanagedBSTRList.Count == 0)
+                    return RetCode.OK;
+
+                data = Marshal.AllocCoTaskMem(unmanagedBSTRList.Count * IntPtr.Size);
+                for (int i = 0; i < unmanagedBSTRList.Count; i++)
+                {
+                    Marshal.WriteIntPtr(data, i * IntPtr.Size, unmanagedBSTRList[i]);
+                }
+                count = unmanagedBSTRList.Count;
+            }
+            catch
+            {
+                if (data != IntPtr.Zero)
+                    Marshal.FreeCoTaskMem(data);
+                foreach (var p in unmanagedBSTRList)
+                {
+                    Marshal.FreeBSTR(p);
+                }
+                data = IntPtr.Zero;
+                count = 0;
+                return RetCode.Exception;
+            }
+
+            return RetCode.OK;
+        }
+
         /// <summary>
         /// Get Source Code.
         /// </summary>
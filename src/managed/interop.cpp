@@ -68,6 +68,7 @@ typedef  RetCode (*GetModuleMethodsRangesDelegate)(PVOID, uint32_t, PVOID, uint3
 typedef  RetCode (*ResolveBreakPointsDelegate)(PVOID[], int32_t, PVOID, int32_t, int32_t, int32_t*, const WCHAR*, PVOID*);
 typedef  RetCode (*GetAsyncMethodSteppingInfoDelegate)(PVOID, mdMethodDef, PVOID*, int32_t*, uint32_t*);
 typedef  RetCode (*GetSourceDelegate)(PVOID, const WCHAR*, int32_t*, PVOID*);
+typedef  RetCode (*GetModuleDocumentsDelegate)(PVOID, int32_t*, PVOID*);
 typedef  PVOID (*LoadDeltaPdbDelegate)(const WCHAR*, PVOID*, int32_t*);
 typedef  RetCode (*CalculationDelegate)(PVOID, int32_t, PVOID, int32_t, int32_t, int32_t*, PVOID*, BSTR*);
 typedef  int (*GenerateStackMachineProgramDelegate)(const WCHAR*, PVOID*, BSTR*);
@@ -91,6 +92,7 @@ GetModuleMethodsRangesDelegate getModuleMethodsRangesDelegate = nullptr;
 ResolveBreakPointsDelegate resolveBreakPointsDelegate = nullptr;
 GetAsyncMethodSteppingInfoDelegate getAsyncMethodSteppingInfoDelegate = nullptr;
 GetSourceDelegate getSourceDelegate = nullptr;
+GetModuleDocumentsDelegate getModuleDocumentsDelegate = nullptr;
 LoadDeltaPdbDelegate loadDeltaPdbDelegate = nullptr;
 GenerateStackMachineProgramDelegate generateStackMachineProgramDelegate = nullptr;
 ReleaseStackMachineProgramDelegate releaseStackMachineProgramDelegate = nullptr;
@@ -236,6 +238,7 @@ void Init(const std::string &coreClrPath)
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "ResolveBreakPoints", (void **)&resolveBreakPointsDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetAsyncMethodSteppingInfo", (void **)&getAsyncMethodSteppingInfoDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetSource", (void **)&getSourceDelegate)) &&
+        SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "GetModuleDocuments", (void **)&getModuleDocumentsDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, SymbolReaderClassName, "LoadDeltaPdb", (void **)&loadDeltaPdbDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, EvaluationClassName, "CalculationDelegate", (void **)&calculationDelegate)) &&
         SUCCEEDED(Status = createDelegate(hostHandle, domainId, ManagedPartDllName, EvaluationClassName, "GenerateStackMachineProgram", (void **)&generateStackMachineProgramDelegate)) &&
@@ -262,6 +265,7 @@ void Init(const std::string &coreClrPath)
                               resolveBreakPointsDelegate &&
                               getAsyncMethodSteppingInfoDelegate &&
                               getSourceDelegate &&
+                              getModuleDocumentsDelegate &&
                               loadDeltaPdbDelegate &&
                               generateStackMachineProgramDelegate &&
                               releaseStackMachineProgramDelegate &&
@@ -302,7 +306,11 @@ void Shutdown()
     resolveBreakPointsDelegate = nullptr;
     getAsyncMethodSteppingInfoDelegate = nullptr;
     getSourceDelegate = nullptr;
+    getModuleDocumentsDelegate = nullptr;
     loadDeltaPdbDelegate = nullptr;
+    generateStackMachineProgramDelegate = nullptr;
+    releaseStackMachineProgramDelegate = nullptr;
+    nextStackCommandDelegate = nullptr;
     stringToUpperDelegate = nullptr;
     coTaskMemAllocDelegate = nullptr;
     coTaskMemFreeDelegate = nullptr;
@@ -594,6 +602,34 @@ HRESULT GetSource(PVOID symbolReaderHandle, std::string fileName, PVOID *data, i
     return retCode == RetCode::OK ? S_OK : E_FAIL;
 }
 
+HRESULT GetModuleDocuments(PVOID pSymbolReaderHandle, std::vector<std::string> &documents)
+{
+    std::unique_lock<Utility::RWLock::Reader> read_lock(CLRrwlock.reader);
+    if (!getModuleDocumentsDelegate || !pSymbolReaderHandle)
+        return E_FAIL;
+
+    int32_t count = 0;
+    PVOID data = nullptr;
+    RetCode retCode = getModuleDocumentsDelegate(pSymbolReaderHandle, &count, &data);
+    read_lock.unlock();
+
+    if (retCode != RetCode::OK)
+        return E_FAIL;
+
+    documents.reserve(count);
+    for (int32_t i = 0; i < count; i++)
+    {
+        BSTR document = ((BSTR*)data)[i];
+        documents.emplace_back(to_utf8(document));
+        Interop::SysFreeString(document);
+    }
+
+    if (data)
+        Interop::CoTaskMemFree(data);
+
+    return S_OK;
+}
+
 HRESULT LoadDeltaPdb(const std::string &pdbPath, VOID **ppSymbolReaderHandle, std::unordered_set<mdMethodDef> &methodTokens)
 {
     std::unique_lock<Utility::RWLock::Reader> read_lock(CLRrwlock.reader);
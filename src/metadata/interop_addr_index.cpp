@@ -0,0 +1,102 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "metadata/interop_addr_index.h"
+
+#include <algorithm>
+
+
+namespace netcoredbg
+{
+namespace InteropDebugging
+{
+
+const uint32_t AddrRangeIndex::NotFound;
+
+void AddrRangeIndex::Add(std::uintptr_t startAddr, std::uintptr_t endAddr, uint32_t value, uint32_t depth)
+{
+    if (startAddr >= endAddr)
+        return;
+
+    m_ranges.push_back({startAddr, endAddr, value, depth});
+}
+
+void AddrRangeIndex::AddSegment(std::uintptr_t startAddr, uint32_t value)
+{
+    if (!m_segments.empty() && m_segments.back().startAddr == startAddr)
+    {
+        m_segments.back().value = value;
+        // Merge with previous segment if possible.
+        if (m_segments.size() > 1 && m_segments[m_segments.size() - 2].value == value)
+            m_segments.pop_back();
+        else if (m_segments.size() == 1 && value == NotFound)
+            m_segments.clear();
+        return;
+    }
+
+    if ((m_segments.empty() && value == NotFound) ||
+        (!m_segments.empty() && m_segments.back().value == value))
+        return;
+
+    m_segments.push_back({startAddr, value});
+}
+
+void AddrRangeIndex::Build()
+{
+    // Outer ranges first, so, inner ranges will "cover" part of outer range.
+    std::sort(m_ranges.begin(), m_ranges.end(), [](const range_t &a, const range_t &b)
+    {
+        if (a.startAddr != b.startAddr)
+            return a.startAddr < b.startAddr;
+        if (a.endAddr != b.endAddr)
+            return a.endAddr > b.endAddr;
+        return a.depth < b.depth;
+    });
+
+    m_segments.clear();
+    // Stack of currently opened ranges (`end address` and value), innermost on top.
+    std::vector<std::pair<std::uintptr_t, uint32_t>> opened;
+    auto closeRanges = [&](std::uintptr_t addr)
+    {
+        while (!opened.empty() && opened.back().first <= addr)
+        {
+            std::uintptr_t endAddr = opened.back().first;
+            opened.pop_back();
+            AddSegment(endAddr, opened.empty() ? NotFound : opened.back().second);
+        }
+    };
+
+    for (const auto &range : m_ranges)
+    {
+        closeRanges(range.startAddr);
+
+        std::uintptr_t endAddr = range.endAddr;
+        // Note, DWARF ranges must be properly nested, but in case broken debug info we just cut range by outer range.
+        if (!opened.empty() && endAddr > opened.back().first)
+            endAddr = opened.back().first;
+
+        AddSegment(range.startAddr, range.value);
+        opened.emplace_back(endAddr, range.value);
+    }
+    closeRanges(UINTPTR_MAX);
+
+    m_ranges.clear();
+    m_ranges.shrink_to_fit();
+    m_segments.shrink_to_fit();
+}
+
+uint32_t AddrRangeIndex::Find(std::uintptr_t addr) const
+{
+    auto upper_bound = std::upper_bound(m_segments.begin(), m_segments.end(), addr, [](std::uintptr_t addr, const segment_t &segment)
+    {
+        return addr < segment.startAddr;
+    });
+    if (upper_bound == m_segments.begin())
+        return NotFound;
+
+    return std::prev(upper_bound)->value;
+}
+
+} // namespace InteropDebugging
+} // namespace netcoredbg
@@ -0,0 +1,58 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+#pragma once
+
+#ifdef INTEROP_DEBUGGING
+
+#include <cstdint>
+#include <vector>
+
+namespace netcoredbg
+{
+namespace InteropDebugging
+{
+
+// Sorted address ranges index for O(log n) address lookup. Ranges could be nested (for example, inlined subroutine DIE
+// inside subprogram DIE), in this case lookup return value of most specific (innermost) range.
+// Note, no libelfin dependency here, caller must collect ranges from debug info.
+class AddrRangeIndex
+{
+public:
+
+    static const uint32_t NotFound = UINT32_MAX;
+
+    // Add [`startAddr`, `endAddr`) range, `depth` is nesting level (deeper range win in case ranges have same bounds).
+    void Add(std::uintptr_t startAddr, std::uintptr_t endAddr, uint32_t value, uint32_t depth = 0);
+    // Must be called after all ranges added and before `Find()`.
+    void Build();
+    uint32_t Find(std::uintptr_t addr) const;
+    bool Empty() const { return m_segments.empty(); }
+
+private:
+
+    struct range_t
+    {
+        std::uintptr_t startAddr;
+        std::uintptr_t endAddr;
+        uint32_t value;
+        uint32_t depth;
+    };
+
+    struct segment_t
+    {
+        std::uintptr_t startAddr;
+        uint32_t value;
+    };
+
+    std::vector<range_t> m_ranges;
+    // Not overlapped segments, each segment continues until next segment start.
+    std::vector<segment_t> m_segments;
+
+    void AddSegment(std::uintptr_t startAddr, uint32_t value);
+};
+
+} // namespace InteropDebugging
+} // namespace netcoredbg
+
+#endif // INTEROP_DEBUGGING
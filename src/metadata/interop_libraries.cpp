@@ -6,8 +6,12 @@
 
 #include <fcntl.h>
 #include <unistd.h>
+#include <unordered_map>
+#include <unordered_set>
 #include "elf++.h"
 #include "dwarf++.h"
+#include "metadata/interop_addr_index.h"
+#include "metadata/interop_sources_index.h"
 #include "utils/logger.h"
 #include <elf.h>
 #include "utils/filesystem.h"
@@ -23,9 +27,60 @@ namespace
 {
 
     constexpr std::uintptr_t NOT_FOUND = 0;
+    // Note, frames symbolization cache have limit, since during long debug session we could collect too many addresses.
+    constexpr size_t SymbolsCacheLimit = 100000;
 
 } // unnamed namespace
 
+struct InteropLibraries::LibraryInfo::symbols_index_t
+{
+    struct line_t
+    {
+        uint32_t fileNum; // index in `cu_index_t::files`
+        unsigned line;
+    };
+
+    struct cu_index_t
+    {
+        bool valid = false;
+        // Subprogram and inlined subroutine DIEs, range value is index in `dies`.
+        AddrRangeIndex diesIndex;
+        std::vector<dwarf::die> dies;
+        // Line table rows, range value is index in `lines`.
+        AddrRangeIndex linesIndex;
+        std::vector<line_t> lines;
+        std::vector<std::string> files;
+    };
+
+    // Compilation units, range value is index in `dwarf::compilation_units()` and `cus`.
+    bool cuIndexValid = false;
+    AddrRangeIndex cuIndex;
+    std::vector<cu_index_t> cus;
+
+    struct symbol_data_t
+    {
+        std::string procName;
+        bool isElfProcName = false;
+        std::uintptr_t procStartAddr = 0;
+        std::string fullSourcePath;
+        int lineNum = 0;
+    };
+    // Frame symbolization results, absolute address is `key`.
+    std::unordered_map<std::uintptr_t, symbol_data_t> symbolsCache;
+
+    // Source file to line table rows (offsets), all CUs.
+    bool sourcesIndexValid = false;
+    SourceLinesIndex sourcesIndex;
+};
+
+static InteropLibraries::LibraryInfo::symbols_index_t &GetSymbolsIndex(InteropLibraries::LibraryInfo &info)
+{
+    if (!info.symbolsIndex)
+        info.symbolsIndex.reset(new InteropLibraries::LibraryInfo::symbols_index_t);
+
+    return *info.symbolsIndex;
+}
+
 static bool OpenElf(const std::string &file, std::unique_ptr<elf::elf> &ef)
 {
     int fd = open(file.c_str(), O_RDONLY);
@@ -361,70 +416,59 @@ void InteropLibraries::RemoveAllLibraries()
     m_librariesInfoMutex.unlock();
 }
 
-static std::uintptr_t FindOffsetBySourceAndLineForDwarf(const std::unique_ptr<dwarf::dwarf> &dw, const std::string &fileName, unsigned lineNum,
-                                                        unsigned &resolvedLineNum, std::string &resolvedFullPath)
+static void BuildSourcesIndex(dwarf::dwarf *dw, SourceLinesIndex &sourcesIndex)
 {
-    if (!dw) // check if lib have debuginfo loaded
-        return NOT_FOUND;
-
-    std::uintptr_t tmpAddr = 0;
-    unsigned tmpLineNum = 0;
-    unsigned tmpColumnNum = 0;
-    std::string tmpFullPath;
-
     for (const auto &cu : dw->compilation_units())
     {
-        // Fast check for all file names in CU.
-        bool nameFound = false;
-        cu.get_line_table().iterate_file_names([&fileName, &nameFound](dwarf::line_table::file* sourceFile)
+        try
         {
-            if (fileName.size() <= sourceFile->path.size() &&
-                std::equal(fileName.rbegin(), fileName.rend(), sourceFile->path.rbegin())) // "end with"
+            const dwarf::line_table::file *prevFile = nullptr;
+            uint32_t prevFileNum = 0;
+            for (const auto &line : cu.get_line_table())
             {
-                nameFound = true;
-                return false;
-            }
-            return true;
-        });
-        if (!nameFound)
-            continue;
-
-        // All lines check.
-        for (const auto &line : cu.get_line_table())
-        {
-            if (line.end_sequence)
-                continue;
+                // Note, zero address is not valid code address (for example, code removed by linker).
+                if (line.end_sequence || line.address == NOT_FOUND)
+                    continue;
 
-            if (fileName.size() > line.file->path.size() ||
-                !std::equal(fileName.rbegin(), fileName.rend(), line.file->path.rbegin()) || // "end with"
-                line.line < lineNum)
-                continue;
-
-            if (!tmpAddr)
-            {
-                tmpAddr = line.address;
-                tmpLineNum = line.line;
-                tmpColumnNum = line.column;
-                tmpFullPath = line.file->path;
-            }
-            else if (line.line < tmpLineNum || (line.line == tmpLineNum && line.column < tmpColumnNum))
-            {
-                tmpAddr = line.address;
-                tmpLineNum = line.line;
-                tmpColumnNum = line.column;
-                tmpFullPath = line.file->path;
+                if (line.file != prevFile)
+                {
+                    prevFile = line.file;
+                    prevFileNum = sourcesIndex.AddFile(line.file->path);
+                }
+                sourcesIndex.AddLine(prevFileNum, line.line, line.column, line.address);
             }
         }
+        catch (std::exception &e)
+        {
+            LOGW("Sources index creation failed: %s", e.what());
+        }
     }
+    sourcesIndex.Build();
+}
+
+static SourceLinesIndex *GetSourcesIndex(InteropLibraries::LibraryInfo &info)
+{
+    if (!info.dw) // check if lib have debuginfo loaded
+        return nullptr;
 
-    if (tmpAddr)
+    auto &index = GetSymbolsIndex(info);
+    if (!index.sourcesIndexValid)
     {
-        resolvedLineNum = tmpLineNum;
-        resolvedFullPath = tmpFullPath;
-        return tmpAddr;
+        index.sourcesIndexValid = true;
+        BuildSourcesIndex(info.dw.get(), index.sourcesIndex);
     }
+    return &index.sourcesIndex;
+}
 
-    return NOT_FOUND;
+static std::uintptr_t FindOffsetBySourceAndLineForDwarf(InteropLibraries::LibraryInfo &info, const std::string &fileName, unsigned lineNum,
+                                                        unsigned &resolvedLineNum, std::string &resolvedFullPath)
+{
+    SourceLinesIndex *sourcesIndex = GetSourcesIndex(info);
+    std::uintptr_t offset = NOT_FOUND;
+    if (!sourcesIndex || !sourcesIndex->Find(fileName, lineNum, resolvedLineNum, resolvedFullPath, offset))
+        return NOT_FOUND;
+
+    return offset;
 }
 
 std::uintptr_t InteropLibraries::FindAddrBySourceAndLineForLib(std::uintptr_t libStartAddr, const std::string &fileName, unsigned lineNum,
@@ -439,7 +483,7 @@ std::uintptr_t InteropLibraries::FindAddrBySourceAndLineForLib(std::uintptr_t li
     if (find->second.isCoreCLR) // NOTE we don't allow setup breakpoint in CoreCLR native code
         return NOT_FOUND;
 
-    std::uintptr_t offset = FindOffsetBySourceAndLineForDwarf(find->second.dw, fileName, lineNum, resolvedLineNum, resolvedFullPath);
+    std::uintptr_t offset = FindOffsetBySourceAndLineForDwarf(find->second, fileName, lineNum, resolvedLineNum, resolvedFullPath);
     if (offset == NOT_FOUND)
         return NOT_FOUND;
 
@@ -458,7 +502,7 @@ std::uintptr_t InteropLibraries::FindAddrBySourceAndLine(const std::string &file
         if (debugInfo.second.isCoreCLR) // NOTE we don't allow setup breakpoint in CoreCLR native code
             continue;
 
-        std::uintptr_t offset = FindOffsetBySourceAndLineForDwarf(debugInfo.second.dw, fileName, lineNum, resolvedLineNum, resolvedFullPath);
+        std::uintptr_t offset = FindOffsetBySourceAndLineForDwarf(debugInfo.second, fileName, lineNum, resolvedLineNum, resolvedFullPath);
         if (offset == NOT_FOUND)
             continue;
 
@@ -487,25 +531,22 @@ void InteropLibraries::FindLibraryInfoForAddr(std::uintptr_t addr, std::function
     }
 }
 
-static bool FindDwarfDieByAddr(const dwarf::die &d, dwarf::taddr addr, dwarf::die &node)
+static void CollectDwarfDieRanges(const dwarf::die &d, uint32_t depth, InteropLibraries::LibraryInfo::symbols_index_t::cu_index_t &cuIndex)
 {
-    // Scan children first to find most specific DIE
-    for (const auto &child : d)
-    {
-        if (FindDwarfDieByAddr(child, addr, node))
-                return true;
-    }
-
     switch (d.tag)
     {
     case dwarf::DW_TAG::subprogram:
     case dwarf::DW_TAG::inlined_subroutine:
+        if (!d.has(dwarf::DW_AT::low_pc) && !d.has(dwarf::DW_AT::ranges))
+            break;
         try
         {
-            if (die_pc_range(d).contains(addr))
+            uint32_t dieNum = (uint32_t)cuIndex.dies.size();
+            cuIndex.dies.emplace_back(d);
+            for (const auto &range : die_pc_range(d))
             {
-                node = d;
-                return true;
+                // Note, children have bigger depth, so, most specific DIE will be found by index.
+                cuIndex.diesIndex.Add(range.low, range.high, dieNum, depth);
             }
         }
         catch (std::out_of_range &e) {}
@@ -515,7 +556,81 @@ static bool FindDwarfDieByAddr(const dwarf::die &d, dwarf::taddr addr, dwarf::di
         break;
     }
 
-    return false;
+    for (const auto &child : d)
+    {
+        CollectDwarfDieRanges(child, depth + 1, cuIndex);
+    }
+}
+
+static void BuildLineTableIndex(const dwarf::line_table &lt, InteropLibraries::LibraryInfo::symbols_index_t::cu_index_t &cuIndex)
+{
+    std::unordered_map<std::string, uint32_t> filesMap;
+    const dwarf::line_table::file *prevFile = nullptr;
+    uint32_t prevFileNum = 0;
+    bool prevValid = false;
+    std::uintptr_t prevAddr = 0;
+
+    // Same logic as `line_table::find_address()` have - row cover addresses from row address until next row address.
+    for (const auto &line : lt)
+    {
+        if (prevValid)
+            cuIndex.linesIndex.Add(prevAddr, line.address, (uint32_t)cuIndex.lines.size() - 1);
+
+        prevValid = !line.end_sequence;
+        if (!prevValid)
+            continue;
+
+        if (line.file != prevFile)
+        {
+            prevFile = line.file;
+            auto find = filesMap.find(line.file->path);
+            if (find == filesMap.end())
+            {
+                find = filesMap.emplace(line.file->path, (uint32_t)cuIndex.files.size()).first;
+                cuIndex.files.emplace_back(line.file->path);
+            }
+            prevFileNum = find->second;
+        }
+        cuIndex.lines.push_back({prevFileNum, line.line});
+        prevAddr = line.address;
+    }
+}
+
+static void BuildCUIndex(const dwarf::compilation_unit &cu, InteropLibraries::LibraryInfo::symbols_index_t::cu_index_t &cuIndex)
+{
+    cuIndex.valid = true;
+    try
+    {
+        BuildLineTableIndex(cu.get_line_table(), cuIndex);
+        CollectDwarfDieRanges(cu.root(), 0, cuIndex);
+    }
+    catch (std::exception &e)
+    {
+        LOGW("Debug info index creation failed: %s", e.what());
+    }
+    cuIndex.linesIndex.Build();
+    cuIndex.diesIndex.Build();
+}
+
+static void BuildCUsIndex(dwarf::dwarf *dw, InteropLibraries::LibraryInfo::symbols_index_t &index)
+{
+    index.cuIndexValid = true;
+    // TODO use `.debug_aranges`
+    const auto &cus = dw->compilation_units();
+    index.cus.resize(cus.size());
+    for (uint32_t i = 0; i < cus.size(); i++)
+    {
+        try
+        {
+            for (const auto &range : die_pc_range(cus[i].root()))
+            {
+                index.cuIndex.Add(range.low, range.high, i);
+            }
+        }
+        catch (std::out_of_range &e) {}
+        catch (dwarf::value_type_mismatch &e) {}
+    }
+    index.cuIndex.Build();
 }
 
 static void ParseDwarfDie(const dwarf::die &node, std::string &methodName, std::string &methodLinkageName)
@@ -560,54 +675,89 @@ static bool DemangleCXXABI(const char *mangledName, std::string &realName)
     return false;
 }
 
-static void FindDataForAddrInDebugInfo(dwarf::dwarf *dw, std::uintptr_t addr, std::string &procName, std::string &fullSourcePath, int &lineNum)
+static void FindDataForAddrInDebugInfo(dwarf::dwarf *dw, InteropLibraries::LibraryInfo::symbols_index_t &index, std::uintptr_t addr,
+                                       std::string &procName, std::string &fullSourcePath, int &lineNum)
 {
     if (!dw)
         return;
 
-    // TODO use `.debug_aranges`
+    if (!index.cuIndexValid)
+        BuildCUsIndex(dw, index);
+
+    uint32_t cuNum = index.cuIndex.Find(addr);
+    if (cuNum == AddrRangeIndex::NotFound)
+        return;
+
+    auto &cuIndex = index.cus[cuNum];
+    if (!cuIndex.valid)
+        BuildCUIndex(dw->compilation_units()[cuNum], cuIndex);
 
-    for (auto &cu : dw->compilation_units())
+    // Map address to source file and line
+    uint32_t lineRow = cuIndex.linesIndex.Find(addr);
+    if (lineRow == AddrRangeIndex::NotFound)
+        return;
+
+    fullSourcePath = cuIndex.files[cuIndex.lines[lineRow].fileNum];
+    lineNum = cuIndex.lines[lineRow].line;
+
+    // Map address to method name
+    uint32_t dieNum = cuIndex.diesIndex.Find(addr);
+    if (dieNum == AddrRangeIndex::NotFound)
+        return;
+
+    std::string methodName;
+    std::string methodLinkageName;
+    ParseDwarfDie(cuIndex.dies[dieNum], methodName, methodLinkageName);
+
+    if (!methodLinkageName.empty())
     {
-        try
-        {
-            if (!die_pc_range(cu.root()).contains(addr))
-                continue;
-        }
-        catch (std::out_of_range &e) {continue;}
-        catch (dwarf::value_type_mismatch &e) {continue;}
+        if (!DemangleCXXABI(methodLinkageName.c_str(), procName))
+            procName = methodLinkageName + "()";
+    }
+    else if (!methodName.empty())
+        procName = methodName + "()";
+    else
+        procName = "unknown";
+}
 
-        // Map address to source file and line
-        auto &lt = cu.get_line_table();
-        auto it = lt.find_address(addr);
-        if (it == lt.end())
-            return;
+static const InteropLibraries::LibraryInfo::symbols_index_t::symbol_data_t &FindSymbolDataForAddr(std::uintptr_t startAddr, InteropLibraries::LibraryInfo &info,
+                                                                                                 std::uintptr_t addr)
+{
+    auto &index = GetSymbolsIndex(info);
+    auto find = index.symbolsCache.find(addr);
+    if (find != index.symbolsCache.end())
+        return find->second;
 
-        fullSourcePath = it->file->path;
-        lineNum = it->line;
+    if (index.symbolsCache.size() >= SymbolsCacheLimit)
+        index.symbolsCache.clear();
 
-        // Map address to method name
-        // TODO index/helper/something for looking up address
-        dwarf::die node;
-        if (FindDwarfDieByAddr(cu.root(), addr, node))
-        {
-            std::string methodName;
-            std::string methodLinkageName;
-            ParseDwarfDie(node, methodName, methodLinkageName);
+    auto &data = index.symbolsCache[addr];
 
-            if (!methodLinkageName.empty())
-            {
-                if (!DemangleCXXABI(methodLinkageName.c_str(), procName))
-                    procName = methodLinkageName + "()";
-            }
-            else if (!methodName.empty())
-                procName = methodName + "()";
-            else
-                procName = "unknown";
+    FindDataForAddrInDebugInfo(info.dw.get(), index, addr - startAddr, data.procName, data.fullSourcePath, data.lineNum);
+    if (!data.procName.empty())
+        return data;
 
-            break;
+    if (!info.proceduresDataValid)
+        CollectProcDataFromElf(startAddr, info);
+
+    if (info.proceduresData.empty() ||
+        addr >= info.proceduresData.rbegin()->second.endAddr)
+        return data;
+
+    auto upper_bound = info.proceduresData.upper_bound(addr);
+    if (upper_bound != info.proceduresData.begin())
+    {
+        auto closest_lower = std::prev(upper_bound);
+        if (closest_lower->first <= addr && addr < closest_lower->second.endAddr)
+        {
+            data.procStartAddr = closest_lower->first;
+            data.isElfProcName = true;
+            if (!DemangleCXXABI(closest_lower->second.procName.c_str(), data.procName))
+                data.procName = closest_lower->second.procName + "()";
         }
     }
+
+    return data;
 }
 
 void InteropLibraries::FindDataForAddr(std::uintptr_t addr, std::string &libName, std::uintptr_t &libStartAddr, std::string &procName,
@@ -618,28 +768,11 @@ void InteropLibraries::FindDataForAddr(std::uintptr_t addr, std::string &libName
         libName = GetBasename(info.fullName);
         libStartAddr = startAddr;
 
-        FindDataForAddrInDebugInfo(info.dw.get(), addr - startAddr, procName, fullSourcePath, lineNum);
-        if (!procName.empty())
-            return;
-
-        if (!info.proceduresDataValid)
-            CollectProcDataFromElf(startAddr, info);
-
-        if (info.proceduresData.empty() ||
-            addr >= info.proceduresData.rbegin()->second.endAddr)
-            return;
-
-        auto upper_bound = info.proceduresData.upper_bound(addr);
-        if (upper_bound != info.proceduresData.begin())
-        {
-            auto closest_lower = std::prev(upper_bound);
-            if (closest_lower->first <= addr && addr < closest_lower->second.endAddr)
-            {
-                procStartAddr = closest_lower->first;
-                if (!DemangleCXXABI(closest_lower->second.procName.c_str(), procName))
-                    procName = closest_lower->second.procName + "()";
-            }
-        }
+        const auto &data = FindSymbolDataForAddr(startAddr, info, addr);
+        procName = data.procName;
+        procStartAddr = data.procStartAddr;
+        fullSourcePath = data.fullSourcePath;
+        lineNum = data.lineNum;
     });
 }
 
@@ -712,34 +845,43 @@ bool InteropLibraries::FindDataForNotClrAddr(std::uintptr_t addr, std::string &l
                 libLoadName = libLoadName.substr(0, i + 3);
         }
 
-        if (info.dw != nullptr)
-        {
-            std::string fullSourcePath;
-            int lineNum;
-            FindDataForAddrInDebugInfo(info.dw.get(), addr - startAddr, procName, fullSourcePath, lineNum);
-            return;
-        }
+        // Note, in case lib have debug info, procedure name from debug info only should be used.
+        const auto &data = FindSymbolDataForAddr(startAddr, info, addr);
+        if (info.dw == nullptr || !data.isElfProcName)
+            procName = data.procName;
+    });
+
+    return isUserCode;
+}
 
-        if (!info.proceduresDataValid)
-            CollectProcDataFromElf(startAddr, info);
+void InteropLibraries::FindFileNames(Utility::string_view pattern, unsigned limit, std::function<void(const char *)> cb)
+{
+    std::lock_guard<std::mutex> lock(m_librariesInfoMutex);
 
-        if (info.proceduresData.empty() ||
-            addr >= info.proceduresData.rbegin()->second.endAddr)
+    std::string patternStr(pattern);
+    // Note, same source file could be part of debug info for different libs.
+    std::unordered_set<std::string> found;
+    for (auto &debugInfo : m_librariesInfo)
+    {
+        if (limit == 0)
             return;
 
-        auto upper_bound = info.proceduresData.upper_bound(addr);
-        if (upper_bound != info.proceduresData.begin())
+        if (debugInfo.second.isCoreCLR) // NOTE we don't allow setup breakpoint in CoreCLR native code
+            continue;
+
+        SourceLinesIndex *sourcesIndex = GetSourcesIndex(debugInfo.second);
+        if (!sourcesIndex)
+            continue;
+
+        sourcesIndex->FindFileNames(patternStr, [&](const std::string &str)
         {
-            auto closest_lower = std::prev(upper_bound);
-            if (closest_lower->first <= addr && addr < closest_lower->second.endAddr)
-            {
-                if (!DemangleCXXABI(closest_lower->second.procName.c_str(), procName))
-                    procName = closest_lower->second.procName + "()";
-            }
-        }
-    });
+            if (!found.insert(str).second)
+                return true;
 
-    return isUserCode;
+            cb(str.c_str());
+            return --limit != 0;
+        });
+    }
 }
 
 } // namespace InteropDebugging
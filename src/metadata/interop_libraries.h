@@ -11,6 +11,7 @@
 #include <map>
 #include <functional>
 #include "interfaces/types.h"
+#include "utils/string_view.h"
 
 
 namespace elf
@@ -60,6 +61,11 @@ public:
         std::map<std::uintptr_t, proc_data_t> proceduresData;
         // Is this lib related to CoreCLR (Note, we don't allow debug CoreCLR native code).
         bool isCoreCLR = false;
+        // Lazy created address to CU/procedure/source line index, symbolization results cache for native frames and
+        // source file to line table rows index for breakpoints setup by source + line.
+        // Note, type defined in interop_libraries.cpp only, so, `shared_ptr` used (could be destroyed with incomplete type).
+        struct symbols_index_t;
+        std::shared_ptr<symbols_index_t> symbolsIndex;
     };
 
     void AddLibrary(const std::string &libLoadName, const std::string &fullName, std::uintptr_t startAddr, std::uintptr_t endAddr, SymbolStatus &symbolStatus);
@@ -74,6 +80,8 @@ public:
     bool FindDataForNotClrAddr(std::uintptr_t addr, std::string &libLoadName, std::string &procName);
     bool IsUserDebuggingCode(std::uintptr_t addr);
     bool IsThumbCode(std::uintptr_t addr);
+    // Source file names search for user's native code (libs with debug info, except CoreCLR libs).
+    void FindFileNames(Utility::string_view pattern, unsigned limit, std::function<void(const char *)> cb);
 
 private:
 
@@ -85,8 +93,6 @@ private:
     void FindLibraryInfoForAddr(std::uintptr_t addr, std::function<void(std::uintptr_t startAddr, LibraryInfo&)> cb);
     bool IsThumbCode(std::uintptr_t libStartAddr, LibraryInfo &info, std::uintptr_t addr);
 
-    // TODO addr search optimization during breakpoint setup by source + line;
-
 };
 
 } // namespace InteropDebugging
@@ -0,0 +1,132 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "metadata/interop_sources_index.h"
+
+#include <algorithm>
+
+
+namespace netcoredbg
+{
+namespace InteropDebugging
+{
+
+static std::string GetFileName(const std::string &path)
+{
+    std::size_t i = path.find_last_of("/");
+    return i == std::string::npos ? path : path.substr(i + 1);
+}
+
+// Check, that `path` end with `fileName` and `fileName` is full path or starts from path component.
+static bool IsPathEndWith(const std::string &path, const std::string &fileName)
+{
+    if (fileName.size() > path.size() ||
+        !std::equal(fileName.rbegin(), fileName.rend(), path.rbegin()))
+        return false;
+
+    return fileName.size() == path.size() ||
+           fileName[0] == '/' ||
+           path[path.size() - fileName.size() - 1] == '/';
+}
+
+uint32_t SourceLinesIndex::AddFile(const std::string &fullPath)
+{
+    auto find = m_fullPathToIndex.find(fullPath);
+    if (find != m_fullPathToIndex.end())
+        return find->second;
+
+    uint32_t fileNum = (uint32_t)m_fullPaths.size();
+    m_fullPathToIndex.emplace(fullPath, fileNum);
+    m_fullPaths.emplace_back(fullPath);
+    m_lines.emplace_back();
+    m_fileNameToFullPathsIndexes[GetFileName(fullPath)].emplace_back(fileNum);
+    return fileNum;
+}
+
+void SourceLinesIndex::AddLine(uint32_t fileNum, unsigned line, unsigned column, std::uintptr_t addr)
+{
+    m_lines[fileNum].push_back({line, column, addr});
+}
+
+void SourceLinesIndex::Build()
+{
+    for (auto &lines : m_lines)
+    {
+        // Note, stable sort is important here, first added row (in line table order) for same line and column should be used.
+        std::stable_sort(lines.begin(), lines.end(), [](const line_t &a, const line_t &b)
+        {
+            return a.line < b.line || (a.line == b.line && a.column < b.column);
+        });
+        lines.erase(std::unique(lines.begin(), lines.end(), [](const line_t &a, const line_t &b)
+        {
+            return a.line == b.line && a.column == b.column;
+        }), lines.end());
+        lines.shrink_to_fit();
+    }
+}
+
+bool SourceLinesIndex::Find(const std::string &fileName, unsigned lineNum, unsigned &resolvedLineNum, std::string &resolvedFullPath, std::uintptr_t &addr) const
+{
+    auto findIndexes = m_fileNameToFullPathsIndexes.find(GetFileName(fileName));
+    if (findIndexes == m_fileNameToFullPathsIndexes.end())
+        return false;
+
+    const line_t *result = nullptr;
+    uint32_t resultFileNum = 0;
+    for (auto fileNum : findIndexes->second)
+    {
+        if (!IsPathEndWith(m_fullPaths[fileNum], fileName))
+            continue;
+
+        const auto &lines = m_lines[fileNum];
+        auto lower_bound = std::lower_bound(lines.begin(), lines.end(), lineNum, [](const line_t &a, unsigned lineNum)
+        {
+            return a.line < lineNum;
+        });
+        if (lower_bound == lines.end())
+            continue;
+
+        if (!result || lower_bound->line < result->line || (lower_bound->line == result->line && lower_bound->column < result->column))
+        {
+            result = &(*lower_bound);
+            resultFileNum = fileNum;
+        }
+    }
+
+    if (!result)
+        return false;
+
+    resolvedLineNum = result->line;
+    resolvedFullPath = m_fullPaths[resultFileNum];
+    addr = result->addr;
+    return true;
+}
+
+bool SourceLinesIndex::FindFileNames(const std::string &pattern, std::function<bool(const std::string&)> cb) const
+{
+    auto check = [&](const std::string& str)
+    {
+        auto pos = str.find(pattern);
+        if (pos != std::string::npos && (pos == 0 || str[pos-1] == '/'))
+            return cb(str);
+
+        return true;
+    };
+
+    for (const auto &pair : m_fileNameToFullPathsIndexes)
+    {
+        if (!check(pair.first))
+            return false;
+
+        for (const auto fileNum : pair.second)
+        {
+            if (!check(m_fullPaths[fileNum]))
+                return false;
+        }
+    }
+    return true;
+}
+
+} // namespace InteropDebugging
+} // namespace netcoredbg
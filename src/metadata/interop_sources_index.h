@@ -0,0 +1,55 @@
+// Copyright (c) 2023 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+#pragma once
+
+#ifdef INTEROP_DEBUGGING
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace netcoredbg
+{
+namespace InteropDebugging
+{
+
+// Source file to line table rows index for native breakpoints setup by source + line and source file names search
+// (completion), file name is `key` (full path and file name without path), rows sorted by line and column.
+// Note, no libelfin dependency here, caller must collect line table rows from debug info.
+class SourceLinesIndex
+{
+public:
+
+    // Return file number for `AddLine()`.
+    uint32_t AddFile(const std::string &fullPath);
+    void AddLine(uint32_t fileNum, unsigned line, unsigned column, std::uintptr_t addr);
+    // Must be called after all lines added and before `Find()`.
+    void Build();
+
+    // Find closest row with line equal or greater than `lineNum` for all full paths, that end with `fileName`.
+    bool Find(const std::string &fileName, unsigned lineNum, unsigned &resolvedLineNum, std::string &resolvedFullPath, std::uintptr_t &addr) const;
+    // Same logic as ModulesSources::FindFileNames() have, `cb` return `false` in order to stop search.
+    bool FindFileNames(const std::string &pattern, std::function<bool(const std::string&)> cb) const;
+
+private:
+
+    struct line_t
+    {
+        unsigned line;
+        unsigned column;
+        std::uintptr_t addr;
+    };
+
+    std::vector<std::string> m_fullPaths;
+    std::vector<std::vector<line_t>> m_lines;
+    std::unordered_map<std::string, uint32_t> m_fullPathToIndex;
+    std::unordered_map<std::string, std::vector<uint32_t>> m_fileNameToFullPathsIndexes;
+};
+
+} // namespace InteropDebugging
+} // namespace netcoredbg
+
+#endif // INTEROP_DEBUGGING
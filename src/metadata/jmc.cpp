@@ -59,7 +59,7 @@ static HRESULT GetNonJMCMethodsForTypeDef(
     return S_OK;
 }
 
-static HRESULT GetNonJMCClassesAndMethods(ICorDebugModule *pModule, std::vector<mdToken> &excludeTokens)
+HRESULT GetNonJMCClassesAndMethods(ICorDebugModule *pModule, std::vector<mdToken> &excludeTokens)
 {
     HRESULT Status;
 
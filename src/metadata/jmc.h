@@ -8,11 +8,16 @@
 #include "cordebug.h"
 
 #include <unordered_set>
+#include <vector>
 
 namespace netcoredbg
 {
 
 HRESULT DisableJMCByAttributes(ICorDebugModule *pModule);
+// Metadata only part of DisableJMCByAttributes(), could be called for running process.
+HRESULT GetNonJMCClassesAndMethods(ICorDebugModule *pModule, std::vector<mdToken> &excludeTokens);
+// Note, process must be stopped, since JMC status can't be changed for running process.
+void DisableJMCForTokenList(ICorDebugModule *pModule, const std::vector<mdToken> &excludeTokens);
 HRESULT DisableJMCByAttributes(ICorDebugModule *pModule, const std::unordered_set<mdMethodDef> &methodTokens);
 
 } // namespace netcoredbg
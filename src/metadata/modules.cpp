@@ -7,6 +7,7 @@
 #include <sstream>
 #include <vector>
 #include <iomanip>
+#include <algorithm>
 
 #include "managed/interop.h"
 #include "utils/platform.h"
@@ -176,13 +177,187 @@ static HRESULT ResolveMethodInModule(ICorDebugModule *pModule, const std::string
     return ForEachMethod(pModule, functor);
 }
 
+Modules::~Modules()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_deferredWorkMutex);
+        m_deferredWorkersExit = true;
+        m_deferredWorkCV.notify_all();
+    }
+
+    for (auto &worker : m_deferredWorkers)
+    {
+        worker.join();
+    }
+}
+
 void Modules::CleanupAllModules()
 {
     std::lock_guard<std::mutex> lock(m_modulesInfoMutex);
+    {
+        // Deferred work use symbol reader handles, that will be disposed with module info.
+        std::unique_lock<std::mutex> lockDeferredWork(m_deferredWorkMutex);
+        for (auto modAddress : m_deferredWorkQueue)
+        {
+            m_deferredWork.erase(modAddress);
+        }
+        m_deferredWorkQueue.clear();
+        m_deferredWorkDoneCV.wait(lockDeferredWork, [this]{
+            if (m_documentsLoadingNum != 0)
+                return false;
+            for (const auto &entry : m_deferredWork)
+            {
+                if (entry.second->m_state != DeferredWork::State::Done)
+                    return false;
+            }
+            return true;
+        });
+        m_deferredWork.clear();
+    }
     m_modulesInfo.clear();
     m_modulesAppUpdate.Clear();
 }
 
+void Modules::AddDeferredWork(ICorDebugModule *pModule, IMetaDataImport *pMDImport, PVOID pSymbolReaderHandle, bool needJMC)
+{
+    CORDB_ADDRESS modAddress;
+    if (FAILED(pModule->GetBaseAddress(&modAddress)))
+        return;
+
+    pModule->AddRef();
+    pMDImport->AddRef();
+    std::lock_guard<std::mutex> lock(m_deferredWorkMutex);
+
+    if (m_deferredWorkers.empty())
+    {
+        // Note, most of work is PDB read in managed part and metadata enumeration, no reason use all CPU cores here.
+        const unsigned maxWorkers = 4;
+        unsigned workersNum = std::thread::hardware_concurrency();
+        workersNum = workersNum == 0 ? 1 : std::min(workersNum, maxWorkers);
+        for (unsigned i = 0; i < workersNum; i++)
+        {
+            m_deferredWorkers.emplace_back(&Modules::DeferredWorker, this);
+        }
+    }
+
+    m_deferredWork[modAddress] = std::make_shared<DeferredWork>(pModule, pMDImport, pSymbolReaderHandle, needJMC);
+    m_deferredWorkQueue.emplace_back(modAddress);
+    m_deferredWorkCV.notify_one();
+}
+
+// Caller must hold m_deferredWorkMutex by `lock`, mutex is unlocked during work execution.
+void Modules::RunDeferredWork(std::unique_lock<std::mutex> &lock, const std::shared_ptr<DeferredWork> &work)
+{
+    work->m_state = DeferredWork::State::Running;
+    lock.unlock();
+
+    if (FAILED(m_modulesSources.FillSourcesCodeLinesForModule(work->m_iCorModule, work->m_iMDImport, work->m_pSymbolReaderHandle)))
+        LOGE("Could not load source lines related info from PDB file. Could produce failures during breakpoint's source path resolve in future.");
+
+    if (work->m_needJMC)
+        GetNonJMCClassesAndMethods(work->m_iCorModule, work->m_nonJMCTokens);
+
+    lock.lock();
+    work->m_state = DeferredWork::State::Done;
+    m_deferredWorkDoneCV.notify_all();
+}
+
+void Modules::DeferredWorker()
+{
+    std::unique_lock<std::mutex> lock(m_deferredWorkMutex);
+    while (true)
+    {
+        m_deferredWorkCV.wait(lock, [this]{ return m_deferredWorkersExit || !m_deferredWorkQueue.empty(); });
+        if (m_deferredWorkersExit)
+            return;
+
+        auto find = m_deferredWork.find(m_deferredWorkQueue.front());
+        m_deferredWorkQueue.pop_front();
+        if (find == m_deferredWork.end())
+            continue;
+
+        // Note, we hold shared pointer, so, work data can't be removed from m_deferredWork during execution.
+        std::shared_ptr<DeferredWork> work = find->second;
+        RunDeferredWork(lock, work);
+    }
+}
+
+void Modules::WaitDeferredWork(CORDB_ADDRESS modAddress)
+{
+    std::unique_lock<std::mutex> lock(m_deferredWorkMutex);
+
+    if (modAddress != 0)
+    {
+        auto find = m_deferredWork.find(modAddress);
+        if (find == m_deferredWork.end())
+            return;
+
+        std::shared_ptr<DeferredWork> work = find->second;
+        if (work->m_state == DeferredWork::State::Queued)
+        {
+            // Don't wait for free worker, since caller (breakpoint resolve or stop event) is blocked by this work.
+            m_deferredWorkQueue.remove(modAddress);
+            RunDeferredWork(lock, work);
+            return;
+        }
+
+        m_deferredWorkDoneCV.wait(lock, [&work]{ return work->m_state == DeferredWork::State::Done; });
+        return;
+    }
+
+    while (!m_deferredWorkQueue.empty())
+    {
+        auto find = m_deferredWork.find(m_deferredWorkQueue.front());
+        m_deferredWorkQueue.pop_front();
+        if (find == m_deferredWork.end())
+            continue;
+
+        std::shared_ptr<DeferredWork> work = find->second;
+        RunDeferredWork(lock, work);
+    }
+
+    m_deferredWorkDoneCV.wait(lock, [this]{
+        for (const auto &entry : m_deferredWork)
+        {
+            if (entry.second->m_state != DeferredWork::State::Done)
+                return false;
+        }
+        return true;
+    });
+}
+
+void Modules::WaitDeferredWork(ICorDebugThread *pThread)
+{
+    ToRelease<ICorDebugFrame> pFrame;
+    ToRelease<ICorDebugFunction> pFunction;
+    ToRelease<ICorDebugModule> pModule;
+    CORDB_ADDRESS modAddress = 0;
+    if (SUCCEEDED(pThread->GetActiveFrame(&pFrame)) && pFrame != nullptr &&
+        SUCCEEDED(pFrame->GetFunction(&pFunction)) &&
+        SUCCEEDED(pFunction->GetModule(&pModule)) &&
+        SUCCEEDED(pModule->GetBaseAddress(&modAddress)))
+        WaitDeferredWork(modAddress);
+}
+
+void Modules::ApplyDeferredJMC()
+{
+    std::lock_guard<std::mutex> lock(m_deferredWorkMutex);
+
+    for (auto it = m_deferredWork.begin(); it != m_deferredWork.end();)
+    {
+        if (it->second->m_state != DeferredWork::State::Done)
+        {
+            ++it;
+            continue;
+        }
+
+        if (!it->second->m_nonJMCTokens.empty())
+            DisableJMCForTokenList(it->second->m_iCorModule, it->second->m_nonJMCTokens);
+
+        it = m_deferredWork.erase(it);
+    }
+}
+
 std::string GetModuleFileName(ICorDebugModule *pModule)
 {
     WCHAR name[mdNameLen];
@@ -336,6 +511,8 @@ HRESULT Modules::GetFrameILAndSequencePoint(
     CORDB_ADDRESS modAddress;
     IfFailRet(pModule->GetBaseAddress(&modAddress));
 
+    // Note, no deferred work wait here, since this is called for each frame of stack trace. Sequence point is read from
+    // module's PDB directly, line updates (Hot Reload) could exist only for module with finished deferred work.
     return GetModuleInfo(modAddress, [&](ModuleInfo &mdInfo) -> HRESULT
     {
         if (mdInfo.m_symbolReaderHandles.empty() || mdInfo.m_symbolReaderHandles.size() < methodVersion)
@@ -343,9 +520,12 @@ HRESULT Modules::GetFrameILAndSequencePoint(
 
         IfFailRet(GetSequencePointByILOffset(mdInfo.m_symbolReaderHandles[methodVersion - 1], methodToken, ilOffset, &sequencePoint));
 
+        if (mdInfo.m_methodBlockUpdates.empty())
+            return S_OK;
+
         // In case Hot Reload we may have line updates that we must take into account.
         unsigned fullPathIndex;
-        IfFailRet(GetIndexBySourceFullPath(sequencePoint.document, fullPathIndex));
+        IfFailRet(m_modulesSources.GetIndexBySourceFullPath(sequencePoint.document, fullPathIndex));
         LineUpdatesForwardCorrection(fullPathIndex, methodToken, mdInfo.m_methodBlockUpdates, sequencePoint);
 
         return S_OK;
@@ -511,6 +691,7 @@ HRESULT Modules::TryLoadModuleSymbols(ICorDebugModule *pModule, Module &module,
     PVOID pSymbolReaderHandle = nullptr;
     LoadSymbols(pMDImport, pModule, &pSymbolReaderHandle);
     module.symbolStatus = pSymbolReaderHandle != nullptr ? SymbolsLoaded : SymbolsNotFound;
+    bool needJMCByAttributes = false;
 
     if (module.symbolStatus == SymbolsLoaded)
     {
@@ -535,8 +716,8 @@ HRESULT Modules::TryLoadModuleSymbols(ICorDebugModule *pModule, Module &module,
                 // * DebuggerHiddenAttribute hides the code from the debugger, even if Just My Code is turned off.
                 // * DebuggerStepThroughAttribute tells the debugger to step through the code it's applied to, rather than step into the code.
                 // The .NET debugger considers all other code to be user code.
-                if (needJMC)
-                    DisableJMCByAttributes(pModule);
+                // Note, attributes scan is part of deferred work, JMC status will be changed at next process stop.
+                needJMCByAttributes = needJMC;
             }
             else if (Status == CORDBG_E_CANT_SET_TO_JMC)
             {
@@ -546,9 +727,6 @@ HRESULT Modules::TryLoadModuleSymbols(ICorDebugModule *pModule, Module &module,
                     outputText = "You are debugging a Release build of " + module.name + ". Without Just My Code Release builds try not to use compiler optimizations, but in some cases (e.g. attach) this still results in a degraded debugging experience (e.g. breakpoints will not be hit).";
             }
         }
-
-        if (FAILED(m_modulesSources.FillSourcesCodeLinesForModule(pModule, pMDImport, pSymbolReaderHandle)))
-            LOGE("Could not load source lines related info from PDB file. Could produce failures during breakpoint's source path resolve in future.");
     }
 
     IfFailRet(GetModuleId(pModule, module.id));
@@ -565,6 +743,10 @@ HRESULT Modules::TryLoadModuleSymbols(ICorDebugModule *pModule, Module &module,
     std::lock_guard<std::mutex> lock(m_modulesInfoMutex);
     m_modulesInfo.insert(std::make_pair(baseAddress, std::move(mdInfo)));
 
+    // Note, work must be added after module info, since methods ranges data resolve require it.
+    if (module.symbolStatus == SymbolsLoaded)
+        AddDeferredWork(pModule, pMDImport, pSymbolReaderHandle, needJMCByAttributes);
+
     if (needHotReload)
         IfFailRet(m_modulesAppUpdate.AddUpdateHandlerTypesForModule(pModule, pMDImport));
 
@@ -715,6 +897,74 @@ HRESULT Modules::ForEachModule(std::function<HRESULT(ICorDebugModule *pModule)>
     return S_OK;
 }
 
+void Modules::WaitDeferredWorkForSource(CORDB_ADDRESS modAddress, const std::string &filename)
+{
+    const std::string sourceFileName = GetFileName(filename);
+    std::vector<CORDB_ADDRESS> waitModules;
+    std::vector<std::pair<CORDB_ADDRESS, std::shared_ptr<DeferredWork>>> loadDocuments;
+    {
+        std::lock_guard<std::mutex> lock(m_deferredWorkMutex);
+
+        for (auto &entry : m_deferredWork)
+        {
+            DeferredWork &work = *entry.second;
+            if ((modAddress != 0 && entry.first != modAddress) || work.m_state == DeferredWork::State::Done)
+                continue;
+
+            if (!work.m_documentsLoaded)
+                loadDocuments.emplace_back(entry.first, entry.second);
+            else if (work.m_documentsFileNames.find(sourceFileName) != work.m_documentsFileNames.end())
+                waitModules.emplace_back(entry.first);
+        }
+        // Note, symbol reader handles must not be disposed by CleanupAllModules() during documents enumeration.
+        m_documentsLoadingNum += loadDocuments.size();
+    }
+
+    // Note, PDB documents enumeration is much faster than methods ranges load, done by deferred work itself,
+    // but still done out of m_deferredWorkMutex, since deferred workers and stop events wait for this mutex.
+    for (auto &entry : loadDocuments)
+    {
+        std::vector<std::string> documents;
+        if (FAILED(Interop::GetModuleDocuments(entry.second->m_pSymbolReaderHandle, documents)))
+        {
+            waitModules.emplace_back(entry.first);
+            continue;
+        }
+
+        std::unordered_set<std::string> documentsFileNames;
+        for (auto &document : documents)
+        {
+#ifdef WIN32
+            if (FAILED(Interop::StringToUpper(document)))
+                continue;
+#endif
+            documentsFileNames.emplace(GetFileName(document));
+        }
+
+        if (documentsFileNames.find(sourceFileName) != documentsFileNames.end())
+            waitModules.emplace_back(entry.first);
+
+        std::lock_guard<std::mutex> lock(m_deferredWorkMutex);
+        if (!entry.second->m_documentsLoaded)
+        {
+            entry.second->m_documentsFileNames = std::move(documentsFileNames);
+            entry.second->m_documentsLoaded = true;
+        }
+    }
+
+    if (!loadDocuments.empty())
+    {
+        std::lock_guard<std::mutex> lock(m_deferredWorkMutex);
+        m_documentsLoadingNum -= loadDocuments.size();
+        m_deferredWorkDoneCV.notify_all();
+    }
+
+    for (auto waitModAddress : waitModules)
+    {
+        WaitDeferredWork(waitModAddress);
+    }
+}
+
 HRESULT Modules::ResolveBreakpoint(/*in*/ CORDB_ADDRESS modAddress, /*in*/ std::string filename, /*out*/ unsigned &fullname_index,
                                    /*in*/ int sourceLine, /*out*/ std::vector<ModulesSources::resolved_bp_t> &resolvedPoints)
 {
@@ -723,7 +973,10 @@ HRESULT Modules::ResolveBreakpoint(/*in*/ CORDB_ADDRESS modAddress, /*in*/ std::
     IfFailRet(Interop::StringToUpper(filename));
 #endif
 
-    // Note, in all code we use m_modulesInfoMutex > m_sourcesInfoMutex lock sequence.
+    // Only modules, that have source file with breakpoint in PDB, could block caller here.
+    WaitDeferredWorkForSource(modAddress, filename);
+
+    // Note, in all code we use m_modulesInfoMutex > m_sourcesInfoRWLock lock sequence.
     std::lock_guard<std::mutex> lockModulesInfo(m_modulesInfoMutex);
     return m_modulesSources.ResolveBreakpoint(this, modAddress, filename, fullname_index, sourceLine, resolvedPoints);
 }
@@ -731,6 +984,12 @@ HRESULT Modules::ResolveBreakpoint(/*in*/ CORDB_ADDRESS modAddress, /*in*/ std::
 HRESULT Modules::ApplyPdbDeltaAndLineUpdates(ICorDebugModule *pModule, bool needJMC, const std::string &deltaPDB,
                                              const std::string &lineUpdates, std::unordered_set<mdMethodDef> &methodTokens)
 {
+    HRESULT Status;
+    CORDB_ADDRESS modAddress;
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+    WaitDeferredWork(modAddress);
+    ApplyDeferredJMC();
+
     return m_modulesSources.ApplyPdbDeltaAndLineUpdates(this, pModule, needJMC, deltaPDB, lineUpdates, methodTokens);
 }
 
@@ -741,11 +1000,17 @@ HRESULT Modules::GetSourceFullPathByIndex(unsigned index, std::string &fullPath)
 
 HRESULT Modules::GetIndexBySourceFullPath(std::string fullPath, unsigned &index)
 {
+    if (SUCCEEDED(m_modulesSources.GetIndexBySourceFullPath(fullPath, index)))
+        return S_OK;
+
+    // Source file could be provided by module with not finished yet deferred work.
+    WaitDeferredWork();
     return m_modulesSources.GetIndexBySourceFullPath(fullPath, index);
 }
 
 void Modules::FindFileNames(string_view pattern, unsigned limit, std::function<void(const char *)> cb)
 {
+    WaitDeferredWork();
     m_modulesSources.FindFileNames(pattern, limit, cb);
 }
 
@@ -9,8 +9,12 @@
 
 #include <functional>
 #include <unordered_map>
+#include <unordered_set>
 #include <mutex>
 #include <memory>
+#include <list>
+#include <thread>
+#include <condition_variable>
 #include "interfaces/types.h"
 #include "metadata/modules_app_update.h"
 #include "metadata/modules_sources.h"
@@ -57,6 +61,9 @@ class Modules
 {
 public:
 
+    Modules() = default;
+    ~Modules();
+
     struct SequencePoint {
         int32_t startLine;
         int32_t startColumn;
@@ -123,6 +130,18 @@ public:
 
     void CleanupAllModules();
 
+    // Wait for deferred symbols related work (methods ranges load and JMC attributes scan) for module,
+    // in case modAddress is 0 - for all modules. Queued and not started yet work will be executed in caller's thread.
+    // Note, caller must not hold m_modulesInfoMutex.
+    void WaitDeferredWork(CORDB_ADDRESS modAddress = 0);
+    // Same as WaitDeferredWork(), but wait only for module of thread's active frame.
+    void WaitDeferredWork(ICorDebugThread *pThread);
+    // Set JMC status for all methods/classes found by finished deferred work.
+    // Note, process must be stopped, since JMC status can't be changed for running process.
+    // Note, JMC status for module's not user code is applied at first stop after work finished, so, code of module
+    // loaded during step could be treated as user code by runtime's JMC stepper until next stop (known limitation).
+    void ApplyDeferredJMC();
+
     HRESULT GetFrameNamedLocalVariable(
         ICorDebugModule *pModule,
         mdMethodDef methodToken,
@@ -169,6 +188,56 @@ private:
     // Note, m_modulesSources have its own mutex for private data state sync.
     ModulesSources m_modulesSources;
 
+    // Heavy symbols related work, that could be done in parallel for different modules and out of LoadModule callback.
+    struct DeferredWork
+    {
+        enum class State
+        {
+            Queued,
+            Running,
+            Done
+        };
+
+        State m_state;
+        ToRelease<ICorDebugModule> m_iCorModule;
+        ToRelease<IMetaDataImport> m_iMDImport;
+        PVOID m_pSymbolReaderHandle;
+        bool m_needJMC;
+        std::vector<mdToken> m_nonJMCTokens;
+        // Module's PDB documents file names (without path), loaded on demand for breakpoint resolve pre-filter.
+        bool m_documentsLoaded;
+        std::unordered_set<std::string> m_documentsFileNames;
+
+        DeferredWork(ICorDebugModule *pModule, IMetaDataImport *pMDImport, PVOID pSymbolReaderHandle, bool needJMC) :
+            m_state(State::Queued),
+            m_iCorModule(pModule),
+            m_iMDImport(pMDImport),
+            m_pSymbolReaderHandle(pSymbolReaderHandle),
+            m_needJMC(needJMC),
+            m_documentsLoaded(false)
+        {}
+    };
+
+    // Note, in case m_modulesInfoMutex + m_deferredWorkMutex, m_modulesInfoMutex must be locked first.
+    std::mutex m_deferredWorkMutex;
+    // Used by workers to wait for new work in m_deferredWorkQueue.
+    std::condition_variable m_deferredWorkCV;
+    // Used by WaitDeferredWork() to wait for work status change to Done (and by CleanupAllModules() for m_documentsLoadingNum).
+    std::condition_variable m_deferredWorkDoneCV;
+    // Number of PDB documents enumerations in progress out of m_deferredWorkMutex (see WaitDeferredWorkForSource()).
+    size_t m_documentsLoadingNum = 0;
+    // All not applied yet work (queued, running and done), module's base address is key.
+    std::unordered_map<CORDB_ADDRESS, std::shared_ptr<DeferredWork>> m_deferredWork;
+    std::list<CORDB_ADDRESS> m_deferredWorkQueue;
+    std::vector<std::thread> m_deferredWorkers;
+    bool m_deferredWorkersExit = false;
+
+    void AddDeferredWork(ICorDebugModule *pModule, IMetaDataImport *pMDImport, PVOID pSymbolReaderHandle, bool needJMC);
+    void DeferredWorker();
+    void RunDeferredWork(std::unique_lock<std::mutex> &lock, const std::shared_ptr<DeferredWork> &work);
+    // Same as WaitDeferredWork(), but wait only for modules, that have source file with same file name as `filename` in PDB.
+    void WaitDeferredWorkForSource(CORDB_ADDRESS modAddress, const std::string &filename);
+
     HRESULT GetSequencePointByILOffset(
         PVOID pSymbolReaderHandle,
         mdMethodDef methodToken,
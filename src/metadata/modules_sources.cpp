@@ -9,6 +9,8 @@
 #include <fstream>
 
 #include "metadata/modules_sources.h"
+#include "metadata/modules_sources_cache.h"
+#include "metadata/modules_sources_lookup.h"
 #include "metadata/modules.h"
 #include "metadata/jmc.h"
 #include "managed/interop.h"
@@ -137,60 +139,7 @@ namespace
                                      /*out*/ std::vector<mdMethodDef> &Tokens,
                                      /*out*/ mdMethodDef &closestNestedToken)
     {
-        const method_data_t *result = nullptr;
-        closestNestedToken = 0;
-
-        for (auto it = methodBpData.cbegin(); it != methodBpData.cend(); ++it)
-        {
-            auto lower = std::lower_bound((*it).cbegin(), (*it).cend(), lineNum);
-            if (lower == (*it).cend())
-                break; // point behind last method for this nested level
-
-            // case with first line of method, for example:
-            // void Method(){ 
-            //            void Method(){ void Method(){...  <- breakpoint at this line
-            if (lineNum == (*lower).startLine)
-            {
-                // At this point we can't check this case, let managed part decide (since it see Columns):
-                // void Method() {
-                // ... code ...; void Method() {     <- breakpoint at this line
-                //  };
-                if (result)
-                    closestNestedToken = (*lower).methodDef;
-                else
-                    result = &(*lower);
-
-                break;
-            }
-            else if (lineNum > (*lower).startLine && (*lower).endLine >= lineNum)
-            {
-                result = &(*lower);
-                continue; // need check nested level (if available)
-            }
-            // out of first level methods lines - forced move line to first method below, for example:
-            //  <-- breakpoint at line without code (out of any methods)
-            // void Method() {...}
-            else if (it == methodBpData.cbegin() && lineNum < (*lower).startLine)
-            {
-                lineNum = (*lower).startLine;
-                result = &(*lower);
-                break;
-            }
-            // result was found on previous cycle, check for closest nested method
-            // need it in case of breakpoint setuped at lines without code and before nested method, for example:
-            // {
-            //  <-- breakpoint at line without code (inside method)
-            //     void Method() {...}
-            // }
-            else if (result && lineNum <= (*lower).startLine && (*lower).endLine <= result->endLine)
-            {
-                closestNestedToken = (*lower).methodDef;
-                break;
-            }
-            else
-                break;
-        }
-
+        const method_data_t *result = FindMethodByLineNumber(methodBpData, lineNum, closestNestedToken);
         if (result)
         {
             auto find = multiMethodBpData.find(*result);
@@ -201,7 +150,7 @@ namespace
             }
             Tokens.emplace_back(result->methodDef);
         }
-        
+
         return !!result;
     }
 
@@ -267,10 +216,15 @@ static std::string GetFileName(const std::string &path)
     return i == std::string::npos ? path : path.substr(i + 1);
 }
 
-// Caller must care about m_sourcesInfoMutex.
+// Caller must care about m_sourcesInfoRWLock.
 HRESULT ModulesSources::GetFullPathIndex(BSTR document, unsigned &fullPathIndex)
 {
-    std::string fullPath = to_utf8(document);
+    return GetFullPathIndex(to_utf8(document), fullPathIndex);
+}
+
+// Caller must care about m_sourcesInfoRWLock.
+HRESULT ModulesSources::GetFullPathIndex(std::string fullPath, unsigned &fullPathIndex)
+{
 #ifdef WIN32
     HRESULT Status;
     std::string initialFullPath = fullPath;
@@ -294,33 +248,85 @@ HRESULT ModulesSources::GetFullPathIndex(BSTR document, unsigned &fullPathIndex)
     return S_OK;
 }
 
-HRESULT ModulesSources::FillSourcesCodeLinesForModule(ICorDebugModule *pModule, IMetaDataImport *pMDImport, PVOID pSymbolReaderHandle)
+// Caller must care about m_sourcesInfoRWLock.
+HRESULT ModulesSources::AddFilesMethodsData(std::vector<std::pair<std::string, FileMethodsData>> &filesMethodsData)
 {
-    std::lock_guard<std::mutex> lock(m_sourcesInfoMutex);
-
     HRESULT Status;
-    std::unique_ptr<module_methods_data_t, module_methods_data_t_deleter> inputData;
-    IfFailRet(GetPdbMethodsRanges(pMDImport, pSymbolReaderHandle, nullptr, inputData));
-    if (inputData == nullptr)
-        return S_OK;
 
     // Usually, modules provide files with unique full paths for sources.
-    m_sourceIndexToPath.reserve(m_sourceIndexToPath.size() + inputData->fileNum);
-    m_sourcesMethodsData.reserve(m_sourcesMethodsData.size() + inputData->fileNum);
+    m_sourceIndexToPath.reserve(m_sourceIndexToPath.size() + filesMethodsData.size());
+    m_sourcesMethodsData.reserve(m_sourcesMethodsData.size() + filesMethodsData.size());
 #ifdef WIN32
-    m_sourceIndexToInitialFullPath.reserve(m_sourceIndexToInitialFullPath.size() + inputData->fileNum);
+    m_sourceIndexToInitialFullPath.reserve(m_sourceIndexToInitialFullPath.size() + filesMethodsData.size());
 #endif
 
+    for (auto &fileMethodsData : filesMethodsData)
+    {
+        unsigned fullPathIndex;
+        IfFailRet(GetFullPathIndex(fileMethodsData.first, fullPathIndex));
+        m_sourcesMethodsData[fullPathIndex].emplace_back(std::move(fileMethodsData.second));
+    }
+
+    m_sourcesMethodsData.shrink_to_fit();
+    m_sourceIndexToPath.shrink_to_fit();
+#ifdef WIN32
+    m_sourceIndexToInitialFullPath.shrink_to_fit();
+#endif
+
+    return S_OK;
+}
+
+// Note, could be called for different modules in parallel, all heavy work (PDB data read and methods data ordering)
+// is done without m_sourcesInfoRWLock lock, lock is taken only for add prepared data into containers.
+HRESULT ModulesSources::FillSourcesCodeLinesForModule(ICorDebugModule *pModule, IMetaDataImport *pMDImport, PVOID pSymbolReaderHandle)
+{
+    HRESULT Status;
     CORDB_ADDRESS modAddress;
     IfFailRet(pModule->GetBaseAddress(&modAddress));
 
-    for (int i = 0; i < inputData->fileNum; i++)
+    std::vector<std::pair<std::string, FileMethodsData>> filesMethodsData;
+
+    std::string cacheFilePath;
+    if (ModulesSourcesCache::GetCacheFilePath(pModule, pMDImport, cacheFilePath) == S_OK)
     {
-        unsigned fullPathIndex;
-        IfFailRet(GetFullPathIndex(inputData->moduleMethodsData[i].document, fullPathIndex));
+        ModulesSourcesCache::View cacheView;
+        if (SUCCEEDED(ModulesSourcesCache::Load(cacheFilePath, cacheView)))
+        {
+            filesMethodsData.resize(cacheView.FilesNum());
+            for (uint32_t i = 0; i < cacheView.FilesNum(); i++)
+            {
+                filesMethodsData[i].first = cacheView.FilePath(i);
+                auto &fileMethodsData = filesMethodsData[i].second;
+                fileMethodsData.modAddress = modAddress;
 
-        m_sourcesMethodsData[fullPathIndex].emplace_back(FileMethodsData{});
-        auto &fileMethodsData = m_sourcesMethodsData[fullPathIndex].back();
+                // Note, cache store already ordered on each nested level data, so, only one allocation per level needed.
+                fileMethodsData.methodsData.resize(cacheView.LevelsNum(i));
+                for (uint32_t level = 0; level < fileMethodsData.methodsData.size(); level++)
+                {
+                    uint32_t methodsNum;
+                    const method_data_t *methods = cacheView.LevelMethods(i, level, methodsNum);
+                    fileMethodsData.methodsData[level].assign(methods, methods + methodsNum);
+                }
+                cacheView.CopyMultiMethodsData(i, fileMethodsData.multiMethodsData);
+            }
+
+            std::lock_guard<Utility::RWLock::Writer> lock(m_sourcesInfoRWLock.writer);
+            return AddFilesMethodsData(filesMethodsData);
+        }
+    }
+
+    std::unique_ptr<module_methods_data_t, module_methods_data_t_deleter> inputData;
+    IfFailRet(GetPdbMethodsRanges(pMDImport, pSymbolReaderHandle, nullptr, inputData));
+    if (inputData == nullptr)
+        return S_OK;
+
+    ModulesSourcesCache::Writer cacheWriter;
+
+    filesMethodsData.resize(inputData->fileNum);
+    for (int i = 0; i < inputData->fileNum; i++)
+    {
+        filesMethodsData[i].first = to_utf8(inputData->moduleMethodsData[i].document);
+        auto &fileMethodsData = filesMethodsData[i].second;
         fileMethodsData.modAddress = modAddress;
 
         // Note, don't reorder input data, since it have almost ideal order for us.
@@ -348,15 +354,16 @@ HRESULT ModulesSources::FillSourcesCodeLinesForModule(ICorDebugModule *pModule,
         {
             data.second.shrink_to_fit();
         }
+
+        if (!cacheFilePath.empty())
+            cacheWriter.AddFile(filesMethodsData[i].first, fileMethodsData.methodsData, fileMethodsData.multiMethodsData);
     }
 
-    m_sourcesMethodsData.shrink_to_fit();
-    m_sourceIndexToPath.shrink_to_fit();
-#ifdef WIN32
-    m_sourceIndexToInitialFullPath.shrink_to_fit();
-#endif
+    if (!cacheFilePath.empty() && !cacheWriter.Save(cacheFilePath))
+        LOGW("Could not save sources cache file %s", cacheFilePath.c_str());
 
-    return S_OK;
+    std::lock_guard<Utility::RWLock::Writer> lock(m_sourcesInfoRWLock.writer);
+    return AddFilesMethodsData(filesMethodsData);
 }
 
 HRESULT ModulesSources::LineUpdatesForMethodData(ICorDebugModule *pModule, unsigned fullPathIndex, method_data_t &methodData,
@@ -471,7 +478,7 @@ HRESULT ModulesSources::LineUpdatesForMethodData(ICorDebugModule *pModule, unsig
 HRESULT ModulesSources::UpdateSourcesCodeLinesForModule(ICorDebugModule *pModule, IMetaDataImport *pMDImport, std::unordered_set<mdMethodDef> methodTokens,
                                                         src_block_updates_t &srcBlockUpdates, ModuleInfo &mdInfo)
 {
-    std::lock_guard<std::mutex> lock(m_sourcesInfoMutex);
+    std::lock_guard<Utility::RWLock::Writer> lock(m_sourcesInfoRWLock.writer);
 
     HRESULT Status;
     std::unique_ptr<module_methods_data_t, module_methods_data_t_deleter> inputData;
@@ -599,7 +606,7 @@ HRESULT ModulesSources::UpdateSourcesCodeLinesForModule(ICorDebugModule *pModule
 
 HRESULT ModulesSources::ResolveRelativeSourceFileName(std::string &filename)
 {
-    // IMPORTANT! Caller should care about m_sourcesInfoMutex.
+    // IMPORTANT! Caller should care about m_sourcesInfoRWLock.
     auto findIndexesByFileName = m_sourceNameToFullPathsIndexes.find(GetFileName(filename));
     if (findIndexesByFileName == m_sourceNameToFullPathsIndexes.end())
         return E_FAIL;
@@ -709,31 +716,76 @@ static void LineUpdatesBackwardCorrection(unsigned fullPathIndex, mdMethodDef me
 HRESULT ModulesSources::ResolveBreakpoint(/*in*/ Modules *pModules, /*in*/ CORDB_ADDRESS modAddress, /*in*/ std::string filename, /*out*/ unsigned &fullname_index,
                                           /*in*/ int sourceLine, /*out*/ std::vector<resolved_bp_t> &resolvedPoints)
 {
-    std::lock_guard<std::mutex> lockSourcesInfo(m_sourcesInfoMutex);
-
     HRESULT Status;
-    auto findIndex = m_sourcePathToIndex.find(filename);
-    if (findIndex == m_sourcePathToIndex.end())
+
+    struct methods_lookup_t
     {
-        // Check for absolute path.
+        CORDB_ADDRESS modAddress;
+        std::vector<mdMethodDef> Tokens;
+        int32_t correctedStartLine;
+        mdMethodDef closestNestedToken;
+    };
+    std::vector<methods_lookup_t> methodsLookup;
+    unsigned fullPathIndex;
+    std::string fullName;
+
+    // Note, only methods lookup is done under m_sourcesInfoRWLock, all related to managed part calls (that are the most
+    // time consuming part) are done out of the lock, so, breakpoint resolve don't block modules load in parallel.
+    {
+        std::lock_guard<Utility::RWLock::Reader> lockSourcesInfo(m_sourcesInfoRWLock.reader);
+
+        auto findIndex = m_sourcePathToIndex.find(filename);
+        if (findIndex == m_sourcePathToIndex.end())
+        {
+            // Check for absolute path.
 #ifdef WIN32
-        // Check, if start from drive letter, for example "D:\" or "D:/".
-        if (filename.size() > 2 && filename[1] == ':' && (filename[2] == '/' || filename[2] == '\\'))
+            // Check, if start from drive letter, for example "D:\" or "D:/".
+            if (filename.size() > 2 && filename[1] == ':' && (filename[2] == '/' || filename[2] == '\\'))
 #else
-        if (filename[0] == '/')
+            if (filename[0] == '/')
 #endif
-        {
-            return E_FAIL;
+            {
+                return E_FAIL;
+            }
+
+            IfFailRet(ResolveRelativeSourceFileName(filename));
+
+            findIndex = m_sourcePathToIndex.find(filename);
+            if (findIndex == m_sourcePathToIndex.end())
+                return E_FAIL;
         }
 
-        IfFailRet(ResolveRelativeSourceFileName(filename));
+        fullPathIndex = findIndex->second;
+#ifndef _WIN32
+        fullName = m_sourceIndexToPath[fullPathIndex];
+#else
+        fullName = m_sourceIndexToInitialFullPath[fullPathIndex];
+#endif
 
-        findIndex = m_sourcePathToIndex.find(filename);
-        if (findIndex == m_sourcePathToIndex.end())
-            return E_FAIL;
+        for (const auto &sourceData : m_sourcesMethodsData[fullPathIndex])
+        {
+            if (modAddress && modAddress != sourceData.modAddress)
+                continue;
+
+            methods_lookup_t lookup;
+            lookup.modAddress = sourceData.modAddress;
+            lookup.correctedStartLine = sourceLine;
+            // correctedStartLine - in case line not belong any methods, if possible, will be "moved" to first line of method below sourceLine.
+            if (!GetMethodTokensByLineNumber(sourceData.methodsData, sourceData.multiMethodsData, lookup.correctedStartLine,
+                                             lookup.Tokens, lookup.closestNestedToken))
+                continue;
+
+            if ((int32_t)lookup.Tokens.size() > std::numeric_limits<int32_t>::max())
+            {
+                LOGE("Too big token arrays.");
+                return E_FAIL;
+            }
+
+            methodsLookup.emplace_back(std::move(lookup));
+        }
     }
 
-    fullname_index = findIndex->second;
+    fullname_index = fullPathIndex;
 
     struct resolved_input_bp_t
     {
@@ -751,34 +803,18 @@ HRESULT ModulesSources::ResolveBreakpoint(/*in*/ Modules *pModules, /*in*/ CORDB
         }
     };
 
-    for (const auto &sourceData : m_sourcesMethodsData[findIndex->second])
+    for (auto &lookup : methodsLookup)
     {
-        if (modAddress && modAddress != sourceData.modAddress)
-            continue;
-
-        std::vector<mdMethodDef> Tokens;
-        int32_t correctedStartLine = sourceLine;
-        mdMethodDef closestNestedToken = 0;
-        if (!GetMethodTokensByLineNumber(sourceData.methodsData, sourceData.multiMethodsData, correctedStartLine, Tokens, closestNestedToken))
-            continue;
-        // correctedStartLine - in case line not belong any methods, if possible, will be "moved" to first line of method below sourceLine.
-
-        if ((int32_t)Tokens.size() > std::numeric_limits<int32_t>::max())
-        {
-            LOGE("Too big token arrays.");
-            return E_FAIL;
-        }
-
         ModuleInfo *pmdInfo; // Note, pmdInfo must be covered by m_modulesInfoMutex.
-        IfFailRet(pModules->GetModuleInfo(sourceData.modAddress, &pmdInfo)); // we must have it, since we loaded data from it
+        IfFailRet(pModules->GetModuleInfo(lookup.modAddress, &pmdInfo)); // we must have it, since we loaded data from it
         if (pmdInfo->m_symbolReaderHandles.empty())
             continue;
 
         // In case one source line (field/property initialization) compiled into all constructors, after Hot Reload, constructors may have different
         // code version numbers, that mean debug info located in different symbol readers.
         std::vector<PVOID> symbolReaderHandles;
-        symbolReaderHandles.reserve(Tokens.size());
-        for (auto methodToken : Tokens)
+        symbolReaderHandles.reserve(lookup.Tokens.size());
+        for (auto methodToken : lookup.Tokens)
         {
             // Note, new breakpoints could be setup for last code version only, since protocols (MI, VSCode, ...) provide source:line data only.
             ULONG32 currentVersion;
@@ -795,17 +831,12 @@ HRESULT ModulesSources::ResolveBreakpoint(/*in*/ Modules *pModules, /*in*/ CORDB
         }
 
         // In case Hot Reload we may have line updates that we must take into account.
-        LineUpdatesBackwardCorrection(findIndex->second, Tokens[0], pmdInfo->m_methodBlockUpdates, correctedStartLine);
+        LineUpdatesBackwardCorrection(fullPathIndex, lookup.Tokens[0], pmdInfo->m_methodBlockUpdates, lookup.correctedStartLine);
 
         PVOID data = nullptr;
         int32_t Count = 0;
-#ifndef _WIN32
-        std::string fullName = m_sourceIndexToPath[findIndex->second];
-#else
-        std::string fullName = m_sourceIndexToInitialFullPath[findIndex->second];
-#endif
-        if (FAILED(Interop::ResolveBreakPoints(symbolReaderHandles.data(), (int32_t)Tokens.size(), Tokens.data(),
-                                               correctedStartLine, closestNestedToken, Count, fullName, &data))
+        if (FAILED(Interop::ResolveBreakPoints(symbolReaderHandles.data(), (int32_t)lookup.Tokens.size(), lookup.Tokens.data(),
+                                               lookup.correctedStartLine, lookup.closestNestedToken, Count, fullName, &data))
             || data == nullptr)
         {
             continue;
@@ -817,7 +848,7 @@ HRESULT ModulesSources::ResolveBreakpoint(/*in*/ Modules *pModules, /*in*/ CORDB
             pmdInfo->m_iCorModule->AddRef();
 
             // In case Hot Reload we may have line updates that we must take into account.
-            LineUpdatesForwardCorrection(findIndex->second, inputData.get()[i].methodToken, pmdInfo->m_methodBlockUpdates, inputData.get()[i]);
+            LineUpdatesForwardCorrection(fullPathIndex, inputData.get()[i].methodToken, pmdInfo->m_methodBlockUpdates, inputData.get()[i]);
 
             resolvedPoints.emplace_back(resolved_bp_t(inputData.get()[i].startLine, inputData.get()[i].endLine, inputData.get()[i].ilOffset,
                                                       inputData.get()[i].methodToken, pmdInfo->m_iCorModule.GetPtr()));
@@ -947,7 +978,7 @@ HRESULT ModulesSources::ApplyPdbDeltaAndLineUpdates(Modules *pModules, ICorDebug
 
 HRESULT ModulesSources::GetSourceFullPathByIndex(unsigned index, std::string &fullPath)
 {
-    std::lock_guard<std::mutex> lock(m_sourcesInfoMutex);
+    std::lock_guard<Utility::RWLock::Reader> lock(m_sourcesInfoRWLock.reader);
 
     if (m_sourceIndexToPath.size() <= index)
         return E_FAIL;
@@ -968,7 +999,7 @@ HRESULT ModulesSources::GetIndexBySourceFullPath(std::string fullPath, unsigned
     IfFailRet(Interop::StringToUpper(fullPath));
 #endif
 
-    std::lock_guard<std::mutex> lock(m_sourcesInfoMutex);
+    std::lock_guard<Utility::RWLock::Reader> lock(m_sourcesInfoRWLock.reader);
 
     auto findIndex = m_sourcePathToIndex.find(fullPath);
     if (findIndex == m_sourcePathToIndex.end())
@@ -1007,7 +1038,7 @@ void ModulesSources::FindFileNames(Utility::string_view pattern, unsigned limit,
         return true;
     };
 
-    std::lock_guard<std::mutex> lock(m_sourcesInfoMutex);
+    std::lock_guard<Utility::RWLock::Reader> lock(m_sourcesInfoRWLock.reader);
     for (const auto &pair : m_sourceNameToFullPathsIndexes)
     {
         LOGD("first '%s'", pair.first.c_str());
@@ -8,11 +8,13 @@
 #include "cordebug.h"
 
 #include <set>
+#include <string>
 #include <mutex>
 #include <functional>
 #include <unordered_set>
 #include <unordered_map>
 #include <vector>
+#include "utils/rwlock.h"
 #include "utils/string_view.h"
 #include "utils/torelease.h"
 
@@ -178,7 +180,8 @@ private:
     };
 
     // Note, breakpoints setup and ran debuggee's process could be in the same time.
-    std::mutex m_sourcesInfoMutex;
+    // Read-only access (breakpoints resolve, source paths lookup) don't block each other, only data add/update take writer lock.
+    Utility::RWLock m_sourcesInfoRWLock;
     // Note, we only add to m_sourceIndexToPath/m_sourcePathToIndex/m_sourceIndexToInitialFullPath, "size()" used as index in map at new element add.
     // m_sourceIndexToPath - mapping index to full path
     std::vector<std::string> m_sourceIndexToPath;
@@ -191,6 +194,8 @@ private:
     std::vector<std::vector<FileMethodsData>> m_sourcesMethodsData;
 
     HRESULT GetFullPathIndex(BSTR document, unsigned &fullPathIndex);
+    HRESULT GetFullPathIndex(std::string fullPath, unsigned &fullPathIndex);
+    HRESULT AddFilesMethodsData(std::vector<std::pair<std::string, FileMethodsData>> &filesMethodsData);
     HRESULT UpdateSourcesCodeLinesForModule(ICorDebugModule *pModule, IMetaDataImport *pMDImport, std::unordered_set<mdMethodDef> methodTokens,
                                             src_block_updates_t &blockUpdates, ModuleInfo &mdInfo);
     HRESULT ResolveRelativeSourceFileName(std::string &filename);
@@ -0,0 +1,174 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "metadata/modules_sources_cache.h"
+
+#include <cstdlib>
+#include <cstring>
+#include "utils/filesystem.h"
+#include "utils/logger.h"
+
+namespace netcoredbg
+{
+
+// Note, all PE related offsets below are defined by "PE Format" specification.
+// https://learn.microsoft.com/en-us/windows/win32/debug/pe-format
+static const uint32_t IMAGE_DEBUG_TYPE_CODEVIEW_ = 2;
+static const uint32_t CodeViewSignatureRSDS = 0x53445352; // 'RSDS'
+
+struct pdb_id_t
+{
+    GUID guid;
+    uint32_t age;
+    uint32_t stamp;
+};
+
+static HRESULT ReadModuleMemory(ICorDebugProcess *pProcess, CORDB_ADDRESS modAddress, ULONG32 modSize,
+                                uint32_t rva, DWORD size, void *buffer)
+{
+    if ((uint64_t)rva + size > modSize)
+        return E_FAIL;
+
+    HRESULT Status;
+    SIZE_T read = 0;
+    IfFailRet(pProcess->ReadMemory(modAddress + rva, size, (BYTE*)buffer, &read));
+    return read == size ? S_OK : E_FAIL;
+}
+
+// Note, for loaded (not file) layout RVA could be used as offset from module's base address.
+static HRESULT GetModulePdbId(ICorDebugModule *pModule, pdb_id_t &pdbId)
+{
+    HRESULT Status;
+    ToRelease<ICorDebugProcess> iCorProcess;
+    IfFailRet(pModule->GetProcess(&iCorProcess));
+    CORDB_ADDRESS modAddress;
+    IfFailRet(pModule->GetBaseAddress(&modAddress));
+    ULONG32 modSize;
+    IfFailRet(pModule->GetSize(&modSize));
+
+    uint16_t dosMagic;
+    IfFailRet(ReadModuleMemory(iCorProcess, modAddress, modSize, 0, sizeof(dosMagic), &dosMagic));
+    if (dosMagic != 0x5A4D) // 'MZ'
+        return E_FAIL;
+    uint32_t peOffset;
+    IfFailRet(ReadModuleMemory(iCorProcess, modAddress, modSize, 0x3C, sizeof(peOffset), &peOffset));
+
+    // PE signature (4 bytes) + COFF file header (20 bytes) + optional header magic (2 bytes).
+    uint8_t ntHeaders[26];
+    IfFailRet(ReadModuleMemory(iCorProcess, modAddress, modSize, peOffset, sizeof(ntHeaders), ntHeaders));
+    if (memcmp(ntHeaders, "PE\0\0", 4) != 0)
+        return E_FAIL;
+
+    uint16_t optMagic;
+    memcpy(&optMagic, ntHeaders + 24, sizeof(optMagic));
+    uint32_t dataDirOffset;
+    if (optMagic == 0x10b) // PE32
+        dataDirOffset = peOffset + 24 + 96;
+    else if (optMagic == 0x20b) // PE32+
+        dataDirOffset = peOffset + 24 + 112;
+    else
+        return E_FAIL;
+
+    const uint32_t debugDirIndex = 6;
+    uint32_t debugDir[2]; // RVA, Size
+    IfFailRet(ReadModuleMemory(iCorProcess, modAddress, modSize, dataDirOffset + debugDirIndex * 8, sizeof(debugDir), debugDir));
+
+    struct image_debug_directory_t
+    {
+        uint32_t characteristics;
+        uint32_t timeDateStamp;
+        uint16_t majorVersion;
+        uint16_t minorVersion;
+        uint32_t type;
+        uint32_t sizeOfData;
+        uint32_t addressOfRawData;
+        uint32_t pointerToRawData;
+    };
+    static_assert(sizeof(image_debug_directory_t) == 28, "Wrong IMAGE_DEBUG_DIRECTORY size");
+
+    const uint32_t entriesNum = debugDir[1] / sizeof(image_debug_directory_t);
+    for (uint32_t i = 0; i < entriesNum; i++)
+    {
+        image_debug_directory_t entry;
+        IfFailRet(ReadModuleMemory(iCorProcess, modAddress, modSize, debugDir[0] + i * (uint32_t)sizeof(entry), sizeof(entry), &entry));
+        if (entry.type != IMAGE_DEBUG_TYPE_CODEVIEW_ || entry.addressOfRawData == 0)
+            continue;
+
+        uint8_t codeView[24]; // signature + GUID + age
+        IfFailRet(ReadModuleMemory(iCorProcess, modAddress, modSize, entry.addressOfRawData, sizeof(codeView), codeView));
+        uint32_t signature;
+        memcpy(&signature, codeView, sizeof(signature));
+        if (signature != CodeViewSignatureRSDS)
+            continue;
+
+        memcpy(&pdbId.guid, codeView + 4, sizeof(pdbId.guid));
+        memcpy(&pdbId.age, codeView + 20, sizeof(pdbId.age));
+        pdbId.stamp = entry.timeDateStamp;
+        return S_OK;
+    }
+
+    return E_FAIL;
+}
+
+static void AppendHex(std::string &str, const void *data, size_t size)
+{
+    static const char digits[] = "0123456789abcdef";
+    const uint8_t *ptr = (const uint8_t*)data;
+    for (size_t i = 0; i < size; i++)
+    {
+        str += digits[ptr[i] >> 4];
+        str += digits[ptr[i] & 0xF];
+    }
+}
+
+HRESULT ModulesSourcesCache::GetCacheFilePath(ICorDebugModule *pModule, IMetaDataImport *pMDImport, std::string &cacheFilePath)
+{
+    static const char *cacheDir = getenv("NETCOREDBG_SOURCES_CACHE");
+    if (cacheDir == nullptr || *cacheDir == '\0')
+        return S_FALSE;
+
+    HRESULT Status;
+    BOOL isDynamic = FALSE;
+    BOOL isInMemory = FALSE;
+    IfFailRet(pModule->IsDynamic(&isDynamic));
+    IfFailRet(pModule->IsInMemory(&isInMemory));
+    if (isDynamic || isInMemory)
+        return S_FALSE;
+
+    GUID mvid;
+    IfFailRet(pMDImport->GetScopeProps(nullptr, 0, nullptr, &mvid));
+
+    pdb_id_t pdbId;
+    if (FAILED(GetModulePdbId(pModule, pdbId)))
+        return S_FALSE;
+
+    cacheFilePath = cacheDir;
+    if (cacheFilePath.back() != '/' && cacheFilePath.back() != '\\')
+        cacheFilePath += FileSystem::PathSeparator;
+    AppendHex(cacheFilePath, &mvid, sizeof(mvid));
+    cacheFilePath += '-';
+    AppendHex(cacheFilePath, &pdbId.guid, sizeof(pdbId.guid));
+    cacheFilePath += '-';
+    AppendHex(cacheFilePath, &pdbId.age, sizeof(pdbId.age));
+    AppendHex(cacheFilePath, &pdbId.stamp, sizeof(pdbId.stamp));
+    cacheFilePath += ".srcs";
+
+    return S_OK;
+}
+
+HRESULT ModulesSourcesCache::Load(const std::string &cacheFilePath, View &view)
+{
+    switch (view.Load(cacheFilePath))
+    {
+    case SourcesCacheFile::ReadResult::Ok:
+        return S_OK;
+    case SourcesCacheFile::ReadResult::NotFound:
+        return COR_E_FILENOTFOUND;
+    default:
+        LOGW("Broken sources cache file %s", cacheFilePath.c_str());
+        return E_FAIL;
+    }
+}
+
+} // namespace netcoredbg
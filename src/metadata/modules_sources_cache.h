@@ -0,0 +1,36 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include "cor.h"
+#include "cordebug.h"
+
+#include <string>
+#include "metadata/modules_sources.h"
+#include "metadata/modules_sources_cache_file.h"
+
+namespace netcoredbg
+{
+
+// On-disk cache for module's methods ranges data (result of FillSourcesCodeLinesForModule()), aimed to avoid
+// PDB reading and managed interop calls for modules that were already loaded in previous debug sessions.
+// Cache is enabled only in case NETCOREDBG_SOURCES_CACHE environment variable provide directory for cache files.
+// Cache file name is content-addressed - based on module's MVID and PDB ID (GUID/age + stamp from CodeView debug directory entry),
+// so, any rebuilt module or PDB will have its own cache file.
+//
+// File format see in modules_sources_cache_file.h.
+class ModulesSourcesCache
+{
+public:
+
+    typedef SourcesCacheFile::View<method_data_t, mdMethodDef, method_data_t_hash> View;
+    typedef SourcesCacheFile::Writer<method_data_t, mdMethodDef, method_data_t_hash> Writer;
+
+    // Return S_FALSE in case cache disabled or module can't be cached (dynamic or in memory module, no CodeView record, etc.).
+    static HRESULT GetCacheFilePath(ICorDebugModule *pModule, IMetaDataImport *pMDImport, std::string &cacheFilePath);
+    static HRESULT Load(const std::string &cacheFilePath, View &view);
+};
+
+} // namespace netcoredbg
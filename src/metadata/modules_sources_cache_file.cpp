@@ -0,0 +1,98 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "metadata/modules_sources_cache_file.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace netcoredbg
+{
+namespace SourcesCacheFile
+{
+
+static const char cacheMagic[8] = {'N', 'C', 'D', 'B', 'S', 'R', 'C', 'S'};
+static const uint32_t cacheVersion = 1;
+
+void InitHeader(header_t &header)
+{
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, cacheMagic, sizeof(cacheMagic));
+    header.version = cacheVersion;
+}
+
+bool CheckHeader(const header_t &header)
+{
+    return memcmp(header.magic, cacheMagic, sizeof(cacheMagic)) == 0 && header.version == cacheVersion;
+}
+
+ReadResult ReadCacheFile(const std::string &cacheFilePath, std::vector<char> &buffer)
+{
+    std::ifstream cacheFileStream(cacheFilePath, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!cacheFileStream.is_open())
+        return ReadResult::NotFound;
+
+    std::streamoff fileSize = cacheFileStream.tellg();
+    if (fileSize <= 0 || (uint64_t)fileSize > std::numeric_limits<uint32_t>::max())
+        return ReadResult::Failed;
+
+    buffer.resize((size_t)fileSize);
+    cacheFileStream.seekg(0, std::ios::beg);
+    cacheFileStream.read(buffer.data(), fileSize);
+    if (cacheFileStream.fail())
+    {
+        buffer.clear();
+        return ReadResult::Failed;
+    }
+
+    return ReadResult::Ok;
+}
+
+bool WriteCacheFile(const std::string &cacheFilePath, const std::vector<std::pair<const void*, size_t>> &chunks)
+{
+    // Note, temporary file name must be unique for debugger instances, that could write same cache file at the same time.
+#ifdef _WIN32
+    const unsigned pid = unsigned(GetCurrentProcessId());
+#else
+    const unsigned pid = unsigned(getpid());
+#endif
+    const std::string tmpFilePath = cacheFilePath + ".tmp" + std::to_string(pid);
+    {
+        std::ofstream cacheFileStream(tmpFilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!cacheFileStream.is_open())
+            return false;
+
+        for (const auto &chunk : chunks)
+        {
+            if (chunk.second != 0)
+                cacheFileStream.write((const char*)chunk.first, chunk.second);
+        }
+        cacheFileStream.close();
+
+        if (cacheFileStream.fail())
+        {
+            std::remove(tmpFilePath.c_str());
+            return false;
+        }
+    }
+
+    if (std::rename(tmpFilePath.c_str(), cacheFilePath.c_str()) != 0)
+    {
+        std::remove(tmpFilePath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace SourcesCacheFile
+} // namespace netcoredbg
@@ -0,0 +1,264 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace netcoredbg
+{
+
+// Modules sources cache file format (see ModulesSourcesCache), file have flat layout (all data 4 bytes aligned and
+// addressed by offsets), so, it could be read by one call or mapped into memory:
+//   header_t
+//   file_t[filesNum]
+//   level_t[levelsNum]
+//   Method[methodsNum]
+//   multi_t<Method>[multiNum]
+//   Token[multiTokensNum]
+//   char[stringsSize]
+// Note, no CoreCLR headers dependency here, Method must be trivially copyable methods data (method_data_t) with
+// hash functor Hash, Token - method token (mdMethodDef).
+namespace SourcesCacheFile
+{
+    struct header_t
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t filesNum;
+        uint32_t levelsNum;
+        uint32_t methodsNum;
+        uint32_t multiNum;
+        uint32_t multiTokensNum;
+        uint32_t stringsSize;
+        uint32_t reserved;
+    };
+
+    struct file_t
+    {
+        uint32_t pathOffset; // offset in strings area
+        uint32_t pathSize;
+        uint32_t firstLevel;
+        uint32_t levelsNum;
+        uint32_t firstMulti;
+        uint32_t multiNum;
+    };
+
+    struct level_t
+    {
+        uint32_t firstMethod;
+        uint32_t methodsNum;
+    };
+
+    template <class Method>
+    struct multi_t
+    {
+        Method key;
+        uint32_t firstToken;
+        uint32_t tokensNum;
+    };
+
+    void InitHeader(header_t &header);
+    bool CheckHeader(const header_t &header);
+
+    enum class ReadResult
+    {
+        Ok,
+        NotFound,
+        Failed
+    };
+
+    // Read whole file into `buffer`.
+    ReadResult ReadCacheFile(const std::string &cacheFilePath, std::vector<char> &buffer);
+    // Write data chunks into temporary file first and rename it after, so, other debugger instances can't see
+    // partially written cache file.
+    bool WriteCacheFile(const std::string &cacheFilePath, const std::vector<std::pair<const void*, size_t>> &chunks);
+
+    // Read-only view for loaded cache file data.
+    template <class Method, class Token, class Hash>
+    class View
+    {
+    public:
+
+        typedef std::unordered_map<Method, std::vector<Token>, Hash> multi_methods_data_t;
+
+        ReadResult Load(const std::string &cacheFilePath)
+        {
+            ReadResult result = ReadCacheFile(cacheFilePath, m_buffer);
+            if (result != ReadResult::Ok)
+                return result;
+
+            if (!Init())
+            {
+                m_buffer.clear();
+                return ReadResult::Failed;
+            }
+            return ReadResult::Ok;
+        }
+
+        uint32_t FilesNum() const { return m_header->filesNum; }
+        std::string FilePath(uint32_t fileIndex) const
+        {
+            return std::string(m_strings + m_files[fileIndex].pathOffset, m_files[fileIndex].pathSize);
+        }
+        uint32_t LevelsNum(uint32_t fileIndex) const { return m_files[fileIndex].levelsNum; }
+
+        // Return pointer to array of methods data for nested level, methodsNum - size of array.
+        const Method *LevelMethods(uint32_t fileIndex, uint32_t level, uint32_t &methodsNum) const
+        {
+            const level_t &levelData = m_levels[m_files[fileIndex].firstLevel + level];
+            methodsNum = levelData.methodsNum;
+            return m_methods + levelData.firstMethod;
+        }
+
+        void CopyMultiMethodsData(uint32_t fileIndex, multi_methods_data_t &multiMethodsData) const
+        {
+            const file_t &file = m_files[fileIndex];
+            if (file.multiNum == 0)
+                return;
+
+            multiMethodsData.reserve(file.multiNum);
+            for (uint32_t i = file.firstMulti; i < file.firstMulti + file.multiNum; i++)
+            {
+                const Token *tokens = m_tokens + m_multi[i].firstToken;
+                multiMethodsData.emplace(m_multi[i].key, std::vector<Token>(tokens, tokens + m_multi[i].tokensNum));
+            }
+        }
+
+    private:
+
+        std::vector<char> m_buffer;
+        const header_t *m_header = nullptr;
+        const file_t *m_files = nullptr;
+        const level_t *m_levels = nullptr;
+        const Method *m_methods = nullptr;
+        const multi_t<Method> *m_multi = nullptr;
+        const Token *m_tokens = nullptr;
+        const char *m_strings = nullptr;
+
+        bool Init()
+        {
+            // Note, all offsets are checked in 64 bits, so, broken file can't overflow calculations.
+            uint64_t offset = sizeof(header_t);
+            if (m_buffer.size() < offset)
+                return false;
+
+            m_header = (const header_t*)m_buffer.data();
+            if (!CheckHeader(*m_header))
+                return false;
+
+            m_files = (const file_t*)(m_buffer.data() + offset);
+            offset += (uint64_t)m_header->filesNum * sizeof(file_t);
+            m_levels = (const level_t*)(m_buffer.data() + offset);
+            offset += (uint64_t)m_header->levelsNum * sizeof(level_t);
+            m_methods = (const Method*)(m_buffer.data() + offset);
+            offset += (uint64_t)m_header->methodsNum * sizeof(Method);
+            m_multi = (const multi_t<Method>*)(m_buffer.data() + offset);
+            offset += (uint64_t)m_header->multiNum * sizeof(multi_t<Method>);
+            m_tokens = (const Token*)(m_buffer.data() + offset);
+            offset += (uint64_t)m_header->multiTokensNum * sizeof(Token);
+            m_strings = m_buffer.data() + offset;
+            offset += m_header->stringsSize;
+
+            if (offset != m_buffer.size())
+                return false;
+
+            for (uint32_t i = 0; i < m_header->filesNum; i++)
+            {
+                const file_t &file = m_files[i];
+                if ((uint64_t)file.pathOffset + file.pathSize > m_header->stringsSize ||
+                    (uint64_t)file.firstLevel + file.levelsNum > m_header->levelsNum ||
+                    (uint64_t)file.firstMulti + file.multiNum > m_header->multiNum)
+                    return false;
+            }
+            for (uint32_t i = 0; i < m_header->levelsNum; i++)
+            {
+                if ((uint64_t)m_levels[i].firstMethod + m_levels[i].methodsNum > m_header->methodsNum)
+                    return false;
+            }
+            for (uint32_t i = 0; i < m_header->multiNum; i++)
+            {
+                if ((uint64_t)m_multi[i].firstToken + m_multi[i].tokensNum > m_header->multiTokensNum)
+                    return false;
+            }
+
+            return true;
+        }
+    };
+
+    // Serializer for one module data, file paths must be provided in initial (not uppercased) form.
+    template <class Method, class Token, class Hash>
+    class Writer
+    {
+    public:
+
+        typedef std::unordered_map<Method, std::vector<Token>, Hash> multi_methods_data_t;
+
+        void AddFile(const std::string &fullPath, const std::vector<std::vector<Method>> &methodsData,
+                     const multi_methods_data_t &multiMethodsData)
+        {
+            file_t file;
+            file.pathOffset = (uint32_t)m_strings.size();
+            file.pathSize = (uint32_t)fullPath.size();
+            file.firstLevel = (uint32_t)m_levels.size();
+            file.levelsNum = (uint32_t)methodsData.size();
+            file.firstMulti = (uint32_t)m_multi.size();
+            file.multiNum = (uint32_t)multiMethodsData.size();
+            m_files.emplace_back(file);
+
+            m_strings += fullPath;
+
+            for (const auto &levelMethods : methodsData)
+            {
+                m_levels.emplace_back(level_t{(uint32_t)m_methods.size(), (uint32_t)levelMethods.size()});
+                m_methods.insert(m_methods.end(), levelMethods.begin(), levelMethods.end());
+            }
+
+            for (const auto &entry : multiMethodsData)
+            {
+                m_multi.emplace_back(multi_t<Method>{entry.first, (uint32_t)m_tokens.size(), (uint32_t)entry.second.size()});
+                m_tokens.insert(m_tokens.end(), entry.second.begin(), entry.second.end());
+            }
+        }
+
+        bool Save(const std::string &cacheFilePath)
+        {
+            header_t header;
+            InitHeader(header);
+            header.filesNum = (uint32_t)m_files.size();
+            header.levelsNum = (uint32_t)m_levels.size();
+            header.methodsNum = (uint32_t)m_methods.size();
+            header.multiNum = (uint32_t)m_multi.size();
+            header.multiTokensNum = (uint32_t)m_tokens.size();
+            header.stringsSize = (uint32_t)m_strings.size();
+
+            std::vector<std::pair<const void*, size_t>> chunks{
+                {&header, sizeof(header)},
+                {m_files.data(), m_files.size() * sizeof(file_t)},
+                {m_levels.data(), m_levels.size() * sizeof(level_t)},
+                {m_methods.data(), m_methods.size() * sizeof(Method)},
+                {m_multi.data(), m_multi.size() * sizeof(multi_t<Method>)},
+                {m_tokens.data(), m_tokens.size() * sizeof(Token)},
+                {m_strings.data(), m_strings.size()}
+            };
+            return WriteCacheFile(cacheFilePath, chunks);
+        }
+
+    private:
+
+        std::vector<file_t> m_files;
+        std::vector<level_t> m_levels;
+        std::vector<Method> m_methods;
+        std::vector<multi_t<Method>> m_multi;
+        std::vector<Token> m_tokens;
+        std::string m_strings;
+    };
+
+} // namespace SourcesCacheFile
+
+} // namespace netcoredbg
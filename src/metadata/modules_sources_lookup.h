@@ -0,0 +1,81 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+namespace netcoredbg
+{
+
+// Find innermost method for source line in one module's methods data of one source file.
+// Methods data is array of nested levels, methods on each level are not overlapped and ordered by end line/column
+// (see AddMethodData()), so, each level is sorted intervals array and method search is binary search on each level,
+// O(levels * log(n)), where levels is methods nesting depth (usually 1-3, lambdas and local functions only).
+// `lineNum` - in case line not belong any methods, if possible, will be "moved" to first line of method below.
+// `closestNestedToken` - token of nested method, that start at `lineNum` or below, let managed part decide (since it see columns).
+// Note, no CoreCLR headers dependency here, T must provide methodDef/startLine/endLine and `operator < (int32_t)` by endLine.
+template <class T, class Token>
+const T *FindMethodByLineNumber(const std::vector<std::vector<T>> &methodsData, int32_t &lineNum, Token &closestNestedToken)
+{
+    const T *result = nullptr;
+    closestNestedToken = 0;
+
+    for (auto it = methodsData.cbegin(); it != methodsData.cend(); ++it)
+    {
+        auto lower = std::lower_bound((*it).cbegin(), (*it).cend(), lineNum);
+        if (lower == (*it).cend())
+            break; // point behind last method for this nested level
+
+        // case with first line of method, for example:
+        // void Method(){
+        //            void Method(){ void Method(){...  <- breakpoint at this line
+        if (lineNum == (*lower).startLine)
+        {
+            // At this point we can't check this case, let managed part decide (since it see Columns):
+            // void Method() {
+            // ... code ...; void Method() {     <- breakpoint at this line
+            //  };
+            if (result)
+                closestNestedToken = (*lower).methodDef;
+            else
+                result = &(*lower);
+
+            break;
+        }
+        else if (lineNum > (*lower).startLine && (*lower).endLine >= lineNum)
+        {
+            result = &(*lower);
+            continue; // need check nested level (if available)
+        }
+        // out of first level methods lines - forced move line to first method below, for example:
+        //  <-- breakpoint at line without code (out of any methods)
+        // void Method() {...}
+        else if (it == methodsData.cbegin() && lineNum < (*lower).startLine)
+        {
+            lineNum = (*lower).startLine;
+            result = &(*lower);
+            break;
+        }
+        // result was found on previous cycle, check for closest nested method
+        // need it in case of breakpoint setuped at lines without code and before nested method, for example:
+        // {
+        //  <-- breakpoint at line without code (inside method)
+        //     void Method() {...}
+        // }
+        else if (result && lineNum <= (*lower).startLine && (*lower).endLine <= result->endLine)
+        {
+            closestNestedToken = (*lower).methodDef;
+            break;
+        }
+        else
+            break;
+    }
+
+    return result;
+}
+
+} // namespace netcoredbg
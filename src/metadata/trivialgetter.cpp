@@ -0,0 +1,96 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "metadata/trivialgetter.h"
+
+namespace netcoredbg
+{
+
+namespace
+{
+    // https://github.com/dotnet/runtime/blob/main/src/coreclr/inc/opcode.def
+    enum : uint8_t
+    {
+        OpNop = 0x00,
+        OpLdarg0 = 0x02,
+        OpLdloc0 = 0x06,
+        OpStloc0 = 0x0A,
+        OpRet = 0x2A,
+        OpBrS = 0x2B,
+        OpLdfld = 0x7B,
+        OpLdsfld = 0x7E
+    };
+
+    class ILReader
+    {
+    public:
+        ILReader(const uint8_t *code, size_t size) : m_code(code), m_size(size), m_pos(0) {}
+
+        bool Match(uint8_t opcode)
+        {
+            if (m_pos >= m_size || m_code[m_pos] != opcode)
+                return false;
+            m_pos++;
+            return true;
+        }
+
+        void SkipNops()
+        {
+            while (Match(OpNop)) {}
+        }
+
+        bool ReadToken(uint32_t &token)
+        {
+            if (m_size - m_pos < 4)
+                return false;
+            token = uint32_t(m_code[m_pos]) | (uint32_t(m_code[m_pos + 1]) << 8) |
+                    (uint32_t(m_code[m_pos + 2]) << 16) | (uint32_t(m_code[m_pos + 3]) << 24);
+            m_pos += 4;
+            return true;
+        }
+
+        bool AtEnd() const { return m_pos == m_size; }
+
+    private:
+        const uint8_t *m_code;
+        size_t m_size;
+        size_t m_pos;
+    };
+
+} // unnamed namespace
+
+bool MatchTrivialGetterIL(const uint8_t *code, size_t size, uint32_t &fieldToken, bool &isStatic)
+{
+    if (code == nullptr || size > MaxTrivialGetterILSize)
+        return false;
+
+    ILReader reader(code, size);
+    reader.SkipNops();
+
+    if (reader.Match(OpLdarg0))
+    {
+        if (!reader.Match(OpLdfld))
+            return false;
+        isStatic = false;
+    }
+    else if (reader.Match(OpLdsfld))
+        isStatic = true;
+    else
+        return false;
+
+    if (!reader.ReadToken(fieldToken))
+        return false;
+
+    // Debug build store result into local and jump to next instruction, that load it back.
+    reader.SkipNops();
+    if (reader.Match(OpStloc0))
+    {
+        if (!reader.Match(OpBrS) || !reader.Match(0x00) || !reader.Match(OpLdloc0))
+            return false;
+    }
+
+    return reader.Match(OpRet) && reader.AtEnd();
+}
+
+} // namespace netcoredbg
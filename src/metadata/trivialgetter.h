@@ -0,0 +1,23 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace netcoredbg
+{
+
+// Max IL code size of trivial getter (debug build `return field;` getter is 12 bytes).
+const size_t MaxTrivialGetterILSize = 16;
+
+// Check, that getter's IL code only load field and return it (auto-property or `return field;` getter, both release and
+// debug builds IL):
+//     [nop] ldarg.0 ldfld <field> [stloc.0 br.s 0 ldloc.0] ret
+//     [nop] ldsfld <field> [stloc.0 br.s 0 ldloc.0] ret
+// Note, no CoreCLR headers dependency here, caller must read IL code and check field token.
+bool MatchTrivialGetterIL(const uint8_t *code, size_t size, uint32_t &fieldToken, bool &isStatic);
+
+} // namespace netcoredbg
@@ -0,0 +1,323 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "metadata/typelayoutcache.h"
+#include "metadata/trivialgetter.h"
+#include "metadata/typeprinter.h"
+#include "utils/utf.h"
+
+namespace netcoredbg
+{
+
+namespace
+{
+
+    bool IsDebuggerBrowsableNever(IMetaDataImport *pMD, mdProperty propertyDef, uint32_t &metadataCalls)
+    {
+        // https://github.sec.samsung.net/dotnet/coreclr/blob/9df87a133b0f29f4932f38b7307c87d09ab80d5d/src/System.Private.CoreLib/shared/System/Diagnostics/DebuggerBrowsableAttribute.cs#L17
+        // Since we check only first byte, no reason store it as int (default enum type in c#)
+        enum DebuggerBrowsableState : char
+        {
+            Never = 0,
+            Expanded = 1,
+            Collapsed = 2,
+            RootHidden = 3
+        };
+
+        const char *g_DebuggerBrowsable = "System.Diagnostics.DebuggerBrowsableAttribute..ctor";
+        bool debuggerBrowsableState_Never = false;
+
+        ULONG numAttributes = 0;
+        HCORENUM hEnum = NULL;
+        mdCustomAttribute attr;
+        while(SUCCEEDED(pMD->EnumCustomAttributes(&hEnum, propertyDef, 0, &attr, 1, &numAttributes)) && numAttributes != 0)
+        {
+            mdToken ptkObj = mdTokenNil;
+            mdToken ptkType = mdTokenNil;
+            void const *ppBlob = 0;
+            ULONG pcbSize = 0;
+            metadataCalls += 3; // EnumCustomAttributes(), GetCustomAttributeProps(), NameForToken()
+            if (FAILED(pMD->GetCustomAttributeProps(attr, &ptkObj, &ptkType, &ppBlob, &pcbSize)))
+                continue;
+
+            std::string mdName;
+            if (FAILED(TypePrinter::NameForToken(ptkType, pMD, mdName, true, nullptr)))
+                continue;
+
+            if (mdName == g_DebuggerBrowsable
+                // In case of DebuggerBrowsableAttribute blob is 8 bytes:
+                // 2 bytes - blob prolog 0x0001
+                // 4 bytes - data (DebuggerBrowsableAttribute::State), default enum type (int)
+                // 2 bytes - alignment
+                // We check only one byte (first data byte), no reason check 4 bytes in our case.
+                && pcbSize > 2
+                && ((char const *)ppBlob)[2] == DebuggerBrowsableState::Never)
+            {
+                debuggerBrowsableState_Never = true;
+                break;
+            }
+        }
+        pMD->CloseEnum(hEnum);
+        metadataCalls++; // last EnumCustomAttributes()
+
+        return debuggerBrowsableState_Never;
+    }
+
+    HRESULT CreateLayout(IMetaDataImport *pMD, mdTypeDef typeDef, TypeLayoutCache::MembersLayout &layout)
+    {
+        ULONG numFields = 0;
+        HCORENUM hEnum = NULL;
+        mdFieldDef fieldDef;
+        while(SUCCEEDED(pMD->EnumFields(&hEnum, typeDef, &fieldDef, 1, &numFields)) && numFields != 0)
+        {
+            ULONG nameLen = 0;
+            WCHAR mdName[mdNameLen] = {0};
+            TypeLayoutCache::FieldLayout field;
+            field.fieldDef = fieldDef;
+            field.attr = 0;
+            field.pSignatureBlob = nullptr;
+            field.sigBlobLength = 0;
+            field.pRawValue = nullptr;
+            field.rawValueLength = 0;
+            layout.metadataCalls += 2; // EnumFields(), GetFieldProps()
+            if (FAILED(pMD->GetFieldProps(fieldDef, nullptr, mdName, _countof(mdName), &nameLen, &field.attr,
+                                          &field.pSignatureBlob, &field.sigBlobLength, nullptr, &field.pRawValue, &field.rawValueLength)))
+                continue;
+
+            // Prevent access to internal compiler added fields (without visible name).
+            // Should be accessed by debugger routine only and hidden from user/ide.
+            // More about compiler generated names in Roslyn sources:
+            // https://github.com/dotnet/roslyn/blob/315c2e149ba7889b0937d872274c33fcbfe9af5f/src/Compilers/CSharp/Portable/Symbols/Synthesized/GeneratedNames.cs
+            // Note, uncontrolled access to internal compiler added field or its properties may break debugger work.
+            if (TypePrinter::IsSynthesizedLocalName(mdName, nameLen))
+                continue;
+
+            field.name = to_utf8(mdName);
+            layout.fields.emplace_back(std::move(field));
+        }
+        pMD->CloseEnum(hEnum);
+        layout.metadataCalls++; // last EnumFields()
+
+        mdProperty propertyDef;
+        ULONG numProperties = 0;
+        HCORENUM propEnum = NULL;
+        while(SUCCEEDED(pMD->EnumProperties(&propEnum, typeDef, &propertyDef, 1, &numProperties)) && numProperties != 0)
+        {
+            mdTypeDef propertyClass;
+            ULONG propertyNameLen = 0;
+            UVCP_CONSTANT pDefaultValue;
+            ULONG cchDefaultValue;
+            TypeLayoutCache::PropertyLayout property;
+            property.propertyDef = propertyDef;
+            WCHAR propertyName[mdNameLen] = W("\0");
+            layout.metadataCalls += 2; // EnumProperties(), GetPropertyProps()
+            if (FAILED(pMD->GetPropertyProps(propertyDef, &propertyClass, propertyName, _countof(propertyName),
+                                             &propertyNameLen, nullptr, nullptr, nullptr, nullptr, &pDefaultValue,
+                                             &cchDefaultValue, &property.setter, &property.getter, nullptr, 0, nullptr)))
+                continue;
+
+            DWORD getterAttr = 0;
+            layout.metadataCalls++; // GetMethodProps()
+            if (FAILED(pMD->GetMethodProps(property.getter, NULL, NULL, 0, NULL, &getterAttr, NULL, NULL, NULL, NULL)))
+                continue;
+
+            if (IsDebuggerBrowsableNever(pMD, propertyDef, layout.metadataCalls))
+                continue;
+
+            property.isStatic = (getterAttr & mdStatic);
+            property.name = to_utf8(propertyName);
+            layout.properties.emplace_back(std::move(property));
+        }
+        pMD->CloseEnum(propEnum);
+        layout.metadataCalls++; // last EnumProperties()
+
+        return S_OK;
+    }
+
+    HRESULT CreateLayout(IMetaDataImport *pMD, mdTypeDef typeDef, TypeLayoutCache::MethodsLayout &layout)
+    {
+        ULONG numMethods = 0;
+        HCORENUM fEnum = NULL;
+        mdMethodDef methodDef;
+        while(SUCCEEDED(pMD->EnumMethods(&fEnum, typeDef, &methodDef, 1, &numMethods)) && numMethods != 0)
+        {
+            mdTypeDef memTypeDef;
+            ULONG nameLen;
+            WCHAR szFunctionName[mdNameLen] = {0};
+            TypeLayoutCache::MethodLayout method;
+            method.methodDef = methodDef;
+            method.attr = 0;
+            method.pSig = nullptr;
+            method.cbSig = 0;
+            layout.metadataCalls += 2; // EnumMethods(), GetMethodProps()
+            if (FAILED(pMD->GetMethodProps(methodDef, &memTypeDef,
+                                           szFunctionName, _countof(szFunctionName), &nameLen,
+                                           &method.attr, &method.pSig, &method.cbSig, nullptr, nullptr)))
+                continue;
+
+            method.name = to_utf8(szFunctionName);
+            layout.methods.emplace_back(std::move(method));
+        }
+        pMD->CloseEnum(fEnum);
+        layout.metadataCalls++; // last EnumMethods()
+
+        return S_OK;
+    }
+
+    // Note, getter must load field of getter's own type, since value will be read with type's class.
+    void CreateGetterLayout(ICorDebugModule *pModule, mdTypeDef typeDef, mdMethodDef getter, TypeLayoutCache::GetterLayout &layout)
+    {
+        layout.fieldDef = mdFieldDefNil;
+
+        ToRelease<ICorDebugFunction> pFunc;
+        ToRelease<ICorDebugCode> pCode;
+        ULONG32 codeSize = 0;
+        if (FAILED(pModule->GetFunctionFromToken(getter, &pFunc)) ||
+            FAILED(pFunc->GetILCode(&pCode)) ||
+            FAILED(pCode->GetSize(&codeSize)) ||
+            codeSize > MaxTrivialGetterILSize)
+            return;
+
+        BYTE code[MaxTrivialGetterILSize];
+        ULONG32 codeRead = 0;
+        uint32_t fieldToken = mdFieldDefNil;
+        bool isStatic = false;
+        if (FAILED(pCode->GetCode(0, codeSize, codeSize, code, &codeRead)) ||
+            codeRead != codeSize ||
+            !MatchTrivialGetterIL(code, codeSize, fieldToken, isStatic) ||
+            // Note, static field could be not initialized yet, getter's func-eval will run static constructor.
+            isStatic ||
+            TypeFromToken(fieldToken) != mdtFieldDef) // member reference (for example, field of generic type) is not supported
+            return;
+
+        ToRelease<IUnknown> pMDUnknown;
+        ToRelease<IMetaDataImport> pMD;
+        mdTypeDef fieldClass = mdTypeDefNil;
+        DWORD methodAttr = 0;
+        DWORD typeAttr = 0;
+        if (FAILED(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown)) ||
+            FAILED(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &pMD)) ||
+            FAILED(pMD->GetFieldProps(fieldToken, &fieldClass, nullptr, 0, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr)) ||
+            fieldClass != typeDef ||
+            FAILED(pMD->GetMethodProps(getter, nullptr, nullptr, 0, nullptr, &methodAttr, nullptr, nullptr, nullptr, nullptr)) ||
+            FAILED(pMD->GetTypeDefProps(typeDef, nullptr, 0, nullptr, &typeAttr, nullptr)))
+            return;
+
+        // Virtual getter could be overridden in derived type, real object's getter must be called by func-eval.
+        if (IsMdVirtual(methodAttr) && !IsMdFinal(methodAttr) && !IsTdSealed(typeAttr))
+            return;
+
+        layout.fieldDef = fieldToken;
+    }
+
+} // unnamed namespace
+
+template <class T>
+HRESULT TypeLayoutCache::GetLayout(std::unordered_map<TypeKey, CacheEntry<T>, TypeKeyHash> &cache, ICorDebugModule *pModule, mdTypeDef typeDef,
+                                   std::shared_ptr<const T> &layout)
+{
+    HRESULT Status;
+    TypeKey key;
+    key.token = typeDef;
+    IfFailRet(pModule->GetBaseAddress(&key.modAddress));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto find = cache.find(key);
+    if (find != cache.end() && find->second.iCorModule.GetPtr() == pModule)
+    {
+        m_stats.hits++;
+        m_stats.avoidedMetadataCalls += find->second.layout->metadataCalls;
+        layout = find->second.layout;
+        return S_OK;
+    }
+
+    std::shared_ptr<T> newLayout(new T());
+    newLayout->metadataCalls = 1; // GetMetaDataInterface()
+    ToRelease<IUnknown> pMDUnknown;
+    IfFailRet(pModule->GetMetaDataInterface(IID_IMetaDataImport, &pMDUnknown));
+    IfFailRet(pMDUnknown->QueryInterface(IID_IMetaDataImport, (LPVOID*) &newLayout->pMD));
+    IfFailRet(CreateLayout(newLayout->pMD, typeDef, *newLayout));
+
+    m_stats.misses++;
+    m_stats.metadataCalls += newLayout->metadataCalls;
+
+    CacheEntry<T> &entry = cache[key];
+    pModule->AddRef();
+    entry.iCorModule = pModule;
+    entry.layout = newLayout;
+    layout = std::move(newLayout);
+    return S_OK;
+}
+
+HRESULT TypeLayoutCache::GetMembersLayout(ICorDebugModule *pModule, mdTypeDef typeDef, std::shared_ptr<const MembersLayout> &layout)
+{
+    return GetLayout(m_membersLayouts, pModule, typeDef, layout);
+}
+
+HRESULT TypeLayoutCache::GetMethodsLayout(ICorDebugModule *pModule, mdTypeDef typeDef, std::shared_ptr<const MethodsLayout> &layout)
+{
+    return GetLayout(m_methodsLayouts, pModule, typeDef, layout);
+}
+
+HRESULT TypeLayoutCache::GetGetterLayout(ICorDebugModule *pModule, mdTypeDef typeDef, mdMethodDef getter, GetterLayout &getterLayout)
+{
+    HRESULT Status;
+    TypeKey key;
+    key.token = getter;
+    IfFailRet(pModule->GetBaseAddress(&key.modAddress));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto find = m_getterLayouts.find(key);
+    if (find != m_getterLayouts.end() && find->second.iCorModule.GetPtr() == pModule)
+    {
+        getterLayout = find->second.layout;
+        return S_OK;
+    }
+
+    CreateGetterLayout(pModule, typeDef, getter, getterLayout);
+
+    GetterEntry &entry = m_getterLayouts[key];
+    pModule->AddRef();
+    entry.iCorModule = pModule;
+    entry.layout = getterLayout;
+    return S_OK;
+}
+
+TypeLayoutCache::Stats TypeLayoutCache::GetStats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void TypeLayoutCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_membersLayouts.clear();
+    m_methodsLayouts.clear();
+    m_getterLayouts.clear();
+}
+
+template <class Cache>
+static void EraseModuleEntries(Cache &cache, CORDB_ADDRESS modAddress)
+{
+    for (auto it = cache.begin(); it != cache.end();)
+    {
+        if (it->first.modAddress == modAddress)
+            it = cache.erase(it);
+        else
+            ++it;
+    }
+}
+
+void TypeLayoutCache::ClearModule(CORDB_ADDRESS modAddress)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    EraseModuleEntries(m_membersLayouts, modAddress);
+    EraseModuleEntries(m_methodsLayouts, modAddress);
+    EraseModuleEntries(m_getterLayouts, modAddress);
+}
+
+} // namespace netcoredbg
@@ -0,0 +1,150 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include "cor.h"
+#include "cordebug.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "utils/torelease.h"
+
+namespace netcoredbg
+{
+
+// Session-wide cache of type's members metadata, aimed to avoid IMetaDataImport enumeration and names conversion
+// for each value at each stop and variables expansion (see Evaluator's WalkMembers() and WalkMethods()).
+// Also cache trivial properties getters backing fields, that could be read directly instead of getter's func-eval.
+// Note, metadata is same for all generic instantiations of type (instantiation related data provided by ICorDebugType
+// during members walk), so, layout cached by (module, typedef) key.
+// Note, must be cleared at Hot Reload, since type's metadata could be changed.
+class TypeLayoutCache
+{
+public:
+
+    struct FieldLayout
+    {
+        mdFieldDef fieldDef;
+        DWORD attr;
+        std::string name;
+        PCCOR_SIGNATURE pSignatureBlob;
+        ULONG sigBlobLength;
+        UVCP_CONSTANT pRawValue;
+        ULONG rawValueLength;
+    };
+
+    struct PropertyLayout
+    {
+        mdProperty propertyDef;
+        mdMethodDef getter;
+        mdMethodDef setter;
+        bool isStatic;
+        std::string name;
+    };
+
+    struct MethodLayout
+    {
+        mdMethodDef methodDef;
+        DWORD attr;
+        std::string name;
+        PCCOR_SIGNATURE pSig;
+        ULONG cbSig;
+    };
+
+    // Note, signature and raw value pointers point to metadata memory, `pMD` hold it.
+    struct MembersLayout
+    {
+        ToRelease<IMetaDataImport> pMD;
+        // Members visible for user only (no compiler generated fields and no properties with `DebuggerBrowsable(Never)`),
+        // in the same order as metadata provide them.
+        std::vector<FieldLayout> fields;
+        std::vector<PropertyLayout> properties;
+        uint32_t metadataCalls; // metadata calls count for layout creation
+    };
+
+    struct MethodsLayout
+    {
+        ToRelease<IMetaDataImport> pMD;
+        std::vector<MethodLayout> methods;
+        uint32_t metadataCalls; // metadata calls count for layout creation
+    };
+
+    // Instance backing field of trivial property getter (see MatchTrivialGetterIL()), `fieldDef` is mdFieldDefNil for other getters.
+    // Note, static getters and getters, that could be overridden, are not trivial (func-eval must be used for them).
+    struct GetterLayout
+    {
+        mdFieldDef fieldDef;
+    };
+
+    struct Stats
+    {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t metadataCalls;        // metadata calls during layouts creation
+        uint64_t avoidedMetadataCalls; // metadata calls avoided by cache hits
+    };
+
+    TypeLayoutCache() : m_stats() {}
+
+    HRESULT GetMembersLayout(ICorDebugModule *pModule, mdTypeDef typeDef, std::shared_ptr<const MembersLayout> &layout);
+    HRESULT GetMethodsLayout(ICorDebugModule *pModule, mdTypeDef typeDef, std::shared_ptr<const MethodsLayout> &layout);
+    HRESULT GetGetterLayout(ICorDebugModule *pModule, mdTypeDef typeDef, mdMethodDef getter, GetterLayout &getterLayout);
+
+    Stats GetStats();
+    void Clear();
+    // Remove all layouts of module, called at module unload, since cached data hold module's objects.
+    void ClearModule(CORDB_ADDRESS modAddress);
+
+private:
+
+    struct TypeKey
+    {
+        CORDB_ADDRESS modAddress;
+        mdToken token; // typedef for layouts, getter's methoddef for getters
+
+        bool operator == (const TypeKey &other) const
+        {
+            return modAddress == other.modAddress && token == other.token;
+        }
+    };
+
+    struct TypeKeyHash
+    {
+        size_t operator()(const TypeKey &key) const
+        {
+            return std::hash<CORDB_ADDRESS>()(key.modAddress) ^ (std::hash<mdToken>()(key.token) << 1);
+        }
+    };
+
+    template <class T>
+    struct CacheEntry
+    {
+        // Note, module with same base address could be loaded after module unload, check module object identity too.
+        ToRelease<ICorDebugModule> iCorModule;
+        std::shared_ptr<const T> layout;
+    };
+
+    struct GetterEntry
+    {
+        ToRelease<ICorDebugModule> iCorModule;
+        GetterLayout layout;
+    };
+
+    std::mutex m_mutex;
+    std::unordered_map<TypeKey, CacheEntry<MembersLayout>, TypeKeyHash> m_membersLayouts;
+    std::unordered_map<TypeKey, CacheEntry<MethodsLayout>, TypeKeyHash> m_methodsLayouts;
+    std::unordered_map<TypeKey, GetterEntry, TypeKeyHash> m_getterLayouts;
+    Stats m_stats;
+
+    template <class T>
+    HRESULT GetLayout(std::unordered_map<TypeKey, CacheEntry<T>, TypeKeyHash> &cache, ICorDebugModule *pModule, mdTypeDef typeDef,
+                      std::shared_ptr<const T> &layout);
+};
+
+} // namespace netcoredbg
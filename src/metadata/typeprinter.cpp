@@ -6,7 +6,9 @@
 
 #include <sstream>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
+#include <mutex>
 
 #include "utils/torelease.h"
 #include "utils/utf.h"
@@ -18,6 +20,165 @@ namespace netcoredbg
 namespace TypePrinter
 {
 
+namespace
+{
+
+// Memoized names of types and methods, that requested for each stack frame and each variable at every stop.
+// Note, names are interned (stored once), different keys with same name point to the same string.
+// Note, COM objects from keys are held by cache, so, objects addresses can't be reused until cache cleared.
+// Note, cache size is limited, cache is cleared at limit and at process exit or module unload.
+class NamesCache
+{
+public:
+
+    enum class Kind
+    {
+        TypeOfValue,  // ICorDebugType -> element type and array type names
+        Token,        // IMetaDataImport, token and class name flag -> name
+        TypeSig,      // IMetaDataImport, signature and enclosing ICorDebugType -> name
+        TypeAndMethod // ICorDebugFunction -> type and method names (not generic frames only)
+    };
+
+    struct Key
+    {
+        Kind kind;
+        IUnknown *pObject;
+        IUnknown *pObject2;
+        uintptr_t data;
+
+        Key(Kind kind_, IUnknown *pObject_, IUnknown *pObject2_ = nullptr, uintptr_t data_ = 0) :
+            kind(kind_), pObject(pObject_), pObject2(pObject2_), data(data_)
+        {}
+
+        bool operator == (const Key &other) const
+        {
+            return kind == other.kind && pObject == other.pObject && pObject2 == other.pObject2 && data == other.data;
+        }
+    };
+
+    NamesCache() : m_hits(0), m_misses(0) {}
+
+    bool Find(const Key &key, std::string &first, std::string *second = nullptr)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto find = m_names.find(key);
+        if (find == m_names.end())
+        {
+            m_misses++;
+            return false;
+        }
+
+        m_hits++;
+        first = *find->second.first;
+        if (second)
+            *second = *find->second.second;
+        return true;
+    }
+
+    void Add(const Key &key, const std::string &first, const std::string &second = std::string())
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // Note, all held COM objects are released at limit, names for current stop will be cached again.
+        if (m_names.size() >= m_namesLimit)
+            ClearUnlocked();
+
+        Names names;
+        names.first = &*m_internedNames.insert(first).first;
+        names.second = &*m_internedNames.insert(second).first;
+        if (!m_names.emplace(key, names).second)
+            return;
+
+        HoldObject(key.pObject);
+        HoldObject(key.pObject2);
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ClearUnlocked();
+    }
+
+    void GetStats(uint64_t &hits, uint64_t &misses)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        hits = m_hits;
+        misses = m_misses;
+    }
+
+private:
+
+    struct Names
+    {
+        const std::string *first;
+        const std::string *second;
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key &key) const
+        {
+            size_t hash = std::hash<int>()(static_cast<int>(key.kind));
+            hash ^= std::hash<void*>()(key.pObject) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            hash ^= std::hash<void*>()(key.pObject2) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            hash ^= std::hash<uintptr_t>()(key.data) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            return hash;
+        }
+    };
+
+    void ClearUnlocked()
+    {
+        m_names.clear();
+        m_internedNames.clear();
+        m_objects.clear();
+    }
+
+    void HoldObject(IUnknown *pObject)
+    {
+        if (!pObject)
+            return;
+
+        pObject->AddRef();
+        m_objects.emplace_back(pObject);
+    }
+
+    static const size_t m_namesLimit = 16384;
+
+    std::mutex m_mutex;
+    // Note, std::unordered_set elements addresses are stable during rehash.
+    std::unordered_set<std::string> m_internedNames;
+    std::unordered_map<Key, Names, KeyHash> m_names;
+    std::vector<ToRelease<IUnknown>> m_objects;
+    uint64_t m_hits;
+    uint64_t m_misses;
+};
+
+// Note, cache intentionally not destroyed at exit, since held COM objects can't be released after debugger shutdown
+// (cache must be cleared by ClearNamesCache() during debugger cleanup).
+NamesCache &GetNamesCache()
+{
+    static NamesCache *namesCache = new NamesCache();
+    return *namesCache;
+}
+
+} // unnamed namespace
+
+void ClearNamesCache()
+{
+    GetNamesCache().Clear();
+}
+
+void GetNamesCacheStats(uint64_t &hits, uint64_t &misses)
+{
+    GetNamesCache().GetStats(hits, misses);
+}
+
+// https://github.com/dotnet/roslyn/blob/d1e617ded188343ba43d24590802dd51e68e8e32/src/Compilers/CSharp/Portable/Symbols/Synthesized/GeneratedNameParser.cs#L13
+bool IsSynthesizedLocalName(const WCHAR *mdName, ULONG nameLen)
+{
+    return (nameLen > 1 && starts_with(mdName, W("<"))) ||
+           (nameLen > 4 && starts_with(mdName, W("CS$<")));
+}
+
 static std::string ConsumeGenericArgs(const std::string &name, std::list<std::string> &args)
 {
     if (args.empty())
@@ -276,11 +437,11 @@ HRESULT NameForTypeByValue(ICorDebugValue *pValue, std::string &mdName)
     return NameForTypeByType(iCorType, mdName);
 }
 
-HRESULT NameForToken(mdToken mb,
-                                  IMetaDataImport *pImport,
-                                  std::string &mdName,
-                                  bool bClassName,
-                                  std::list<std::string> *args)
+static HRESULT InternalNameForToken(mdToken mb,
+                                    IMetaDataImport *pImport,
+                                    std::string &mdName,
+                                    bool bClassName,
+                                    std::list<std::string> *args)
 {
     mdName[0] = L'\0';
     if (TypeFromToken(mb) != mdtTypeDef
@@ -375,6 +536,26 @@ HRESULT NameForToken(mdToken mb,
     return hr;
 }
 
+HRESULT NameForToken(mdToken mb,
+                     IMetaDataImport *pImport,
+                     std::string &mdName,
+                     bool bClassName,
+                     std::list<std::string> *args)
+{
+    // Note, name with generic arguments consume `args`, can't be cached by token.
+    if (args)
+        return InternalNameForToken(mb, pImport, mdName, bClassName, args);
+
+    NamesCache::Key key(NamesCache::Kind::Token, pImport, nullptr, ((uintptr_t)mb << 1) | (bClassName ? 1 : 0));
+    if (GetNamesCache().Find(key, mdName))
+        return S_OK;
+
+    HRESULT Status;
+    IfFailRet(InternalNameForToken(mb, pImport, mdName, bClassName, args));
+    GetNamesCache().Add(key, mdName);
+    return S_OK;
+}
+
 HRESULT GetTypeOfValue(ICorDebugValue *pValue, std::string &output)
 {
     ToRelease<ICorDebugType> pType;
@@ -389,10 +570,8 @@ HRESULT GetTypeOfValue(ICorDebugValue *pValue, std::string &output)
 
 // From strike.cpp
 
-HRESULT GetTypeOfValue(ICorDebugType *pType, std::string &elementType, std::string &arrayType)
+static HRESULT InternalGetTypeOfValue(ICorDebugType *pType, std::string &elementType, std::string &arrayType)
 {
-    if (pType == nullptr)
-        return E_INVALIDARG;
 
     HRESULT Status = S_OK;
 
@@ -561,6 +740,25 @@ HRESULT GetTypeOfValue(ICorDebugType *pType, std::string &elementType, std::stri
     return S_OK;
 }
 
+HRESULT GetTypeOfValue(ICorDebugType *pType, std::string &elementType, std::string &arrayType)
+{
+    if (pType == nullptr)
+        return E_INVALIDARG;
+
+    NamesCache::Key key(NamesCache::Kind::TypeOfValue, pType);
+    if (GetNamesCache().Find(key, elementType, &arrayType))
+        return S_OK;
+
+    HRESULT Status;
+    std::string typeElementType;
+    std::string typeArrayType;
+    IfFailRet(InternalGetTypeOfValue(pType, typeElementType, typeArrayType));
+    GetNamesCache().Add(key, typeElementType, typeArrayType);
+    elementType = std::move(typeElementType);
+    arrayType = std::move(typeArrayType);
+    return S_OK;
+}
+
 // From sildasm.cpp
 static PCCOR_SIGNATURE NameForTypeSig(PCCOR_SIGNATURE typePtr, const std::vector<std::string> &args,
                                       IMetaDataImport *pImport, std::string &out, std::string &appendix)
@@ -753,6 +951,10 @@ void NameForTypeSig(
     IMetaDataImport *pImport,
     std::string &typeName)
 {
+    NamesCache::Key key(NamesCache::Kind::TypeSig, pImport, enclosingType, (uintptr_t)typePtr);
+    if (GetNamesCache().Find(key, typeName))
+        return;
+
     // Gather generic arguments from enclosing type
     std::vector<std::string> args;
     ToRelease<ICorDebugTypeEnum> pTypeEnum;
@@ -775,6 +977,7 @@ void NameForTypeSig(
     std::string appendix;
     NameForTypeSig(typePtr, args, pImport, out, appendix);
     typeName = out + appendix;
+    GetNamesCache().Add(key, typeName);
 }
 
 HRESULT GetTypeOfValue(ICorDebugType *pType, std::string &output)
@@ -794,6 +997,14 @@ HRESULT GetTypeAndMethod(ICorDebugFrame *pFrame, std::string &typeName, std::str
     ToRelease<ICorDebugFunction> pFunction;
     IfFailRet(pFrame->GetFunction(&pFunction));
 
+    // Note, names for frames with generic arguments depend on frame's instantiation, cache names for not generic frames only.
+    std::list<std::string> args;
+    AddGenericArgs(pFrame, args);
+    NamesCache::Key key(NamesCache::Kind::TypeAndMethod, pFunction);
+    const bool cacheable = args.empty();
+    if (cacheable && GetNamesCache().Find(key, typeName, &methodName))
+        return S_OK;
+
     ToRelease<ICorDebugClass> pClass;
     ToRelease<ICorDebugModule> pModule;
     mdMethodDef methodDef;
@@ -846,9 +1057,6 @@ HRESULT GetTypeAndMethod(ICorDebugFrame *pFrame, std::string &typeName, std::str
         funcName = ss.str();
     }
 
-    std::list<std::string> args;
-    AddGenericArgs(pFrame, args);
-
     if (memTypeDef != mdTypeDefNil)
     {
         if (FAILED(NameForTypeDef(memTypeDef, pMD, typeName, &args)))
@@ -857,6 +1065,9 @@ HRESULT GetTypeAndMethod(ICorDebugFrame *pFrame, std::string &typeName, std::str
 
     methodName = ConsumeGenericArgs(funcName, args);
 
+    if (cacheable)
+        GetNamesCache().Add(key, typeName, methodName);
+
     return S_OK;
 }
 
@@ -867,13 +1078,17 @@ HRESULT GetMethodName(ICorDebugFrame *pFrame, std::string &output)
     std::string typeName;
     std::string methodName;
 
-    std::ostringstream ss;
     IfFailRet(GetTypeAndMethod(pFrame, typeName, methodName));
+    output.clear();
+    output.reserve(typeName.size() + methodName.size() + 3);
     if (!typeName.empty())
-        ss << typeName << ".";
-    ss << methodName << "()";
+    {
+        output += typeName;
+        output += '.';
+    }
+    output += methodName;
+    output += "()";
 
-    output = ss.str();
     return S_OK;
 }
 
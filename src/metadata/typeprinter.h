@@ -6,6 +6,7 @@
 #include "cor.h"
 #include "cordebug.h"
 
+#include <cstdint>
 #include <list>
 #include <string>
 #include <vector>
@@ -32,6 +33,13 @@ namespace TypePrinter
     HRESULT GetTypeAndMethod(ICorDebugFrame *pFrame, std::string &typeName, std::string &methodName);
     std::string RenameToSystem(const std::string &typeName);
     std::string RenameToCSharp(const std::string &typeName);
+    // Compiler generated (synthesized) local or field name, that should not be exposed to user.
+    bool IsSynthesizedLocalName(const WCHAR *mdName, ULONG nameLen);
+
+    // Names memoization (see NamesCache in typeprinter.cpp), must be cleared at debugger cleanup, process exit,
+    // module unload and Hot Reload.
+    void ClearNamesCache();
+    void GetNamesCacheStats(uint64_t &hits, uint64_t &misses);
 
 } // namespace TypePrinter
 
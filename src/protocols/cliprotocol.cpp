@@ -1658,7 +1658,8 @@ HRESULT CLIProtocol::doCommand<CommandTag::Next>(const std::vector<std::string>
 
 HRESULT CLIProtocol::PrintVariable(const Variable &v, std::ostringstream &ss, bool expand, bool is_static)
 {
-    if (v.namedVariables > 0 && expand)
+    const int numChild = v.namedVariables + v.indexedVariables;
+    if (numChild > 0 && expand)
     {
         std::vector<Variable> children;
 
@@ -1667,7 +1668,7 @@ HRESULT CLIProtocol::PrintVariable(const Variable &v, std::ostringstream &ss, bo
         else
             ss << v.name << " = " << v.value << ": {";
 
-        m_sharedDebugger->GetVariables(v.variablesReference, VariablesBoth, 0, v.namedVariables, children);
+        m_sharedDebugger->GetVariables(v.variablesReference, VariablesBoth, 0, numChild, children);
         for (auto &child : children)
         {
             bool stm = (child.name == "Static members") ? true : false;
@@ -0,0 +1,153 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "protocols/framedreader.h"
+
+#include <cstring>
+#include <algorithm>
+#include <limits>
+#include "utils/logger.h"
+
+namespace netcoredbg
+{
+
+namespace
+{
+    const size_t MinReadSize = 4096;
+    const string_view ContentLength("Content-Length: ");
+
+    inline bool IsSpace(char ch) { return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n' || ch == '\v' || ch == '\f'; }
+
+    // Parse `Content-Length` header value, same as strtoul() do (leading spaces allowed, trailing spaces ignored).
+    bool ParseContentLength(string_view value, size_t &result)
+    {
+        while (!value.empty() && IsSpace(value.front()))
+            value.remove_prefix(1);
+
+        if (value.empty() || value.front() < '0' || value.front() > '9')
+            return false;
+
+        result = 0;
+        while (!value.empty() && value.front() >= '0' && value.front() <= '9')
+        {
+            size_t digit = value.front() - '0';
+            if (result > (std::numeric_limits<size_t>::max() - digit) / 10)
+                return false;
+            result = result * 10 + digit;
+            value.remove_prefix(1);
+        }
+
+        return value.empty() || IsSpace(value.front());
+    }
+
+} // unnamed namespace
+
+// Read all data, that stream buffer could provide without block (at least 1 byte).
+bool FramedReader::ReadMore()
+{
+    // Note, sgetc() block until at least 1 byte available, all data after that already in stream buffer.
+    if (m_streamBuf->sgetc() == std::char_traits<char>::eof())
+        return false;
+
+    size_t available = std::max<std::streamsize>(m_streamBuf->in_avail(), 1);
+
+    if (m_begin > 0)
+    {
+        memmove(m_buffer.data(), m_buffer.data() + m_begin, m_end - m_begin);
+        m_end -= m_begin;
+        m_begin = 0;
+    }
+    if (m_buffer.size() < m_end + available)
+        m_buffer.resize(std::max(m_end + available, std::max(m_buffer.size() * 2, MinReadSize)));
+
+    m_end += m_streamBuf->sgetn(m_buffer.data() + m_end, available);
+    return true;
+}
+
+// Make sure buffer have at least `size` bytes of not processed data.
+bool FramedReader::ReadExactly(size_t size)
+{
+    if (m_end - m_begin >= size)
+        return true;
+
+    if (m_buffer.size() - m_begin < size)
+    {
+        memmove(m_buffer.data(), m_buffer.data() + m_begin, m_end - m_begin);
+        m_end -= m_begin;
+        m_begin = 0;
+        if (m_buffer.size() < size)
+            m_buffer.resize(size);
+    }
+
+    // Note, sgetn() block until all requested data read (or EOF/error).
+    size_t required = size - (m_end - m_begin);
+    size_t read = m_streamBuf->sgetn(m_buffer.data() + m_end, required);
+    m_end += read;
+    return read == required;
+}
+
+bool FramedReader::ReadMessage(string_view &content)
+{
+    // parse header (only content len) until empty line
+    bool haveContentLength = false;
+    size_t contentLength = 0;
+    while (true)
+    {
+        const char *lineBegin = m_buffer.data() + m_begin;
+        const char *lineEnd = m_begin == m_end ? nullptr : static_cast<const char*>(memchr(lineBegin, '\n', m_end - m_begin));
+        if (lineEnd == nullptr)
+        {
+            if (!ReadMore())
+            {
+                if (m_begin == m_end) LOGI("EOF");
+                else LOGE("Unexpected EOF!");
+                return false;
+            }
+            continue;
+        }
+
+        string_view line(lineBegin, lineEnd - lineBegin);
+        m_begin += line.size() + 1;
+
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+
+        if (line.empty())
+        {
+            if (!haveContentLength)
+            {
+                LOGE("protocol error: no 'Content Length:' field!");
+                return false;
+            }
+            break; // header and content delimiter
+        }
+
+        LOGD("header: '%.*s'", int(line.size()), line.data());
+
+        if (line.size() > ContentLength.size() && line.substr(0, ContentLength.size()) == ContentLength)
+        {
+            if (haveContentLength)
+                LOGW("protocol violation: duplicate '%.*s'", int(line.size()), line.data());
+
+            if (!ParseContentLength(line.substr(ContentLength.size()), contentLength))
+            {
+                LOGE("protocol violation: '%.*s'", int(line.size()), line.data());
+                return false;
+            }
+            haveContentLength = true;
+        }
+    }
+
+    if (!ReadExactly(contentLength))
+    {
+        LOGE("Unexpected EOF!");
+        return false;
+    }
+
+    content = string_view(m_buffer.data() + m_begin, contentLength);
+    m_begin += contentLength;
+    return true;
+}
+
+} // namespace netcoredbg
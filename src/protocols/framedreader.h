@@ -0,0 +1,38 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <istream>
+#include <vector>
+#include "utils/string_view.h"
+
+namespace netcoredbg
+{
+
+using Utility::string_view;
+
+// Reader for messages framed by `Content-Length: N\r\n\r\n` header (VSCode debug adapter protocol base protocol).
+// Data read from stream buffer by big chunks into internal reusable buffer, headers parsed in place
+// (no allocation for each header line and each message content).
+class FramedReader
+{
+public:
+    explicit FramedReader(std::istream &input) : m_streamBuf(input.rdbuf()), m_begin(0), m_end(0) {}
+
+    // Read next message content, return false in case of EOF, stream reading or protocol error.
+    // Note, provided content valid until next ReadMessage() call.
+    bool ReadMessage(string_view &content);
+
+private:
+    std::streambuf *m_streamBuf;
+    std::vector<char> m_buffer;
+    size_t m_begin; // start of not processed data in m_buffer
+    size_t m_end;   // end of data in m_buffer
+
+    bool ReadMore();
+    bool ReadExactly(size_t size);
+};
+
+} // namespace netcoredbg
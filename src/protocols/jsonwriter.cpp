@@ -0,0 +1,146 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "protocols/jsonwriter.h"
+
+namespace netcoredbg
+{
+
+namespace
+{
+    const char HexDigits[] = "0123456789abcdef";
+
+    inline bool IsContinuation(uint8_t ch) { return (ch & 0xc0) == 0x80; }
+
+    // Return length of valid UTF-8 multibyte sequence, or 0 in case of invalid sequence.
+    size_t ValidSequenceLength(const uint8_t *str, size_t len)
+    {
+        uint8_t ch = str[0];
+        if (ch >= 0xc2 && ch <= 0xdf)
+            return (len >= 2 && IsContinuation(str[1])) ? 2 : 0;
+
+        if (ch >= 0xe0 && ch <= 0xef)
+        {
+            if (len < 3 || !IsContinuation(str[1]) || !IsContinuation(str[2]))
+                return 0;
+            uint32_t cp = ((ch & 0x0f) << 12) | ((str[1] & 0x3f) << 6) | (str[2] & 0x3f);
+            return (cp >= 0x800 && (cp < 0xd800 || cp > 0xdfff)) ? 3 : 0;
+        }
+
+        if (ch >= 0xf0 && ch <= 0xf4)
+        {
+            if (len < 4 || !IsContinuation(str[1]) || !IsContinuation(str[2]) || !IsContinuation(str[3]))
+                return 0;
+            uint32_t cp = ((ch & 0x07) << 18) | ((str[1] & 0x3f) << 12) | ((str[2] & 0x3f) << 6) | (str[3] & 0x3f);
+            return (cp >= 0x10000 && cp <= 0x10ffff) ? 4 : 0;
+        }
+
+        return 0;
+    }
+
+    // Lone surrogate, encoded as 3 bytes sequence by utf16_to_utf8().
+    inline bool IsEncodedSurrogate(const uint8_t *str, size_t len)
+    {
+        return len >= 3 && str[0] == 0xed && str[1] >= 0xa0 && str[1] <= 0xbf && IsContinuation(str[2]);
+    }
+
+    inline void AppendUnicodeEscape(std::string &output, uint32_t cp)
+    {
+        char escape[6] = {'\\', 'u', HexDigits[(cp >> 12) & 0xf], HexDigits[(cp >> 8) & 0xf], HexDigits[(cp >> 4) & 0xf], HexDigits[cp & 0xf]};
+        output.append(escape, sizeof(escape));
+    }
+
+} // unnamed namespace
+
+void JsonWriter::String(string_view value)
+{
+    Separator();
+    m_output.push_back('"');
+
+    const uint8_t *str = reinterpret_cast<const uint8_t*>(value.data());
+    const size_t len = value.size();
+    size_t runStart = 0; // start of characters, that could be copied as is
+    size_t i = 0;
+    while (i < len)
+    {
+        uint8_t ch = str[i];
+        if (ch >= 0x20 && ch < 0x80 && ch != '"' && ch != '\\')
+        {
+            i++;
+            continue;
+        }
+
+        size_t sequenceLength = ch >= 0x80 ? ValidSequenceLength(str + i, len - i) : 0;
+        if (sequenceLength > 0)
+        {
+            i += sequenceLength;
+            continue;
+        }
+
+        m_output.append(value.data() + runStart, i - runStart);
+        switch (ch)
+        {
+            case '"':  m_output.append("\\\""); break;
+            case '\\': m_output.append("\\\\"); break;
+            case '\b': m_output.append("\\b"); break;
+            case '\f': m_output.append("\\f"); break;
+            case '\n': m_output.append("\\n"); break;
+            case '\r': m_output.append("\\r"); break;
+            case '\t': m_output.append("\\t"); break;
+            default:
+                if (ch < 0x20)
+                    AppendUnicodeEscape(m_output, ch);
+                else if (IsEncodedSurrogate(str + i, len - i))
+                {
+                    AppendUnicodeEscape(m_output, ((ch & 0x0f) << 12) | ((str[i + 1] & 0x3f) << 6) | (str[i + 2] & 0x3f));
+                    i += 2;
+                }
+                else
+                    m_output.append("\xef\xbf\xbd"); // U+FFFD
+                break;
+        }
+        i++;
+        runStart = i;
+    }
+    m_output.append(value.data() + runStart, len - runStart);
+
+    m_output.push_back('"');
+    m_first = false;
+}
+
+void JsonWriter::AppendUInt(uint64_t value)
+{
+    char buffer[20]; // max uint64_t value have 20 digits
+    char *end = buffer + sizeof(buffer);
+    char *begin = end;
+    do
+    {
+        *--begin = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    while (value != 0);
+    m_output.append(begin, end - begin);
+}
+
+void JsonWriter::Int(int64_t value)
+{
+    Separator();
+    if (value < 0)
+    {
+        m_output.push_back('-');
+        AppendUInt(0 - static_cast<uint64_t>(value));
+    }
+    else
+        AppendUInt(static_cast<uint64_t>(value));
+    m_first = false;
+}
+
+void JsonWriter::UInt(uint64_t value)
+{
+    Separator();
+    AppendUInt(value);
+    m_first = false;
+}
+
+} // namespace netcoredbg
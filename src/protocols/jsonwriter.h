@@ -0,0 +1,48 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "utils/string_view.h"
+
+namespace netcoredbg
+{
+
+using Utility::string_view;
+
+// Streaming JSON writer, serialize values directly into caller provided buffer without building of intermediate
+// JSON tree (buffer could be reused between messages for avoid allocations). Produce same compact output as
+// nlohmann::json::dump() do, but strings with invalid UTF-8 don't lead to exception: encoded lone surrogates written
+// as `\uXXXX` escape sequence, other invalid bytes replaced by U+FFFD.
+// Note, writer don't check document structure, caller responsible for proper Key() and values calls order.
+class JsonWriter
+{
+public:
+    // Note, writer append data to the end of output buffer.
+    explicit JsonWriter(std::string &output) : m_output(output), m_first(true) {}
+
+    void BeginObject() { Separator(); m_output.push_back('{'); m_first = true; }
+    void EndObject() { m_output.push_back('}'); m_first = false; }
+    void BeginArray() { Separator(); m_output.push_back('['); m_first = true; }
+    void EndArray() { m_output.push_back(']'); m_first = false; }
+
+    // Write object member name, must be followed by value.
+    void Key(string_view key) { String(key); m_output.push_back(':'); m_first = true; }
+
+    void String(string_view value);
+    void Int(int64_t value);
+    void UInt(uint64_t value);
+    void Bool(bool value) { Separator(); m_output.append(value ? "true" : "false"); m_first = false; }
+
+private:
+    std::string &m_output;
+    bool m_first; // next value is first in array or object, or object member value
+
+    void Separator() { if (!m_first) m_output.push_back(','); }
+    void AppendUInt(uint64_t value);
+};
+
+} // namespace netcoredbg
@@ -244,7 +244,7 @@ static void PrintVar(const std::string &varobjName, Variable &v, ThreadId thread
     }
     ss << "attributes=\"" << attributes << "\",";
     ss << "exp=\"" << MIProtocol::EscapeMIValue(v.name.empty() ? v.evaluateName : v.name) << "\",";
-    ss << "numchild=\"" << v.namedVariables << "\",";
+    ss << "numchild=\"" << v.namedVariables + v.indexedVariables << "\",";
     ss << "type=\"" << v.type << "\",";
     ss << "thread-id=\"" << int(threadId) << "\"";
 
@@ -367,7 +367,7 @@ HRESULT MIProtocol::VariablesHandle::ListChildren(std::shared_ptr<IDebugger> &sh
 
     if (miVariable.variable.variablesReference > 0)
     {
-        IfFailRet(sharedDebugger->GetVariables(miVariable.variable.variablesReference, VariablesNamed, childStart, childEnd - childStart, variables));
+        IfFailRet(sharedDebugger->GetVariables(miVariable.variable.variablesReference, VariablesBoth, childStart, childEnd - childStart, variables));
         has_more = childEnd < sharedDebugger->GetNamedVariables(miVariable.variable.variablesReference);
         for (auto &child : variables)
         {
@@ -12,7 +12,8 @@
 #include <sstream>
 #include <algorithm>
 #include <thread>
-#include <future>
+#include <chrono>
+#include <memory>
 
 // note: order matters, vscodeprotocol.h should be included before winerror.h
 #include "protocols/vscodeprotocol.h"
@@ -24,6 +25,8 @@
 #include "utils/utf.h"
 #include "utils/logger.h"
 #include "protocols/escaped_string.h"
+#include "protocols/jsonwriter.h"
+#include "protocols/framedreader.h"
 
 // for convenience
 using json = nlohmann::json;
@@ -54,6 +57,13 @@ namespace
     // Don't cancel commands related to debugger configuration. For example, breakpoint setup could be done in any time (even if process don't attached at all).
     const std::unordered_set<std::string> g_debuggerSetupCommandSet{
         "initialize", "setExceptionBreakpoints", "configurationDone", "setBreakpoints", "launch", "disconnect", "terminate", "attach", "setFunctionBreakpoints"};
+    // Read-only commands, that could be executed concurrently with each other (debugger take process reader lock for them).
+    // Note, any other command executed only after all previous commands execution is finished.
+    // Note, "scopes" and "variables" are not here, since they could run properties getters (func-eval resume debuggee process).
+    const std::unordered_set<std::string> g_concurrentCommandSet{
+        "threads", "stackTrace"};
+    // Note, most of time read-only commands wait for each other on debugger internal locks, no reason for big pool.
+    const unsigned g_commandsWorkersCount = 4;
 } // unnamed namespace
 
 void to_json(json &j, const Source &s) {
@@ -74,25 +84,6 @@ void to_json(json &j, const Breakpoint &b) {
     }
 }
 
-void to_json(json &j, const StackFrame &f) {
-    j = json{
-        {"id",        int(f.id)},
-        {"name",      f.methodName},
-        {"line",      f.line},
-        {"column",    f.column},
-        {"endLine",   f.endLine},
-        {"endColumn", f.endColumn},
-        {"moduleId",  f.moduleId}};
-    if (!f.source.IsNull())
-        j["source"] = f.source;
-}
-
-void to_json(json &j, const Thread &t) {
-    j = json{{"id",   int(t.id)},
-             {"name", t.name}};
-          // {"running", t.running}
-}
-
 void to_json(json &j, const Scope &s) {
     j = json{
         {"name",               s.name},
@@ -102,23 +93,93 @@ void to_json(json &j, const Scope &s) {
     if (s.variablesReference > 0)
     {
         j["namedVariables"] = s.namedVariables;
-        // j["indexedVariables"] = s.indexedVariables;
+        if (s.indexedVariables > 0)
+            j["indexedVariables"] = s.indexedVariables;
     }
 }
 
-void to_json(json &j, const Variable &v) {
-    j = json{
-        {"name",               v.name},
-        {"value",              v.value},
-        {"type",               v.type},
-        {"evaluateName",       v.evaluateName},
-        {"variablesReference", v.variablesReference}};
+// Serializers for big responses (variables, stack trace, threads and breakpoints lists).
+// Note, members written in the same order as nlohmann::json dump() do (sorted by name).
+static void WriteJson(JsonWriter &writer, const Source &s)
+{
+    writer.BeginObject();
+    writer.Key("name"); writer.String(s.name);
+    writer.Key("path"); writer.String(s.path);
+    writer.EndObject();
+}
+
+static void WriteJson(JsonWriter &writer, const Breakpoint &b)
+{
+    writer.BeginObject();
+    if (b.verified)
+    {
+        writer.Key("endLine"); writer.Int(b.endLine);
+    }
+    writer.Key("id"); writer.UInt(b.id);
+    writer.Key("line"); writer.Int(b.line);
+    writer.Key("message"); writer.String(b.message);
+    if (b.verified && !b.source.IsNull())
+    {
+        writer.Key("source"); WriteJson(writer, b.source);
+    }
+    writer.Key("verified"); writer.Bool(b.verified);
+    writer.EndObject();
+}
+
+static void WriteJson(JsonWriter &writer, const StackFrame &f)
+{
+    writer.BeginObject();
+    writer.Key("column"); writer.Int(f.column);
+    writer.Key("endColumn"); writer.Int(f.endColumn);
+    writer.Key("endLine"); writer.Int(f.endLine);
+    writer.Key("id"); writer.Int(int(f.id));
+    writer.Key("line"); writer.Int(f.line);
+    writer.Key("moduleId"); writer.String(f.moduleId);
+    writer.Key("name"); writer.String(f.methodName);
+    if (!f.source.IsNull())
+    {
+        writer.Key("source"); WriteJson(writer, f.source);
+    }
+    writer.EndObject();
+}
+
+static void WriteJson(JsonWriter &writer, const Thread &t)
+{
+    writer.BeginObject();
+    writer.Key("id"); writer.Int(int(t.id));
+    writer.Key("name"); writer.String(t.name);
+    // writer.Key("running"); writer.Bool(t.running);
+    writer.EndObject();
+}
 
+static void WriteJson(JsonWriter &writer, const Variable &v)
+{
+    writer.BeginObject();
+    writer.Key("evaluateName"); writer.String(v.evaluateName);
+    writer.Key("name"); writer.String(v.name);
     if (v.variablesReference > 0)
     {
-        j["namedVariables"] = v.namedVariables;
-        // j["indexedVariables"] = v.indexedVariables;
+        writer.Key("namedVariables"); writer.Int(v.namedVariables);
+        if (v.indexedVariables > 0)
+        {
+            writer.Key("indexedVariables"); writer.Int(v.indexedVariables);
+        }
     }
+    writer.Key("type"); writer.String(v.type);
+    writer.Key("value"); writer.String(v.value);
+    writer.Key("variablesReference"); writer.UInt(v.variablesReference);
+    writer.EndObject();
+}
+
+template <typename T>
+static void WriteJson(JsonWriter &writer, const std::vector<T> &values)
+{
+    writer.BeginArray();
+    for (const auto &value : values)
+    {
+        WriteJson(writer, value);
+    }
+    writer.EndArray();
 }
 
 static json FormJsonForExceptionDetails(const ExceptionDetails &details)
@@ -401,6 +462,7 @@ static void AddCapabilitiesTo(json &capabilities)
     capabilities["supportsSetExpression"] = true;
     capabilities["supportsTerminateRequest"] = true;
     capabilities["supportsCancelRequest"] = true;
+    capabilities["supportsValueFormattingOptions"] = true;
 
     capabilities["supportsExceptionInfoRequest"] = true;
     capabilities["supportsExceptionFilterOptions"] = true;
@@ -435,21 +497,35 @@ void VSCodeProtocol::Cleanup()
 }
 
 // Caller must care about m_outMutex.
-void VSCodeProtocol::EmitMessage(nlohmann::json &message, std::string &output)
+// Note, not empty `rawBody` is already serialized message "body" member.
+void VSCodeProtocol::EmitMessage(nlohmann::json &message, std::string &output, string_view rawBody)
 {
     message["seq"] = std::to_string(m_seqCounter);
     ++m_seqCounter;
-    output = message.dump();
+
+    // Serialize into provided buffer, so, buffer memory could be reused.
+    output.clear();
+    nlohmann::detail::serializer<json> serializer(nlohmann::detail::output_adapter<char>(output), ' ');
+    serializer.dump(message, false, false, 0);
+
+    if (!rawBody.empty())
+    {
+        // Note, "body" is the first member of message object, since members sorted by name.
+        static const string_view bodyKey("\"body\":");
+        output.insert(1, bodyKey.size() + rawBody.size() + 1, ',');
+        std::copy(bodyKey.begin(), bodyKey.end(), output.begin() + 1);
+        std::copy(rawBody.begin(), rawBody.end(), output.begin() + 1 + bodyKey.size());
+    }
+
     cout << CONTENT_LENGTH << output.size() << TWO_CRLF << output;
     cout.flush();
 }
 
-void VSCodeProtocol::EmitMessageWithLog(const std::string &message_prefix, nlohmann::json &message)
+void VSCodeProtocol::EmitMessageWithLog(const std::string &message_prefix, nlohmann::json &message, string_view rawBody)
 {
     std::lock_guard<std::mutex> lock(m_outMutex);
-    std::string output;
-    EmitMessage(message, output);
-    Log(message_prefix, output);
+    EmitMessage(message, m_outputBuffer, rawBody);
+    Log(message_prefix, m_outputBuffer);
 }
 
 void VSCodeProtocol::EmitEvent(const std::string &name, const nlohmann::json &body)
@@ -461,9 +537,162 @@ void VSCodeProtocol::EmitEvent(const std::string &name, const nlohmann::json &bo
     EmitMessageWithLog(LOG_EVENT, message);
 }
 
+// Note, netcoredbg specific launch/attach argument, for example:
+// "evalTimeouts": {"locals": 1000, "watch": 5000, "condition": 5000, "hover": 2000, "abort": 5000, "slowGetterThreshold": 500}
+// Not provided values stay as is (could be set by command line options).
+static void SetEvalTimeouts(std::shared_ptr<IDebugger> &sharedDebugger, const json &arguments)
+{
+    auto evalTimeoutsIter = arguments.find("evalTimeouts");
+    if (evalTimeoutsIter == arguments.end())
+        return;
+
+    const json &timeouts = evalTimeoutsIter.value();
+    EvalTimeouts evalTimeouts = sharedDebugger->GetEvalTimeouts();
+    // Note, zero or negative timeout is ignored, slow getter threshold 0 means "disabled".
+    auto setValue = [&timeouts](const char *name, int &value, int minValue)
+    {
+        int newValue = timeouts.value(name, value);
+        if (newValue >= minValue)
+            value = newValue;
+        else
+            LOGW("Ignore wrong evalTimeouts value %s: %d", name, newValue);
+    };
+    setValue("locals", evalTimeouts.locals, 1);
+    setValue("watch", evalTimeouts.watch, 1);
+    setValue("condition", evalTimeouts.condition, 1);
+    setValue("hover", evalTimeouts.hover, 1);
+    setValue("abort", evalTimeouts.abort, 1);
+    setValue("slowGetterThreshold", evalTimeouts.slowGetterThreshold, 0);
+    sharedDebugger->SetEvalTimeouts(evalTimeouts);
+}
+
 static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::string &fileExec, std::vector<std::string> &execArgs,
-                             const std::string &command, const json &arguments, json &body)
+                             const std::string &command, const json &arguments, json &body, JsonWriter &bodyWriter)
 {
+    // Commands with big responses, body serialized by JsonWriter directly into reusable buffer.
+    // Note, `body` used for error message only, `bodyWriter` must be used only in case of success.
+    typedef std::function<HRESULT(const json &arguments, json &body, JsonWriter &bodyWriter)> WriterCommandCallback;
+    static std::unordered_map<std::string, WriterCommandCallback> writerCommands {
+    { "setBreakpoints", [&](const json &arguments, json &body, JsonWriter &bodyWriter){
+        HRESULT Status;
+
+        std::vector<LineBreakpoint> lineBreakpoints;
+        for (auto &b : arguments.at("breakpoints"))
+            lineBreakpoints.emplace_back(std::string(), b.at("line"), b.value("condition", std::string()));
+
+        std::vector<Breakpoint> breakpoints;
+        IfFailRet(sharedDebugger->SetLineBreakpoints(arguments.at("source").at("path"), lineBreakpoints, breakpoints));
+
+        bodyWriter.BeginObject();
+        bodyWriter.Key("breakpoints"); WriteJson(bodyWriter, breakpoints);
+        bodyWriter.EndObject();
+
+        return S_OK;
+    } },
+    { "threads", [&](const json &arguments, json &body, JsonWriter &bodyWriter){
+        HRESULT Status;
+        std::vector<Thread> threads;
+        IfFailRet(sharedDebugger->GetThreads(threads));
+
+        bodyWriter.BeginObject();
+        bodyWriter.Key("threads"); WriteJson(bodyWriter, threads);
+        bodyWriter.EndObject();
+
+        return S_OK;
+    } },
+    { "stackTrace", [&](const json &arguments, json &body, JsonWriter &bodyWriter){
+        HRESULT Status;
+
+        int totalFrames = 0;
+        ThreadId threadId{int(arguments.at("threadId"))};
+
+        std::vector<StackFrame> stackFrames;
+        IfFailRet(sharedDebugger->GetStackTrace(
+            threadId,
+            FrameLevel{arguments.value("startFrame", 0)},
+            unsigned(arguments.value("levels", 0)),
+            stackFrames,
+            totalFrames
+            ));
+
+        bodyWriter.BeginObject();
+        bodyWriter.Key("stackFrames"); WriteJson(bodyWriter, stackFrames);
+        bodyWriter.Key("totalFrames"); bodyWriter.Int(totalFrames);
+        bodyWriter.EndObject();
+
+        return S_OK;
+    } },
+    { "variables", [&](const json &arguments, json &body, JsonWriter &bodyWriter){
+        HRESULT Status;
+        std::string filterName = arguments.value("filter", "");
+        VariablesFilter filter = VariablesBoth;
+        if (filterName == "named")
+            filter = VariablesNamed;
+        else if (filterName == "indexed")
+            filter = VariablesIndexed;
+
+        std::vector<Variable> variables;
+        IfFailRet(sharedDebugger->GetVariables(
+            arguments.at("variablesReference"),
+            filter,
+            arguments.value("start", 0),
+            arguments.value("count", 0),
+            variables,
+            arguments.value("format", json::object()).value("hex", false)));
+
+        bodyWriter.BeginObject();
+        bodyWriter.Key("variables"); WriteJson(bodyWriter, variables);
+        bodyWriter.EndObject();
+
+        return S_OK;
+    } },
+    { "setFunctionBreakpoints", [&](const json &arguments, json &body, JsonWriter &bodyWriter) {
+        HRESULT Status = S_OK;
+
+        std::vector<FuncBreakpoint> funcBreakpoints;
+        for (auto &b : arguments.at("breakpoints"))
+        {
+            std::string module("");
+            std::string params("");
+            std::string name = b.at("name");
+
+            std::size_t i = name.find('!');
+
+            if (i != std::string::npos)
+            {
+                module = std::string(name, 0, i);
+                name.erase(0, i + 1);
+            }
+
+            i = name.find('(');
+            if (i != std::string::npos)
+            {
+                std::size_t closeBrace = name.find(')');
+
+                params = std::string(name, i, closeBrace - i + 1);
+                name.erase(i, closeBrace);
+            }
+
+            funcBreakpoints.emplace_back(module, name, params, b.value("condition", std::string()));
+        }
+
+        std::vector<Breakpoint> breakpoints;
+        IfFailRet(sharedDebugger->SetFuncBreakpoints(funcBreakpoints, breakpoints));
+
+        bodyWriter.BeginObject();
+        bodyWriter.Key("breakpoints"); WriteJson(bodyWriter, breakpoints);
+        bodyWriter.EndObject();
+
+        return Status;
+    } }
+    };
+
+    auto writerCommand_it = writerCommands.find(command);
+    if (writerCommand_it != writerCommands.end())
+    {
+        return writerCommand_it->second(arguments, body, bodyWriter);
+    }
+
     typedef std::function<HRESULT(const json &arguments, json &body)> CommandCallback;
     static std::unordered_map<std::string, CommandCallback> commands {
     { "initialize", [&](const json &arguments, json &body){
@@ -548,20 +777,6 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         body["details"] = FormJsonForExceptionDetails(exceptionInfo.details);
         return S_OK;
     } },
-    { "setBreakpoints", [&](const json &arguments, json &body){
-        HRESULT Status;
-
-        std::vector<LineBreakpoint> lineBreakpoints;
-        for (auto &b : arguments.at("breakpoints"))
-            lineBreakpoints.emplace_back(std::string(), b.at("line"), b.value("condition", std::string()));
-
-        std::vector<Breakpoint> breakpoints;
-        IfFailRet(sharedDebugger->SetLineBreakpoints(arguments.at("source").at("path"), lineBreakpoints, breakpoints));
-
-        body["breakpoints"] = breakpoints;
-
-        return S_OK;
-    } },
     { "launch", [&](const json &arguments, json &body){
         auto cwdIt = arguments.find("cwd");
         const std::string cwd(cwdIt != arguments.end() ? cwdIt.value().get<std::string>() : std::string{});
@@ -579,6 +794,7 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
 
         sharedDebugger->SetJustMyCode(arguments.value("justMyCode", true)); // MS vsdbg have "justMyCode" enabled by default.
         sharedDebugger->SetStepFiltering(arguments.value("enableStepFiltering", true)); // MS vsdbg have "enableStepFiltering" enabled by default.
+        SetEvalTimeouts(sharedDebugger, arguments);
 
         if (!fileExec.empty())
             return sharedDebugger->Launch(fileExec, execArgs, env, cwd, arguments.value("stopAtEntry", false));
@@ -588,15 +804,6 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
 
         return sharedDebugger->Launch("dotnet", args, env, cwd, arguments.value("stopAtEntry", false));
     } },
-    { "threads", [&](const json &arguments, json &body){
-        HRESULT Status;
-        std::vector<Thread> threads;
-        IfFailRet(sharedDebugger->GetThreads(threads));
-
-        body["threads"] = threads;
-
-        return S_OK;
-    } },
     { "disconnect", [&](const json &arguments, json &body){
         auto terminateArgIter = arguments.find("terminateDebuggee");
         IDebugger::DisconnectAction action;
@@ -613,26 +820,6 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         sharedDebugger->Disconnect(IDebugger::DisconnectAction::DisconnectTerminate);
         return S_OK;
     } },
-    { "stackTrace", [&](const json &arguments, json &body){
-        HRESULT Status;
-
-        int totalFrames = 0;
-        ThreadId threadId{int(arguments.at("threadId"))};
-
-        std::vector<StackFrame> stackFrames;
-        IfFailRet(sharedDebugger->GetStackTrace(
-            threadId,
-            FrameLevel{arguments.value("startFrame", 0)},
-            unsigned(arguments.value("levels", 0)),
-            stackFrames,
-            totalFrames
-            ));
-
-        body["stackFrames"] = stackFrames;
-        body["totalFrames"] = totalFrames;
-
-        return S_OK;
-    } },
     { "continue", [&](const json &arguments, json &body){
         body["allThreadsContinued"] = true;
 
@@ -664,27 +851,6 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
 
         return S_OK;
     } },
-    { "variables", [&](const json &arguments, json &body){
-        HRESULT Status;
-        std::string filterName = arguments.value("filter", "");
-        VariablesFilter filter = VariablesBoth;
-        if (filterName == "named")
-            filter = VariablesNamed;
-        else if (filterName == "indexed")
-            filter = VariablesIndexed;
-
-        std::vector<Variable> variables;
-        IfFailRet(sharedDebugger->GetVariables(
-            arguments.at("variablesReference"),
-            filter,
-            arguments.value("start", 0),
-            arguments.value("count", 0),
-            variables));
-
-        body["variables"] = variables;
-
-        return S_OK;
-    } },
     { "evaluate", [&](const json &arguments, json &body){
         HRESULT Status;
         std::string expression = arguments.at("expression");
@@ -704,6 +870,15 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         // VSCode don't support evaluation flags, we can't disable implicit function calls during evaluation.
         // https://github.com/OmniSharp/omnisharp-vscode/issues/3173
         Variable variable;
+        // Note, netcoredbg specific arguments for huge strings retrieval by chunks.
+        auto stringRangeIter = arguments.find("stringRange");
+        if (stringRangeIter != arguments.end())
+        {
+            variable.stringStart = stringRangeIter.value().value("start", 0);
+            variable.stringCount = stringRangeIter.value().value("count", 0);
+        }
+        variable.hexFormat = arguments.value("format", json::object()).value("hex", false);
+        variable.evalRequest = arguments.value("context", "") == "hover" ? EvalRequestKind::Hover : EvalRequestKind::Watch;
         std::string output;
         Status = sharedDebugger->Evaluate(frameId, expression, variable, output);
         if (FAILED(Status))
@@ -722,11 +897,14 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
 
         body["result"] = variable.value;
         body["type"] = variable.type;
+        if (variable.stringLength >= 0)
+            body["stringLength"] = variable.stringLength;
         body["variablesReference"] = variable.variablesReference;
         if (variable.variablesReference > 0)
         {
             body["namedVariables"] = variable.namedVariables;
-            // indexedVariables
+            if (variable.indexedVariables > 0)
+                body["indexedVariables"] = variable.indexedVariables;
         }
         return S_OK;
     } },
@@ -779,6 +957,7 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         else
             return E_INVALIDARG;
 
+        SetEvalTimeouts(sharedDebugger, arguments);
         return sharedDebugger->Attach(processId);
     } },
     { "setVariable", [&](const json &arguments, json &body) {
@@ -799,43 +978,6 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
         body["value"] = output;
 
         return S_OK;
-    } },
-    { "setFunctionBreakpoints", [&](const json &arguments, json &body) {
-        HRESULT Status = S_OK;
-
-        std::vector<FuncBreakpoint> funcBreakpoints;
-        for (auto &b : arguments.at("breakpoints"))
-        {
-            std::string module("");
-            std::string params("");
-            std::string name = b.at("name");
-
-            std::size_t i = name.find('!');
-
-            if (i != std::string::npos)
-            {
-                module = std::string(name, 0, i);
-                name.erase(0, i + 1);
-            }
-
-            i = name.find('(');
-            if (i != std::string::npos)
-            {
-                std::size_t closeBrace = name.find(')');
-
-                params = std::string(name, i, closeBrace - i + 1);
-                name.erase(i, closeBrace);
-            }
-
-            funcBreakpoints.emplace_back(module, name, params, b.value("condition", std::string()));
-        }
-
-        std::vector<Breakpoint> breakpoints;
-        IfFailRet(sharedDebugger->SetFuncBreakpoints(funcBreakpoints, breakpoints));
-
-        body["breakpoints"] = breakpoints;
-
-        return Status;
     } }
     };
 
@@ -849,11 +991,11 @@ static HRESULT HandleCommand(std::shared_ptr<IDebugger> &sharedDebugger, std::st
 }
 
 static HRESULT HandleCommandJSON(std::shared_ptr<IDebugger> &sharedDebugger, std::string &fileExec, std::vector<std::string> &execArgs,
-                                 const std::string &command, const json &arguments, json &body)
+                                 const std::string &command, const json &arguments, json &body, JsonWriter &bodyWriter)
 {
     try
     {
-        return HandleCommand(sharedDebugger, fileExec, execArgs, command, arguments, body);
+        return HandleCommand(sharedDebugger, fileExec, execArgs, command, arguments, body, bodyWriter);
     }
     catch (nlohmann::detail::exception& ex)
     {
@@ -864,170 +1006,275 @@ static HRESULT HandleCommandJSON(std::shared_ptr<IDebugger> &sharedDebugger, std
     return E_FAIL;
 }
 
-static std::string ReadData(std::istream& cin)
+static std::chrono::milliseconds GetCommandTimeout(const std::string &command, const json &arguments, const EvalTimeouts &evalTimeouts)
 {
-    // parse header (only content len) until empty line
-    long content_len = -1;
-    while (true)
+    // MSVS debugger use config file, for Visual Studio 2022 Community Edition located at
+    // C:\Program Files\Microsoft Visual Studio\2022\Community\Common7\IDE\Profiles\CSharp.vssettings
+    // Visual Studio have timeout setup for each type of requests, for example:
+    // LocalsTimeout = 1000
+    // LongEvalTimeout = 10000
+    // NormalEvalTimeout = 5000
+    // QuickwatchTimeout = 15000
+    // SetValueTimeout = 10000
+    // ...
+    // Note, all requests have at least QuickwatchTimeout, since some of them could wait for deferred module's data load
+    // (for example, first stack trace in big module), requests with evaluation could take more time in case evaluation
+    // timeouts are configured bigger than default.
+    static const std::chrono::milliseconds QuickwatchTimeout(15000);
+
+    // Note, command should not be canceled before configured evaluation timeout plus evaluation abort time.
+    auto evalTimeout = [&evalTimeouts](int timeout)
     {
-        std::string line;
-        std::getline(cin, line);
-        if (!cin.good())
-        {
-            if (cin.eof()) LOGI("EOF");
-            else LOGE("input stream reading error");
-            return {};
-        }
+        return std::max(QuickwatchTimeout, std::chrono::milliseconds(timeout) + std::chrono::milliseconds(evalTimeouts.abort));
+    };
+
+    // Note, variables listing could execute many properties getters.
+    if (command == "scopes" || command == "variables" || command == "exceptionInfo")
+        return evalTimeout(evalTimeouts.locals);
 
-        if (!line.empty() && line.back() == '\r')
-                line.pop_back();
+    if (command == "evaluate")
+        return evalTimeout(arguments.value("context", "") == "hover" ? evalTimeouts.hover : evalTimeouts.watch);
+
+    if (command == "setVariable" || command == "setExpression")
+        return evalTimeout(evalTimeouts.watch);
+
+    // Default timeout for all other requests (including concurrent `threads` and `stackTrace`).
+    return QuickwatchTimeout;
+}
 
-        if (line.empty())
+// Note, in case of success with not empty `rawBody`, response body must be emitted from `rawBody`.
+static void FormResponse(json &response, const std::string &command, HRESULT Status, json &body, const std::string &rawBody)
+{
+    if (SUCCEEDED(Status))
+    {
+        response["success"] = true;
+        if (rawBody.empty())
+            response["body"] = body;
+    }
+    else
+    {
+        if (body.find("message") == body.end())
         {
-            if (content_len < 0)
-            {
-                LOGE("protocol error: no 'Content Length:' field!");
-                return {};
-            }
-            break;         // header and content delimiter
+            std::ostringstream ss;
+            ss << "Failed command '" << command << "' : "
+            << "0x" << std::setw(8) << std::setfill('0') << std::hex << Status;
+            response["message"] = ss.str();
         }
+        else
+            response["message"] = body["message"];
 
-        LOGD("header: '%s'", line.c_str());
+        response["success"] = false;
+    }
+}
 
-        if (line.size() > CONTENT_LENGTH.size()
-            && std::equal(CONTENT_LENGTH.begin(), CONTENT_LENGTH.end(), line.begin()))
-        {
-            if (content_len >= 0)
-                LOGW("protocol violation: duplicate '%s'", line.c_str());
+// Caller must care about m_commandsMutex.
+// Note, timed out task is responded, but still executed by worker, no state changing commands allowed until it finished.
+bool VSCodeProtocol::HaveNotFinishedTasks(bool isConcurrent)
+{
+    for (const auto &task : m_tasks)
+    {
+        if (!task->finished && (!isConcurrent || !task->isConcurrent))
+            return true;
+    }
+    return false;
+}
 
-            char *p;
-            errno = 0;
-            content_len = strtoul(&line[CONTENT_LENGTH.size()], &p, 10);
-            if (errno == ERANGE || !(*p == 0 || isspace(*p)))
-            {
-                LOGE("protocol violation: '%s'", line.c_str());
-                return {};
-            }
-        }
+// Caller must not hold m_commandsMutex.
+void VSCodeProtocol::EmitResponses(std::vector<json> &responses)
+{
+    for (auto &response : responses)
+    {
+        EmitMessageWithLog(LOG_RESPONSE, response);
     }
+    responses.clear();
+}
 
-    std::string result(content_len, 0);
-    if (!cin.read(&result[0], content_len))
+// Caller must care about m_commandsMutex.
+// Wait for commands queue or tasks changes and respond timed out tasks.
+void VSCodeProtocol::WaitCommandsOrTasks(std::unique_lock<std::mutex> &lock)
+{
+    bool haveDeadline = false;
+    std::chrono::steady_clock::time_point deadline;
+    for (const auto &task : m_tasks)
     {
-        if (cin.eof()) LOGE("Unexpected EOF!");
-        else LOGE("input stream reading error");
-        return {};
+        if (!task->started || task->responded || (haveDeadline && deadline <= task->deadline))
+            continue;
+
+        deadline = task->deadline;
+        haveDeadline = true;
     }
 
-    return result;
+    // Note, during m_commandsCV.wait() (waiting for notify_one call with entry added into queue or task finished),
+    // m_commandsMutex will be unlocked (see std::condition_variable for more info).
+    if (haveDeadline)
+        m_commandsCV.wait_until(lock, deadline);
+    else
+        m_commandsCV.wait(lock);
+
+    // Note, timed out command continue execution in worker thread, but its result will be ignored.
+    // This could be not critical issue. Let IDE decide.
+    std::vector<json> responses;
+    auto now = std::chrono::steady_clock::now();
+    for (auto &task : m_tasks)
+    {
+        if (!task->started || task->responded || task->deadline > now)
+            continue;
+
+        task->responded = true;
+        task->timedOut = true;
+        task->entry.response["success"] = false;
+        task->entry.response["message"] = "Command execution timed out.";
+        responses.emplace_back(task->entry.response);
+    }
+
+    if (responses.empty())
+        return;
+
+    lock.unlock();
+    EmitResponses(responses);
+    lock.lock();
+}
+
+void VSCodeProtocol::TasksWorker()
+{
+    // Note, buffer reused by all commands executed by this worker.
+    std::string rawBody;
+
+    std::unique_lock<std::mutex> lockCommandsMutex(m_commandsMutex);
+
+    while (true)
+    {
+        auto iter = std::find_if(m_tasks.begin(), m_tasks.end(), [](const std::shared_ptr<CommandTask> &task) { return !task->started; });
+        if (iter == m_tasks.end())
+        {
+            if (m_tasksExit)
+                break;
+
+            m_tasksCV.wait(lockCommandsMutex);
+            continue;
+        }
+
+        std::shared_ptr<CommandTask> task = *iter;
+        task->started = true;
+        // Note, command timeout counted from execution start, not from dispatch.
+        task->deadline = std::chrono::steady_clock::now() + task->timeout;
+        m_commandsCV.notify_one(); // notify_one with lock, new deadline
+        lockCommandsMutex.unlock();
+
+        json body = json::object();
+        rawBody.clear();
+        JsonWriter bodyWriter(rawBody);
+        HRESULT Status = HandleCommandJSON(m_sharedDebugger, m_fileExec, m_execArgs, task->entry.command, task->entry.arguments, body, bodyWriter);
+        if (FAILED(Status))
+            rawBody.clear();
+
+        lockCommandsMutex.lock();
+        if (!task->responded)
+        {
+            task->responded = true;
+            FormResponse(task->entry.response, task->entry.command, Status, body, rawBody);
+            lockCommandsMutex.unlock();
+            EmitMessageWithLog(LOG_RESPONSE, task->entry.response, rawBody);
+            lockCommandsMutex.lock();
+        }
+        task->finished = true;
+        m_tasks.remove(task);
+        m_commandsCV.notify_one(); // notify_one with lock
+    }
 }
 
 void VSCodeProtocol::CommandsWorker()
 {
+    std::vector<std::thread> tasksWorkers;
+    for (unsigned i = 0; i < g_commandsWorkersCount; i++)
+    {
+        tasksWorkers.emplace_back(&VSCodeProtocol::TasksWorker, this);
+    }
+
     std::unique_lock<std::mutex> lockCommandsMutex(m_commandsMutex);
 
     while (true)
     {
         while (m_commandsQueue.empty())
         {
-            // Note, during m_commandsCV.wait() (waiting for notify_one call with entry added into queue),
-            // m_commandsMutex will be unlocked (see std::condition_variable for more info).
-            m_commandsCV.wait(lockCommandsMutex);
+            WaitCommandsOrTasks(lockCommandsMutex);
         }
 
         CommandQueueEntry c = std::move(m_commandsQueue.front());
         m_commandsQueue.pop_front();
-        lockCommandsMutex.unlock();
 
         // Check for ncdbg internal commands.
         if (c.command == "ncdbg_disconnect")
         {
+            lockCommandsMutex.unlock();
             m_sharedDebugger->Disconnect();
+            lockCommandsMutex.lock();
             break;
         }
 
-        json body = json::object();
-        std::future<HRESULT> future = std::async(std::launch::async, [&](){
-            return HandleCommandJSON(m_sharedDebugger, m_fileExec, m_execArgs, c.command, c.arguments, body);
-        });
-        HRESULT Status;
-        // Note, CommandsWorker() loop should never hangs, but even in case some command execution is timed out,
-        // this could be not critical issue. Let IDE decide.
-
-        // MSVS debugger use config file, for Visual Studio 2022 Community Edition located at
-        // C:\Program Files\Microsoft Visual Studio\2022\Community\Common7\IDE\Profiles\CSharp.vssettings
-        // Visual Studio have timeout setup for each type of requests, for example:
-        // LocalsTimeout = 1000
-        // LongEvalTimeout = 10000
-        // NormalEvalTimeout = 5000
-        // QuickwatchTimeout = 15000
-        // SetValueTimeout = 10000
-        // ...
-        // we use max default timeout (15000), one timeout for all requests.
-
-        // TODO add timeout configuration feature
-        std::future_status timeoutStatus = future.wait_for(std::chrono::milliseconds(15000));
-        if (timeoutStatus == std::future_status::timeout)
+        // Note, concurrent command wait for all not concurrent commands finish, not concurrent - for all commands finish.
+        bool isConcurrent = g_concurrentCommandSet.find(c.command) != g_concurrentCommandSet.end();
+        while (HaveNotFinishedTasks(isConcurrent))
         {
-            body["message"] = "Command execution timed out.";
-            Status = COR_E_TIMEOUT;
+            WaitCommandsOrTasks(lockCommandsMutex);
         }
-        else
-            Status = future.get();
 
-        if (SUCCEEDED(Status))
-        {
-            c.response["success"] = true;
-            c.response["body"] = body;
-        }
-        else
-        {
-            if (body.find("message") == body.end())
-            {
-                std::ostringstream ss;
-                ss << "Failed command '" << c.command << "' : "
-                << "0x" << std::setw(8) << std::setfill('0') << std::hex << Status;
-                c.response["message"] = ss.str();
-            }
-            else
-                c.response["message"] = body["message"];
+        std::shared_ptr<CommandTask> task(new CommandTask());
+        task->timeout = GetCommandTimeout(c.command, c.arguments, m_sharedDebugger->GetEvalTimeouts());
+        task->isConcurrent = isConcurrent;
+        task->entry = std::move(c);
+        m_tasks.push_back(task);
+        m_tasksCV.notify_one(); // notify_one with lock
 
-            c.response["success"] = false;
-        }
+        if (isConcurrent)
+            continue;
 
-        EmitMessageWithLog(LOG_RESPONSE, c.response);
+        // Note, worker set `finished` after response emitted, post command action must be done after response.
+        while (!task->finished && !task->timedOut)
+        {
+            WaitCommandsOrTasks(lockCommandsMutex);
+        }
 
         // Post command action.
-        if (g_syncCommandExecutionSet.find(c.command) != g_syncCommandExecutionSet.end())
+        if (g_syncCommandExecutionSet.find(task->entry.command) != g_syncCommandExecutionSet.end())
             m_commandSyncCV.notify_one();
-        if (c.command == "disconnect")
+        if (task->entry.command == "disconnect")
             break;
+    }
 
-        lockCommandsMutex.lock();
+    m_tasksExit = true;
+    m_tasksCV.notify_all(); // notify_all with lock
+    lockCommandsMutex.unlock();
+
+    for (auto &tasksWorker : tasksWorkers)
+    {
+        tasksWorker.join();
     }
 
     m_exit = true;
 }
 
 // Caller must care about m_commandsMutex.
-std::list<VSCodeProtocol::CommandQueueEntry>::iterator VSCodeProtocol::CancelCommand(const std::list<VSCodeProtocol::CommandQueueEntry>::iterator &iter)
+// Note, responses must be emitted by caller after m_commandsMutex unlock.
+void VSCodeProtocol::CancelCommand(CommandQueueEntry &entry, std::vector<json> &responses)
 {
-    iter->response["success"] = false;
-    iter->response["message"] = std::string("Error processing '") + iter->command + std::string("' request. The operation was canceled.");
-    EmitMessageWithLog(LOG_RESPONSE, iter->response);
-    return m_commandsQueue.erase(iter);
+    entry.response["success"] = false;
+    entry.response["message"] = std::string("Error processing '") + entry.command + std::string("' request. The operation was canceled.");
+    responses.emplace_back(entry.response);
 }
 
 void VSCodeProtocol::CommandLoop()
 {
     std::thread commandsWorker{&VSCodeProtocol::CommandsWorker, this};
 
+    FramedReader reader(cin);
+
     m_exit = false;
 
     while (!m_exit)
     {
-        std::string requestText = ReadData(cin);
-        if (requestText.empty())
+        string_view requestText;
+        if (!reader.ReadMessage(requestText) || requestText.empty())
         {
             CommandQueueEntry queueEntry;
             queueEntry.command = "ncdbg_disconnect";
@@ -1051,7 +1298,7 @@ void VSCodeProtocol::CommandLoop()
         CommandQueueEntry queueEntry;
         try
         {
-            json request = json::parse(requestText);
+            json request = json::parse(requestText.begin(), requestText.end());
 
             // Variable `resp' is used to construct response and assign it to `response'
             // variable in single step: `response' variable should always be in
@@ -1078,7 +1325,8 @@ void VSCodeProtocol::CommandLoop()
                 EmitCapabilitiesEvent();
             else if (g_cancelCommandQueueSet.find(queueEntry.command) != g_cancelCommandQueueSet.end())
             {
-                std::lock_guard<std::mutex> guardCommandsMutex(m_commandsMutex);
+                std::vector<json> responses;
+                std::unique_lock<std::mutex> lockCommandsMutex(m_commandsMutex);
                 m_sharedDebugger->CancelEvalRunning();
 
                 for (auto iter = m_commandsQueue.begin(); iter != m_commandsQueue.end();)
@@ -1086,13 +1334,35 @@ void VSCodeProtocol::CommandLoop()
                     if (g_debuggerSetupCommandSet.find(iter->command) != g_debuggerSetupCommandSet.end())
                         ++iter;
                     else
-                        iter = CancelCommand(iter);
+                    {
+                        CancelCommand(*iter, responses);
+                        iter = m_commandsQueue.erase(iter);
+                    }
+                }
+
+                // Note, only read-only commands could wait for start in tasks list.
+                for (auto iter = m_tasks.begin(); iter != m_tasks.end();)
+                {
+                    if ((*iter)->started || (*iter)->responded)
+                        ++iter;
+                    else
+                    {
+                        (*iter)->responded = true;
+                        (*iter)->finished = true;
+                        CancelCommand((*iter)->entry, responses);
+                        iter = m_tasks.erase(iter);
+                    }
                 }
+                m_commandsCV.notify_one(); // notify_one with lock
+                lockCommandsMutex.unlock();
+
+                EmitResponses(responses);
             }
             // Note, in case "cancel" this is command implementation itself.
             else if (queueEntry.command == "cancel")
             {
                 auto requestId = queueEntry.arguments.at("requestId");
+                std::vector<json> responses;
                 std::unique_lock<std::mutex> lockCommandsMutex(m_commandsMutex);
                 queueEntry.response["success"] = false;
                 for (auto iter = m_commandsQueue.begin(); iter != m_commandsQueue.end(); ++iter)
@@ -1103,13 +1373,32 @@ void VSCodeProtocol::CommandLoop()
                     if (g_debuggerSetupCommandSet.find(iter->command) != g_debuggerSetupCommandSet.end())
                         break;
 
-                    CancelCommand(iter);
+                    CancelCommand(*iter, responses);
+                    m_commandsQueue.erase(iter);
+
+                    queueEntry.response["success"] = true;
+                    break;
+                }
+                for (auto iter = m_tasks.begin(); iter != m_tasks.end(); ++iter)
+                {
+                    if (requestId != (*iter)->entry.response["request_seq"])
+                        continue;
+
+                    if ((*iter)->started || (*iter)->responded)
+                        break;
+
+                    (*iter)->responded = true;
+                    (*iter)->finished = true;
+                    CancelCommand((*iter)->entry, responses);
+                    m_tasks.erase(iter);
+                    m_commandsCV.notify_one(); // notify_one with lock
 
                     queueEntry.response["success"] = true;
                     break;
                 }
                 lockCommandsMutex.unlock();
 
+                EmitResponses(responses);
                 if (!queueEntry.response["success"])
                     queueEntry.response["message"] = "CancelRequest is not supported for requestId.";
 
@@ -1162,7 +1451,7 @@ void VSCodeProtocol::EngineLogging(const std::string &path)
 }
 
 // Caller must care about m_outMutex.
-void VSCodeProtocol::Log(const std::string &prefix, const std::string &text)
+void VSCodeProtocol::Log(const std::string &prefix, string_view text)
 {
     switch(m_engineLogOutput)
     {
@@ -1179,7 +1468,7 @@ void VSCodeProtocol::Log(const std::string &prefix, const std::string &text)
             response["event"] = "output";
             response["body"] = json{
                 {"category", "console"},
-                {"output", prefix + text + "\n"}
+                {"output", prefix + std::string(text) + "\n"}
             };
             std::string output;
             EmitMessage(response, output);
@@ -7,6 +7,9 @@
 #include <mutex>
 #include <string>
 #include <list>
+#include <vector>
+#include <memory>
+#include <chrono>
 #include <condition_variable>
 
 #pragma warning (disable:4068)  // Visual Studio should ignore GCC pragmas
@@ -30,15 +33,16 @@ class VSCodeProtocol : public IProtocol
     } m_engineLogOutput;
     std::ofstream m_engineLog;
     uint64_t m_seqCounter; // Note, this counter must be covered by m_outMutex.
+    std::string m_outputBuffer; // Note, reusable messages output buffer must be covered by m_outMutex.
 
     std::string m_fileExec;
     std::vector<std::string> m_execArgs;
 
-    void EmitMessage(nlohmann::json &message, std::string &output);
-    void EmitMessageWithLog(const std::string &message_prefix, nlohmann::json &message);
+    void EmitMessage(nlohmann::json &message, std::string &output, string_view rawBody = {});
+    void EmitMessageWithLog(const std::string &message_prefix, nlohmann::json &message, string_view rawBody = {});
     void EmitEvent(const std::string &name, const nlohmann::json &body);
 
-    void Log(const std::string &prefix, const std::string &text);
+    void Log(const std::string &prefix, string_view text);
 
     struct CommandQueueEntry
     {
@@ -47,18 +51,41 @@ class VSCodeProtocol : public IProtocol
         nlohmann::json response;
     };
 
+    // Command executed by commands workers pool.
+    struct CommandTask
+    {
+        CommandQueueEntry entry;
+        std::chrono::milliseconds timeout;
+        std::chrono::steady_clock::time_point deadline; // set at task execution start
+        bool isConcurrent;
+        bool started;
+        bool responded;
+        bool timedOut;
+        bool finished;
+
+        CommandTask() : timeout(0), isConcurrent(false), started(false), responded(false), timedOut(false), finished(false) {}
+    };
+
     std::mutex m_commandsMutex;
-    std::condition_variable m_commandsCV;
+    std::condition_variable m_commandsCV; // commands queue or tasks changes
     std::condition_variable m_commandSyncCV;
     std::list<CommandQueueEntry> m_commandsQueue;
+    // Note, tasks list and tasks state are protected by m_commandsMutex.
+    std::condition_variable m_tasksCV;
+    std::list<std::shared_ptr<CommandTask>> m_tasks; // not finished tasks
+    bool m_tasksExit;
 
     void CommandsWorker();
-    std::list<CommandQueueEntry>::iterator CancelCommand(const std::list<CommandQueueEntry>::iterator &iter);
+    void TasksWorker();
+    void WaitCommandsOrTasks(std::unique_lock<std::mutex> &lock);
+    bool HaveNotFinishedTasks(bool isConcurrent);
+    void CancelCommand(CommandQueueEntry &entry, std::vector<nlohmann::json> &responses);
+    void EmitResponses(std::vector<nlohmann::json> &responses);
 
 public:
 
     VSCodeProtocol(std::istream& input, std::ostream& output) :
-        IProtocol(input, output), m_engineLogOutput(LogNone), m_seqCounter(1) {}
+        IProtocol(input, output), m_engineLogOutput(LogNone), m_seqCounter(1), m_tasksExit(false) {}
     void EngineLogging(const std::string &path);
     void SetLaunchCommand(const std::string &fileExec, const std::vector<std::string> &args) override
     {
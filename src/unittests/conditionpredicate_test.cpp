@@ -0,0 +1,108 @@
+// Copyright (C) 2022 Samsung Electronics Co., Ltd.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <limits>
+#include "debugger/conditionpredicate.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    bool Evaluate(const std::string &condition, const ConditionValue &value)
+    {
+        ConditionPredicate predicate;
+        REQUIRE(ParseConditionPredicate(condition, predicate));
+        bool result = false;
+        REQUIRE(EvaluateConditionPredicate(predicate, value, result));
+        return result;
+    }
+}
+
+TEST_CASE("ConditionPredicate::Parse")
+{
+    ConditionPredicate predicate;
+
+    CHECK(ParseConditionPredicate("i == 1000", predicate));
+    CHECK(predicate.identifiers == std::vector<std::string>{"i"});
+    CHECK(predicate.operation == ConditionPredicate::Operation::Equal);
+    CHECK(predicate.literal.kind == ConditionValue::Kind::Signed);
+    CHECK(predicate.literal.signedValue == 1000);
+
+    CHECK(ParseConditionPredicate("  this.obj.count>=-0x10L ", predicate));
+    CHECK(predicate.identifiers == std::vector<std::string>{"this", "obj", "count"});
+    CHECK(predicate.operation == ConditionPredicate::Operation::GreaterOrEqual);
+    CHECK(predicate.literal.signedValue == -16);
+
+    // Literal first, operation must be swapped.
+    CHECK(ParseConditionPredicate("1.5f < value", predicate));
+    CHECK(predicate.identifiers == std::vector<std::string>{"value"});
+    CHECK(predicate.operation == ConditionPredicate::Operation::Greater);
+    CHECK(predicate.literal.kind == ConditionValue::Kind::Real);
+    CHECK(predicate.literal.realValue == 1.5);
+    CHECK(predicate.literal.isSingle);
+
+    CHECK(ParseConditionPredicate("flag != true", predicate));
+    CHECK(predicate.literal.kind == ConditionValue::Kind::Boolean);
+    CHECK(ParseConditionPredicate("c == 'a'", predicate));
+    CHECK(predicate.literal.signedValue == 'a');
+    CHECK(ParseConditionPredicate("u == 18446744073709551615", predicate));
+    CHECK(predicate.literal.kind == ConditionValue::Kind::Unsigned);
+    CHECK(ParseConditionPredicate("i == 1_000_000u", predicate));
+    CHECK(predicate.literal.signedValue == 1000000);
+
+    // Not simple predicates, must be evaluated by stack machine.
+    CHECK_FALSE(ParseConditionPredicate("i", predicate));
+    CHECK_FALSE(ParseConditionPredicate("i == j", predicate));
+    CHECK_FALSE(ParseConditionPredicate("i == 1 && j == 2", predicate));
+    CHECK_FALSE(ParseConditionPredicate("i + 1 == 2", predicate));
+    CHECK_FALSE(ParseConditionPredicate("GetCount() == 2", predicate));
+    CHECK_FALSE(ParseConditionPredicate("array[0] == 2", predicate));
+    CHECK_FALSE(ParseConditionPredicate("i << 2", predicate));
+    CHECK_FALSE(ParseConditionPredicate("obj != null", predicate));
+    CHECK_FALSE(ParseConditionPredicate("str == \"text\"", predicate));
+    CHECK_FALSE(ParseConditionPredicate("d == 1.5m", predicate));
+    CHECK_FALSE(ParseConditionPredicate("c == '\\n'", predicate));
+    CHECK_FALSE(ParseConditionPredicate("$exception == 1", predicate));
+    CHECK_FALSE(ParseConditionPredicate("true == false", predicate));
+    CHECK_FALSE(ParseConditionPredicate("i == 99999999999999999999", predicate));
+}
+
+TEST_CASE("ConditionPredicate::Evaluate")
+{
+    CHECK(Evaluate("i == 1000", ConditionValue::Signed(1000)));
+    CHECK_FALSE(Evaluate("i == 1000", ConditionValue::Signed(999)));
+    CHECK(Evaluate("i != 1000", ConditionValue::Signed(999)));
+    CHECK(Evaluate("i < 0", ConditionValue::Signed(-1)));
+    CHECK(Evaluate("10 > i", ConditionValue::Signed(9)));
+    CHECK_FALSE(Evaluate("10 <= i", ConditionValue::Signed(9)));
+
+    // Integral value with floating point literal.
+    CHECK(Evaluate("i > 1.5", ConditionValue::Signed(2)));
+    CHECK(Evaluate("d == 1", ConditionValue::Real(1.0)));
+    // Single value converted to double in case of double literal, same as C# do.
+    CHECK_FALSE(Evaluate("f == 0.1", ConditionValue::Single(0.1f)));
+    CHECK(Evaluate("f == 0.1f", ConditionValue::Single(0.1f)));
+    // Single value compared with integral literal as Single.
+    CHECK(Evaluate("f == 16777217", ConditionValue::Single(16777216.0f)));
+    CHECK_FALSE(Evaluate("d == 16777217", ConditionValue::Real(16777216.0)));
+    // Integral value compared with Single literal as Single.
+    CHECK(Evaluate("i == 16777216f", ConditionValue::Signed(16777217)));
+    CHECK(Evaluate("d != 0", ConditionValue::Real(std::numeric_limits<double>::quiet_NaN())));
+    CHECK_FALSE(Evaluate("d == 0", ConditionValue::Real(std::numeric_limits<double>::quiet_NaN())));
+
+    CHECK(Evaluate("u > 1", ConditionValue::Unsigned(std::numeric_limits<uint64_t>::max())));
+    CHECK(Evaluate("u == 18446744073709551615", ConditionValue::Unsigned(std::numeric_limits<uint64_t>::max())));
+    CHECK(Evaluate("flag == true", ConditionValue::Boolean(true)));
+    CHECK(Evaluate("flag != true", ConditionValue::Boolean(false)));
+
+    // C# compilation errors, caller must use stack machine for proper error message.
+    ConditionPredicate predicate;
+    bool result;
+    REQUIRE(ParseConditionPredicate("flag < true", predicate));
+    CHECK_FALSE(EvaluateConditionPredicate(predicate, ConditionValue::Boolean(true), result));
+    REQUIRE(ParseConditionPredicate("i == true", predicate));
+    CHECK_FALSE(EvaluateConditionPredicate(predicate, ConditionValue::Signed(1), result));
+    REQUIRE(ParseConditionPredicate("u == -1", predicate));
+    CHECK_FALSE(EvaluateConditionPredicate(predicate, ConditionValue::Unsigned(1), result));
+}
@@ -0,0 +1,257 @@
+// Copyright (C) 2022 Samsung Electronics Co., Ltd.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <limits>
+#include "debugger/evalcalculation.h"
+
+using namespace netcoredbg;
+
+// Note, expected results below are results of managed CalculationDelegate() (C# `dynamic` in unchecked context)
+// for the same operands, native calculation must be identical or refuse calculation (managed part used in this case).
+
+namespace
+{
+    template <class T>
+    CalculationValue Value(BasicTypes type, T value)
+    {
+        CalculationValue result;
+        result.type = type;
+        static_assert(sizeof(T) <= sizeof(uint64_t), "wrong type");
+        *static_cast<T*>(result.GetRawData()) = value;
+        return result;
+    }
+
+    CalculationValue Int(int32_t value) { return Value(BasicTypes::TypeInt32, value); }
+    CalculationValue UInt(uint32_t value) { return Value(BasicTypes::TypeUInt32, value); }
+    CalculationValue Long(int64_t value) { return Value(BasicTypes::TypeInt64, value); }
+    CalculationValue ULong(uint64_t value) { return Value(BasicTypes::TypeUInt64, value); }
+    CalculationValue Short(int16_t value) { return Value(BasicTypes::TypeInt16, value); }
+    CalculationValue Byte(uint8_t value) { return Value(BasicTypes::TypeByte, value); }
+    CalculationValue SByte(int8_t value) { return Value(BasicTypes::TypeSByte, value); }
+    CalculationValue Char(uint16_t value) { return Value(BasicTypes::TypeChar, value); }
+    CalculationValue Float(float value) { return Value(BasicTypes::TypeSingle, value); }
+    CalculationValue Double(double value) { return Value(BasicTypes::TypeDouble, value); }
+    CalculationValue Bool(bool value) { return Value(BasicTypes::TypeBoolean, value); }
+
+    CalculationValue String(const std::string &value)
+    {
+        CalculationValue result;
+        result.type = BasicTypes::TypeString;
+        result.stringValue = value;
+        return result;
+    }
+
+    CalculationValue Calc(OperationType opType, const CalculationValue &first, const CalculationValue &second = CalculationValue())
+    {
+        CalculationValue result;
+        REQUIRE(CalculateNatively(opType, first, second, result));
+        return result;
+    }
+
+    bool Refused(OperationType opType, const CalculationValue &first, const CalculationValue &second = CalculationValue())
+    {
+        CalculationValue result;
+        return !CalculateNatively(opType, first, second, result);
+    }
+}
+
+TEST_CASE("EvalCalculation::NumericPromotion")
+{
+    // byte + byte = int
+    CalculationValue result = Calc(OperationType::AddExpression, Byte(200), Byte(100));
+    CHECK(result.type == BasicTypes::TypeInt32);
+    CHECK(result.int32Value == 300);
+
+    // char - char = int
+    result = Calc(OperationType::SubtractExpression, Char('a'), Char('c'));
+    CHECK(result.type == BasicTypes::TypeInt32);
+    CHECK(result.int32Value == -2);
+
+    // uint + int = long
+    result = Calc(OperationType::AddExpression, UInt(4000000000u), Int(-1));
+    CHECK(result.type == BasicTypes::TypeInt64);
+    CHECK(result.int64Value == 3999999999ll);
+
+    // uint + ushort = uint
+    result = Calc(OperationType::AddExpression, UInt(1), Value(BasicTypes::TypeUInt16, (uint16_t)2));
+    CHECK(result.type == BasicTypes::TypeUInt32);
+    CHECK(result.uint32Value == 3);
+
+    // long * sbyte = long
+    result = Calc(OperationType::MultiplyExpression, Long(1ll << 40), SByte(-2));
+    CHECK(result.type == BasicTypes::TypeInt64);
+    CHECK(result.int64Value == -(1ll << 41));
+
+    // ulong + byte = ulong
+    result = Calc(OperationType::AddExpression, ULong(1), Byte(1));
+    CHECK(result.type == BasicTypes::TypeUInt64);
+    CHECK(result.uint64Value == 2);
+
+    // ulong + int is CS0034 (ambiguous)
+    CHECK(Refused(OperationType::AddExpression, ULong(1), Int(1)));
+    CHECK(Refused(OperationType::AddExpression, Short(1), ULong(1)));
+
+    // int + float = float
+    result = Calc(OperationType::AddExpression, Int(16777217), Float(0.0f));
+    CHECK(result.type == BasicTypes::TypeSingle);
+    CHECK(result.singleValue == 16777216.0f);
+
+    // long + float converted directly to float (no double rounding)
+    result = Calc(OperationType::AddExpression, Long(0x7fffffbfffffffffll), Float(0.0f));
+    CHECK(result.type == BasicTypes::TypeSingle);
+    CHECK(result.singleValue == static_cast<float>(0x7fffffbfffffffffll));
+
+    // float / double = double
+    result = Calc(OperationType::DivideExpression, Float(1.0f), Double(4.0));
+    CHECK(result.type == BasicTypes::TypeDouble);
+    CHECK(result.doubleValue == 0.25);
+}
+
+TEST_CASE("EvalCalculation::Unchecked")
+{
+    const int32_t intMax = std::numeric_limits<int32_t>::max();
+    const int32_t intMin = std::numeric_limits<int32_t>::min();
+    const int64_t longMax = std::numeric_limits<int64_t>::max();
+
+    CHECK(Calc(OperationType::AddExpression, Int(intMax), Int(1)).int32Value == intMin);
+    CHECK(Calc(OperationType::SubtractExpression, Int(intMin), Int(1)).int32Value == intMax);
+    CHECK(Calc(OperationType::MultiplyExpression, Int(0x10000), Int(0x10000)).int32Value == 0);
+    CHECK(Calc(OperationType::AddExpression, Long(longMax), Long(1)).int64Value == std::numeric_limits<int64_t>::min());
+    CHECK(Calc(OperationType::SubtractExpression, UInt(0), UInt(1)).uint32Value == 0xffffffffu);
+    CHECK(Calc(OperationType::UnaryMinusExpression, Int(intMin)).int32Value == intMin);
+
+    // Integer division truncates toward zero, remainder has sign of dividend.
+    CHECK(Calc(OperationType::DivideExpression, Int(-7), Int(2)).int32Value == -3);
+    CHECK(Calc(OperationType::ModuloExpression, Int(-7), Int(2)).int32Value == -1);
+    CHECK(Calc(OperationType::ModuloExpression, Long(7), Long(-2)).int64Value == 1);
+
+    // DivideByZeroException and OverflowException, error messages provided by managed part.
+    CHECK(Refused(OperationType::DivideExpression, Int(1), Int(0)));
+    CHECK(Refused(OperationType::ModuloExpression, ULong(1), ULong(0)));
+    CHECK(Refused(OperationType::DivideExpression, Int(intMin), Int(-1)));
+    CHECK(Refused(OperationType::ModuloExpression, Long(std::numeric_limits<int64_t>::min()), Long(-1)));
+}
+
+TEST_CASE("EvalCalculation::FloatingPoint")
+{
+    CalculationValue result = Calc(OperationType::DivideExpression, Double(1.0), Int(0));
+    CHECK(result.type == BasicTypes::TypeDouble);
+    CHECK(std::isinf(result.doubleValue));
+
+    result = Calc(OperationType::ModuloExpression, Double(-5.5), Double(2.0));
+    CHECK(result.doubleValue == -1.5);
+
+    result = Calc(OperationType::ModuloExpression, Float(5.5f), Float(-2.0f));
+    CHECK(result.type == BasicTypes::TypeSingle);
+    CHECK(result.singleValue == 1.5f);
+
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    CHECK(Calc(OperationType::EqualsExpression, Double(nan), Double(nan)).boolValue == false);
+    CHECK(Calc(OperationType::NotEqualsExpression, Double(nan), Double(nan)).boolValue == true);
+    CHECK(Calc(OperationType::LessThanExpression, Double(nan), Double(1.0)).boolValue == false);
+    CHECK(Calc(OperationType::GreaterThanOrEqualExpression, Double(nan), Double(1.0)).boolValue == false);
+
+    // Bitwise operators are not defined for floating point.
+    CHECK(Refused(OperationType::BitwiseAndExpression, Double(1.0), Int(1)));
+    CHECK(Refused(OperationType::LeftShiftExpression, Float(1.0f), Int(1)));
+    CHECK(Refused(OperationType::BitwiseNotExpression, Double(1.0)));
+}
+
+TEST_CASE("EvalCalculation::Shifts")
+{
+    CalculationValue result = Calc(OperationType::LeftShiftExpression, Byte(1), Int(33));
+    CHECK(result.type == BasicTypes::TypeInt32);
+    CHECK(result.int32Value == 2);
+
+    CHECK(Calc(OperationType::LeftShiftExpression, Int(1), Int(31)).int32Value == std::numeric_limits<int32_t>::min());
+    CHECK(Calc(OperationType::RightShiftExpression, Int(-16), Int(2)).int32Value == -4);
+    CHECK(Calc(OperationType::RightShiftExpression, UInt(0x80000000u), Int(31)).uint32Value == 1);
+    CHECK(Calc(OperationType::LeftShiftExpression, Long(1), Int(65)).int64Value == 2);
+    CHECK(Calc(OperationType::RightShiftExpression, Long(-1), Char(63)).int64Value == -1);
+    CHECK(Calc(OperationType::RightShiftExpression, ULong(0x8000000000000000ull), Short(63)).uint64Value == 1);
+    CHECK(Calc(OperationType::LeftShiftExpression, Int(1), Int(-1)).int32Value == std::numeric_limits<int32_t>::min());
+
+    // Shift count must be implicitly convertible to int.
+    CHECK(Refused(OperationType::LeftShiftExpression, Int(1), Long(1)));
+    CHECK(Refused(OperationType::LeftShiftExpression, Int(1), UInt(1)));
+}
+
+TEST_CASE("EvalCalculation::BitwiseAndBoolean")
+{
+    CalculationValue result = Calc(OperationType::BitwiseAndExpression, Short(-1), Byte(0x0f));
+    CHECK(result.type == BasicTypes::TypeInt32);
+    CHECK(result.int32Value == 0x0f);
+
+    CHECK(Calc(OperationType::BitwiseOrExpression, ULong(1), UInt(2)).uint64Value == 3);
+    CHECK(Calc(OperationType::ExclusiveOrExpression, Int(5), Int(3)).int32Value == 6);
+
+    result = Calc(OperationType::BitwiseNotExpression, Byte(0));
+    CHECK(result.type == BasicTypes::TypeInt32);
+    CHECK(result.int32Value == -1);
+    CHECK(Calc(OperationType::BitwiseNotExpression, UInt(0)).uint32Value == 0xffffffffu);
+
+    CHECK(Calc(OperationType::LogicalAndExpression, Bool(true), Bool(false)).boolValue == false);
+    CHECK(Calc(OperationType::LogicalOrExpression, Bool(true), Bool(false)).boolValue == true);
+    CHECK(Calc(OperationType::ExclusiveOrExpression, Bool(true), Bool(true)).boolValue == false);
+    CHECK(Calc(OperationType::BitwiseAndExpression, Bool(true), Bool(true)).boolValue == true);
+    CHECK(Calc(OperationType::LogicalNotExpression, Bool(false)).boolValue == true);
+    CHECK(Calc(OperationType::EqualsExpression, Bool(false), Bool(false)).boolValue == true);
+
+    CHECK(Refused(OperationType::LogicalAndExpression, Int(1), Int(1)));
+    CHECK(Refused(OperationType::AddExpression, Bool(true), Int(1)));
+    CHECK(Refused(OperationType::LessThanExpression, Bool(true), Bool(false)));
+    CHECK(Refused(OperationType::LogicalNotExpression, Int(1)));
+    CHECK(Refused(OperationType::UnaryMinusExpression, Bool(true)));
+}
+
+TEST_CASE("EvalCalculation::Unary")
+{
+    CalculationValue result = Calc(OperationType::UnaryPlusExpression, Char('A'));
+    CHECK(result.type == BasicTypes::TypeInt32);
+    CHECK(result.int32Value == 65);
+
+    result = Calc(OperationType::UnaryMinusExpression, UInt(1));
+    CHECK(result.type == BasicTypes::TypeInt64);
+    CHECK(result.int64Value == -1);
+
+    result = Calc(OperationType::UnaryMinusExpression, Float(2.5f));
+    CHECK(result.type == BasicTypes::TypeSingle);
+    CHECK(result.singleValue == -2.5f);
+
+    // ulong negation is CS0023.
+    CHECK(Refused(OperationType::UnaryMinusExpression, ULong(1)));
+}
+
+TEST_CASE("EvalCalculation::Comparison")
+{
+    CHECK(Calc(OperationType::LessThanExpression, Int(-1), UInt(1)).boolValue == true); // long comparison
+    CHECK(Calc(OperationType::GreaterThanExpression, Char('b'), Int('a')).boolValue == true);
+    CHECK(Calc(OperationType::LessThanOrEqualExpression, ULong(5), ULong(5)).boolValue == true);
+    CHECK(Calc(OperationType::EqualsExpression, Int(1), Double(1.0)).boolValue == true);
+    CHECK(Calc(OperationType::NotEqualsExpression, Long(1), Float(1.5f)).boolValue == true);
+}
+
+TEST_CASE("EvalCalculation::String")
+{
+    CalculationValue result = Calc(OperationType::AddExpression, String("abc"), String("def"));
+    CHECK(result.type == BasicTypes::TypeString);
+    CHECK(result.stringValue == "abcdef");
+
+    CHECK(Calc(OperationType::AddExpression, String("i="), Int(-42)).stringValue == "i=-42");
+    CHECK(Calc(OperationType::AddExpression, ULong(18446744073709551615ull), String("")).stringValue == "18446744073709551615");
+    CHECK(Calc(OperationType::AddExpression, String("b="), Bool(true)).stringValue == "b=True");
+    CHECK(Calc(OperationType::AddExpression, Char(0x44f), String("!")).stringValue == "\xd1\x8f!");
+    CHECK(Calc(OperationType::AddExpression, String(""), Char(0x20ac)).stringValue == "\xe2\x82\xac");
+
+    CHECK(Calc(OperationType::EqualsExpression, String("abc"), String("abc")).boolValue == true);
+    CHECK(Calc(OperationType::NotEqualsExpression, String("abc"), String("abC")).boolValue == true);
+
+    // Floating point formatting and lone surrogates are handled by managed part.
+    CHECK(Refused(OperationType::AddExpression, String("d="), Double(0.1)));
+    CHECK(Refused(OperationType::AddExpression, String(""), Char(0xd800)));
+    CHECK(Refused(OperationType::SubtractExpression, String("a"), String("b")));
+    CHECK(Refused(OperationType::EqualsExpression, String("1"), Int(1)));
+    CHECK(Refused(OperationType::LessThanExpression, String("a"), String("b")));
+}
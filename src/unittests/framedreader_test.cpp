@@ -0,0 +1,60 @@
+// Copyright (C) 2022 Samsung Electronics Co., Ltd.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <string>
+#include "protocols/framedreader.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    std::string Frame(const std::string &content)
+    {
+        return "Content-Length: " + std::to_string(content.size()) + "\r\n\r\n" + content;
+    }
+}
+
+TEST_CASE("FramedReader::Messages")
+{
+    std::string bigContent(100000, 'x');
+    std::istringstream input(Frame("{\"seq\":1}") + Frame(bigContent) + "Content-Length: 3\n\nabc" + Frame("{}"));
+    FramedReader reader(input);
+
+    string_view content;
+    REQUIRE(reader.ReadMessage(content));
+    CHECK(content == "{\"seq\":1}");
+    REQUIRE(reader.ReadMessage(content));
+    CHECK(content == bigContent);
+    REQUIRE(reader.ReadMessage(content));
+    CHECK(content == "abc");
+    REQUIRE(reader.ReadMessage(content));
+    CHECK(content == "{}");
+    CHECK(!reader.ReadMessage(content));
+}
+
+TEST_CASE("FramedReader::Errors")
+{
+    string_view content;
+    {
+        std::istringstream input("Other-Header: 1\r\n\r\n{}");
+        FramedReader reader(input);
+        CHECK(!reader.ReadMessage(content));
+    }
+    {
+        std::istringstream input("Content-Length: abc\r\n\r\n{}");
+        FramedReader reader(input);
+        CHECK(!reader.ReadMessage(content));
+    }
+    {
+        std::istringstream input("Content-Length: 10\r\n\r\n{}");
+        FramedReader reader(input);
+        CHECK(!reader.ReadMessage(content));
+    }
+    {
+        std::istringstream input("Content-Length: 2\r\n");
+        FramedReader reader(input);
+        CHECK(!reader.ReadMessage(content));
+    }
+}
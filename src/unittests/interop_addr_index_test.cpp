@@ -0,0 +1,113 @@
+// Copyright (C) 2022 Samsung Electronics Co., Ltd.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <vector>
+#include "metadata/interop_addr_index.h"
+
+using namespace netcoredbg::InteropDebugging;
+
+TEST_CASE("InteropAddrIndex::Find")
+{
+    AddrRangeIndex index;
+    CHECK(index.Find(0x1000) == AddrRangeIndex::NotFound);
+
+    // Note, ranges added not sorted, as DIEs could be.
+    index.Add(0x3000, 0x4000, 3);
+    index.Add(0x1000, 0x2000, 1);
+    index.Add(0x1100, 0x1200, 11, 1); // nested
+    index.Add(0x1180, 0x11a0, 111, 2); // nested into nested
+    index.Add(0x1100, 0x1200, 12, 2); // same bounds, deeper
+    index.Add(0x2000, 0x2800, 2);     // adjacent
+    index.Add(0x5000, 0x5000, 5);     // empty, ignored
+    index.Build();
+
+    CHECK(index.Find(0x0fff) == AddrRangeIndex::NotFound);
+    CHECK(index.Find(0x1000) == 1);
+    CHECK(index.Find(0x10ff) == 1);
+    CHECK(index.Find(0x1100) == 12);
+    CHECK(index.Find(0x1180) == 111);
+    CHECK(index.Find(0x119f) == 111);
+    CHECK(index.Find(0x11a0) == 12);
+    CHECK(index.Find(0x1200) == 1);
+    CHECK(index.Find(0x1fff) == 1);
+    CHECK(index.Find(0x2000) == 2);
+    CHECK(index.Find(0x2800) == AddrRangeIndex::NotFound);
+    CHECK(index.Find(0x3000) == 3);
+    CHECK(index.Find(0x4000) == AddrRangeIndex::NotFound);
+    CHECK(index.Find(0x5000) == AddrRangeIndex::NotFound);
+    CHECK(index.Find(UINTPTR_MAX) == AddrRangeIndex::NotFound);
+}
+
+TEST_CASE("InteropAddrIndex::BrokenNesting")
+{
+    AddrRangeIndex index;
+    index.Add(0x1000, 0x2000, 1);
+    index.Add(0x1800, 0x2800, 2, 1); // cross outer range end
+    index.Build();
+
+    CHECK(index.Find(0x17ff) == 1);
+    CHECK(index.Find(0x1800) == 2);
+    CHECK(index.Find(0x2000) == AddrRangeIndex::NotFound);
+}
+
+TEST_CASE("InteropAddrIndex::Benchmark", "[.][benchmark]")
+{
+    // Emulate big library debug info: procedures with inlined code inside.
+    const uint32_t procCount = 200000;
+    const std::uintptr_t procSize = 0x100;
+    struct range_t
+    {
+        std::uintptr_t startAddr;
+        std::uintptr_t endAddr;
+        uint32_t value;
+    };
+    std::vector<range_t> ranges;
+    AddrRangeIndex index;
+    for (uint32_t i = 0; i < procCount; i++)
+    {
+        std::uintptr_t startAddr = 0x10000 + i * procSize;
+        ranges.push_back({startAddr, startAddr + procSize, i * 2});
+        ranges.push_back({startAddr + 0x40, startAddr + 0x80, i * 2 + 1});
+        index.Add(startAddr, startAddr + procSize, i * 2, 0);
+        index.Add(startAddr + 0x40, startAddr + 0x80, i * 2 + 1, 1);
+    }
+    auto start = std::chrono::steady_clock::now();
+    index.Build();
+    auto elapsedBuild = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    // 50 frames stack.
+    std::vector<std::uintptr_t> addrs;
+    for (uint32_t i = 0; i < 50; i++)
+    {
+        addrs.push_back(0x10000 + ((i * 7919) % procCount) * procSize + 0x50);
+    }
+
+    uint64_t sum = 0;
+    start = std::chrono::steady_clock::now();
+    for (auto addr : addrs)
+    {
+        sum += index.Find(addr);
+    }
+    auto elapsedIndex = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    // Same as linear search for most specific range, that was used before.
+    uint64_t sumLinear = 0;
+    start = std::chrono::steady_clock::now();
+    for (auto addr : addrs)
+    {
+        uint32_t value = AddrRangeIndex::NotFound;
+        for (const auto &range : ranges)
+        {
+            if (range.startAddr <= addr && addr < range.endAddr)
+                value = range.value;
+        }
+        sumLinear += value;
+    }
+    auto elapsedLinear = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    CHECK(sum == sumLinear);
+    WARN(ranges.size() << " ranges, index build " << elapsedBuild << " us, 50 frames lookup: index "
+         << elapsedIndex / 1000.0 << " us, linear " << elapsedLinear / 1000.0 << " us");
+}
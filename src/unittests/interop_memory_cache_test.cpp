@@ -0,0 +1,67 @@
+// Copyright (C) 2022 Samsung Electronics Co., Ltd.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <cstring>
+#include <vector>
+#include "debugger/interop_memory_cache.h"
+
+using namespace netcoredbg::InteropDebugging;
+
+TEST_CASE("InteropMemoryCache::Read")
+{
+    // Note, own process memory used as tracee's memory here.
+    std::vector<uint64_t> data(ProcessMemoryCache::PageSize * 3 / sizeof(uint64_t));
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        data[i] = i * 0x9E3779B97F4A7C15ULL;
+    }
+
+    ProcessMemoryCache cache;
+    pid_t pid = getpid();
+
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        uint64_t value = 0;
+        REQUIRE(cache.Read(pid, (std::uintptr_t)&data[i], &value, sizeof(value)));
+        REQUIRE(value == data[i]);
+    }
+
+    // Read, that cross page boundary.
+    std::uintptr_t pageEnd = ((std::uintptr_t)data.data() + ProcessMemoryCache::PageSize) & ~((std::uintptr_t)ProcessMemoryCache::PageSize - 1);
+    uint8_t buffer[64];
+    REQUIRE(cache.Read(pid, pageEnd - 20, buffer, sizeof(buffer)));
+    CHECK(memcmp(buffer, (void*)(pageEnd - 20), sizeof(buffer)) == 0);
+
+    // Snapshot stay the same until cache cleared.
+    uint64_t oldValue = data[1];
+    data[1] = 42;
+    uint64_t value = 0;
+    REQUIRE(cache.Read(pid, (std::uintptr_t)&data[1], &value, sizeof(value)));
+    CHECK(value == oldValue);
+    cache.Clear();
+    REQUIRE(cache.Read(pid, (std::uintptr_t)&data[1], &value, sizeof(value)));
+    CHECK(value == 42);
+}
+
+TEST_CASE("InteropMemoryCache::Unreadable")
+{
+    ProcessMemoryCache cache;
+    pid_t pid = getpid();
+
+    void *page = mmap(nullptr, ProcessMemoryCache::PageSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    REQUIRE(page != MAP_FAILED);
+
+    uint64_t value = 0;
+    CHECK(!cache.Read(pid, (std::uintptr_t)page, &value, sizeof(value)));
+    CHECK(!cache.Read(pid, 0, &value, sizeof(value)));
+
+    // Error for one page don't affect other pages.
+    uint64_t data = 12345;
+    REQUIRE(cache.Read(pid, (std::uintptr_t)&data, &value, sizeof(value)));
+    CHECK(value == data);
+
+    munmap(page, ProcessMemoryCache::PageSize);
+}
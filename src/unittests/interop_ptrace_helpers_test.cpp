@@ -0,0 +1,150 @@
+// Copyright (C) 2022 Samsung Electronics Co., Ltd.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <sys/wait.h>
+#include <signal.h>
+#include <unistd.h>
+#include <chrono>
+#include <vector>
+#include "debugger/interop_ptrace_helpers.h"
+
+using namespace netcoredbg;
+using namespace netcoredbg::InteropDebugging;
+
+namespace
+{
+    // Note, forked tracee have same memory layout, so, parent could use own addresses for tracee's memory access.
+    const size_t DataSize = 4096;
+    word_t g_data[DataSize];
+
+    struct Tracee
+    {
+        pid_t pid = 0;
+
+        Tracee()
+        {
+            for (size_t i = 0; i < DataSize; i++)
+            {
+                g_data[i] = (word_t)(i * 2654435761u);
+            }
+
+            pid = fork();
+            REQUIRE(pid != -1);
+            if (pid == 0)
+            {
+                while (true)
+                    pause();
+            }
+
+            async_ptrace_init();
+            REQUIRE(async_ptrace(PTRACE_SEIZE, pid, nullptr, nullptr) != -1);
+            REQUIRE(async_ptrace(PTRACE_INTERRUPT, pid, nullptr, nullptr) != -1);
+            int status = 0;
+            REQUIRE(waitpid(pid, &status, __WALL) == pid);
+            REQUIRE(WIFSTOPPED(status));
+        }
+
+        ~Tracee()
+        {
+            kill(pid, SIGKILL);
+            int status = 0;
+            waitpid(pid, &status, __WALL);
+            async_ptrace_shutdown();
+        }
+    };
+}
+
+TEST_CASE("InteropPtraceHelpers::Batch")
+{
+    Tracee tracee;
+
+    std::vector<ptrace_call_t> calls;
+    for (size_t i = 0; i < DataSize; i++)
+    {
+        calls.emplace_back(PTRACE_PEEKDATA, tracee.pid, (void*)&g_data[i], nullptr);
+    }
+    // Note, failed call must not affect other calls in batch.
+    calls.emplace_back(PTRACE_PEEKDATA, tracee.pid, nullptr, nullptr);
+    calls.emplace_back(PTRACE_PEEKDATA, tracee.pid, (void*)&g_data[0], nullptr);
+
+    async_ptrace_batch(calls);
+
+    for (size_t i = 0; i < DataSize; i++)
+    {
+        REQUIRE(calls[i].error_n == 0);
+        REQUIRE((word_t)calls[i].result == g_data[i]);
+    }
+    CHECK(calls[DataSize].error_n != 0);
+    CHECK(calls[DataSize + 1].error_n == 0);
+    CHECK((word_t)calls[DataSize + 1].result == g_data[0]);
+
+    errno = 0;
+    CHECK((word_t)async_ptrace(PTRACE_PEEKDATA, tracee.pid, (void*)&g_data[1], nullptr) == g_data[1]);
+    CHECK(errno == 0);
+    CHECK(async_ptrace(PTRACE_PEEKDATA, tracee.pid, nullptr, nullptr) == -1);
+    CHECK(errno != 0);
+}
+
+TEST_CASE("InteropPtraceHelpers::Exec")
+{
+    Tracee tracee;
+
+    // Read-modify-write in one handoff.
+    int error_n = 0;
+    REQUIRE(async_ptrace_exec([&]()
+    {
+        errno = 0;
+        word_t data = ptrace(PTRACE_PEEKDATA, tracee.pid, (void*)&g_data[5], nullptr);
+        if (errno != 0 || ptrace(PTRACE_POKEDATA, tracee.pid, (void*)&g_data[5], (void*)(uintptr_t)(data + 1)) == -1)
+            error_n = errno;
+    }));
+    REQUIRE(error_n == 0);
+
+    errno = 0;
+    CHECK((word_t)async_ptrace(PTRACE_PEEKDATA, tracee.pid, (void*)&g_data[5], nullptr) == g_data[5] + 1);
+    CHECK(errno == 0);
+}
+
+TEST_CASE("InteropPtraceHelpers::NotInitialized")
+{
+    std::vector<ptrace_call_t> calls;
+    calls.emplace_back(PTRACE_PEEKDATA, 1, nullptr, nullptr);
+    async_ptrace_batch(calls);
+    CHECK(calls[0].result == -1);
+    CHECK(calls[0].error_n == EPERM);
+    CHECK(!async_ptrace_exec([](){}));
+}
+
+TEST_CASE("InteropPtraceHelpers::Benchmark", "[.][benchmark]")
+{
+    Tracee tracee;
+    const int iterations = 20;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+        for (size_t j = 0; j < DataSize; j++)
+        {
+            REQUIRE((word_t)async_ptrace(PTRACE_PEEKDATA, tracee.pid, (void*)&g_data[j], nullptr) == g_data[j]);
+        }
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+        std::vector<ptrace_call_t> calls;
+        calls.reserve(DataSize);
+        for (size_t j = 0; j < DataSize; j++)
+        {
+            calls.emplace_back(PTRACE_PEEKDATA, tracee.pid, (void*)&g_data[j], nullptr);
+        }
+        async_ptrace_batch(calls);
+        REQUIRE((word_t)calls.back().result == g_data[DataSize - 1]);
+    }
+    auto elapsedBatch = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    WARN(DataSize << " PTRACE_PEEKDATA calls: async_ptrace() " << (double)elapsed / iterations << " us, async_ptrace_batch() "
+         << (double)elapsedBatch / iterations << " us");
+}
@@ -0,0 +1,178 @@
+// Copyright (C) 2022 Samsung Electronics Co., Ltd.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <chrono>
+#include <set>
+#include <string>
+#include <vector>
+#include "metadata/interop_sources_index.h"
+
+using namespace netcoredbg::InteropDebugging;
+
+namespace
+{
+    struct test_line_t
+    {
+        std::string fullPath;
+        unsigned line;
+        unsigned column;
+        std::uintptr_t addr;
+    };
+
+    // Same search as linear scan of all line table rows, that was used before.
+    bool LinearFind(const std::vector<test_line_t> &rows, const std::string &fileName, unsigned lineNum,
+                    unsigned &resolvedLineNum, std::string &resolvedFullPath, std::uintptr_t &addr)
+    {
+        const test_line_t *result = nullptr;
+        for (const auto &row : rows)
+        {
+            if (fileName.size() > row.fullPath.size() ||
+                !std::equal(fileName.rbegin(), fileName.rend(), row.fullPath.rbegin()) ||
+                row.line < lineNum)
+                continue;
+
+            if (!result || row.line < result->line || (row.line == result->line && row.column < result->column))
+                result = &row;
+        }
+        if (!result)
+            return false;
+
+        resolvedLineNum = result->line;
+        resolvedFullPath = result->fullPath;
+        addr = result->addr;
+        return true;
+    }
+
+    void AddRows(SourceLinesIndex &index, const std::vector<test_line_t> &rows)
+    {
+        for (const auto &row : rows)
+        {
+            index.AddLine(index.AddFile(row.fullPath), row.line, row.column, row.addr);
+        }
+        index.Build();
+    }
+}
+
+TEST_CASE("InteropSourcesIndex::Find")
+{
+    std::vector<test_line_t> rows{
+        {"/src/app/main.cpp", 10, 5, 0x1010},
+        {"/src/app/main.cpp", 10, 1, 0x1000}, // same line, less column
+        {"/src/app/main.cpp", 12, 1, 0x1020},
+        {"/src/app/main.cpp", 10, 1, 0x1100}, // same line and column, first added should be used
+        {"/src/lib/util.h", 3, 1, 0x2000},
+        {"/src/app/util.h", 5, 1, 0x3000},
+        {"/src/app/util.h", 2, 7, 0x3010},
+    };
+    SourceLinesIndex index;
+    AddRows(index, rows);
+
+    unsigned resolvedLineNum = 0;
+    std::string resolvedFullPath;
+    std::uintptr_t addr = 0;
+
+    REQUIRE(index.Find("main.cpp", 1, resolvedLineNum, resolvedFullPath, addr));
+    CHECK(resolvedLineNum == 10);
+    CHECK(resolvedFullPath == "/src/app/main.cpp");
+    CHECK(addr == 0x1000);
+
+    REQUIRE(index.Find("/src/app/main.cpp", 11, resolvedLineNum, resolvedFullPath, addr));
+    CHECK(resolvedLineNum == 12);
+    CHECK(addr == 0x1020);
+
+    CHECK(!index.Find("main.cpp", 13, resolvedLineNum, resolvedFullPath, addr));
+    CHECK(!index.Find("ain.cpp", 1, resolvedLineNum, resolvedFullPath, addr));
+    CHECK(!index.Find("other/main.cpp", 1, resolvedLineNum, resolvedFullPath, addr));
+
+    // Closest line from all files with same name.
+    REQUIRE(index.Find("util.h", 1, resolvedLineNum, resolvedFullPath, addr));
+    CHECK(resolvedLineNum == 2);
+    CHECK(resolvedFullPath == "/src/app/util.h");
+    REQUIRE(index.Find("util.h", 3, resolvedLineNum, resolvedFullPath, addr));
+    CHECK(resolvedFullPath == "/src/lib/util.h");
+    CHECK(addr == 0x2000);
+    REQUIRE(index.Find("lib/util.h", 1, resolvedLineNum, resolvedFullPath, addr));
+    CHECK(resolvedLineNum == 3);
+}
+
+TEST_CASE("InteropSourcesIndex::FindFileNames")
+{
+    SourceLinesIndex index;
+    AddRows(index, {{"/src/app/main.cpp", 1, 1, 0x1000}, {"/src/app/main.h", 1, 1, 0x2000}, {"/src/lib/mainlib.cpp", 1, 1, 0x3000}});
+
+    std::set<std::string> result;
+    CHECK(index.FindFileNames("main", [&](const std::string &str) { result.insert(str); return true; }));
+    CHECK(result == std::set<std::string>({"main.cpp", "main.h", "mainlib.cpp",
+                                           "/src/app/main.cpp", "/src/app/main.h", "/src/lib/mainlib.cpp"}));
+
+    result.clear();
+    CHECK(index.FindFileNames("pp/", [&](const std::string &str) { result.insert(str); return true; }));
+    CHECK(result.empty());
+
+    result.clear();
+    CHECK(index.FindFileNames("src/app/", [&](const std::string &str) { result.insert(str); return true; }));
+    CHECK(result == std::set<std::string>({"/src/app/main.cpp", "/src/app/main.h"}));
+
+    // Stop search by callback.
+    size_t count = 0;
+    CHECK(!index.FindFileNames("main", [&](const std::string &) { return ++count < 2; }));
+    CHECK(count == 2);
+}
+
+TEST_CASE("InteropSourcesIndex::Benchmark", "[.][benchmark]")
+{
+    // Emulate big library debug info: 2000 source files (10 with same name), 500 lines each, 4 rows per line.
+    const unsigned filesNum = 2000;
+    const unsigned linesNum = 500;
+    std::vector<test_line_t> rows;
+    std::uintptr_t addr = 0x1000;
+    for (unsigned i = 0; i < filesNum; i++)
+    {
+        std::string fullPath = "/build/project/module" + std::to_string(i % 200) + "/file" + std::to_string(i / 10) + ".cpp";
+        for (unsigned line = 1; line <= linesNum; line++)
+        {
+            for (unsigned column = 1; column <= 4; column++)
+            {
+                rows.push_back({fullPath, line, column, addr});
+                addr += 4;
+            }
+        }
+    }
+
+    SourceLinesIndex index;
+    auto start = std::chrono::steady_clock::now();
+    AddRows(index, rows);
+    auto elapsedBuild = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    // 30 breakpoints.
+    const unsigned breakpointsNum = 30;
+    std::uintptr_t sum = 0;
+    start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < breakpointsNum; i++)
+    {
+        unsigned resolvedLineNum;
+        std::string resolvedFullPath;
+        std::uintptr_t resolvedAddr = 0;
+        index.Find("file" + std::to_string(i * 7) + ".cpp", i * 13 + 1, resolvedLineNum, resolvedFullPath, resolvedAddr);
+        sum += resolvedAddr;
+    }
+    auto elapsedIndex = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    std::uintptr_t sumLinear = 0;
+    start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < breakpointsNum; i++)
+    {
+        unsigned resolvedLineNum;
+        std::string resolvedFullPath;
+        std::uintptr_t resolvedAddr = 0;
+        LinearFind(rows, "file" + std::to_string(i * 7) + ".cpp", i * 13 + 1, resolvedLineNum, resolvedFullPath, resolvedAddr);
+        sumLinear += resolvedAddr;
+    }
+    auto elapsedLinear = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    CHECK(sum == sumLinear);
+    WARN(rows.size() << " rows, index build " << elapsedBuild << " us, " << breakpointsNum << " breakpoints: index "
+         << elapsedIndex << " us, linear " << elapsedLinear << " us");
+}
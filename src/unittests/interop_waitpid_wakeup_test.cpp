@@ -0,0 +1,156 @@
+// Copyright (C) 2022 Samsung Electronics Co., Ltd.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <sys/mman.h>
+#include <sys/ptrace.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "debugger/interop_waitpid_wakeup.h"
+
+using namespace netcoredbg::InteropDebugging;
+
+namespace
+{
+    int64_t NowUs()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void SetupSigchldHandler()
+    {
+        struct sigaction sa;
+        memset(&sa, 0, sizeof(sa));
+        sigemptyset(&sa.sa_mask);
+        sa.sa_handler = WaitpidWakeupSignalHandler;
+        sa.sa_flags = SA_RESTART;
+        REQUIRE(sigaction(SIGCHLD, &sa, NULL) == 0);
+    }
+
+    void ResetSigchldHandler()
+    {
+        signal(SIGCHLD, SIG_DFL);
+    }
+
+    // Small test program for tracee: stop itself `count` times, store time of stop in shared memory.
+    void TraceeMain(volatile int64_t *stopTime, int count)
+    {
+        if (ptrace(PTRACE_TRACEME, 0, nullptr, nullptr) == -1)
+            _exit(1);
+
+        for (int i = 0; i < count; i++)
+        {
+            usleep(1000 + (i * 7919) % 3000); // don't sync stops with debugger's polling
+            *stopTime = NowUs();
+            raise(SIGSTOP);
+        }
+        _exit(0);
+    }
+}
+
+TEST_CASE("InteropWaitpidWakeup::Request")
+{
+    REQUIRE(InitWaitpidWakeup());
+    WaitForWaitpidWakeup(0); // drain
+
+    CHECK(!WaitForWaitpidWakeup(0));
+    WakeupWaitpidLoop();
+    WakeupWaitpidLoop();
+    CHECK(WaitForWaitpidWakeup(1000));
+    // All requests handled by one wakeup.
+    CHECK(!WaitForWaitpidWakeup(0));
+
+    std::thread wakeupThread([]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        WakeupWaitpidLoop();
+    });
+    CHECK(WaitForWaitpidWakeup(-1));
+    wakeupThread.join();
+}
+
+TEST_CASE("InteropWaitpidWakeup::Sigchld")
+{
+    REQUIRE(InitWaitpidWakeup());
+    SetupSigchldHandler();
+    WaitForWaitpidWakeup(0); // drain
+
+    pid_t pid = fork();
+    REQUIRE(pid != -1);
+    if (pid == 0)
+        _exit(0);
+
+    CHECK(WaitForWaitpidWakeup(5000));
+    int status = 0;
+    CHECK(waitpid(pid, &status, 0) == pid);
+    CHECK(WIFEXITED(status));
+
+    ResetSigchldHandler();
+}
+
+TEST_CASE("InteropWaitpidWakeup::Benchmark", "[.][benchmark]")
+{
+    REQUIRE(InitWaitpidWakeup());
+
+    const int stops = 200;
+    volatile int64_t *stopTime = static_cast<volatile int64_t*>(mmap(nullptr, sizeof(int64_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+    REQUIRE(stopTime != MAP_FAILED);
+
+    for (bool eventDriven : {false, true})
+    {
+        // Note, SIGCHLD handler interrupt `usleep()`, so, polling measured with SIG_DFL (interop debugger's default).
+        if (eventDriven)
+            SetupSigchldHandler();
+        WaitForWaitpidWakeup(0); // drain
+
+        pid_t tracee = fork();
+        REQUIRE(tracee != -1);
+        if (tracee == 0)
+            TraceeMain(stopTime, stops);
+
+        int64_t latencySum = 0;
+        int64_t latencyMax = 0;
+        int stopped = 0;
+        while (true)
+        {
+            int status = 0;
+            pid_t pid = waitpid(-1, &status, __WALL | WNOHANG);
+            REQUIRE(pid != -1);
+
+            if (pid == 0)
+            {
+                // Same as waitpid loop in interop debugger do.
+                if (eventDriven)
+                    WaitForWaitpidWakeup(-1);
+                else
+                    usleep(10*1000);
+                continue;
+            }
+
+            if (!WIFSTOPPED(status))
+                break;
+
+            if (WSTOPSIG(status) == SIGSTOP && stopped < stops)
+            {
+                int64_t latency = NowUs() - *stopTime;
+                latencySum += latency;
+                latencyMax = std::max(latencyMax, latency);
+                stopped++;
+            }
+
+            REQUIRE(ptrace(PTRACE_CONT, pid, nullptr, nullptr) != -1);
+        }
+
+        REQUIRE(stopped == stops);
+        WARN((eventDriven ? "SIGCHLD wakeup" : "10 ms polling") << ": " << stopped << " tracee stops, average latency "
+             << latencySum / stopped << " us, max latency " << latencyMax << " us");
+    }
+
+    munmap((void*)stopTime, sizeof(int64_t));
+    ResetSigchldHandler();
+}
@@ -0,0 +1,180 @@
+// Copyright (C) 2022 Samsung Electronics Co., Ltd.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "protocols/jsonwriter.h"
+#include "json/json.hpp"
+
+using namespace netcoredbg;
+using json = nlohmann::json;
+
+namespace
+{
+    std::string WriteString(string_view value)
+    {
+        std::string output;
+        JsonWriter writer(output);
+        writer.String(value);
+        return output;
+    }
+
+    // Same members as Variable have in `variables` response.
+    struct TestVariable
+    {
+        std::string name;
+        std::string value;
+        std::string type;
+        std::string evaluateName;
+        uint32_t variablesReference;
+        int namedVariables;
+    };
+
+    std::vector<TestVariable> MakeVariables(size_t count)
+    {
+        std::vector<TestVariable> variables;
+        for (size_t i = 0; i < count; i++)
+        {
+            std::string name = "field" + std::to_string(i);
+            bool isObject = i % 4 == 0;
+            variables.push_back({name, isObject ? "{TestNamespace.TestClass}" : "\"string value " + std::to_string(i) + "\"",
+                                 isObject ? "TestNamespace.TestClass" : "string", "this." + name,
+                                 isObject ? uint32_t(i + 1) : 0, isObject ? 5 : 0});
+        }
+        return variables;
+    }
+
+    void WriteVariables(JsonWriter &writer, const std::vector<TestVariable> &variables)
+    {
+        writer.BeginObject();
+        writer.Key("variables");
+        writer.BeginArray();
+        for (const auto &v : variables)
+        {
+            writer.BeginObject();
+            writer.Key("evaluateName"); writer.String(v.evaluateName);
+            writer.Key("name"); writer.String(v.name);
+            if (v.variablesReference > 0)
+            {
+                writer.Key("namedVariables"); writer.Int(v.namedVariables);
+            }
+            writer.Key("type"); writer.String(v.type);
+            writer.Key("value"); writer.String(v.value);
+            writer.Key("variablesReference"); writer.UInt(v.variablesReference);
+            writer.EndObject();
+        }
+        writer.EndArray();
+        writer.EndObject();
+    }
+
+    json VariablesToJson(const std::vector<TestVariable> &variables)
+    {
+        json array = json::array();
+        for (const auto &v : variables)
+        {
+            json j{{"name",               v.name},
+                   {"value",              v.value},
+                   {"type",               v.type},
+                   {"evaluateName",       v.evaluateName},
+                   {"variablesReference", v.variablesReference}};
+            if (v.variablesReference > 0)
+                j["namedVariables"] = v.namedVariables;
+            array.push_back(j);
+        }
+        json body;
+        body["variables"] = array;
+        return body;
+    }
+}
+
+TEST_CASE("JsonWriter::Values")
+{
+    std::string output;
+    JsonWriter writer(output);
+    writer.BeginObject();
+    writer.Key("array");
+    writer.BeginArray();
+    writer.Int(0);
+    writer.Int(-1);
+    writer.Int(INT64_MIN);
+    writer.UInt(UINT64_MAX);
+    writer.Bool(true);
+    writer.BeginObject();
+    writer.EndObject();
+    writer.BeginArray();
+    writer.EndArray();
+    writer.EndArray();
+    writer.Key("empty"); writer.String("");
+    writer.Key("object");
+    writer.BeginObject();
+    writer.Key("a"); writer.Bool(false);
+    writer.Key("b"); writer.Int(12345);
+    writer.EndObject();
+    writer.EndObject();
+
+    CHECK(output == "{\"array\":[0,-1,-9223372036854775808,18446744073709551615,true,{},[]],\"empty\":\"\",\"object\":{\"a\":false,\"b\":12345}}");
+    CHECK(json::parse(output).dump() == output);
+}
+
+TEST_CASE("JsonWriter::Escaping")
+{
+    // Same as nlohmann::json dump() for valid UTF-8.
+    std::string str = "quote\" backslash\\ slash/ \b\f\n\r\t \x01\x1f\x7f éè привет \xf0\x9f\x98\x80";
+    CHECK(WriteString(str) == json(str).dump());
+    CHECK(json::parse(WriteString(str)).get<std::string>() == str);
+
+    for (int ch = 0; ch < 0x80; ch++)
+    {
+        std::string single(1, static_cast<char>(ch));
+        CHECK(WriteString(single) == json(single).dump());
+    }
+
+    // Encoded lone surrogates.
+    CHECK(WriteString("a\xed\xa0\x80" "b\xed\xbf\xbf") == "\"a\\ud800b\\udfff\"");
+    // Invalid UTF-8.
+    CHECK(WriteString("a\x80" "b") == "\"a\xef\xbf\xbd" "b\"");
+    CHECK(WriteString("\xc0\xaf") == "\"\xef\xbf\xbd\xef\xbf\xbd\"");
+    CHECK(WriteString("\xe4\xbd") == "\"\xef\xbf\xbd\xef\xbf\xbd\"");
+    CHECK(WriteString("\xf4\x90\x80\x80") == "\"\xef\xbf\xbd\xef\xbf\xbd\xef\xbf\xbd\xef\xbf\xbd\"");
+}
+
+TEST_CASE("JsonWriter::Variables")
+{
+    std::vector<TestVariable> variables = MakeVariables(10);
+    std::string output;
+    JsonWriter writer(output);
+    WriteVariables(writer, variables);
+    CHECK(output == VariablesToJson(variables).dump());
+}
+
+TEST_CASE("JsonWriter::Benchmark", "[.][benchmark]")
+{
+    const int iterations = 100;
+    std::vector<TestVariable> variables = MakeVariables(10000);
+
+    std::string output;
+    size_t size = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+        output.clear();
+        JsonWriter writer(output);
+        WriteVariables(writer, variables);
+        size += output.size();
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    size_t sizeJson = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+        sizeJson += VariablesToJson(variables).dump().size();
+    }
+    auto elapsedJson = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    CHECK(size == sizeJson);
+    WARN("10k variables response, " << output.size() << " bytes: JsonWriter " << (double)elapsed / iterations
+         << " us, nlohmann::json " << (double)elapsedJson / iterations << " us");
+}
@@ -0,0 +1,162 @@
+// Copyright (C) 2022 Samsung Electronics Co., Ltd.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "metadata/modules_sources_cache_file.h"
+
+using namespace netcoredbg::SourcesCacheFile;
+
+namespace
+{
+    // Same layout as method_data_t, but without CoreCLR headers dependency.
+    struct test_method_t
+    {
+        uint32_t methodDef;
+        int32_t startLine;
+        int32_t endLine;
+        int32_t startColumn;
+        int32_t endColumn;
+
+        bool operator == (const test_method_t &other) const
+        {
+            return methodDef == other.methodDef && startLine == other.startLine && endLine == other.endLine &&
+                   startColumn == other.startColumn && endColumn == other.endColumn;
+        }
+    };
+
+    struct test_method_hash
+    {
+        size_t operator()(const test_method_t &p) const
+        {
+            return p.methodDef + (uint32_t)p.startLine * 100 + (uint32_t)p.endLine * 1000;
+        }
+    };
+
+    typedef View<test_method_t, uint32_t, test_method_hash> test_view_t;
+    typedef Writer<test_method_t, uint32_t, test_method_hash> test_writer_t;
+
+    const std::string cacheFilePath = "modules_sources_cache_test.srcs";
+
+    std::vector<char> ReadAll(const std::string &path)
+    {
+        std::ifstream stream(path, std::ios::in | std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+
+    void WriteAll(const std::string &path, const std::vector<char> &data)
+    {
+        std::ofstream stream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        stream.write(data.data(), data.size());
+    }
+
+    void SaveTestData()
+    {
+        std::vector<std::vector<test_method_t>> methodsData{
+            {{0x06000001, 1, 10, 5, 6}, {0x06000002, 12, 20, 5, 6}},
+            {{0x06000003, 14, 15, 9, 10}}
+        };
+        test_writer_t::multi_methods_data_t multiMethodsData{
+            {{0x06000004, 30, 30, 1, 40}, {0x06000004, 0x06000005}}
+        };
+
+        test_writer_t writer;
+        writer.AddFile("/src/Program.cs", methodsData, multiMethodsData);
+        writer.AddFile("/src/Empty.cs", {}, {});
+        REQUIRE(writer.Save(cacheFilePath));
+    }
+}
+
+TEST_CASE("ModulesSourcesCache::RoundTrip")
+{
+    SaveTestData();
+
+    test_view_t view;
+    REQUIRE(view.Load(cacheFilePath) == ReadResult::Ok);
+    REQUIRE(view.FilesNum() == 2);
+
+    CHECK(view.FilePath(0) == "/src/Program.cs");
+    REQUIRE(view.LevelsNum(0) == 2);
+    uint32_t methodsNum = 0;
+    const test_method_t *methods = view.LevelMethods(0, 0, methodsNum);
+    REQUIRE(methodsNum == 2);
+    CHECK(methods[0] == test_method_t{0x06000001, 1, 10, 5, 6});
+    CHECK(methods[1] == test_method_t{0x06000002, 12, 20, 5, 6});
+    methods = view.LevelMethods(0, 1, methodsNum);
+    REQUIRE(methodsNum == 1);
+    CHECK(methods[0] == test_method_t{0x06000003, 14, 15, 9, 10});
+
+    test_view_t::multi_methods_data_t multiMethodsData;
+    view.CopyMultiMethodsData(0, multiMethodsData);
+    REQUIRE(multiMethodsData.size() == 1);
+    CHECK(multiMethodsData.begin()->first == test_method_t{0x06000004, 30, 30, 1, 40});
+    CHECK(multiMethodsData.begin()->second == std::vector<uint32_t>({0x06000004, 0x06000005}));
+
+    CHECK(view.FilePath(1) == "/src/Empty.cs");
+    CHECK(view.LevelsNum(1) == 0);
+    multiMethodsData.clear();
+    view.CopyMultiMethodsData(1, multiMethodsData);
+    CHECK(multiMethodsData.empty());
+
+    std::remove(cacheFilePath.c_str());
+}
+
+TEST_CASE("ModulesSourcesCache::BrokenFile")
+{
+    test_view_t view;
+    std::remove(cacheFilePath.c_str());
+    CHECK(view.Load(cacheFilePath) == ReadResult::NotFound);
+
+    SaveTestData();
+    const std::vector<char> data = ReadAll(cacheFilePath);
+    REQUIRE(data.size() > sizeof(header_t));
+
+    // Truncated file.
+    for (size_t size : {size_t(1), sizeof(header_t) - 1, sizeof(header_t), data.size() - 1})
+    {
+        WriteAll(cacheFilePath, std::vector<char>(data.begin(), data.begin() + size));
+        CHECK(view.Load(cacheFilePath) == ReadResult::Failed);
+    }
+
+    // Extra data at the end.
+    std::vector<char> broken(data);
+    broken.push_back(0);
+    WriteAll(cacheFilePath, broken);
+    CHECK(view.Load(cacheFilePath) == ReadResult::Failed);
+
+    // Wrong magic.
+    broken = data;
+    broken[0] = 'X';
+    WriteAll(cacheFilePath, broken);
+    CHECK(view.Load(cacheFilePath) == ReadResult::Failed);
+
+    // Corrupted first file's levels number, out of levels array.
+    broken = data;
+    file_t file;
+    memcpy(&file, broken.data() + sizeof(header_t), sizeof(file));
+    file.levelsNum = 100;
+    memcpy(broken.data() + sizeof(header_t), &file, sizeof(file));
+    WriteAll(cacheFilePath, broken);
+    CHECK(view.Load(cacheFilePath) == ReadResult::Failed);
+
+    // Corrupted first level's methods number, out of methods array.
+    broken = data;
+    level_t level;
+    const size_t levelOffset = sizeof(header_t) + 2 * sizeof(file_t);
+    memcpy(&level, broken.data() + levelOffset, sizeof(level));
+    level.methodsNum = 0xffffffff;
+    memcpy(broken.data() + levelOffset, &level, sizeof(level));
+    WriteAll(cacheFilePath, broken);
+    CHECK(view.Load(cacheFilePath) == ReadResult::Failed);
+
+    // Not changed data is still valid.
+    WriteAll(cacheFilePath, data);
+    CHECK(view.Load(cacheFilePath) == ReadResult::Ok);
+
+    std::remove(cacheFilePath.c_str());
+}
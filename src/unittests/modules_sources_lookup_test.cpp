@@ -0,0 +1,144 @@
+// Copyright (C) 2022 Samsung Electronics Co., Ltd.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <random>
+#include "metadata/modules_sources_lookup.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    // Same layout and ordering as method_data_t, but without CoreCLR headers dependency.
+    struct test_method_t
+    {
+        uint32_t methodDef;
+        int32_t startLine;
+        int32_t endLine;
+
+        bool operator < (const int32_t lineNum) const { return endLine < lineNum; }
+    };
+
+    typedef std::vector<std::vector<test_method_t>> test_methods_t;
+
+    // Synthetic source file: `methodsNum` methods (5 lines each, one empty line between), every 4th method have 1 lambda inside.
+    test_methods_t GenerateMethods(uint32_t methodsNum)
+    {
+        test_methods_t result(2);
+        int32_t line = 1;
+        for (uint32_t i = 0; i < methodsNum; i++)
+        {
+            result[0].push_back({i + 1, line, line + 4});
+            if (i % 4 == 0)
+                result[1].push_back({methodsNum + i + 1, line + 2, line + 2});
+            line += 6;
+        }
+        return result;
+    }
+}
+
+TEST_CASE("ModulesSourcesLookup::Basic")
+{
+    test_methods_t methods = GenerateMethods(8);
+    uint32_t closestNestedToken;
+
+    // Line inside method, before lambda.
+    int32_t line = 2;
+    const test_method_t *result = FindMethodByLineNumber(methods, line, closestNestedToken);
+    REQUIRE(result != nullptr);
+    CHECK(result->methodDef == 1);
+    CHECK(line == 2);
+    CHECK(closestNestedToken == 9);
+
+    // Line with lambda.
+    line = 3;
+    result = FindMethodByLineNumber(methods, line, closestNestedToken);
+    REQUIRE(result != nullptr);
+    CHECK(result->methodDef == 1);
+    CHECK(closestNestedToken == 9);
+
+    // Empty line between methods moved to first line of method below.
+    line = 6;
+    result = FindMethodByLineNumber(methods, line, closestNestedToken);
+    REQUIRE(result != nullptr);
+    CHECK(result->methodDef == 2);
+    CHECK(line == 7);
+
+    // Method without lambda.
+    line = 9;
+    result = FindMethodByLineNumber(methods, line, closestNestedToken);
+    REQUIRE(result != nullptr);
+    CHECK(result->methodDef == 2);
+    CHECK(closestNestedToken == 0);
+
+    // Line behind last method.
+    line = 1000;
+    result = FindMethodByLineNumber(methods, line, closestNestedToken);
+    CHECK(result == nullptr);
+}
+
+TEST_CASE("ModulesSourcesLookup::Nested")
+{
+    test_methods_t methods(3);
+    methods[0].push_back({1, 1, 20});
+    methods[1].push_back({2, 3, 6});
+    methods[1].push_back({3, 10, 15});
+    methods[2].push_back({4, 12, 12});
+    uint32_t closestNestedToken;
+
+    int32_t line = 12;
+    const test_method_t *result = FindMethodByLineNumber(methods, line, closestNestedToken);
+    REQUIRE(result != nullptr);
+    CHECK(result->methodDef == 3);
+    CHECK(closestNestedToken == 4);
+
+    line = 11;
+    result = FindMethodByLineNumber(methods, line, closestNestedToken);
+    REQUIRE(result != nullptr);
+    CHECK(result->methodDef == 3);
+    CHECK(closestNestedToken == 4);
+
+    // Line without code inside method and before nested method.
+    line = 8;
+    result = FindMethodByLineNumber(methods, line, closestNestedToken);
+    REQUIRE(result != nullptr);
+    CHECK(result->methodDef == 1);
+    CHECK(closestNestedToken == 3);
+
+    line = 18;
+    result = FindMethodByLineNumber(methods, line, closestNestedToken);
+    REQUIRE(result != nullptr);
+    CHECK(result->methodDef == 1);
+    CHECK(closestNestedToken == 0);
+}
+
+// Microbenchmark, hidden by default, run with `modules_sources_lookup [benchmark]`.
+TEST_CASE("ModulesSourcesLookup::Benchmark", "[.][benchmark]")
+{
+    const uint32_t methodsNum = 10000;
+    const int lookupsNum = 1000000;
+    test_methods_t methods = GenerateMethods(methodsNum);
+    const int32_t linesNum = methods[0].back().endLine;
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int32_t> distribution(1, linesNum);
+    std::vector<int32_t> lines(lookupsNum);
+    for (auto &line : lines)
+    {
+        line = distribution(generator);
+    }
+
+    uint64_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (auto line : lines)
+    {
+        uint32_t closestNestedToken;
+        if (FindMethodByLineNumber(methods, line, closestNestedToken))
+            found++;
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    CHECK(found == (uint64_t)lookupsNum);
+    WARN(methodsNum << " methods, " << lookupsNum << " lookups: " << (double)elapsed / lookupsNum << " ns per lookup");
+}
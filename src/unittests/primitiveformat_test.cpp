@@ -0,0 +1,148 @@
+// Copyright (C) 2022 Samsung Electronics Co., Ltd.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "debugger/primitiveformat.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    template <typename T>
+    std::vector<std::string> Format(PrimitiveKind kind, const std::vector<T> &data, bool hex = false)
+    {
+        std::vector<std::string> values;
+        FormatPrimitives(kind, data.data(), data.size(), hex, values);
+        return values;
+    }
+
+    // Same formatting as PrintValue() use.
+    template <typename T>
+    std::string StreamFormat(T value, int precision = 0)
+    {
+        std::ostringstream ss;
+        if (precision != 0)
+            ss << std::setprecision(precision);
+        ss << value;
+        return ss.str();
+    }
+}
+
+TEST_CASE("PrimitiveFormat::Integers")
+{
+    std::vector<int32_t> ints{0, 1, -1, 9, 10, 99, 100, -100, 12345, std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max()};
+    std::vector<std::string> values = Format(PrimitiveKind::Int32, ints);
+    REQUIRE(values.size() == ints.size());
+    for (size_t i = 0; i < ints.size(); i++)
+        CHECK(values[i] == StreamFormat(ints[i]));
+
+    std::vector<int64_t> longs{std::numeric_limits<int64_t>::min(), -1234567890123LL, std::numeric_limits<int64_t>::max()};
+    values = Format(PrimitiveKind::Int64, longs);
+    for (size_t i = 0; i < longs.size(); i++)
+        CHECK(values[i] == StreamFormat(longs[i]));
+
+    std::vector<uint64_t> ulongs{0, std::numeric_limits<uint64_t>::max()};
+    values = Format(PrimitiveKind::UInt64, ulongs);
+    for (size_t i = 0; i < ulongs.size(); i++)
+        CHECK(values[i] == StreamFormat(ulongs[i]));
+
+    std::vector<uint8_t> bytes{0, 7, 200, 255};
+    CHECK(Format(PrimitiveKind::Byte, bytes) == std::vector<std::string>({"0", "7", "200", "255"}));
+    std::vector<int8_t> sbytes{-128, -1, 127};
+    CHECK(Format(PrimitiveKind::SByte, sbytes) == std::vector<std::string>({"-128", "-1", "127"}));
+    std::vector<int16_t> shorts{-32768, 32767};
+    CHECK(Format(PrimitiveKind::Int16, shorts) == std::vector<std::string>({"-32768", "32767"}));
+    std::vector<uint8_t> bools{0, 1, 2};
+    CHECK(Format(PrimitiveKind::Boolean, bools) == std::vector<std::string>({"false", "true", "true"}));
+}
+
+TEST_CASE("PrimitiveFormat::Hex")
+{
+    std::vector<int32_t> ints{42, -1};
+    CHECK(Format(PrimitiveKind::Int32, ints, true) == std::vector<std::string>({"0x0000002a", "0xffffffff"}));
+    std::vector<int8_t> sbytes{-1, 16};
+    CHECK(Format(PrimitiveKind::SByte, sbytes, true) == std::vector<std::string>({"0xff", "0x10"}));
+    std::vector<uint64_t> ulongs{0x123456789abcdef0ULL};
+    CHECK(Format(PrimitiveKind::UInt64, ulongs, true) == std::vector<std::string>({"0x123456789abcdef0"}));
+    // Hex format is not applied to floating point values.
+    std::vector<double> doubles{1.5};
+    CHECK(Format(PrimitiveKind::Double, doubles, true) == std::vector<std::string>({"1.5"}));
+}
+
+TEST_CASE("PrimitiveFormat::Floats")
+{
+    std::vector<double> doubles{0.0, -0.0, 1.0, 0.1, 1.0 / 3, 123456789012345678.0, 1e-300, -2.5e300,
+                                std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+    std::vector<std::string> values = Format(PrimitiveKind::Double, doubles);
+    for (size_t i = 0; i < doubles.size(); i++)
+        CHECK(values[i] == StreamFormat(doubles[i], 16));
+
+    std::vector<float> floats{0.0f, 0.1f, 1.0f / 3, 3.4e38f, -1.17549435e-38f};
+    values = Format(PrimitiveKind::Single, floats);
+    for (size_t i = 0; i < floats.size(); i++)
+        CHECK(values[i] == StreamFormat(floats[i], 8));
+}
+
+TEST_CASE("PrimitiveFormat::HexDump")
+{
+    std::string data = "Hello World\n\x01\x02\x03\x04" "ABC";
+    std::string output;
+    FormatHexDump(reinterpret_cast<const uint8_t*>(data.data()), data.size(), output);
+    CHECK(output ==
+        "00000000  48 65 6c 6c 6f 20 57 6f  72 6c 64 0a 01 02 03 04  |Hello World.....|\n"
+        "00000010  41 42 43                                          |ABC|");
+
+    output.clear();
+    FormatHexDump(nullptr, 0, output);
+    CHECK(output.empty());
+}
+
+TEST_CASE("PrimitiveFormat::Benchmark", "[.][benchmark]")
+{
+    const int iterations = 20;
+    std::vector<int32_t> ints(100000);
+    std::vector<double> doubles(ints.size());
+    for (size_t i = 0; i < ints.size(); i++)
+    {
+        ints[i] = static_cast<int32_t>(i * 7919 - 50000);
+        doubles[i] = ints[i] / 7.0;
+    }
+
+    for (bool isDouble : {false, true})
+    {
+        size_t size = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            std::vector<std::string> values;
+            if (isDouble)
+                FormatPrimitives(PrimitiveKind::Double, doubles.data(), doubles.size(), false, values);
+            else
+                FormatPrimitives(PrimitiveKind::Int32, ints.data(), ints.size(), false, values);
+            size += values.size();
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        size_t sizeStream = 0;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+        {
+            std::vector<std::string> values;
+            for (size_t j = 0; j < ints.size(); j++)
+                values.push_back(isDouble ? StreamFormat(doubles[j], 16) : StreamFormat(ints[j]));
+            sizeStream += values.size();
+        }
+        auto elapsedStream = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        CHECK(size == sizeStream);
+        WARN((isDouble ? "double" : "int") << " array, " << ints.size() << " elements: FormatPrimitives "
+             << (double)elapsed / iterations << " us, std::ostringstream " << (double)elapsedStream / iterations << " us");
+    }
+}
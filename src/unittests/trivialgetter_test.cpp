@@ -0,0 +1,68 @@
+// Copyright (C) 2022 Samsung Electronics Co., Ltd.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <vector>
+#include "metadata/trivialgetter.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    bool Match(const std::vector<uint8_t> &code, uint32_t &fieldToken, bool &isStatic)
+    {
+        return MatchTrivialGetterIL(code.data(), code.size(), fieldToken, isStatic);
+    }
+}
+
+TEST_CASE("TrivialGetter::Match")
+{
+    uint32_t fieldToken = 0;
+    bool isStatic = true;
+
+    // Auto-property or `=> field` getter: ldarg.0 ldfld ret
+    REQUIRE(Match({0x02, 0x7B, 0x01, 0x00, 0x00, 0x04, 0x2A}, fieldToken, isStatic));
+    CHECK(fieldToken == 0x04000001);
+    CHECK(!isStatic);
+
+    // Debug build `{ return field; }`: nop ldarg.0 ldfld stloc.0 br.s 0 ldloc.0 ret
+    REQUIRE(Match({0x00, 0x02, 0x7B, 0x23, 0x01, 0x00, 0x04, 0x0A, 0x2B, 0x00, 0x06, 0x2A}, fieldToken, isStatic));
+    CHECK(fieldToken == 0x04000123);
+    CHECK(!isStatic);
+
+    // Static: ldsfld ret
+    REQUIRE(Match({0x7E, 0x05, 0x00, 0x00, 0x04, 0x2A}, fieldToken, isStatic));
+    CHECK(fieldToken == 0x04000005);
+    CHECK(isStatic);
+
+    // Debug build static: nop ldsfld stloc.0 br.s 0 ldloc.0 ret
+    REQUIRE(Match({0x00, 0x7E, 0x05, 0x00, 0x00, 0x04, 0x0A, 0x2B, 0x00, 0x06, 0x2A}, fieldToken, isStatic));
+    CHECK(isStatic);
+}
+
+TEST_CASE("TrivialGetter::NoMatch")
+{
+    uint32_t fieldToken = 0;
+    bool isStatic = false;
+
+    // Empty and truncated code.
+    CHECK(!Match({}, fieldToken, isStatic));
+    CHECK(!Match({0x02, 0x7B, 0x01, 0x00}, fieldToken, isStatic));
+    CHECK(!Match({0x02, 0x7B, 0x01, 0x00, 0x00, 0x04}, fieldToken, isStatic));
+    // ldarg.0 ldfld ldfld ret (nested field access).
+    CHECK(!Match({0x02, 0x7B, 0x01, 0x00, 0x00, 0x04, 0x7B, 0x02, 0x00, 0x00, 0x04, 0x2A}, fieldToken, isStatic));
+    // ldarg.0 ldfld box ret (conversion).
+    CHECK(!Match({0x02, 0x7B, 0x01, 0x00, 0x00, 0x04, 0x8C, 0x01, 0x00, 0x00, 0x02, 0x2A}, fieldToken, isStatic));
+    // ldarg.0 call ret (getter call).
+    CHECK(!Match({0x02, 0x28, 0x01, 0x00, 0x00, 0x06, 0x2A}, fieldToken, isStatic));
+    // ldc.i4.1 ret (constant).
+    CHECK(!Match({0x17, 0x2A}, fieldToken, isStatic));
+    // Jump to other instruction than next one.
+    CHECK(!Match({0x00, 0x02, 0x7B, 0x23, 0x01, 0x00, 0x04, 0x0A, 0x2B, 0x01, 0x06, 0x2A}, fieldToken, isStatic));
+    // Code after ret.
+    CHECK(!Match({0x02, 0x7B, 0x01, 0x00, 0x00, 0x04, 0x2A, 0x2A}, fieldToken, isStatic));
+    // Too big code (valid pattern with leading nops).
+    std::vector<uint8_t> bigCode(MaxTrivialGetterILSize - 6, 0x00);
+    bigCode.insert(bigCode.end(), {0x02, 0x7B, 0x01, 0x00, 0x00, 0x04, 0x2A});
+    CHECK(!Match(bigCode, fieldToken, isStatic));
+}
@@ -0,0 +1,154 @@
+// Copyright (C) 2022 Samsung Electronics Co., Ltd.
+// See the LICENSE file in the project root for more information.
+
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <codecvt>
+#include <locale>
+#include <string>
+#include "utils/utf_transcode.h"
+
+using namespace netcoredbg;
+
+namespace
+{
+    std::string ToUtf8(const std::u16string &str)
+    {
+        std::string result(utf8_max_length(str.size()), '\0');
+        result.resize(utf16_to_utf8(str.data(), str.size(), &result[0]));
+        return result;
+    }
+
+    std::u16string ToUtf16(const std::string &str)
+    {
+        std::u16string result(utf16_max_length(str.size()), u'\0');
+        result.resize(utf8_to_utf16(str.data(), str.size(), &result[0]));
+        return result;
+    }
+
+    // Mixed text with all UTF-8 sequence lengths, long enough for fast path blocks.
+    std::u16string MixedText()
+    {
+        return u"ASCII only text, long enough for several blocks: 0123456789abcdef"
+               u" éè привет 你好 \U0001F600 \U00010348"
+               u" and ASCII tail after non ASCII characters 0123456789";
+    }
+}
+
+TEST_CASE("UtfTranscode::Ascii")
+{
+    CHECK(ToUtf8(u"").empty());
+    CHECK(ToUtf16("").empty());
+
+    // Lengths around fast path block size.
+    for (size_t len = 0; len < 70; len++)
+    {
+        std::string utf8;
+        std::u16string utf16;
+        for (size_t i = 0; i < len; i++)
+        {
+            utf8 += static_cast<char>(0x20 + i % 0x5f);
+            utf16 += static_cast<char16_t>(0x20 + i % 0x5f);
+        }
+        CHECK(ToUtf8(utf16) == utf8);
+        CHECK(ToUtf16(utf8) == utf16);
+    }
+}
+
+TEST_CASE("UtfTranscode::NonAscii")
+{
+    CHECK(ToUtf8(u"\u007f\u0080߿ࠀ￿") == "\x7f\xc2\x80\xdf\xbf\xe0\xa0\x80\xef\xbf\xbf");
+    CHECK(ToUtf8(u"\U00010000\U0010ffff") == "\xf0\x90\x80\x80\xf4\x8f\xbf\xbf");
+
+    std::u16string mixed = MixedText();
+    std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> convert;
+    CHECK(ToUtf8(mixed) == convert.to_bytes(mixed));
+    CHECK(ToUtf16(convert.to_bytes(mixed)) == mixed);
+
+    // Non ASCII character at each position of fast path block.
+    for (size_t pos = 0; pos < 40; pos++)
+    {
+        std::u16string str(40, u'a');
+        str[pos] = u'я';
+        CHECK(ToUtf16(ToUtf8(str)) == str);
+        CHECK(ToUtf8(str) == convert.to_bytes(str));
+    }
+}
+
+TEST_CASE("UtfTranscode::LoneSurrogates")
+{
+    // Lone surrogates survive round trip (encoded as 3 bytes sequences).
+    std::u16string lone;
+    lone += u'a';
+    lone += static_cast<char16_t>(0xd800);
+    lone += u'b';
+    lone += static_cast<char16_t>(0xdfff);
+    lone += static_cast<char16_t>(0xdc00); // low surrogate before high surrogate, not a pair
+    lone += static_cast<char16_t>(0xd83d);
+    CHECK(ToUtf8(lone) == "a\xed\xa0\x80" "b\xed\xbf\xbf\xed\xb0\x80\xed\xa0\xbd");
+    CHECK(ToUtf16(ToUtf8(lone)) == lone);
+
+    // Pair split at the end of fast path block.
+    std::u16string split(15, u'x');
+    split += u"\U0001F600";
+    split += std::u16string(20, u'y');
+    CHECK(ToUtf16(ToUtf8(split)) == split);
+}
+
+TEST_CASE("UtfTranscode::InvalidUtf8")
+{
+    const std::u16string replacement(1, static_cast<char16_t>(0xfffd));
+
+    CHECK(ToUtf16("a\x80" "b") == u"a" + replacement + u"b");              // unexpected continuation byte
+    CHECK(ToUtf16("\xc0\xaf") == replacement + replacement);               // overlong 2 bytes
+    CHECK(ToUtf16("\xe0\x80\xaf") == replacement + replacement + replacement); // overlong 3 bytes
+    CHECK(ToUtf16("\xf4\x90\x80\x80") == replacement + replacement + replacement + replacement); // > U+10FFFF
+    CHECK(ToUtf16("\xe4\xbd") == replacement + replacement);               // truncated sequence
+    CHECK(ToUtf16("\xff" "abc") == replacement + u"abc");
+}
+
+TEST_CASE("UtfTranscode::Benchmark", "[.][benchmark]")
+{
+    const int iterations = 200;
+    std::u16string ascii(1024 * 1024, u'a');
+    std::u16string mixed;
+    while (mixed.size() < ascii.size())
+        mixed += MixedText();
+
+    std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t> convert;
+
+    for (const std::u16string *text : {&ascii, &mixed})
+    {
+        std::string utf8(utf8_max_length(text->size()), '\0');
+        size_t size = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+            size += utf16_to_utf8(text->data(), text->size(), &utf8[0]);
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        size_t sizeConvert = 0;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+            sizeConvert += convert.to_bytes(text->data(), text->data() + text->size()).size();
+        auto elapsedConvert = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        CHECK(size == sizeConvert);
+        WARN((text == &ascii ? "ASCII" : "mixed") << " UTF-16 -> UTF-8, " << text->size() << " code units: "
+             << (double)elapsed / iterations << " us, wstring_convert " << (double)elapsedConvert / iterations << " us");
+
+        std::u16string utf16(utf16_max_length(utf8.size()), u'\0');
+        utf8.resize(utf16_to_utf8(text->data(), text->size(), &utf8[0]));
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+            size += utf8_to_utf16(utf8.data(), utf8.size(), &utf16[0]);
+        elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++)
+            sizeConvert += convert.from_bytes(utf8).size();
+        elapsedConvert = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+        WARN((text == &ascii ? "ASCII" : "mixed") << " UTF-8 -> UTF-16, " << utf8.size() << " bytes: "
+             << (double)elapsed / iterations << " us, wstring_convert " << (double)elapsedConvert / iterations << " us");
+    }
+}
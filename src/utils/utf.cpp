@@ -3,28 +3,37 @@
 // See the LICENSE file in the project root for more information.
 
 #include "utils/utf.h"
-
-#include <codecvt>
-#include <locale>
+#include "utils/utf_transcode.h"
 
 namespace netcoredbg
 {
 
-static std::wstring_convert<std::codecvt_utf8_utf16<WCHAR>,WCHAR> convert;
+static_assert(sizeof(WCHAR) == sizeof(char16_t), "WCHAR must be UTF-16 code unit");
+
+std::string to_utf8(const WCHAR *wstr, size_t len)
+{
+    std::string result;
+    result.resize(utf8_max_length(len));
+    result.resize(utf16_to_utf8(reinterpret_cast<const char16_t*>(wstr), len, &result[0]));
+    return result;
+}
 
 std::string to_utf8(const WCHAR *wstr)
 {
-    return convert.to_bytes(wstr);
+    return to_utf8(wstr, std::char_traits<WCHAR>::length(wstr));
 }
 
 std::string to_utf8(WCHAR wch)
 {
-    return convert.to_bytes(wch);
+    return to_utf8(&wch, 1);
 }
 
 WSTRING to_utf16(const std::string &utf8)
 {
-    return convert.from_bytes(utf8);
+    WSTRING result;
+    result.resize(utf16_max_length(utf8.size()));
+    result.resize(utf8_to_utf16(utf8.data(), utf8.size(), reinterpret_cast<char16_t*>(&result[0])));
+    return result;
 }
 
 } // namespace netcoredbg
@@ -25,7 +25,9 @@ typedef std::wstring WSTRING;
 typedef std::u16string WSTRING;
 #endif
 
+// Note, lone surrogates converted into UTF-8 losslessly and invalid UTF-8 into U+FFFD, see utils/utf_transcode.h.
 std::string to_utf8(const WCHAR *wstr);
+std::string to_utf8(const WCHAR *wstr, size_t len);
 WSTRING to_utf16(const std::string &utf8);
 std::string to_utf8(WCHAR wch);
 
@@ -0,0 +1,191 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+
+#include "utils/utf_transcode.h"
+
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define UTF_TRANSCODE_SSE2
+#endif
+
+namespace netcoredbg
+{
+
+namespace
+{
+    // Note, ASCII fast path check and convert 16 characters per iteration, scalar code convert at least same amount of
+    // characters after fast path fail, so, non ASCII text don't pay for fast path check at each character.
+    const size_t BlockSize = 16;
+
+    inline bool IsHighSurrogate(uint32_t ch) { return ch >= 0xd800 && ch <= 0xdbff; }
+    inline bool IsLowSurrogate(uint32_t ch) { return ch >= 0xdc00 && ch <= 0xdfff; }
+    inline bool IsContinuation(uint8_t ch) { return (ch & 0xc0) == 0x80; }
+
+    inline size_t Utf16ToUtf8AsciiBlocks(const char16_t *src, size_t len, char *dst)
+    {
+        size_t i = 0;
+#ifdef UTF_TRANSCODE_SSE2
+        const __m128i nonAsciiMask = _mm_set1_epi16(static_cast<short>(0xff80));
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + BlockSize <= len; i += BlockSize)
+        {
+            __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+            __m128i nonAscii = _mm_and_si128(_mm_or_si128(first, second), nonAsciiMask);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(nonAscii, zero)) != 0xffff)
+                break;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(first, second));
+        }
+#else
+        for (; i + BlockSize <= len; i += BlockSize)
+        {
+            uint32_t nonAscii = 0;
+            for (size_t j = 0; j < BlockSize; j++)
+                nonAscii |= src[i + j];
+            if (nonAscii >= 0x80)
+                break;
+            for (size_t j = 0; j < BlockSize; j++)
+                dst[i + j] = static_cast<char>(src[i + j]);
+        }
+#endif
+        return i;
+    }
+
+    inline size_t Utf8ToUtf16AsciiBlocks(const char *src, size_t len, char16_t *dst)
+    {
+        size_t i = 0;
+#ifdef UTF_TRANSCODE_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        for (; i + BlockSize <= len; i += BlockSize)
+        {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            if (_mm_movemask_epi8(bytes) != 0)
+                break;
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi8(bytes, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), _mm_unpackhi_epi8(bytes, zero));
+        }
+#else
+        for (; i + BlockSize <= len; i += BlockSize)
+        {
+            uint8_t nonAscii = 0;
+            for (size_t j = 0; j < BlockSize; j++)
+                nonAscii |= static_cast<uint8_t>(src[i + j]);
+            if (nonAscii >= 0x80)
+                break;
+            for (size_t j = 0; j < BlockSize; j++)
+                dst[i + j] = static_cast<char16_t>(src[i + j]);
+        }
+#endif
+        return i;
+    }
+
+} // unnamed namespace
+
+size_t utf16_to_utf8(const char16_t *src, size_t len, char *dst)
+{
+    char *out = dst;
+    size_t i = 0;
+    while (i < len)
+    {
+        size_t ascii = Utf16ToUtf8AsciiBlocks(src + i, len - i, out);
+        i += ascii;
+        out += ascii;
+
+        size_t blockEnd = (len - i > BlockSize) ? i + BlockSize : len;
+        while (i < blockEnd)
+        {
+            uint32_t ch = src[i++];
+            if (ch < 0x80)
+            {
+                *out++ = static_cast<char>(ch);
+            }
+            else if (ch < 0x800)
+            {
+                *out++ = static_cast<char>(0xc0 | (ch >> 6));
+                *out++ = static_cast<char>(0x80 | (ch & 0x3f));
+            }
+            else if (IsHighSurrogate(ch) && i < len && IsLowSurrogate(src[i]))
+            {
+                uint32_t cp = 0x10000 + ((ch - 0xd800) << 10) + (src[i++] - 0xdc00);
+                *out++ = static_cast<char>(0xf0 | (cp >> 18));
+                *out++ = static_cast<char>(0x80 | ((cp >> 12) & 0x3f));
+                *out++ = static_cast<char>(0x80 | ((cp >> 6) & 0x3f));
+                *out++ = static_cast<char>(0x80 | (cp & 0x3f));
+            }
+            else
+            {
+                // BMP character or lone surrogate.
+                *out++ = static_cast<char>(0xe0 | (ch >> 12));
+                *out++ = static_cast<char>(0x80 | ((ch >> 6) & 0x3f));
+                *out++ = static_cast<char>(0x80 | (ch & 0x3f));
+            }
+        }
+    }
+    return out - dst;
+}
+
+size_t utf8_to_utf16(const char *src, size_t len, char16_t *dst)
+{
+    const uint8_t *in = reinterpret_cast<const uint8_t*>(src);
+    char16_t *out = dst;
+    size_t i = 0;
+    while (i < len)
+    {
+        size_t ascii = Utf8ToUtf16AsciiBlocks(src + i, len - i, out);
+        i += ascii;
+        out += ascii;
+
+        size_t blockEnd = (len - i > BlockSize) ? i + BlockSize : len;
+        while (i < blockEnd)
+        {
+            uint8_t ch = in[i];
+            if (ch < 0x80)
+            {
+                *out++ = ch;
+                i++;
+                continue;
+            }
+
+            if (ch >= 0xc2 && ch <= 0xdf && i + 1 < len && IsContinuation(in[i + 1]))
+            {
+                *out++ = static_cast<char16_t>(((ch & 0x1f) << 6) | (in[i + 1] & 0x3f));
+                i += 2;
+                continue;
+            }
+
+            if (ch >= 0xe0 && ch <= 0xef && i + 2 < len && IsContinuation(in[i + 1]) && IsContinuation(in[i + 2]))
+            {
+                uint32_t cp = ((ch & 0x0f) << 12) | ((in[i + 1] & 0x3f) << 6) | (in[i + 2] & 0x3f);
+                // Note, encoded surrogates are accepted (lone surrogates encoded this way).
+                if (cp >= 0x800)
+                {
+                    *out++ = static_cast<char16_t>(cp);
+                    i += 3;
+                    continue;
+                }
+            }
+            else if (ch >= 0xf0 && ch <= 0xf4 && i + 3 < len &&
+                     IsContinuation(in[i + 1]) && IsContinuation(in[i + 2]) && IsContinuation(in[i + 3]))
+            {
+                uint32_t cp = ((ch & 0x07) << 18) | ((in[i + 1] & 0x3f) << 12) | ((in[i + 2] & 0x3f) << 6) | (in[i + 3] & 0x3f);
+                if (cp >= 0x10000 && cp <= 0x10ffff)
+                {
+                    cp -= 0x10000;
+                    *out++ = static_cast<char16_t>(0xd800 + (cp >> 10));
+                    *out++ = static_cast<char16_t>(0xdc00 + (cp & 0x3ff));
+                    i += 4;
+                    continue;
+                }
+            }
+
+            *out++ = 0xfffd;
+            i++;
+        }
+    }
+    return out - dst;
+}
+
+} // namespace netcoredbg
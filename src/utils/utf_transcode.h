@@ -0,0 +1,28 @@
+// Copyright (c) 2022 Samsung Electronics Co., LTD
+// Distributed under the MIT License.
+// See the LICENSE file in the project root for more information.
+#pragma once
+
+#include <cstddef>
+
+namespace netcoredbg
+{
+
+// UTF-16 <-> UTF-8 transcoding into caller-provided buffers, without CoreCLR headers dependency (see utils/utf.h
+// for WCHAR based interface).
+// Note, lone surrogates are encoded as 3 bytes sequences (WTF-8), so, any UTF-16 string survive round trip.
+// Invalid UTF-8 sequences are converted into U+FFFD, one replacement character per invalid byte.
+
+// Maximum UTF-8 size (in bytes) for UTF-16 string with `len` code units.
+inline size_t utf8_max_length(size_t len) { return len * 3; }
+
+// Maximum UTF-16 size (in code units) for UTF-8 string with `len` bytes.
+inline size_t utf16_max_length(size_t len) { return len; }
+
+// Convert `len` UTF-16 code units into `dst` with at least utf8_max_length(len) bytes, return written bytes count.
+size_t utf16_to_utf8(const char16_t *src, size_t len, char *dst);
+
+// Convert `len` UTF-8 bytes into `dst` with at least utf16_max_length(len) code units, return written code units count.
+size_t utf8_to_utf16(const char *src, size_t len, char16_t *dst);
+
+} // namespace netcoredbg